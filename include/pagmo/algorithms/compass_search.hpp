@@ -83,6 +83,15 @@ namespace pagmo
  *    Compass search is a fully deterministic algorithms and will produce identical results if its evolve method is
  *    called from two identical populations.
  *
+ * .. note::
+ *
+ *    Since version 2.20, the trial points are evaluated via :cpp:func:`pagmo::problem::incremental_fitness()`,
+ *    as each trial point differs from the current best in a single component. If the problem supports
+ *    incremental fitness evaluations, one fitness evaluation of the budget is reserved to recompute
+ *    from scratch the fitness of the final best point, in order to remove the accumulated rounding errors.
+ *    Since the moves are accepted on the incrementally computed values, runs on such problems
+ *    may follow a different path than in previous versions.
+ *
  * .. seealso::
  *
  *    Kolda, Lewis, Torczon: 'Optimization by Direct Search: New Perspectives on Some Classical and Modern Methods'
@@ -33,7 +33,10 @@ see https://www.gnu.org/licenses/. */
 #include <tuple>
 #include <vector>
 
+#include <boost/optional.hpp>
+
 #include <pagmo/algorithm.hpp>
+#include <pagmo/bfe.hpp>
 #include <pagmo/detail/visibility.hpp>
 #include <pagmo/population.hpp>
 #include <pagmo/rng.hpp>
@@ -62,6 +65,12 @@ namespace pagmo
  *    The feasibility correction, that is the correction applied to an allele when some mutation puts it outside
  *    the allowed box-bounds, is here done by creating a random number in the bounds.
  *
+ * .. note::
+ *
+ *    If a batch fitness evaluator is set via set_bfe(), all the trial vectors of a generation are
+ *    evaluated at once with it. Since the trial vectors are generated only from the individuals of
+ *    the previous generation, the evolution is the same as without a batch fitness evaluator.
+ *
  * .. seealso::
  *
  *    The paper that introduces Differential Evolution https://link.springer.com/article/10.1023%2FA%3A1008202821328
@@ -159,6 +168,8 @@ public:
     {
         return m_gen;
     }
+    // Sets the bfe.
+    void set_bfe(const bfe &);
     /// Algorithm name
     /**
      * One of the optional methods of any user-defined algorithm (UDA).
@@ -199,10 +210,14 @@ private:
     unsigned m_seed;
     unsigned m_verbosity;
     mutable log_type m_log;
+    boost::optional<bfe> m_bfe;
 };
 
 } // namespace pagmo
 
 PAGMO_S11N_ALGORITHM_EXPORT_KEY(pagmo::de)
 
+// NOTE: version 1 added the bfe.
+BOOST_CLASS_VERSION(pagmo::de, 1)
+
 #endif
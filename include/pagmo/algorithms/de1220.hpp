@@ -33,7 +33,10 @@ see https://www.gnu.org/licenses/. */
 #include <tuple>
 #include <vector>
 
+#include <boost/optional.hpp>
+
 #include <pagmo/algorithm.hpp>
+#include <pagmo/bfe.hpp>
 #include <pagmo/detail/visibility.hpp>
 #include <pagmo/population.hpp>
 #include <pagmo/rng.hpp>
@@ -88,6 +91,13 @@ const std::vector<unsigned> de1220_statics<T>::allowed_variants = {2u, 3u, 7u, 1
  *    The search range is defined relative to the box-bounds. Hence, unbounded problems
  *    will produce an error.
  *
+ * .. note::
+ *
+ *    If a batch fitness evaluator is set via set_bfe(), the algorithm becomes generational: all the
+ *    trial vectors of a generation are created first, and then evaluated at once with the batch fitness
+ *    evaluator. The adapted parameters are thus updated only at the end of each generation, and the
+ *    evolution will in general differ from the one obtained without a batch fitness evaluator.
+ *
  *
  * .. seealso::
  *
@@ -225,6 +235,9 @@ public:
         return m_gen;
     }
 
+    // Sets the bfe.
+    void set_bfe(const bfe &);
+
     /// Algorithm name
     /**
      * One of the optional methods of any user-defined algorithm (UDA).
@@ -272,10 +285,14 @@ private:
     unsigned m_seed;
     unsigned m_verbosity;
     mutable log_type m_log;
+    boost::optional<bfe> m_bfe;
 };
 
 } // namespace pagmo
 
 PAGMO_S11N_ALGORITHM_EXPORT_KEY(pagmo::de1220)
 
+// NOTE: version 1 added the bfe.
+BOOST_CLASS_VERSION(pagmo::de1220, 1)
+
 #endif
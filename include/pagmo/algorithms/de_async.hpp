@@ -0,0 +1,211 @@
+/* Copyright 2017-2021 PaGMO development team
+
+This file is part of the PaGMO library.
+
+The PaGMO library is free software; you can redistribute it and/or modify
+it under the terms of either:
+
+  * the GNU Lesser General Public License as published by the Free
+    Software Foundation; either version 3 of the License, or (at your
+    option) any later version.
+
+or
+
+  * the GNU General Public License as published by the Free Software
+    Foundation; either version 3 of the License, or (at your option) any
+    later version.
+
+or both in parallel, as here.
+
+The PaGMO library is distributed in the hope that it will be useful, but
+WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+for more details.
+
+You should have received copies of the GNU General Public License and the
+GNU Lesser General Public License along with the PaGMO library.  If not,
+see https://www.gnu.org/licenses/. */
+
+#ifndef PAGMO_ALGORITHMS_DE_ASYNC_HPP
+#define PAGMO_ALGORITHMS_DE_ASYNC_HPP
+
+#include <string>
+#include <tuple>
+#include <vector>
+
+#include <pagmo/algorithm.hpp>
+#include <pagmo/detail/visibility.hpp>
+#include <pagmo/population.hpp>
+#include <pagmo/rng.hpp>
+#include <pagmo/s11n.hpp>
+
+namespace pagmo
+{
+
+/// Asynchronous steady-state Differential Evolution
+/**
+ * This is a steady-state version of pagmo::de, in which the fitness evaluations run asynchronously
+ * on a set of worker threads (see pagmo::async_evaluator). Rather than waiting for all the trial vectors of
+ * a generation to be evaluated, the outcome of each evaluation is integrated in the population
+ * as soon as it is available, and a new trial vector is immediately created and submitted in its place.
+ * Workers thus never sit idle waiting for the slowest evaluation of a generation, which makes this algorithm
+ * suitable for expensive fitness functions with variable runtimes.
+ *
+ * The target individuals of the trial vectors are selected in a round-robin fashion, and each
+ * trial vector is built, with the mutation variants of pagmo::de, from the population as it is at the time
+ * of the submission. A trial vector replaces its target individual if its fitness is not worse than
+ * the fitness of the target individual at the time of the completion of the evaluation.
+ *
+ * In order to be comparable with pagmo::de, the number of evaluations is expressed in generations,
+ * where each generation amounts to a number of evaluations equal to the population size. The stopping
+ * criteria and the logs are checked and updated at the end of each generation.
+ *
+ * \verbatim embed:rst:leading-asterisk
+ * .. versionadded:: 2.20
+ *
+ * .. note::
+ *
+ *    With more than one worker thread, the order in which the evaluations complete depends on the
+ *    scheduling of the threads, thus the outcome of the evolution is not reproducible
+ *    even if the seed is fixed.
+ *
+ * .. note::
+ *
+ *    The problem must provide at least the :cpp:enumerator:`~pagmo::thread_safety::basic` thread safety level.
+ *    The evaluations of the trial vectors still pending when the evolution stops are discarded,
+ *    and they are not accounted for in the fitness evaluations counter of the problem.
+ *
+ * .. seealso::
+ *
+ *    :cpp:class:`pagmo::de` for the generational version of this algorithm.
+ *
+ * \endverbatim
+ */
+class PAGMO_DLL_PUBLIC de_async
+{
+public:
+    /// Single entry of the log (gen, fevals, best, dx, df)
+    typedef std::tuple<unsigned, unsigned long long, double, double, double> log_line_type;
+    /// The log
+    typedef std::vector<log_line_type> log_type;
+
+    /// Constructor.
+    /**
+     * Constructs de_async. The mutation variants are the same as in pagmo::de.
+     *
+     * @param gen number of generations.
+     * @param F weight coefficient (default value is 0.8)
+     * @param CR crossover probability (default value is 0.9)
+     * @param variant mutation variant (default variant is 2: /rand/1/exp)
+     * @param ftol stopping criteria on the f tolerance (default is 1e-6)
+     * @param xtol stopping criteria on the x tolerance (default is 1e-6)
+     * @param n_workers number of worker threads, which is also the maximum number of evaluations
+     * running at the same time (default is 0, meaning the hardware concurrency)
+     * @param seed seed used by the internal random number generator (default is random)
+     *
+     * @throws std::invalid_argument if F, CR are not in [0,1]
+     * @throws std::invalid_argument if variant is not one of 1 .. 10
+     */
+    de_async(unsigned gen = 1u, double F = 0.8, double CR = 0.9, unsigned variant = 2u, double ftol = 1e-6,
+             double xtol = 1e-6, unsigned n_workers = 0u, unsigned seed = pagmo::random_device::next());
+
+    // Evolve.
+    population evolve(population) const;
+    // Set the seed.
+    void set_seed(unsigned);
+    /// Get the seed
+    /**
+     * @return the seed controlling the algorithm stochastic behaviour
+     */
+    unsigned get_seed() const
+    {
+        return m_seed;
+    }
+    /// Sets the algorithm verbosity
+    /**
+     * Sets the verbosity level of the screen output and of the
+     * log returned by get_log(). \p level can be:
+     * - 0: no verbosity
+     * - >0: will print and log one line each \p level generations.
+     *
+     * The content of the log lines is the same as in pagmo::de.
+     *
+     * @param level verbosity level
+     */
+    void set_verbosity(unsigned level)
+    {
+        m_verbosity = level;
+    }
+    /// Gets the verbosity level
+    /**
+     * @return the verbosity level
+     */
+    unsigned get_verbosity() const
+    {
+        return m_verbosity;
+    }
+    /// Gets the generations
+    /**
+     * @return the number of generations to evolve for
+     */
+    unsigned get_gen() const
+    {
+        return m_gen;
+    }
+    /// Gets the number of worker threads
+    /**
+     * @return the number of worker threads (0 means the hardware concurrency)
+     */
+    unsigned get_n_workers() const
+    {
+        return m_n_workers;
+    }
+    /// Algorithm name
+    /**
+     * One of the optional methods of any user-defined algorithm (UDA).
+     *
+     * @return a string containing the algorithm name
+     */
+    std::string get_name() const
+    {
+        return "DE (async): Asynchronous steady-state Differential Evolution";
+    }
+    // Extra info.
+    std::string get_extra_info() const;
+    /// Get log
+    /**
+     * A log containing relevant quantities monitoring the last call to evolve. Each element of the returned
+     * <tt>std::vector</tt> is a de_async::log_line_type containing: Gen, Fevals, Best, dx, df as described
+     * in pagmo::de::set_verbosity
+     * @return an <tt>std::vector</tt> of de_async::log_line_type containing the logged values Gen, Fevals, Best,
+     * dx, df
+     */
+    const log_type &get_log() const
+    {
+        return m_log;
+    }
+
+private:
+    // Object serialization
+    friend class boost::serialization::access;
+    template <typename Archive>
+    void serialize(Archive &, unsigned);
+
+    unsigned m_gen;
+    double m_F;
+    double m_CR;
+    unsigned m_variant;
+    double m_Ftol;
+    double m_xtol;
+    unsigned m_n_workers;
+    mutable detail::random_engine_type m_e;
+    unsigned m_seed;
+    unsigned m_verbosity;
+    mutable log_type m_log;
+};
+
+} // namespace pagmo
+
+PAGMO_S11N_ALGORITHM_EXPORT_KEY(pagmo::de_async)
+
+#endif
@@ -166,6 +166,43 @@ public:
         return m_last_opt_res;
     }
 
+    /// Get the number of reused fitness evaluations in the last optimisation.
+    /**
+     * \verbatim embed:rst:leading-asterisk
+     * .. versionadded:: 2.20
+     * \endverbatim
+     *
+     * Ipopt requests separately the value of the objective function and of the constraints, which
+     * pagmo computes together in a single fitness evaluation. If Ipopt signals that the decision vector
+     * has not changed since the previous request, the last computed fitness is reused.
+     *
+     * @return the number of requests for the objective function or the constraints which, during the
+     * last evolve() call, were served by reusing a previously-computed fitness vector, or zero if no
+     * optimisations have been run yet.
+     */
+    unsigned long get_last_fitness_reuses() const
+    {
+        return m_last_fitness_reuses;
+    }
+
+    /// Get the number of reused gradient evaluations in the last optimisation.
+    /**
+     * \verbatim embed:rst:leading-asterisk
+     * .. versionadded:: 2.20
+     * \endverbatim
+     *
+     * This is the analogue of get_last_fitness_reuses() for the gradients of the objective function
+     * and of the constraints.
+     *
+     * @return the number of requests for the gradient of the objective function or for the Jacobian of
+     * the constraints which, during the last evolve() call, were served by reusing a previously-computed
+     * gradient, or zero if no optimisations have been run yet.
+     */
+    unsigned long get_last_gradient_reuses() const
+    {
+        return m_last_gradient_reuses;
+    }
+
     /// Get the algorithm's name.
     /**
      * @return <tt>"Ipopt"</tt>.
@@ -308,6 +345,9 @@ private:
     std::map<std::string, double> m_numeric_opts;
     // Solver return status.
     mutable Ipopt::ApplicationReturnStatus m_last_opt_res = Ipopt::Solve_Succeeded;
+    // Reused fitness/gradient evaluations.
+    mutable unsigned long m_last_fitness_reuses = 0;
+    mutable unsigned long m_last_gradient_reuses = 0;
     // Verbosity/log.
     unsigned m_verbosity = 0;
     mutable log_type m_log;
@@ -316,6 +356,9 @@ private:
 
 PAGMO_S11N_ALGORITHM_EXPORT_KEY(pagmo::ipopt)
 
+// NOTE: version 1 added the reuse counters.
+BOOST_CLASS_VERSION(pagmo::ipopt, 1)
+
 #else // PAGMO_WITH_IPOPT
 
 #error The ipopt.hpp header was included, but pagmo was not compiled with Ipopt support
@@ -220,6 +220,42 @@ public:
         return m_last_opt_result;
     }
 
+    /// Get the number of reused fitness evaluations in the last optimisation.
+    /**
+     * \verbatim embed:rst:leading-asterisk
+     * .. versionadded:: 2.20
+     * \endverbatim
+     *
+     * NLopt invokes separately the objective function and the constraints, which pagmo computes
+     * together in a single fitness evaluation. If they are invoked at the same decision vector,
+     * the last computed fitness is reused.
+     *
+     * @return the number of invocations of the objective function or of the constraints which, during
+     * the last evolve() call, were served by reusing a previously-computed fitness vector, or zero if no
+     * optimisations have been run yet.
+     */
+    unsigned long get_last_fitness_reuses() const
+    {
+        return m_last_fitness_reuses;
+    }
+
+    /// Get the number of reused gradient evaluations in the last optimisation.
+    /**
+     * \verbatim embed:rst:leading-asterisk
+     * .. versionadded:: 2.20
+     * \endverbatim
+     *
+     * This is the analogue of get_last_fitness_reuses() for the gradients of the objective function
+     * and of the constraints.
+     *
+     * @return the number of gradient requests which, during the last evolve() call, were served by
+     * reusing a previously-computed gradient, or zero if no optimisations have been run yet.
+     */
+    unsigned long get_last_gradient_reuses() const
+    {
+        return m_last_gradient_reuses;
+    }
+
     /// Get the ``stopval`` stopping criterion.
     /**
      * The ``stopval`` stopping criterion instructs the solver to stop when an objective value less than
@@ -408,6 +444,9 @@ private:
 
     std::string m_algo;
     mutable ::nlopt_result m_last_opt_result = NLOPT_SUCCESS;
+    // Reused fitness/gradient evaluations.
+    mutable unsigned long m_last_fitness_reuses = 0;
+    mutable unsigned long m_last_gradient_reuses = 0;
     // Stopping criteria.
     double m_sc_stopval = -HUGE_VAL;
     double m_sc_ftol_rel = 0.;
@@ -426,6 +465,9 @@ private:
 
 PAGMO_S11N_ALGORITHM_EXPORT_KEY(pagmo::nlopt)
 
+// NOTE: version 1 added the reuse counters.
+BOOST_CLASS_VERSION(pagmo::nlopt, 1)
+
 #else // PAGMO_WITH_NLOPT
 
 #error The nlopt.hpp header was included, but pagmo was not compiled with NLopt support
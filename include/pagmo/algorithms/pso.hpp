@@ -105,6 +105,11 @@ namespace pagmo
  *
  *    https://link.springer.com/article/10.1007%2Fs11721-007-0002-0 for a survey
  *
+ * .. seealso::
+ *
+ *    :cpp:class:`pagmo::pso_gen` for a generational variant of PSO, which supports
+ *    batch fitness evaluation
+ *
  * \endverbatim
  */
 class PAGMO_DLL_PUBLIC pso
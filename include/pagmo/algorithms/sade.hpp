@@ -33,7 +33,10 @@ see https://www.gnu.org/licenses/. */
 #include <tuple>
 #include <vector>
 
+#include <boost/optional.hpp>
+
 #include <pagmo/algorithm.hpp>
+#include <pagmo/bfe.hpp>
 #include <pagmo/detail/visibility.hpp>
 #include <pagmo/population.hpp>
 #include <pagmo/rng.hpp>
@@ -75,6 +78,13 @@ namespace pagmo
  *    The feasibility correction, that is the correction applied to an allele when some mutation puts it outside
  *    the allowed box-bounds, is here done by creating a random number in the bounds.
  *
+ * .. note::
+ *
+ *    If a batch fitness evaluator is set via set_bfe(), the algorithm becomes generational: all the
+ *    trial vectors of a generation are created first, and then evaluated at once with the batch fitness
+ *    evaluator. The adapted parameters are thus updated only at the end of each generation, and the
+ *    evolution will in general differ from the one obtained without a batch fitness evaluator.
+ *
  * .. seealso::
  *
  *    (jDE) - Brest, J., Greiner, S., Bošković, B., Mernik, M., & Zumer, V. (2006). Self-adapting control parameters
@@ -203,6 +213,9 @@ public:
         return m_gen;
     }
 
+    // Sets the bfe.
+    void set_bfe(const bfe &);
+
     /// Algorithm name
     /**
      * One of the optional methods of any user-defined algorithm (UDA).
@@ -248,10 +261,14 @@ private:
     unsigned m_seed;
     unsigned m_verbosity;
     mutable log_type m_log;
+    boost::optional<bfe> m_bfe;
 };
 
 } // namespace pagmo
 
 PAGMO_S11N_ALGORITHM_EXPORT_KEY(pagmo::sade)
 
+// NOTE: version 1 added the bfe.
+BOOST_CLASS_VERSION(pagmo::sade, 1)
+
 #endif
@@ -71,6 +71,17 @@ namespace pagmo
  *    At each call of the evolve method the number of fitness evaluations will be
  *    `n_T_adj` * `n_range_adj` * `bin_size` times the problem dimension
  *
+ * .. note::
+ *
+ *    Since version 2.20, the moves of the algorithm are evaluated via
+ *    :cpp:func:`pagmo::problem::incremental_fitness()`, as each move perturbs a single
+ *    component of the current point. If the problem supports incremental fitness evaluations,
+ *    the fitness of the best point is recomputed from scratch before it is written back into
+ *    the population, in order to remove the rounding errors accumulated by the incremental
+ *    evaluations. This adds one fitness evaluation to the count above. Since the acceptance
+ *    of the moves is decided on the incrementally computed values, seeded runs on such problems
+ *    may follow a different path than in previous versions.
+ *
  * .. seealso::
  *
  *    Corana, A., Marchesi, M., Martini, C., & Ridella, S. (1987). Minimizing multimodal
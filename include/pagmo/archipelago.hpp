@@ -30,13 +30,14 @@ see https://www.gnu.org/licenses/. */
 #define PAGMO_ARCHIPELAGO_HPP
 
 #include <atomic>
+#include <functional>
 #include <iostream>
 #include <memory>
 #include <mutex>
 #include <random>
+#include <string>
 #include <tuple>
 #include <type_traits>
-#include <unordered_map>
 #include <utility>
 #include <vector>
 
@@ -46,13 +47,16 @@ see https://www.gnu.org/licenses/. */
 #include <pagmo/algorithm.hpp>
 #include <pagmo/bfe.hpp>
 #include <pagmo/detail/archipelago_fwd.hpp>
+#include <pagmo/detail/migration_db.hpp>
 #include <pagmo/detail/support_xeus_cling.hpp>
 #include <pagmo/detail/visibility.hpp>
 #include <pagmo/island.hpp>
 #include <pagmo/problem.hpp>
 #include <pagmo/r_policy.hpp>
+#include <pagmo/rng.hpp>
 #include <pagmo/s11n.hpp>
 #include <pagmo/s_policy.hpp>
+#include <pagmo/threading.hpp>
 #include <pagmo/topology.hpp>
 #include <pagmo/type_traits.hpp>
 #include <pagmo/types.hpp>
@@ -102,11 +106,38 @@ enum class migrant_handling {
     evict     ///< Evict migrants from the database.
 };
 
+/// Migration log mode.
+/**
+ * \verbatim embed:rst:leading-asterisk
+ * .. versionadded:: 2.20
+ *
+ * This enumeration represents the available modes for the
+ * migration log of an :cpp:class:`~pagmo::archipelago`:
+ *
+ * - in the unbounded mode, all the migration entries are stored
+ *   in the archipelago;
+ * - in the bounded mode, only the most recent migration entries
+ *   (up to a fixed number) are stored in the archipelago;
+ * - in the off mode, migrations are not recorded;
+ * - in the stream mode, the migration entries are not stored in the
+ *   archipelago, and they are instead forwarded to a user-supplied sink.
+ *
+ * \endverbatim
+ */
+enum class migration_log_mode {
+    unbounded, ///< Store all the migration entries.
+    bounded,   ///< Store only the most recent migration entries.
+    off,       ///< Do not record migrations.
+    stream     ///< Forward the migration entries to a sink.
+};
+
 #if !defined(PAGMO_DOXYGEN_INVOKED)
 
-// Provide the stream operator overloads for migration_type and migrant_handling.
+// Provide the stream operator overloads for migration_type, migrant_handling
+// and migration_log_mode.
 PAGMO_DLL_PUBLIC std::ostream &operator<<(std::ostream &, migration_type);
 PAGMO_DLL_PUBLIC std::ostream &operator<<(std::ostream &, migrant_handling);
+PAGMO_DLL_PUBLIC std::ostream &operator<<(std::ostream &, migration_log_mode);
 
 #endif
 
@@ -195,12 +226,23 @@ public:
      */
     using migration_log_t = std::vector<migration_entry_t>;
 
+    /// Migration log sink.
+    /**
+     * \verbatim embed:rst:leading-asterisk
+     * .. versionadded:: 2.20
+     *
+     * A callable which, in the :cpp:enumerator:`~pagmo::migration_log_mode::stream`
+     * migration log mode, is invoked with the batches of migration entries
+     * produced by the islands. The sink may be invoked concurrently from
+     * multiple threads.
+     * \endverbatim
+     */
+    using migration_log_sink_t = std::function<void(const migration_log_t &)>;
+
 private:
-    // A map to connect island pointers to an idx
-    // in the archipelago. This will be used by islands
-    // during migration in order to establish the island
-    // indices within the archipelago.
-    using idx_map_t = std::unordered_map<const island *, size_type>;
+    // The state of the migration log.
+    struct migr_log_state;
+    PAGMO_DLL_LOCAL std::shared_ptr<migr_log_state> get_migr_log_state() const;
 
 public:
     /// Mutable iterator.
@@ -267,17 +309,68 @@ private:
     template <typename... Args>
     using n_ctor_enabler = enable_if_t<std::is_constructible<island, Args...>::value, int>;
 #endif
+    // Construct n islands via the functor f (which returns
+    // a pointer to the i-th island when invoked with i), and push them back.
+    // The islands are constructed in parallel, unless par is false or the
+    // first island has insufficient thread safety guarantees.
+    void push_back_n(size_type, const std::function<std::unique_ptr<island>(size_type)> &, bool);
+    // Check whether the island constructor argument x allows to construct
+    // the islands in parallel. Only the batch fitness evaluators need
+    // to be checked here, the algorithm and the problem are checked
+    // in push_back_n() on the first constructed island.
+    template <typename T>
+    static bool n_ctor_par_arg(const T &x)
+    {
+        if constexpr (std::is_same<T, bfe>::value) {
+            // A bfe is invoked concurrently by all the populations being initialised.
+            return x.get_thread_safety() >= thread_safety::constant;
+        } else if constexpr (std::is_constructible<bfe, const T &>::value) {
+            // A UDBFE is copied into each population being initialised.
+            return bfe(x).get_thread_safety() >= thread_safety::basic;
+        } else {
+            (void)x;
+            return true;
+        }
+    }
+    // Generate the seeds of the populations of n islands from the seed argument
+    // of the constructor. The generation is sequential, so that the seeds do not depend
+    // on the order in which the islands are constructed.
+    template <typename S>
+    static std::vector<unsigned> n_ctor_seeds(size_type n, S seed)
+    {
+        std::mt19937 eng(static_cast<std::mt19937::result_type>(static_cast<unsigned>(seed)));
+        std::uniform_int_distribution<unsigned> udist;
+        std::vector<unsigned> retval;
+        retval.reserve(n);
+        for (size_type i = 0; i < n; ++i) {
+            retval.push_back(udist(eng));
+        }
+        return retval;
+    }
     // The "default" constructor from n islands. Just forward
-    // the input arguments to n calls to push_back().
+    // the input arguments to n island constructors.
+    // NOTE: we don't perfectly forward, in order to avoid moving several
+    // times from the same objects.
     template <typename... Args>
     void n_ctor(size_type n, const Args &...args)
     {
-        for (size_type i = 0; i < n; ++i) {
-            // NOTE: we don't perfectly forward, in order to avoid moving twice
-            // from the same objects. This also ensures that, when
-            // using a ctor without seed, the seed is set to random
-            // for each island.
-            push_back(args...);
+        // NOTE: if an unsigned can be appended to args, then it is interpreted
+        // by the island constructor as the seed of the population, whose default
+        // value is pagmo::random_device::next(). In such case, draw the seeds
+        // beforehand so that, as in a sequential construction, the i-th island
+        // receives the i-th seed.
+        if constexpr (std::is_constructible<island, const Args &..., unsigned>::value) {
+            std::vector<unsigned> seeds;
+            seeds.reserve(n);
+            for (size_type i = 0; i < n; ++i) {
+                seeds.push_back(pagmo::random_device::next());
+            }
+            push_back_n(
+                n, [&](size_type i) { return std::make_unique<island>(args..., seeds[i]); },
+                (n_ctor_par_arg(args) && ...));
+        } else {
+            push_back_n(
+                n, [&](size_type) { return std::make_unique<island>(args...); }, (n_ctor_par_arg(args) && ...));
         }
     }
     // The following functions are used to implement construction
@@ -297,11 +390,10 @@ private:
                           int> = 0>
     void n_ctor(size_type n, const Algo &a, const Prob &p, S1 size, S2 seed)
     {
-        std::mt19937 eng(static_cast<std::mt19937::result_type>(static_cast<unsigned>(seed)));
-        std::uniform_int_distribution<unsigned> udist;
-        for (size_type i = 0; i < n; ++i) {
-            push_back(a, p, boost::numeric_cast<population::size_type>(size), udist(eng));
-        }
+        const auto seeds = n_ctor_seeds(n, seed);
+        const auto pop_size = boost::numeric_cast<population::size_type>(size);
+        push_back_n(
+            n, [&](size_type i) { return std::make_unique<island>(a, p, pop_size, seeds[i]); }, true);
     }
     // algo, prob, rpol, spol.
     template <
@@ -313,11 +405,10 @@ private:
                     int> = 0>
     void n_ctor(size_type n, const Algo &a, const Prob &p, S1 size, const RPol &r_pol, const SPol &s_pol, S2 seed)
     {
-        std::mt19937 eng(static_cast<std::mt19937::result_type>(static_cast<unsigned>(seed)));
-        std::uniform_int_distribution<unsigned> udist;
-        for (size_type i = 0; i < n; ++i) {
-            push_back(a, p, boost::numeric_cast<population::size_type>(size), r_pol, s_pol, udist(eng));
-        }
+        const auto seeds = n_ctor_seeds(n, seed);
+        const auto pop_size = boost::numeric_cast<population::size_type>(size);
+        push_back_n(
+            n, [&](size_type i) { return std::make_unique<island>(a, p, pop_size, r_pol, s_pol, seeds[i]); }, true);
     }
     // algo, prob, bfe.
     // NOTE: performance wise, it would be better for these constructors from bfe
@@ -332,11 +423,10 @@ private:
                     int> = 0>
     void n_ctor(size_type n, const Algo &a, const Prob &p, const Bfe &b, S1 size, S2 seed)
     {
-        std::mt19937 eng(static_cast<std::mt19937::result_type>(static_cast<unsigned>(seed)));
-        std::uniform_int_distribution<unsigned> udist;
-        for (size_type i = 0; i < n; ++i) {
-            push_back(a, p, b, boost::numeric_cast<population::size_type>(size), udist(eng));
-        }
+        const auto seeds = n_ctor_seeds(n, seed);
+        const auto pop_size = boost::numeric_cast<population::size_type>(size);
+        push_back_n(
+            n, [&](size_type i) { return std::make_unique<island>(a, p, b, pop_size, seeds[i]); }, n_ctor_par_arg(b));
     }
     // algo, prob, bfe, rpol, spol.
     template <typename Algo, typename Prob, typename Bfe, typename S1, typename RPol, typename SPol, typename S2,
@@ -349,11 +439,14 @@ private:
     void n_ctor(size_type n, const Algo &a, const Prob &p, const Bfe &b, S1 size, const RPol &r_pol, const SPol &s_pol,
                 S2 seed)
     {
-        std::mt19937 eng(static_cast<std::mt19937::result_type>(static_cast<unsigned>(seed)));
-        std::uniform_int_distribution<unsigned> udist;
-        for (size_type i = 0; i < n; ++i) {
-            push_back(a, p, b, boost::numeric_cast<population::size_type>(size), r_pol, s_pol, udist(eng));
-        }
+        const auto seeds = n_ctor_seeds(n, seed);
+        const auto pop_size = boost::numeric_cast<population::size_type>(size);
+        push_back_n(
+            n,
+            [&](size_type i) {
+                return std::make_unique<island>(a, p, b, pop_size, r_pol, s_pol, seeds[i]);
+            },
+            n_ctor_par_arg(b));
     }
     // isl, algo, prob.
     template <typename Isl, typename Algo, typename Prob, typename S1, typename S2,
@@ -363,11 +456,10 @@ private:
                           int> = 0>
     void n_ctor(size_type n, const Isl &isl, const Algo &a, const Prob &p, S1 size, S2 seed)
     {
-        std::mt19937 eng(static_cast<std::mt19937::result_type>(static_cast<unsigned>(seed)));
-        std::uniform_int_distribution<unsigned> udist;
-        for (size_type i = 0; i < n; ++i) {
-            push_back(isl, a, p, boost::numeric_cast<population::size_type>(size), udist(eng));
-        }
+        const auto seeds = n_ctor_seeds(n, seed);
+        const auto pop_size = boost::numeric_cast<population::size_type>(size);
+        push_back_n(
+            n, [&](size_type i) { return std::make_unique<island>(isl, a, p, pop_size, seeds[i]); }, true);
     }
     // isl, algo, prob, rpol, spol.
     template <typename Isl, typename Algo, typename Prob, typename S1, typename RPol, typename SPol, typename S2,
@@ -380,11 +472,14 @@ private:
     void n_ctor(size_type n, const Isl &isl, const Algo &a, const Prob &p, S1 size, const RPol &r_pol,
                 const SPol &s_pol, S2 seed)
     {
-        std::mt19937 eng(static_cast<std::mt19937::result_type>(static_cast<unsigned>(seed)));
-        std::uniform_int_distribution<unsigned> udist;
-        for (size_type i = 0; i < n; ++i) {
-            push_back(isl, a, p, boost::numeric_cast<population::size_type>(size), r_pol, s_pol, udist(eng));
-        }
+        const auto seeds = n_ctor_seeds(n, seed);
+        const auto pop_size = boost::numeric_cast<population::size_type>(size);
+        push_back_n(
+            n,
+            [&](size_type i) {
+                return std::make_unique<island>(isl, a, p, pop_size, r_pol, s_pol, seeds[i]);
+            },
+            true);
     }
     // isl, algo, prob, bfe.
     template <typename Isl, typename Algo, typename Prob, typename Bfe, typename S1, typename S2,
@@ -395,11 +490,14 @@ private:
                           int> = 0>
     void n_ctor(size_type n, const Isl &isl, const Algo &a, const Prob &p, const Bfe &b, S1 size, S2 seed)
     {
-        std::mt19937 eng(static_cast<std::mt19937::result_type>(static_cast<unsigned>(seed)));
-        std::uniform_int_distribution<unsigned> udist;
-        for (size_type i = 0; i < n; ++i) {
-            push_back(isl, a, p, b, boost::numeric_cast<population::size_type>(size), udist(eng));
-        }
+        const auto seeds = n_ctor_seeds(n, seed);
+        const auto pop_size = boost::numeric_cast<population::size_type>(size);
+        push_back_n(
+            n,
+            [&](size_type i) {
+                return std::make_unique<island>(isl, a, p, b, pop_size, seeds[i]);
+            },
+            n_ctor_par_arg(b));
     }
     // isl, algo, prob, bfe, rpol, spol.
     template <
@@ -414,11 +512,14 @@ private:
     void n_ctor(size_type n, const Isl &isl, const Algo &a, const Prob &p, const Bfe &b, S1 size, const RPol &r_pol,
                 const SPol &s_pol, S2 seed)
     {
-        std::mt19937 eng(static_cast<std::mt19937::result_type>(static_cast<unsigned>(seed)));
-        std::uniform_int_distribution<unsigned> udist;
-        for (size_type i = 0; i < n; ++i) {
-            push_back(isl, a, p, b, boost::numeric_cast<population::size_type>(size), r_pol, s_pol, udist(eng));
-        }
+        const auto seeds = n_ctor_seeds(n, seed);
+        const auto pop_size = boost::numeric_cast<population::size_type>(size);
+        push_back_n(
+            n,
+            [&](size_type i) {
+                return std::make_unique<island>(isl, a, p, b, pop_size, r_pol, s_pol, seeds[i]);
+            },
+            n_ctor_par_arg(b));
     }
 
 public:
@@ -444,10 +545,16 @@ public:
      * seed, but \p n islands whose population seeds have been randomly generated starting from
      * the supplied seed argument.
      *
+     * The islands (and thus their initial populations) are constructed in parallel if the algorithm,
+     * the problem and the (optional) batch fitness evaluator provide adequate
+     * thread safety guarantees, sequentially otherwise. In both cases, the islands are inserted
+     * in order and the seeds of their populations are the same that a sequential construction would produce.
+     *
      * @param n the desired number of islands.
      * @param args the arguments that will be used for the construction of each island.
      *
-     * @throws unspecified any exception thrown by archipelago::push_back().
+     * @throws unspecified any exception thrown by archipelago::push_back() or by
+     * the public interface of \p tbb::parallel_for().
      */
     template <typename... Args, n_ctor_enabler<const Args &...> = 0>
     explicit archipelago(size_type n, const Args &...args)
@@ -567,6 +674,8 @@ public:
     void wait_check();
     // Status of the archipelago.
     evolve_status status() const;
+    // Status of each island.
+    std::vector<evolve_status> get_islands_status() const;
 
     /// Mutable begin iterator.
     /**
@@ -644,6 +753,19 @@ public:
 
     // Get the migration log.
     migration_log_t get_migration_log() const;
+    // Migration log configuration.
+    migration_log_mode get_migration_log_mode() const;
+    size_type get_migration_log_capacity() const;
+    void set_migration_log_unbounded();
+    void set_migration_log_bounded(size_type);
+    void set_migration_log_off();
+    void set_migration_log_sink(migration_log_sink_t);
+    // Helpers to stream the migration log to a binary file.
+    static migration_log_sink_t migration_log_file_sink(const std::string &);
+    static migration_log_t read_migration_log_file(const std::string &);
+    // Binary checkpoints.
+    size_type save_checkpoint(const std::string &) const;
+    void load_checkpoint(const std::string &);
     // Get the database of migrants.
     migrants_db_t get_migrants_db() const;
     // Set the database of migrants.
@@ -682,19 +804,21 @@ private:
             // Recover the islands.
             ar >> m_islands;
 
-            // Reset and remap the island indices, assign the
-            // archi pointers.
-            m_idx_map.clear();
+            // Assign the archi pointers and the island indices.
             for (size_type i = 0; i < m_islands.size(); ++i) {
-                m_idx_map.emplace(m_islands[i].get(), i);
                 m_islands[i]->m_ptr->archi_ptr = this;
+                m_islands[i]->m_ptr->archi_idx = i;
             }
 
             // Load the migrants.
-            ar >> m_migrants;
+            migrants_db_t tmp_migrants;
+            ar >> tmp_migrants;
+            m_migrants.set_all(std::move(tmp_migrants));
 
             // Load the migration log.
-            ar >> m_migr_log;
+            migration_log_t tmp_migr_log;
+            ar >> tmp_migr_log;
+            set_migration_log_entries(std::move(tmp_migr_log));
 
             // Load the topology.
             ar >> m_topology;
@@ -720,24 +844,38 @@ private:
     PAGMO_DLL_LOCAL individuals_group_t extract_migrants(size_type);
     PAGMO_DLL_LOCAL individuals_group_t get_migrants(size_type) const;
     PAGMO_DLL_LOCAL void set_migrants(size_type, individuals_group_t &&);
-    // Helper to add entries to the migration log.
-    PAGMO_DLL_LOCAL void append_migration_log(const migration_log_t &);
+    // Helpers to add entries to the migration log.
+    PAGMO_DLL_LOCAL bool migration_log_enabled() const;
+    PAGMO_DLL_LOCAL void append_migration_log(migration_log_t &&);
+    // Replace the entries of the migration log.
+    // NOTE: this cannot be PAGMO_DLL_LOCAL, as it is invoked
+    // by load(), which is instantiated in the user's code.
+    void set_migration_log_entries(migration_log_t &&);
     // Get the index of an island.
     PAGMO_DLL_LOCAL size_type get_island_idx(const island &) const;
     // Get the connections to the island at the given index.
     PAGMO_DLL_LOCAL std::pair<std::vector<size_type>, vector_double> get_island_connections(size_type) const;
+    // Write/read the record of an island in a checkpoint file.
+    PAGMO_DLL_LOCAL unsigned long long write_ckpt_island(std::ostream &, size_type) const;
+    PAGMO_DLL_LOCAL static std::unique_ptr<island> read_ckpt_island(std::istream &, unsigned long long,
+                                                                    const std::string &);
 
     container_t m_islands;
-    // The map from island pointers to indices in the archi.
-    // It needs to be protected by a mutex.
-    mutable std::mutex m_idx_map_mutex;
-    idx_map_t m_idx_map;
-    // The migrants.
+    // The migrants, one slot per island.
+    // NOTE: the islands access their slots without locking.
+    // The mutex is used only to serialise the operations
+    // which change the size of the database, or which
+    // read/write it as a whole.
     mutable std::mutex m_migrants_mutex;
-    migrants_db_t m_migrants;
-    // The migration log.
+    detail::migrants_slots m_migrants;
+    // The migration log. The islands append
+    // to it without locking. The mutex is used only
+    // to serialise changes to the configuration of the log.
+    // NOTE: the state is created lazily (a null pointer stands for
+    // an empty log in the default mode), so that default construction
+    // and the move operations do not allocate.
     mutable std::mutex m_migr_log_mutex;
-    migration_log_t m_migr_log;
+    mutable std::shared_ptr<migr_log_state> m_migr_log;
     // The topology.
     // NOTE: the topology does not need
     // an associated mutex as it is supposed
@@ -746,6 +884,24 @@ private:
     // Migration type and migrant handling policy.
     std::atomic<migration_type> m_migr_type;
     std::atomic<migrant_handling> m_migr_handling;
+    // The layout of the checkpoint file last written
+    // by save_checkpoint() or read by load_checkpoint(),
+    // used to write incremental checkpoints.
+    // NOTE: this is not transferred by copy/move operations:
+    // the next checkpoint will then be written from scratch.
+    struct ckpt_state {
+        std::string filename;
+        unsigned long long token = 0;
+        unsigned long long file_size = 0;
+        // The size of the data reachable from
+        // the current index of the file.
+        unsigned long long live_size = 0;
+        // Offset, size and version of the record
+        // of each island.
+        std::vector<unsigned long long> offsets, sizes, versions;
+    };
+    mutable std::mutex m_ckpt_mutex;
+    mutable ckpt_state m_ckpt;
 };
 
 // Stream operator.
@@ -0,0 +1,145 @@
+/* Copyright 2017-2021 PaGMO development team
+
+This file is part of the PaGMO library.
+
+The PaGMO library is free software; you can redistribute it and/or modify
+it under the terms of either:
+
+  * the GNU Lesser General Public License as published by the Free
+    Software Foundation; either version 3 of the License, or (at your
+    option) any later version.
+
+or
+
+  * the GNU General Public License as published by the Free Software
+    Foundation; either version 3 of the License, or (at your option) any
+    later version.
+
+or both in parallel, as here.
+
+The PaGMO library is distributed in the hope that it will be useful, but
+WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+for more details.
+
+You should have received copies of the GNU General Public License and the
+GNU Lesser General Public License along with the PaGMO library.  If not,
+see https://www.gnu.org/licenses/. */
+
+#ifndef PAGMO_ASYNC_EVALUATOR_HPP
+#define PAGMO_ASYNC_EVALUATOR_HPP
+
+#include <memory>
+#include <tuple>
+
+#include <pagmo/detail/visibility.hpp>
+#include <pagmo/problem.hpp>
+#include <pagmo/types.hpp>
+
+namespace pagmo
+{
+
+/// Asynchronous fitness evaluator.
+/**
+ * \verbatim embed:rst:leading-asterisk
+ * .. versionadded:: 2.20
+ * \endverbatim
+ *
+ * This class evaluates the fitnesses of decision vectors asynchronously on a set of worker threads.
+ * Decision vectors are submitted one at a time via submit(), and the results are retrieved via
+ * retrieve() in order of completion.
+ *
+ * The problem must provide at least the pagmo::thread_safety::basic thread safety level. If it provides
+ * the pagmo::thread_safety::constant level, the workers share a single copy of the problem. Otherwise,
+ * each worker uses its own copy.
+ *
+ * This class is neither copyable nor movable.
+ */
+class PAGMO_DLL_PUBLIC async_evaluator
+{
+public:
+    /// Ticket type.
+    /**
+     * The type of the tickets identifying the submitted evaluations.
+     */
+    using ticket_type = unsigned long long;
+    /// Result type.
+    /**
+     * The type of the result of an evaluation: ticket, decision vector and fitness vector.
+     */
+    using result_type = std::tuple<ticket_type, vector_double, vector_double>;
+
+    /// Constructor.
+    /**
+     * Stores a copy of the input problem and starts the worker threads.
+     *
+     * @param p the input problem.
+     * @param n_workers the number of worker threads. If zero, the number of worker threads
+     * will be the hardware concurrency.
+     *
+     * @throws std::invalid_argument if \p p does not provide at least the
+     * pagmo::thread_safety::basic thread safety level.
+     * @throws unspecified any exception thrown by copying \p p, or by the creation of the threads.
+     */
+    explicit async_evaluator(const problem &p, unsigned n_workers = 0);
+    /// Destructor.
+    /**
+     * The evaluations which have not started yet are discarded, and the destructor
+     * waits for the evaluations currently running to complete.
+     */
+    ~async_evaluator();
+
+    // Make extra sure we never try to move/copy.
+    async_evaluator(const async_evaluator &) = delete;
+    async_evaluator(async_evaluator &&) = delete;
+    async_evaluator &operator=(const async_evaluator &) = delete;
+    async_evaluator &operator=(async_evaluator &&) = delete;
+
+    /// Submit a decision vector for evaluation.
+    /**
+     * @param dv the decision vector to be evaluated.
+     *
+     * @return the ticket identifying the evaluation. Tickets are assigned in increasing order,
+     * starting from zero.
+     *
+     * @throws std::invalid_argument if the dimension of \p dv is not consistent with the problem.
+     * @throws unspecified any exception thrown by memory allocation failures.
+     */
+    ticket_type submit(vector_double dv);
+    /// Wait for the next completed evaluation.
+    /**
+     * This function will block until an evaluation completes. The evaluations are returned in
+     * order of completion, which in general differs from the order of submission.
+     *
+     * @return the ticket, the decision vector and the fitness vector of the evaluation.
+     *
+     * @throws std::invalid_argument if there are no pending evaluations.
+     * @throws unspecified any exception thrown by the fitness evaluation.
+     */
+    result_type retrieve();
+
+    /// Number of pending evaluations.
+    /**
+     * @return the number of evaluations which were submitted but not retrieved yet.
+     */
+    unsigned long long get_n_pending() const;
+    /// Number of worker threads.
+    /**
+     * @return the number of worker threads.
+     */
+    unsigned get_n_workers() const;
+    /// Problem getter.
+    /**
+     * @return a reference to the copy of the problem stored within this evaluator. Its fitness
+     * evaluation counter accounts for all the completed evaluations.
+     */
+    const problem &get_problem() const;
+
+private:
+    struct impl;
+    std::unique_ptr<impl> m_impl;
+};
+
+} // namespace pagmo
+
+#endif
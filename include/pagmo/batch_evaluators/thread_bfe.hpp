@@ -29,6 +29,7 @@ see https://www.gnu.org/licenses/. */
 #ifndef PAGMO_BATCH_EVALUATORS_THREAD_BFE_HPP
 #define PAGMO_BATCH_EVALUATORS_THREAD_BFE_HPP
 
+#include <cstddef>
 #include <string>
 
 #include <pagmo/bfe.hpp>
@@ -44,26 +45,44 @@ namespace pagmo
 class PAGMO_DLL_PUBLIC thread_bfe
 {
 public:
+    // Default ctor.
+    thread_bfe();
+    // Ctor from grain size.
+    explicit thread_bfe(std::size_t);
     // Call operator.
-    // NOTE: pass the problem by copy, as we want to ensure the
-    // fitness() of the original problem is never called in order
-    // to avoid altering the fevals counter.
-    vector_double operator()(problem, const vector_double &) const;
+    // NOTE: the fitness() of the original problem is never called,
+    // in order to avoid altering the fevals counter.
+    vector_double operator()(const problem &, const vector_double &) const;
     // Name.
     std::string get_name() const
     {
         return "Multi-threaded batch fitness evaluator";
     }
+    // Extra info.
+    std::string get_extra_info() const;
+    // Getter for the grain size.
+    std::size_t get_grain_size() const
+    {
+        return m_grain_size;
+    }
 
 private:
     // Object serialization
     friend class boost::serialization::access;
     template <typename Archive>
-    void serialize(Archive &, unsigned);
+    void save(Archive &, unsigned) const;
+    template <typename Archive>
+    void load(Archive &, unsigned);
+    BOOST_SERIALIZATION_SPLIT_MEMBER()
+
+    std::size_t m_grain_size;
 };
 
 } // namespace pagmo
 
 PAGMO_S11N_BFE_EXPORT_KEY(pagmo::thread_bfe)
 
+// NOTE: version 1 added the grain size.
+BOOST_CLASS_VERSION(pagmo::thread_bfe, 1)
+
 #endif
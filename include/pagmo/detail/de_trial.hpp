@@ -0,0 +1,54 @@
+/* Copyright 2017-2021 PaGMO development team
+
+This file is part of the PaGMO library.
+
+The PaGMO library is free software; you can redistribute it and/or modify
+it under the terms of either:
+
+  * the GNU Lesser General Public License as published by the Free
+    Software Foundation; either version 3 of the License, or (at your
+    option) any later version.
+
+or
+
+  * the GNU General Public License as published by the Free Software
+    Foundation; either version 3 of the License, or (at your option) any
+    later version.
+
+or both in parallel, as here.
+
+The PaGMO library is distributed in the hope that it will be useful, but
+WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+for more details.
+
+You should have received copies of the GNU General Public License and the
+GNU Lesser General Public License along with the PaGMO library.  If not,
+see https://www.gnu.org/licenses/. */
+
+#ifndef PAGMO_DETAIL_DE_TRIAL_HPP
+#define PAGMO_DETAIL_DE_TRIAL_HPP
+
+#include <vector>
+
+#include <pagmo/detail/visibility.hpp>
+#include <pagmo/rng.hpp>
+#include <pagmo/types.hpp>
+
+namespace pagmo
+{
+namespace detail
+{
+
+// Build in tmp the trial vector for the i-th individual of popold, according to the DE mutation
+// variant (from 1 to 10, see the docs of pagmo::de). r contains the indices of (at least) 5 randomly
+// selected individuals, gbIter is the best decision vector.
+PAGMO_DLL_PUBLIC void de_make_trial(vector_double &tmp, unsigned variant, double F, double CR,
+                                    const std::vector<vector_double> &popold, vector_double::size_type i,
+                                    const std::vector<vector_double::size_type> &r, const vector_double &gbIter,
+                                    random_engine_type &e);
+
+} // namespace detail
+} // namespace pagmo
+
+#endif
@@ -0,0 +1,271 @@
+/* Copyright 2017-2021 PaGMO development team
+
+This file is part of the PaGMO library.
+
+The PaGMO library is free software; you can redistribute it and/or modify
+it under the terms of either:
+
+  * the GNU Lesser General Public License as published by the Free
+    Software Foundation; either version 3 of the License, or (at your
+    option) any later version.
+
+or
+
+  * the GNU General Public License as published by the Free Software
+    Foundation; either version 3 of the License, or (at your option) any
+    later version.
+
+or both in parallel, as here.
+
+The PaGMO library is distributed in the hope that it will be useful, but
+WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+for more details.
+
+You should have received copies of the GNU General Public License and the
+GNU Lesser General Public License along with the PaGMO library.  If not,
+see https://www.gnu.org/licenses/. */
+
+#ifndef PAGMO_DETAIL_MIGRATION_DB_HPP
+#define PAGMO_DETAIL_MIGRATION_DB_HPP
+
+#include <array>
+#include <atomic>
+#include <cassert>
+#include <cstddef>
+#include <limits>
+#include <memory>
+#include <utility>
+#include <vector>
+
+#include <pagmo/detail/visibility.hpp>
+#include <pagmo/types.hpp>
+
+namespace pagmo::detail
+{
+
+// A growable array of slots, each holding the candidate outgoing
+// migrants of an island in an archipelago. The content of a slot
+// is an immutable group of individuals which is published, read and
+// extracted via atomic operations on a shared pointer, so that
+// get(), extract() and set() never block on a lock shared by all the islands.
+// The slots are allocated in segments of geometrically increasing size
+// which are never moved, so that the array can grow while other threads
+// are accessing the existing slots.
+// NOTE: resize() and set_all() must not be invoked concurrently
+// with each other, and swap() must not be invoked concurrently
+// with any other member function.
+class PAGMO_DLL_PUBLIC migrants_slots
+{
+public:
+    using size_type = std::size_t;
+
+    migrants_slots();
+    ~migrants_slots();
+
+    // Make extra sure we never try to move/copy.
+    migrants_slots(const migrants_slots &) = delete;
+    migrants_slots(migrants_slots &&) = delete;
+    migrants_slots &operator=(const migrants_slots &) = delete;
+    migrants_slots &operator=(migrants_slots &&) = delete;
+
+    void swap(migrants_slots &) noexcept;
+
+    size_type size() const;
+    void resize(size_type);
+
+    // Single slot access. The index must be less than size().
+    individuals_group_t get(size_type) const;
+    individuals_group_t extract(size_type);
+    void set(size_type, individuals_group_t &&);
+
+    // Whole database access.
+    std::vector<individuals_group_t> get_all() const;
+    void set_all(std::vector<individuals_group_t> &&);
+
+private:
+    using group_ptr = std::shared_ptr<individuals_group_t>;
+    group_ptr &slot(size_type) const;
+
+    // NOTE: segment i contains 2**i slots, so that
+    // this number of segments covers the full range of size_type.
+    static constexpr auto n_segments = static_cast<std::size_t>(std::numeric_limits<size_type>::digits);
+    std::array<std::atomic<group_ptr *>, n_segments> m_segments;
+    std::atomic<size_type> m_size;
+};
+
+// A log to which multiple threads can append
+// batches of entries concurrently without locking.
+// The batches are pushed onto a singly-linked list,
+// and they are never modified after insertion.
+// NOTE: clear() and swap() must not be invoked concurrently
+// with any other member function.
+template <typename T>
+class append_only_log
+{
+    struct node {
+        std::vector<T> entries;
+        node *next;
+    };
+
+public:
+    append_only_log() = default;
+    ~append_only_log()
+    {
+        clear();
+    }
+
+    // Make extra sure we never try to move/copy.
+    append_only_log(const append_only_log &) = delete;
+    append_only_log(append_only_log &&) = delete;
+    append_only_log &operator=(const append_only_log &) = delete;
+    append_only_log &operator=(append_only_log &&) = delete;
+
+    void swap(append_only_log &other) noexcept
+    {
+        auto tmp = m_head.load(std::memory_order_relaxed);
+        m_head.store(other.m_head.load(std::memory_order_relaxed), std::memory_order_relaxed);
+        other.m_head.store(tmp, std::memory_order_relaxed);
+    }
+
+    // Append a batch of entries.
+    void append(std::vector<T> &&entries)
+    {
+        if (entries.empty()) {
+            return;
+        }
+
+        auto new_node = new node{std::move(entries), m_head.load(std::memory_order_relaxed)};
+        while (!m_head.compare_exchange_weak(new_node->next, new_node, std::memory_order_release,
+                                             std::memory_order_relaxed)) {
+        }
+    }
+
+    // Fetch a copy of all the entries, in the order of insertion.
+    std::vector<T> get_all() const
+    {
+        // Walk the list from the most recent batch, then
+        // copy out the batches in reverse order.
+        std::vector<const node *> nodes;
+        std::size_t n_entries = 0;
+        for (const node *cur = m_head.load(std::memory_order_acquire); cur != nullptr; cur = cur->next) {
+            nodes.push_back(cur);
+            n_entries += cur->entries.size();
+        }
+
+        std::vector<T> retval;
+        retval.reserve(n_entries);
+        for (auto it = nodes.rbegin(); it != nodes.rend(); ++it) {
+            retval.insert(retval.end(), (*it)->entries.begin(), (*it)->entries.end());
+        }
+
+        return retval;
+    }
+
+    // Replace the content of the log.
+    void set_all(std::vector<T> &&entries)
+    {
+        clear();
+        append(std::move(entries));
+    }
+
+    void clear() noexcept
+    {
+        auto cur = m_head.exchange(nullptr, std::memory_order_acquire);
+        while (cur != nullptr) {
+            auto next = cur->next;
+            delete cur;
+            cur = next;
+        }
+    }
+
+private:
+    std::atomic<node *> m_head = nullptr;
+};
+
+// A log retaining only the most recent entries, up to a fixed capacity.
+// Multiple threads can append entries concurrently without locking: each
+// entry is assigned a sequence number which determines its slot in a circular
+// buffer, and it is published atomically together with its sequence number.
+// NOTE: clear() must not be invoked concurrently with any other member function.
+template <typename T>
+class ring_log
+{
+    using slot_t = std::shared_ptr<const std::pair<unsigned long long, T>>;
+
+public:
+    explicit ring_log(std::size_t capacity) : m_slots(capacity), m_next(0)
+    {
+        assert(capacity > 0u);
+    }
+
+    // Make extra sure we never try to move/copy.
+    ring_log(const ring_log &) = delete;
+    ring_log(ring_log &&) = delete;
+    ring_log &operator=(const ring_log &) = delete;
+    ring_log &operator=(ring_log &&) = delete;
+
+    std::size_t capacity() const
+    {
+        return m_slots.size();
+    }
+
+    // Append a batch of entries.
+    void append(std::vector<T> &&entries)
+    {
+        if (entries.empty()) {
+            return;
+        }
+
+        // Reserve a range of sequence numbers.
+        auto seq = m_next.fetch_add(static_cast<unsigned long long>(entries.size()), std::memory_order_relaxed);
+        for (auto &e : entries) {
+            auto &slot = m_slots[static_cast<std::size_t>(seq % m_slots.size())];
+            const slot_t new_ptr(std::make_shared<std::pair<unsigned long long, T>>(seq, std::move(e)));
+            // NOTE: a concurrent batch which wrapped around the capacity may have
+            // already stored a newer entry in this slot. Never overwrite it with
+            // an older one, otherwise get_all() would skip the newer entry.
+            auto cur = std::atomic_load(&slot);
+            while ((!cur || cur->first < seq) && !std::atomic_compare_exchange_weak(&slot, &cur, new_ptr)) {
+            }
+            ++seq;
+        }
+    }
+
+    // Fetch a copy of the retained entries, from the oldest to the most recent.
+    std::vector<T> get_all() const
+    {
+        const auto end = m_next.load(std::memory_order_acquire);
+        const auto cap = static_cast<unsigned long long>(m_slots.size());
+        const auto begin = end > cap ? end - cap : 0ull;
+
+        std::vector<T> retval;
+        retval.reserve(static_cast<std::size_t>(end - begin));
+        for (auto seq = begin; seq < end; ++seq) {
+            const auto ptr = std::atomic_load(&m_slots[static_cast<std::size_t>(seq % cap)]);
+            // NOTE: skip the slots which have not been written yet,
+            // or which have already been overwritten by newer entries.
+            if (ptr && ptr->first == seq) {
+                retval.push_back(ptr->second);
+            }
+        }
+
+        return retval;
+    }
+
+    void clear()
+    {
+        for (auto &slot : m_slots) {
+            slot.reset();
+        }
+        m_next.store(0, std::memory_order_relaxed);
+    }
+
+private:
+    std::vector<slot_t> m_slots;
+    std::atomic<unsigned long long> m_next;
+};
+
+} // namespace pagmo::detail
+
+#endif
@@ -80,6 +80,47 @@ struct PAGMO_DLL_PUBLIC task_queue {
     std::thread m_thread;
 };
 
+// A task queue which does not own a thread of execution. Instead, the tasks
+// are consumed one at a time (and in FIFO order) by a global, work-stealing
+// thread pool shared by all pool_task_queue instances. The number of threads
+// in the pool is bounded by the hardware concurrency, regardless
+// of the number of existing queues.
+struct PAGMO_DLL_PUBLIC pool_task_queue {
+    pool_task_queue();
+    ~pool_task_queue();
+
+    // Make extra sure we never try to move/copy.
+    pool_task_queue(const pool_task_queue &) = delete;
+    pool_task_queue(pool_task_queue &&) = delete;
+    pool_task_queue &operator=(const pool_task_queue &) = delete;
+    pool_task_queue &operator=(pool_task_queue &&) = delete;
+
+    using task_type = std::packaged_task<void()>;
+    // Main enqueue function.
+    std::future<void> enqueue_impl(task_type &&);
+    template <typename F>
+    std::future<void> enqueue(F &&f)
+    {
+        return enqueue_impl(task_type(std::forward<F>(f)));
+    }
+
+    void wait_all();
+
+    // Run the first task in the queue on the thread pool.
+    void run_next();
+
+    // Data members.
+    // NOTE: if this flag is set to false, it means
+    // that the queue has not submitted any work to the
+    // thread pool which has not been completed yet. That is,
+    // no task is being executed and no task is waiting
+    // in the pool to be executed.
+    bool m_scheduled = false;
+    std::condition_variable m_cond;
+    std::mutex m_mutex;
+    std::queue<task_type> m_tasks;
+};
+
 } // namespace pagmo::detail
 
 #endif
@@ -29,6 +29,8 @@ see https://www.gnu.org/licenses/. */
 #ifndef PAGMO_ISLAND_HPP
 #define PAGMO_ISLAND_HPP
 
+#include <atomic>
+#include <cstddef>
 #include <functional>
 #include <future>
 #include <iostream>
@@ -250,6 +252,33 @@ BOOST_CLASS_TRACKING(pagmo::detail::isl_inner_base, boost::serialization::track_
 namespace pagmo
 {
 
+/// Island execution backends.
+/**
+ * \verbatim embed:rst:leading-asterisk
+ * .. versionadded:: 2.20
+ * \endverbatim
+ *
+ * The execution backend determines how the evolution tasks enqueued via
+ * island::evolve() are consumed.
+ */
+enum class island_backend {
+    thread = 0, ///< Each island owns a separate thread of execution which
+                /// consumes the island's evolution tasks
+    pool = 1    ///< The evolution tasks of all islands are consumed by a shared,
+                /// work-stealing thread pool whose size is bounded by the hardware concurrency
+};
+
+#if !defined(PAGMO_DOXYGEN_INVOKED)
+
+// Stream operator for island_backend.
+PAGMO_DLL_PUBLIC std::ostream &operator<<(std::ostream &, island_backend);
+
+#endif
+
+// Get/set the island execution backend.
+PAGMO_DLL_PUBLIC island_backend get_island_backend();
+PAGMO_DLL_PUBLIC void set_island_backend(island_backend);
+
 namespace detail
 {
 
@@ -270,6 +299,9 @@ PAGMO_DLL_PUBLIC extern std::function<void(const algorithm &, const population &
 
 PAGMO_DLL_PUBLIC std::unique_ptr<task_queue> get_task_queue();
 
+// Generate a new island state version.
+PAGMO_DLL_PUBLIC unsigned long long new_island_version();
+
 // NOTE: the idea with this class is that we use it to store the data members of pagmo::island, and,
 // within pagmo::island, we store a pointer to an instance of this struct. The reason for this approach
 // is that, like this, we can provide sensible move semantics: just move the internal pointer of pagmo::island.
@@ -349,14 +381,36 @@ struct PAGMO_DLL_PUBLIC island_data {
     // and pop is not necessary.
     r_policy r_pol;
     s_policy s_pol;
+    // The version of the state of the island. It is refreshed
+    // *after* every replacement or modification of algo/pop,
+    // and it is used to detect which islands need to be
+    // written in incremental archipelago checkpoints. The
+    // versions are unique across all islands.
+    std::atomic<unsigned long long> version{new_island_version()};
     // The vector of futures.
     std::vector<std::future<void>> futures;
     // This will be explicitly set only during archipelago::push_back().
     // In all other situations, it will be null.
     archipelago *archi_ptr = nullptr;
-    // NOTE: this will either create a brand new queue,
-    // or grab one from the global cache.
-    std::unique_ptr<task_queue> queue = get_task_queue();
+    // The index of the island in the archipelago. It is
+    // meaningful only if archi_ptr is not null, and it is
+    // set together with archi_ptr.
+    std::size_t archi_idx = 0;
+    // The execution backend, fixed upon construction.
+    island_backend backend = get_island_backend();
+    // NOTE: depending on the backend, only one of the two
+    // queues will be created. The thread queue will either
+    // be a brand new queue, or it will be grabbed from the global cache.
+    std::unique_ptr<task_queue> queue = (backend == island_backend::thread) ? get_task_queue() : nullptr;
+    std::unique_ptr<pool_task_queue> pool_queue
+        = (backend == island_backend::pool) ? std::make_unique<pool_task_queue>() : nullptr;
+
+    // Enqueue a task in the active queue.
+    template <typename F>
+    std::future<void> enqueue(F &&f)
+    {
+        return pool_queue ? pool_queue->enqueue(std::forward<F>(f)) : queue->enqueue(std::forward<F>(f));
+    }
 };
 
 } // namespace detail
@@ -1074,7 +1128,9 @@ public:
      * a call to island::evolve() will create an evolution task that will be pushed
      * to a queue, and then return immediately.
      * The tasks in the queue are consumed
-     * by a separate thread of execution managed by the pagmo::island object.
+     * by a separate thread of execution managed by the pagmo::island object
+     * or, if the island was created while the pagmo::island_backend::pool backend
+     * was active, by a thread pool shared by all islands (see pagmo::set_island_backend()).
      * Each task will invoke the <tt>run_evolve()</tt>
      * method of the UDI \p n times consecutively to perform the actual evolution.
      * The island's population will be updated at the end of each <tt>run_evolve()</tt>
@@ -1128,6 +1184,10 @@ public:
     population get_population() const;
     // Set the population.
     void set_population(const population &);
+    // Get the decision vector of the population's champion.
+    vector_double get_champion_x() const;
+    // Get the fitness vector of the population's champion.
+    vector_double get_champion_f() const;
     // Get the replacement policy.
     r_policy get_r_policy() const;
     // Get the selection policy.
@@ -1207,6 +1267,7 @@ private:
 
         try {
             detail::from_archive(ar, m_ptr->isl_ptr, *m_ptr->algo, *m_ptr->pop, m_ptr->r_pol, m_ptr->s_pol);
+            m_ptr->version.store(detail::new_island_version());
         } catch (...) {
             *this = island{};
             throw;
@@ -1223,7 +1284,7 @@ private:
     // Fetch the migration data.
     PAGMO_DLL_LOCAL migration_data_t get_migration_data() const;
     // Set all the individuals in the population.
-    PAGMO_DLL_LOCAL void set_individuals(const individuals_group_t &);
+    PAGMO_DLL_LOCAL void set_individuals(individuals_group_t &&);
 
     std::unique_ptr<idata_t> m_ptr;
 };
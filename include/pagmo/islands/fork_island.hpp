@@ -34,6 +34,7 @@ see https://www.gnu.org/licenses/. */
 #if defined(PAGMO_WITH_FORK_ISLAND)
 
 #include <atomic>
+#include <memory>
 #include <string>
 
 #include <unistd.h>
@@ -45,17 +46,29 @@ see https://www.gnu.org/licenses/. */
 namespace pagmo
 {
 
+namespace detail
+{
+
+// The state of the persistent child process
+// of a fork_island.
+struct fork_worker;
+
+} // namespace detail
+
 // Fork island: will offload the evolution to a child process created with the fork() system call.
 class PAGMO_DLL_PUBLIC fork_island
 {
 public:
-    // NOTE: we need to implement these because of the m_pid member,
-    // which has a trivial def ctor and which is missing the copy/move ctors.
+    // NOTE: we need to implement these because of the m_pid and m_worker members.
     // m_pid is only informational and it is relevant only while the evolution
-    // is undergoing, we will not copy it or serialize it.
-    fork_island() : m_pid(0) {}
-    fork_island(const fork_island &) : fork_island() {}
-    fork_island(fork_island &&) : fork_island() {}
+    // is undergoing, we will not copy it or serialize it. Similarly, the persistent
+    // child process is never shared among fork_island instances.
+    fork_island();
+    // Ctor with persistent flag.
+    explicit fork_island(bool);
+    fork_island(const fork_island &);
+    fork_island(fork_island &&) noexcept;
+    ~fork_island();
     void run_evolve(island &) const;
     std::string get_name() const
     {
@@ -67,20 +80,39 @@ public:
     {
         return m_pid.load();
     }
+    // Get the persistent flag.
+    bool get_persistent() const
+    {
+        return m_persistent;
+    }
 
 private:
+    PAGMO_DLL_LOCAL void run_evolve_fork(island &) const;
+    PAGMO_DLL_LOCAL void run_evolve_persistent(island &) const;
+    [[noreturn]] PAGMO_DLL_LOCAL static void worker_loop(detail::fork_worker &);
+
     // Object serialization
     friend class boost::serialization::access;
     template <typename Archive>
-    void serialize(Archive &, unsigned);
+    void save(Archive &, unsigned) const;
+    template <typename Archive>
+    void load(Archive &, unsigned);
+    BOOST_SERIALIZATION_SPLIT_MEMBER()
 
     mutable std::atomic<pid_t> m_pid;
+    bool m_persistent;
+    // NOTE: the persistent child process is
+    // created on the first run_evolve() invocation.
+    mutable std::unique_ptr<detail::fork_worker> m_worker;
 };
 
 } // namespace pagmo
 
 PAGMO_S11N_ISLAND_EXPORT_KEY(pagmo::fork_island)
 
+// NOTE: version 1 added the m_persistent flag.
+BOOST_CLASS_VERSION(pagmo::fork_island, 1)
+
 #else
 
 #error The fork_island.hpp header was included, but the fork island is not available on the current platform
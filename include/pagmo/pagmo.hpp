@@ -34,6 +34,7 @@ see https://www.gnu.org/licenses/. */
 // Core.
 #include <pagmo/algorithm.hpp>
 #include <pagmo/archipelago.hpp>
+#include <pagmo/async_evaluator.hpp>
 #include <pagmo/bfe.hpp>
 #include <pagmo/exceptions.hpp>
 #include <pagmo/io.hpp>
@@ -62,6 +63,7 @@ see https://www.gnu.org/licenses/. */
 #include <pagmo/utils/hv_algos/hv_hv3d.hpp>
 #include <pagmo/utils/hv_algos/hv_hvwfg.hpp>
 #include <pagmo/utils/hypervolume.hpp>
+#include <pagmo/utils/incremental_hypervolume.hpp>
 #include <pagmo/utils/multi_objective.hpp>
 
 // Algorithms.
@@ -70,6 +72,7 @@ see https://www.gnu.org/licenses/. */
 #include <pagmo/algorithms/cstrs_self_adaptive.hpp>
 #include <pagmo/algorithms/de.hpp>
 #include <pagmo/algorithms/de1220.hpp>
+#include <pagmo/algorithms/de_async.hpp>
 #include <pagmo/algorithms/gaco.hpp>
 #include <pagmo/algorithms/gwo.hpp>
 #include <pagmo/algorithms/ihs.hpp>
@@ -110,6 +113,7 @@ see https://www.gnu.org/licenses/. */
 
 // Problems.
 #include <pagmo/problems/ackley.hpp>
+#include <pagmo/problems/cached.hpp>
 #include <pagmo/problems/cec2006.hpp>
 #include <pagmo/problems/cec2009.hpp>
 #include <pagmo/problems/cec2013.hpp>
@@ -127,6 +131,7 @@ see https://www.gnu.org/licenses/. */
 #include <pagmo/problems/rastrigin.hpp>
 #include <pagmo/problems/rosenbrock.hpp>
 #include <pagmo/problems/schwefel.hpp>
+#include <pagmo/problems/sharded.hpp>
 #include <pagmo/problems/translate.hpp>
 #include <pagmo/problems/unconstrain.hpp>
 #include <pagmo/problems/wfg.hpp>
@@ -48,6 +48,13 @@ see https://www.gnu.org/licenses/. */
 
 namespace pagmo
 {
+
+// Get the parallel initialisation policy of populations.
+PAGMO_DLL_PUBLIC bool get_population_parallel_init();
+
+// Set the parallel initialisation policy of populations.
+PAGMO_DLL_PUBLIC void set_population_parallel_init(bool);
+
 /// Population class.
 /**
  * \image html pop_no_text.png
@@ -82,6 +89,14 @@ class PAGMO_DLL_PUBLIC population
     // access to the population's members during
     // evolution.
     friend class PAGMO_DLL_PUBLIC island;
+    // Make friends with fork_island for the
+    // incremental transfer of the population's members
+    // to/from the persistent child process.
+    friend class PAGMO_DLL_PUBLIC fork_island;
+    // Make friends with archipelago for the direct
+    // transfer of the population's members to/from
+    // checkpoint files.
+    friend class PAGMO_DLL_PUBLIC archipelago;
 
 public:
     /// The size type of the population.
@@ -115,13 +130,18 @@ public:
      * to \p seed. The input problem \p x can be either a pagmo::problem or a user-defined problem
      * (UDP).
      *
+     * If the parallel initialisation of populations is enabled (see pagmo::set_population_parallel_init())
+     * and the problem provides at least the pagmo::thread_safety::basic guarantee, the fitnesses
+     * of the individuals will be evaluated in parallel via pagmo::thread_bfe. The decision vectors
+     * of the individuals do not depend on whether the evaluation is sequential or parallel.
+     *
      * @param x the problem the population refers to.
      * @param pop_size population size (i.e. number of individuals therein).
      * @param seed seed of the random number generator used, for example, to
      * create new random individuals within the bounds.
      *
-     * @throws unspecified any exception thrown by random_decision_vector(), push_back(), or by the
-     * invoked constructor of pagmo::problem.
+     * @throws unspecified any exception thrown by random_decision_vector(), push_back(), the public API
+     * of pagmo::thread_bfe, or by the invoked constructor of pagmo::problem.
      */
     template <typename T, generic_ctor_enabler<T> = 0>
     explicit population(T &&x, size_type pop_size = 0u, unsigned seed = pagmo::random_device::next())
@@ -413,6 +413,45 @@ public:
     static constexpr bool value = implementation_defined;
 };
 
+// Detect the fitness_into() member function.
+template <typename T>
+class has_fitness_into
+{
+    template <typename U>
+    using fitness_into_t = decltype(std::declval<const U &>().fitness_into(std::declval<const double *>(),
+                                                                           std::declval<double *>()));
+    static const bool implementation_defined = std::is_same<void, detected_t<fitness_into_t, T>>::value;
+
+public:
+    static constexpr bool value = implementation_defined;
+};
+
+// Detect the has_fitness_into() member function.
+template <typename T>
+class override_has_fitness_into
+{
+    template <typename U>
+    using has_fitness_into_t = decltype(std::declval<const U &>().has_fitness_into());
+    static const bool implementation_defined = std::is_same<bool, detected_t<has_fitness_into_t, T>>::value;
+
+public:
+    static constexpr bool value = implementation_defined;
+};
+
+// Detect the incremental_fitness() member function.
+template <typename T>
+class has_incremental_fitness
+{
+    template <typename U>
+    using incremental_fitness_t = decltype(std::declval<const U &>().incremental_fitness(
+        std::declval<const vector_double &>(), std::declval<const vector_double &>(),
+        std::declval<const vector_double &>(), std::declval<const std::vector<vector_double::size_type> &>()));
+    static const bool implementation_defined = std::is_same<vector_double, detected_t<incremental_fitness_t, T>>::value;
+
+public:
+    static constexpr bool value = implementation_defined;
+};
+
 namespace detail
 {
 
@@ -473,6 +512,11 @@ struct PAGMO_DLL_PUBLIC_INLINE_CLASS prob_inner_base {
     virtual vector_double fitness(const vector_double &) const = 0;
     virtual vector_double batch_fitness(const vector_double &) const = 0;
     virtual bool has_batch_fitness() const = 0;
+    virtual void fitness_into(const double *, double *) const = 0;
+    virtual bool has_fitness_into() const = 0;
+    virtual vector_double incremental_fitness(const vector_double &, const vector_double &, const vector_double &,
+                                              const std::vector<vector_double::size_type> &) const = 0;
+    virtual bool has_incremental_fitness() const = 0;
     virtual vector_double gradient(const vector_double &) const = 0;
     virtual bool has_gradient() const = 0;
     virtual sparsity_pattern gradient_sparsity() const = 0;
@@ -551,6 +595,41 @@ struct PAGMO_DLL_PUBLIC_INLINE_CLASS prob_inner final : prob_inner_base {
             return pagmo::has_batch_fitness<T>::value;
         }
     }
+    void fitness_into([[maybe_unused]] const double *dv, [[maybe_unused]] double *fv) const final
+    {
+        if constexpr (pagmo::has_fitness_into<T>::value) {
+            m_value.fitness_into(dv, fv);
+        } else {
+            pagmo_throw(not_implemented_error,
+                        "The fitness_into() method has been invoked, but it is not implemented in a UDP of type '"
+                            + get_name_impl(m_value) + "'");
+        }
+    }
+    bool has_fitness_into() const final
+    {
+        if constexpr (detail::conjunction<pagmo::has_fitness_into<T>, pagmo::override_has_fitness_into<T>>::value) {
+            return m_value.has_fitness_into();
+        } else {
+            return pagmo::has_fitness_into<T>::value;
+        }
+    }
+    vector_double incremental_fitness([[maybe_unused]] const vector_double &dv,
+                                      [[maybe_unused]] const vector_double &dv_old,
+                                      [[maybe_unused]] const vector_double &fv_old,
+                                      [[maybe_unused]] const std::vector<vector_double::size_type> &idx) const final
+    {
+        if constexpr (pagmo::has_incremental_fitness<T>::value) {
+            return m_value.incremental_fitness(dv, dv_old, fv_old, idx);
+        } else {
+            pagmo_throw(not_implemented_error, "The incremental_fitness() method has been invoked, but it is not "
+                                               "implemented in a UDP of type '"
+                                                   + get_name_impl(m_value) + "'");
+        }
+    }
+    bool has_incremental_fitness() const final
+    {
+        return pagmo::has_incremental_fitness<T>::value;
+    }
     vector_double::size_type get_nobj() const final
     {
         return get_nobj_impl(m_value);
@@ -963,6 +1042,10 @@ PAGMO_DLL_PUBLIC vector_double prob_invoke_mem_batch_fitness(const problem &, co
  * vector_double::size_type get_nix() const;
  * vector_double batch_fitness(const vector_double &) const;
  * bool has_batch_fitness() const;
+ * void fitness_into(const double *, double *) const;
+ * bool has_fitness_into() const;
+ * vector_double incremental_fitness(const vector_double &, const vector_double &, const vector_double &,
+ *                                   const std::vector<vector_double::size_type> &) const;
  * bool has_gradient() const;
  * vector_double gradient(const vector_double &) const;
  * bool has_gradient_sparsity() const;
@@ -1194,6 +1277,50 @@ public:
         return m_has_batch_fitness;
     }
 
+    // Fitness into a caller-provided buffer.
+    void fitness_into(const double *, double *) const;
+
+    /// Check if the UDP provides the <tt>%fitness_into()</tt> method.
+    /**
+     * \verbatim embed:rst:leading-asterisk
+     * .. versionadded:: 2.20
+     *
+     * The availability of the ``fitness_into()`` method in the UDP is determined as follows:
+     *
+     * * if the UDP does not satisfy :cpp:class:`pagmo::has_fitness_into`, then this method will always return
+     *   ``false``;
+     * * if the UDP satisfies :cpp:class:`pagmo::has_fitness_into` but it does not satisfy
+     *   :cpp:class:`pagmo::override_has_fitness_into`, then this method will always return ``true``;
+     * * if the UDP satisfies both :cpp:class:`pagmo::has_fitness_into` and
+     *   :cpp:class:`pagmo::override_has_fitness_into`, then this method will return the output of the
+     *   ``has_fitness_into()`` method of the UDP.
+     *
+     * \endverbatim
+     *
+     * @return a flag signalling the availability of the <tt>%fitness_into()</tt> method in the UDP.
+     */
+    bool has_fitness_into() const
+    {
+        return ptr()->has_fitness_into();
+    }
+
+    // Incremental fitness.
+    vector_double incremental_fitness(const vector_double &, const vector_double &, const vector_double &,
+                                      const std::vector<vector_double::size_type> &) const;
+
+    /// Check if the UDP provides the <tt>%incremental_fitness()</tt> method.
+    /**
+     * \verbatim embed:rst:leading-asterisk
+     * .. versionadded:: 2.20
+     * \endverbatim
+     *
+     * @return \p true if the UDP satisfies pagmo::has_incremental_fitness, \p false otherwise.
+     */
+    bool has_incremental_fitness() const
+    {
+        return ptr()->has_incremental_fitness();
+    }
+
     // Gradient.
     vector_double gradient(const vector_double &) const;
 
@@ -1466,6 +1593,21 @@ public:
         return m_gevals.load(std::memory_order_relaxed);
     }
 
+    /// Increment the number of gradient evaluations.
+    /**
+     * \verbatim embed:rst:leading-asterisk
+     * .. versionadded:: 2.20
+     * \endverbatim
+     *
+     * This method will increase the internal counter of gradient evaluations by \p n.
+     *
+     * @param n the amount by which the internal counter of gradient evaluations will be increased.
+     */
+    void increment_gevals(unsigned long long n) const
+    {
+        m_gevals.fetch_add(n, std::memory_order_relaxed);
+    }
+
     /// Number of hessians evaluations.
     /**
      * Each time a call to problem::hessians() successfully completes, an internal counter is increased by one.
@@ -1479,6 +1621,21 @@ public:
         return m_hevals.load(std::memory_order_relaxed);
     }
 
+    /// Increment the number of hessians evaluations.
+    /**
+     * \verbatim embed:rst:leading-asterisk
+     * .. versionadded:: 2.20
+     * \endverbatim
+     *
+     * This method will increase the internal counter of hessians evaluations by \p n.
+     *
+     * @param n the amount by which the internal counter of hessians evaluations will be increased.
+     */
+    void increment_hevals(unsigned long long n) const
+    {
+        m_hevals.fetch_add(n, std::memory_order_relaxed);
+    }
+
     // Set the seed for the stochastic variables.
     void set_seed(unsigned);
 
@@ -65,6 +65,8 @@ struct PAGMO_DLL_PUBLIC ackley {
     ackley(unsigned dim = 1u);
     // Fitness computation
     vector_double fitness(const vector_double &) const;
+    // Batch fitness computation
+    vector_double batch_fitness(const vector_double &) const;
     // Box-bounds
     std::pair<vector_double, vector_double> get_bounds() const;
     /// Problem name
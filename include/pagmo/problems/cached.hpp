@@ -0,0 +1,303 @@
+/* Copyright 2017-2021 PaGMO development team
+
+This file is part of the PaGMO library.
+
+The PaGMO library is free software; you can redistribute it and/or modify
+it under the terms of either:
+
+  * the GNU Lesser General Public License as published by the Free
+    Software Foundation; either version 3 of the License, or (at your
+    option) any later version.
+
+or
+
+  * the GNU General Public License as published by the Free Software
+    Foundation; either version 3 of the License, or (at your option) any
+    later version.
+
+or both in parallel, as here.
+
+The PaGMO library is distributed in the hope that it will be useful, but
+WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+for more details.
+
+You should have received copies of the GNU General Public License and the
+GNU Lesser General Public License along with the PaGMO library.  If not,
+see https://www.gnu.org/licenses/. */
+
+#ifndef PAGMO_PROBLEMS_CACHED_HPP
+#define PAGMO_PROBLEMS_CACHED_HPP
+
+#include <atomic>
+#include <cstddef>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <type_traits>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include <pagmo/detail/custom_comparisons.hpp>
+#include <pagmo/detail/visibility.hpp>
+#include <pagmo/problem.hpp>
+#include <pagmo/s11n.hpp>
+#include <pagmo/type_traits.hpp>
+#include <pagmo/types.hpp>
+
+namespace pagmo
+{
+
+/// The cached meta-problem.
+/**
+ * This meta-problem memoizes the fitness evaluations of an inner problem in a bounded
+ * cache with least-recently-used (LRU) eviction. Whenever the fitness of a decision vector which
+ * is still present in the cache is requested, the stored fitness is returned without invoking
+ * the inner problem. This is useful with algorithms that tend to re-evaluate identical decision vectors
+ * (e.g., pagmo::mbh, pagmo::ihs or pagmo::compass_search) when the fitness function is expensive.
+ *
+ * Decision vectors are compared bitwise-exactly, with all NaNs considered equal. The cache
+ * is split into a number of independently-locked shards, so that concurrent fitness evaluations
+ * (e.g., via pagmo::thread_bfe) do not serialise on a single lock. The thread safety level
+ * of this meta-problem is thus the same as the thread safety level of the inner problem.
+ *
+ * The number of cache hits and misses can be queried via cached::get_hits() and
+ * cached::get_misses(). Batch fitness evaluations are forwarded to the inner problem's
+ * batch fitness function, after the removal of the decision vectors already present in the cache.
+ *
+ * \verbatim embed:rst:leading-asterisk
+ * .. note::
+ *
+ *    The cache assumes that the fitness function of the inner problem is deterministic. If
+ *    the inner problem is stochastic, the cache is cleared each time the seed of the inner
+ *    problem is changed via :cpp:func:`pagmo::cached::set_seed()`.
+ *
+ * .. note::
+ *
+ *    The content of the cache and the hit/miss counters are not serialised.
+ *
+ * .. note::
+ *
+ *    Copies of a :cpp:class:`~pagmo::cached` problem (e.g., those made when constructing a
+ *    :cpp:class:`~pagmo::population` or an :cpp:class:`~pagmo::island`, or by the batch fitness
+ *    evaluators) share the cache and the hit/miss counters with the original object, so that
+ *    copying is cheap regardless of the cache size and the evaluations performed by any copy
+ *    are visible to all the others. A copy gets a new, empty cache of its own as soon as its inner
+ *    problem might change, that is, when :cpp:func:`pagmo::cached::set_seed()` or the non-const overload of
+ *    :cpp:func:`pagmo::cached::get_inner_problem()` are invoked.
+ *
+ * .. versionadded:: 2.20
+ *
+ * \endverbatim
+ */
+class PAGMO_DLL_PUBLIC cached
+{
+    // Enabler for the ctor from UDP or problem. In this case we also allow construction from type problem.
+    template <typename T>
+    using ctor_enabler = enable_if_t<detail::conjunction<detail::negation<std::is_same<cached, uncvref_t<T>>>,
+                                                         std::is_constructible<problem, T &&>>::value,
+                                     int>;
+    // Implementation of the generic ctor.
+    void generic_ctor_impl();
+
+public:
+    // Default constructor.
+    cached();
+
+    /// Constructor from problem and cache capacity.
+    /**
+     * \verbatim embed:rst:leading-asterisk
+     * .. note::
+     *
+     *    This constructor is enabled only if ``T`` can be used to construct a :cpp:class:`pagmo::problem`
+     *    and if ``T``, after the removal of reference and cv qualifiers, is not :cpp:class:`pagmo::cached`.
+     *
+     * \endverbatim
+     *
+     * Wraps a user-defined problem so that its fitness evaluations will be cached.
+     *
+     * @param p a pagmo::problem or a user-defined problem (UDP).
+     * @param capacity the maximum number of fitness evaluations that will be stored in the cache.
+     *
+     * @throws std::invalid_argument if \p capacity is zero.
+     * @throws unspecified any exception thrown by the pagmo::problem constructor.
+     */
+    template <typename T, ctor_enabler<T> = 0>
+    explicit cached(T &&p, std::size_t capacity = 10000u) : m_problem(std::forward<T>(p)), m_capacity(capacity)
+    {
+        generic_ctor_impl();
+    }
+
+    // Copy/move ctors and assignment operators.
+    cached(const cached &);
+    cached(cached &&) noexcept;
+    cached &operator=(const cached &);
+    cached &operator=(cached &&) noexcept;
+    ~cached();
+
+    // Fitness.
+    vector_double fitness(const vector_double &) const;
+
+    // Batch fitness.
+    vector_double batch_fitness(const vector_double &) const;
+
+    // Check if the inner problem can compute fitnesses in batch mode.
+    bool has_batch_fitness() const;
+
+    // Fitness into a caller-provided buffer.
+    void fitness_into(const double *, double *) const;
+
+    // Check if the inner problem provides fitness_into().
+    bool has_fitness_into() const;
+
+    // Box-bounds.
+    std::pair<vector_double, vector_double> get_bounds() const;
+
+    // Number of objectives.
+    vector_double::size_type get_nobj() const;
+
+    // Equality constraint dimension.
+    vector_double::size_type get_nec() const;
+
+    // Inequality constraint dimension.
+    vector_double::size_type get_nic() const;
+
+    // Integer dimension
+    vector_double::size_type get_nix() const;
+
+    // Checks if the inner problem has gradients.
+    bool has_gradient() const;
+
+    // Gradients.
+    vector_double gradient(const vector_double &) const;
+
+    // Checks if the inner problem has gradient sparisty implemented.
+    bool has_gradient_sparsity() const;
+
+    // Gradient sparsity.
+    sparsity_pattern gradient_sparsity() const;
+
+    // Checks if the inner problem has hessians.
+    bool has_hessians() const;
+
+    // Hessians.
+    std::vector<vector_double> hessians(const vector_double &) const;
+
+    // Checks if the inner problem has hessians sparisty implemented.
+    bool has_hessians_sparsity() const;
+
+    // Hessians sparsity.
+    std::vector<sparsity_pattern> hessians_sparsity() const;
+
+    // Calls <tt>has_set_seed()</tt> of the inner problem.
+    bool has_set_seed() const;
+
+    // Calls <tt>set_seed()</tt> of the inner problem.
+    void set_seed(unsigned);
+
+    // Problem name
+    std::string get_name() const;
+
+    // Extra info
+    std::string get_extra_info() const;
+
+    // Problem's thread safety level.
+    thread_safety get_thread_safety() const;
+
+    // Cache capacity.
+    std::size_t get_capacity() const;
+
+    // Number of entries currently in the cache.
+    std::size_t get_cache_size() const;
+
+    // Number of cache hits.
+    unsigned long long get_hits() const;
+
+    // Number of cache misses.
+    unsigned long long get_misses() const;
+
+    // Clear the cache and reset the counters.
+    void clear_cache();
+
+    /// Getter for the inner problem.
+    /**
+     * Returns a const reference to the inner pagmo::problem.
+     *
+     * @return a const reference to the inner pagmo::problem.
+     */
+    const problem &get_inner_problem() const;
+
+    /// Getter for the inner problem.
+    /**
+     * Returns a reference to the inner pagmo::problem.
+     *
+     * \verbatim embed:rst:leading-asterisk
+     * .. note::
+     *
+     *    The ability to extract a non const reference is provided only in order to allow to call
+     *    non-const methods on the internal :cpp:class:`pagmo::problem` instance. Assigning a new
+     *    :cpp:class:`pagmo::problem` via this reference is undefined behaviour.
+     *
+     *    Since the inner problem may be modified via the returned reference, this method
+     *    detaches this object from the cache it shares with its copies, and sets up a new, empty cache.
+     *
+     * \endverbatim
+     *
+     * @return a reference to the inner pagmo::problem.
+     *
+     * @throws unspecified any exception thrown by memory errors in standard containers.
+     */
+    problem &get_inner_problem();
+
+private:
+    // Object serialization
+    friend class boost::serialization::access;
+    template <typename Archive>
+    void save(Archive &, unsigned) const;
+    template <typename Archive>
+    void load(Archive &, unsigned);
+    BOOST_SERIALIZATION_SPLIT_MEMBER()
+
+    // A single shard of the cache. Each shard
+    // is an independent LRU cache protected by its own mutex.
+    // The LRU list stores pointers to the keys in the map
+    // (which are stable), ordered from the most recently used
+    // to the least recently used.
+    struct shard {
+        using lru_list_t = std::list<const vector_double *>;
+        using map_t = std::unordered_map<vector_double, std::pair<vector_double, lru_list_t::iterator>,
+                                         detail::hash_vf<double>, detail::equal_to_vf<double>>;
+
+        mutable std::mutex m_mutex;
+        std::size_t m_capacity = 0;
+        lru_list_t m_lru;
+        map_t m_map;
+    };
+    // The storage of the cache, shared among the copies
+    // of a cached problem: the shards and the hit/miss counters.
+    struct storage {
+        std::vector<std::unique_ptr<shard>> m_shards;
+        std::atomic<unsigned long long> m_hits{0};
+        std::atomic<unsigned long long> m_misses{0};
+    };
+
+    PAGMO_DLL_LOCAL void init_storage();
+    PAGMO_DLL_LOCAL shard &get_shard(std::size_t) const;
+    PAGMO_DLL_LOCAL bool lookup(const vector_double &, std::size_t, vector_double &) const;
+    PAGMO_DLL_LOCAL void insert(const vector_double &, std::size_t, const vector_double &) const;
+
+    // Inner problem
+    problem m_problem;
+    // Cache capacity.
+    std::size_t m_capacity;
+    // The cache storage.
+    std::shared_ptr<storage> m_storage;
+};
+
+} // namespace pagmo
+
+PAGMO_S11N_PROBLEM_EXPORT_KEY(pagmo::cached)
+
+#endif
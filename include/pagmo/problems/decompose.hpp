@@ -148,6 +148,12 @@ public:
     // Fitness of the original problem.
     vector_double original_fitness(const vector_double &) const;
 
+    // Fitness into a caller-provided buffer.
+    void fitness_into(const double *, double *) const;
+
+    // Check if the inner problem provides fitness_into().
+    bool has_fitness_into() const;
+
     /// Number of objectives.
     /**
      * @return one.
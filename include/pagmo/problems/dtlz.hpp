@@ -106,6 +106,8 @@ public:
          unsigned alpha = 100u);
     // Fitness computation
     vector_double fitness(const vector_double &) const;
+    // Batch fitness computation
+    vector_double batch_fitness(const vector_double &) const;
     /// Number of objectives
     /**
      *
@@ -154,6 +156,10 @@ private:
     PAGMO_DLL_LOCAL vector_double f56_objfun_impl(const vector_double &) const;
     PAGMO_DLL_LOCAL vector_double f7_objfun_impl(const vector_double &) const;
 
+    // Pointer to one of the objective functions above.
+    using fitness_impl_t = vector_double (dtlz::*)(const vector_double &) const;
+    PAGMO_DLL_LOCAL fitness_impl_t get_fitness_impl() const;
+
     // Gives a convergence metric for the population (0 = converged to the optimal front)
     PAGMO_DLL_LOCAL double convergence_metric(const vector_double &) const;
 
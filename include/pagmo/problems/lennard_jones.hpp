@@ -31,6 +31,7 @@ see https://www.gnu.org/licenses/. */
 
 #include <string>
 #include <utility>
+#include <vector>
 
 #include <pagmo/detail/visibility.hpp>
 #include <pagmo/problem.hpp>
@@ -69,6 +70,9 @@ public:
     lennard_jones(unsigned atoms = 3u);
     // Fitness computation
     vector_double fitness(const vector_double &) const;
+    // Incremental fitness computation
+    vector_double incremental_fitness(const vector_double &, const vector_double &, const vector_double &,
+                                      const std::vector<vector_double::size_type> &) const;
     // Box-bounds
     std::pair<vector_double, vector_double> get_bounds() const;
     // Problem name
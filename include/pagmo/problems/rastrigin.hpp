@@ -75,6 +75,11 @@ struct PAGMO_DLL_PUBLIC rastrigin {
 
     // Fitness computation
     vector_double fitness(const vector_double &) const;
+    // Batch fitness computation
+    vector_double batch_fitness(const vector_double &) const;
+    // Incremental fitness computation
+    vector_double incremental_fitness(const vector_double &, const vector_double &, const vector_double &,
+                                      const std::vector<vector_double::size_type> &) const;
 
     // Box-bounds
     std::pair<vector_double, vector_double> get_bounds() const;
@@ -0,0 +1,241 @@
+/* Copyright 2017-2021 PaGMO development team
+
+This file is part of the PaGMO library.
+
+The PaGMO library is free software; you can redistribute it and/or modify
+it under the terms of either:
+
+  * the GNU Lesser General Public License as published by the Free
+    Software Foundation; either version 3 of the License, or (at your
+    option) any later version.
+
+or
+
+  * the GNU General Public License as published by the Free Software
+    Foundation; either version 3 of the License, or (at your option) any
+    later version.
+
+or both in parallel, as here.
+
+The PaGMO library is distributed in the hope that it will be useful, but
+WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+for more details.
+
+You should have received copies of the GNU General Public License and the
+GNU Lesser General Public License along with the PaGMO library.  If not,
+see https://www.gnu.org/licenses/. */
+
+#ifndef PAGMO_PROBLEMS_SHARDED_HPP
+#define PAGMO_PROBLEMS_SHARDED_HPP
+
+#include <cstddef>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include <pagmo/detail/visibility.hpp>
+#include <pagmo/problem.hpp>
+#include <pagmo/s11n.hpp>
+#include <pagmo/threading.hpp>
+#include <pagmo/type_traits.hpp>
+#include <pagmo/types.hpp>
+
+namespace pagmo
+{
+
+/// The sharded meta-problem.
+/**
+ * This meta-problem upgrades the thread safety level of an inner problem providing
+ * only the pagmo::thread_safety::basic level to pagmo::thread_safety::constant. This is achieved
+ * by evaluating the inner problem via a pool of clones: when a thread invokes a method of this meta-problem
+ * which needs to call into the inner problem (e.g., the fitness function), an idle clone is checked out of
+ * the pool (or, if there are no idle clones, a new copy of the inner problem is created), used exclusively
+ * by the calling thread for the duration of the invocation, and then returned to the pool for reuse. The
+ * idle clones are stored in a number of independently-locked shards, so that threads checking out and
+ * returning clones do not serialise on a single lock.
+ *
+ * The typical use case is a large problem object providing only the basic thread safety level (e.g.,
+ * because it uses mutable scratch buffers). Batch fitness evaluators such as pagmo::thread_bfe
+ * would otherwise have to copy such a problem for every parallel evaluation: when wrapped in this
+ * meta-problem, the problem is copied roughly once per concurrent evaluation, and the copies are reused
+ * across evaluations.
+ *
+ * The properties of the problem which are cached by pagmo::problem upon construction (e.g., the bounds
+ * and the dimensions) are read directly from the inner problem, without creating clones. The sparsity
+ * patterns and the extra info are also computed by the inner problem, under a lock.
+ *
+ * \verbatim embed:rst:leading-asterisk
+ * .. note::
+ *
+ *    The number of idle clones kept in the pool is bounded by ``std::thread::hardware_concurrency()``,
+ *    rounded up to a multiple of the number of shards. Clones returned to a full pool are destroyed,
+ *    thus the memory footprint of this meta-problem does not grow with the number of distinct threads
+ *    which have evaluated it. The idle clones are destroyed when the inner problem is modified via
+ *    :cpp:func:`pagmo::sharded::set_seed()` or :cpp:func:`pagmo::sharded::get_inner_problem()`.
+ *
+ * .. note::
+ *
+ *    The clones are not copied, moved or serialised together with the meta-problem.
+ *
+ * .. versionadded:: 2.20
+ *
+ * \endverbatim
+ */
+class PAGMO_DLL_PUBLIC sharded
+{
+    // Enabler for the ctor from UDP or problem. In this case we also allow construction from type problem.
+    template <typename T>
+    using ctor_enabler = enable_if_t<detail::conjunction<detail::negation<std::is_same<sharded, uncvref_t<T>>>,
+                                                         std::is_constructible<problem, T &&>>::value,
+                                     int>;
+    // Implementation of the generic ctor.
+    void generic_ctor_impl();
+
+public:
+    // Default constructor.
+    sharded();
+
+    /// Constructor from problem.
+    /**
+     * \verbatim embed:rst:leading-asterisk
+     * .. note::
+     *
+     *    This constructor is enabled only if ``T`` can be used to construct a :cpp:class:`pagmo::problem`
+     *    and if ``T``, after the removal of reference and cv qualifiers, is not :cpp:class:`pagmo::sharded`.
+     *
+     * \endverbatim
+     *
+     * Wraps a user-defined problem so that it will be evaluated via a pool of clones.
+     *
+     * @param p a pagmo::problem or a user-defined problem (UDP).
+     *
+     * @throws unspecified any exception thrown by the pagmo::problem constructor.
+     */
+    template <typename T, ctor_enabler<T> = 0>
+    explicit sharded(T &&p) : m_problem(std::forward<T>(p))
+    {
+        generic_ctor_impl();
+    }
+
+    // Copy/move ctors and assignment operators.
+    sharded(const sharded &);
+    sharded(sharded &&) noexcept;
+    sharded &operator=(const sharded &);
+    sharded &operator=(sharded &&) noexcept;
+    ~sharded();
+
+    // Fitness.
+    vector_double fitness(const vector_double &) const;
+
+    // Batch fitness.
+    vector_double batch_fitness(const vector_double &) const;
+
+    // Check if the inner problem can compute fitnesses in batch mode.
+    bool has_batch_fitness() const;
+
+    // Box-bounds.
+    std::pair<vector_double, vector_double> get_bounds() const;
+
+    // Number of objectives.
+    vector_double::size_type get_nobj() const;
+
+    // Equality constraint dimension.
+    vector_double::size_type get_nec() const;
+
+    // Inequality constraint dimension.
+    vector_double::size_type get_nic() const;
+
+    // Integer dimension
+    vector_double::size_type get_nix() const;
+
+    // Checks if the inner problem has gradients.
+    bool has_gradient() const;
+
+    // Gradients.
+    vector_double gradient(const vector_double &) const;
+
+    // Checks if the inner problem has gradient sparisty implemented.
+    bool has_gradient_sparsity() const;
+
+    // Gradient sparsity.
+    sparsity_pattern gradient_sparsity() const;
+
+    // Checks if the inner problem has hessians.
+    bool has_hessians() const;
+
+    // Hessians.
+    std::vector<vector_double> hessians(const vector_double &) const;
+
+    // Checks if the inner problem has hessians sparisty implemented.
+    bool has_hessians_sparsity() const;
+
+    // Hessians sparsity.
+    std::vector<sparsity_pattern> hessians_sparsity() const;
+
+    // Calls <tt>has_set_seed()</tt> of the inner problem.
+    bool has_set_seed() const;
+
+    // Calls <tt>set_seed()</tt> of the inner problem.
+    void set_seed(unsigned);
+
+    // Problem name
+    std::string get_name() const;
+
+    // Extra info
+    std::string get_extra_info() const;
+
+    // Problem's thread safety level.
+    thread_safety get_thread_safety() const;
+
+    // Number of clones of the inner problem.
+    std::size_t get_n_clones() const;
+
+    // Getters for the inner problem.
+    const problem &get_inner_problem() const;
+    problem &get_inner_problem();
+
+private:
+    // Object serialization
+    friend class boost::serialization::access;
+    template <typename Archive>
+    void save(Archive &, unsigned) const;
+    template <typename Archive>
+    void load(Archive &, unsigned);
+    BOOST_SERIALIZATION_SPLIT_MEMBER()
+
+    // A single shard of the pool of idle clones,
+    // protected by its own mutex.
+    struct shard {
+        mutable std::mutex m_mutex;
+        // NOTE: the capacity of m_clones is reserved
+        // to m_max_size upon construction.
+        std::vector<std::unique_ptr<const problem>> m_clones;
+        std::size_t m_max_size = 0;
+    };
+    // RAII handle to a clone checked out of the pool.
+    class clone_handle;
+
+    PAGMO_DLL_LOCAL void init_shards();
+    PAGMO_DLL_LOCAL clone_handle get_clone() const;
+    PAGMO_DLL_LOCAL void return_clone(std::unique_ptr<const problem> &&) const noexcept;
+    PAGMO_DLL_LOCAL void clear_clones();
+
+    // Inner problem.
+    problem m_problem;
+    // NOTE: the inner problem provides only basic thread safety,
+    // thus the const operations on it (including the copies used
+    // to create the clones) need to be serialised.
+    mutable std::mutex m_problem_mutex;
+    // The shards.
+    std::vector<std::unique_ptr<shard>> m_shards;
+};
+
+} // namespace pagmo
+
+PAGMO_S11N_PROBLEM_EXPORT_KEY(pagmo::sharded)
+
+#endif
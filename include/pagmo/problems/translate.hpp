@@ -98,6 +98,12 @@ public:
     // Check if the inner problem can compute fitnesses in batch mode.
     bool has_batch_fitness() const;
 
+    // Fitness into a caller-provided buffer.
+    void fitness_into(const double *, double *) const;
+
+    // Check if the inner problem provides fitness_into().
+    bool has_fitness_into() const;
+
     // Box-bounds.
     std::pair<vector_double, vector_double> get_bounds() const;
 
@@ -116,6 +116,12 @@ public:
     // The batch fitness of the problem.
     vector_double batch_fitness(const vector_double & xs) const;
 
+    // Fitness into a caller-provided buffer.
+    void fitness_into(const double *, double *) const;
+
+    // Check if the inner problem provides fitness_into().
+    bool has_fitness_into() const;
+
     // Number of objectives.
     vector_double::size_type get_nobj() const;
 
@@ -145,6 +145,8 @@ public:
     zdt(unsigned prob_id = 1u, unsigned param = 30u);
     // Fitness computation
     vector_double fitness(const vector_double &) const;
+    // Batch fitness computation
+    vector_double batch_fitness(const vector_double &) const;
     /// Number of objectives
     /**
      * It returns the number of objectives.
@@ -190,12 +192,15 @@ private:
     template <typename Archive>
     void serialize(Archive &, unsigned);
 
-    PAGMO_DLL_LOCAL vector_double zdt1_fitness(const vector_double &) const;
-    PAGMO_DLL_LOCAL vector_double zdt2_fitness(const vector_double &) const;
-    PAGMO_DLL_LOCAL vector_double zdt3_fitness(const vector_double &) const;
-    PAGMO_DLL_LOCAL vector_double zdt4_fitness(const vector_double &) const;
-    PAGMO_DLL_LOCAL vector_double zdt5_fitness(const vector_double &) const;
-    PAGMO_DLL_LOCAL vector_double zdt6_fitness(const vector_double &) const;
+    // Pointer to one of the fitness implementations below.
+    using fitness_impl_t = void (zdt::*)(const double *, vector_double::size_type, double *) const;
+    PAGMO_DLL_LOCAL fitness_impl_t get_fitness_impl() const;
+    PAGMO_DLL_LOCAL void zdt1_fitness(const double *, vector_double::size_type, double *) const;
+    PAGMO_DLL_LOCAL void zdt2_fitness(const double *, vector_double::size_type, double *) const;
+    PAGMO_DLL_LOCAL void zdt3_fitness(const double *, vector_double::size_type, double *) const;
+    PAGMO_DLL_LOCAL void zdt4_fitness(const double *, vector_double::size_type, double *) const;
+    PAGMO_DLL_LOCAL void zdt5_fitness(const double *, vector_double::size_type, double *) const;
+    PAGMO_DLL_LOCAL void zdt6_fitness(const double *, vector_double::size_type, double *) const;
     PAGMO_DLL_LOCAL double zdt123_p_distance(const vector_double &) const;
     PAGMO_DLL_LOCAL double zdt4_p_distance(const vector_double &) const;
     PAGMO_DLL_LOCAL double zdt5_p_distance(const vector_double &) const;
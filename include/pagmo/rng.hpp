@@ -29,8 +29,13 @@ see https://www.gnu.org/licenses/. */
 #ifndef PAGMO_RNG_HPP
 #define PAGMO_RNG_HPP
 
+#include <array>
+#include <cstdint>
+#include <iosfwd>
+#include <limits>
 #include <random>
 
+#include <pagmo/config.hpp>
 #include <pagmo/detail/visibility.hpp>
 
 namespace pagmo
@@ -39,9 +44,166 @@ namespace pagmo
 namespace detail
 {
 
+// Implementation of the xoshiro128** generator by Blackman and Vigna, 2018
+// (see https://prng.di.unimi.it/). It is a small (128 bits of state), fast
+// generator of 32-bit numbers with period 2**128 - 1. It provides a jump()
+// function equivalent to 2**64 calls to the generator, which can be used
+// to produce up to 2**64 non-overlapping substreams (e.g., one per thread)
+// from a single seed.
+class xoshiro128ss
+{
+    static constexpr std::uint32_t rotl(std::uint32_t x, int k)
+    {
+        return (x << k) | (x >> (32 - k));
+    }
+    // The splitmix64 generator, used to turn a seed into a state.
+    static std::uint64_t splitmix64(std::uint64_t &x)
+    {
+        auto z = (x += 0x9e3779b97f4a7c15ull);
+        z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ull;
+        z = (z ^ (z >> 27)) * 0x94d049bb133111ebull;
+        return z ^ (z >> 31);
+    }
+
+public:
+    using result_type = std::uint32_t;
+    using state_type = std::array<std::uint32_t, 4>;
+    static constexpr result_type default_seed = 5489u;
+
+    xoshiro128ss() : xoshiro128ss(default_seed) {}
+    explicit xoshiro128ss(result_type s)
+    {
+        seed(s);
+    }
+
+    void seed(result_type s = default_seed)
+    {
+        std::uint64_t x = s;
+        const auto a = splitmix64(x), b = splitmix64(x);
+        m_state = {static_cast<std::uint32_t>(a), static_cast<std::uint32_t>(a >> 32), static_cast<std::uint32_t>(b),
+                   static_cast<std::uint32_t>(b >> 32)};
+    }
+
+    static constexpr result_type min()
+    {
+        return 0;
+    }
+    static constexpr result_type max()
+    {
+        return std::numeric_limits<result_type>::max();
+    }
+
+    result_type operator()()
+    {
+        const auto retval = rotl(m_state[1] * 5u, 7) * 9u;
+        const auto t = m_state[1] << 9;
+
+        m_state[2] ^= m_state[0];
+        m_state[3] ^= m_state[1];
+        m_state[1] ^= m_state[2];
+        m_state[0] ^= m_state[3];
+
+        m_state[2] ^= t;
+
+        m_state[3] = rotl(m_state[3], 11);
+
+        return retval;
+    }
+
+    void discard(unsigned long long n)
+    {
+        for (; n != 0u; --n) {
+            (*this)();
+        }
+    }
+
+    // Advance the state as if operator() had been called 2**64 times.
+    void jump()
+    {
+        constexpr state_type jmp = {0x8764000bu, 0xf542d2d3u, 0x6fa035c3u, 0x77f2db5bu};
+
+        state_type s = {0, 0, 0, 0};
+        for (const auto j : jmp) {
+            for (auto b = 0; b < 32; ++b) {
+                if (j & (std::uint32_t(1) << b)) {
+                    for (auto i = 0; i < 4; ++i) {
+                        s[i] ^= m_state[i];
+                    }
+                }
+                (*this)();
+            }
+        }
+        m_state = s;
+    }
+
+    // Generator for the n-th substream of this generator, that is,
+    // a copy of this generator advanced by n jumps.
+    xoshiro128ss substream(unsigned long long n) const
+    {
+        auto retval(*this);
+        for (; n != 0u; --n) {
+            retval.jump();
+        }
+        return retval;
+    }
+
+    const state_type &get_state() const
+    {
+        return m_state;
+    }
+    void set_state(const state_type &s)
+    {
+        m_state = s;
+    }
+
+    friend bool operator==(const xoshiro128ss &a, const xoshiro128ss &b)
+    {
+        return a.m_state == b.m_state;
+    }
+    friend bool operator!=(const xoshiro128ss &a, const xoshiro128ss &b)
+    {
+        return !(a == b);
+    }
+    // Stream operators, in the textual representation
+    // of the state used by the standard engines.
+    template <typename CharT, typename Traits>
+    friend std::basic_ostream<CharT, Traits> &operator<<(std::basic_ostream<CharT, Traits> &os, const xoshiro128ss &e)
+    {
+        os << e.m_state[0];
+        for (auto i = 1; i < 4; ++i) {
+            os << os.widen(' ') << e.m_state[i];
+        }
+        return os;
+    }
+    template <typename CharT, typename Traits>
+    friend std::basic_istream<CharT, Traits> &operator>>(std::basic_istream<CharT, Traits> &is, xoshiro128ss &e)
+    {
+        state_type st;
+        for (auto &w : st) {
+            is >> w;
+        }
+        if (is) {
+            e.m_state = st;
+        }
+        return is;
+    }
+
+private:
+    state_type m_state;
+};
+
+#if defined(PAGMO_WITH_XOSHIRO)
+
+// PaGMO makes use of the xoshiro128** generator by Blackman and Vigna, 2018.
+using random_engine_type = xoshiro128ss;
+
+#else
+
 // PaGMO makes use of the 32-bit Mersenne Twister by Matsumoto and Nishimura, 1998.
 using random_engine_type = std::mt19937;
 
+#endif
+
 } // namespace detail
 
 /// Thread-safe random device
@@ -49,11 +211,17 @@ using random_engine_type = std::mt19937;
  * This class intends to be a thread-safe substitute for std::random_device,
  * allowing, at the same time, precise global seed control throughout PaGMO.
  * It offers the user access to a global Pseudo Random Sequence generated by the
- * 32-bit Mersenne Twister by Matsumoto and Nishimura, 1998.
+ * 32-bit Mersenne Twister by Matsumoto and Nishimura, 1998, or, if pagmo was built
+ * with the \p PAGMO_WITH_XOSHIRO option, by the splitmix64 generator by Steele, Lea and Flood, 2014.
  * Such a PRS can be accessed by all PaGMO classes via the static method
  * random_device::next(). The seed of this global Pseudo Random Sequence can
  * be set by the method random_device::set_seed(), else by default is initialized
  * once at run-time using std::random_device.
+ *
+ * The Mersenne Twister is protected by a mutex. The state of splitmix64 is instead
+ * a counter which is advanced atomically, so that random_device::next() never blocks.
+ * In both cases, for a given seed, the sequence of values returned by random_device::next()
+ * is reproducible.
  */
 struct PAGMO_DLL_PUBLIC random_device {
     static unsigned next();
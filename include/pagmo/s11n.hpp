@@ -30,6 +30,7 @@ see https://www.gnu.org/licenses/. */
 #define PAGMO_S11N_HPP
 
 #include <cstddef>
+#include <cstdint>
 #include <locale>
 #include <random>
 #include <sstream>
@@ -56,6 +57,7 @@ see https://www.gnu.org/licenses/. */
 #include <boost/archive/text_oarchive.hpp>
 
 #include <pagmo/detail/s11n_wrappers.hpp>
+#include <pagmo/rng.hpp>
 
 namespace pagmo
 {
@@ -134,6 +136,33 @@ inline void serialize(Archive &ar, std::mersenne_twister_engine<UIntType, w, n,
     split_free(ar, e, version);
 }
 
+// Implement serialization for the xoshiro128** engine.
+// NOTE: the state is saved as 4 32-bit integers, which
+// take 16 bytes in binary archives.
+template <class Archive>
+inline void save(Archive &ar, const pagmo::detail::xoshiro128ss &e, unsigned)
+{
+    for (const auto w : e.get_state()) {
+        ar << w;
+    }
+}
+
+template <class Archive>
+inline void load(Archive &ar, pagmo::detail::xoshiro128ss &e, unsigned)
+{
+    pagmo::detail::xoshiro128ss::state_type st;
+    for (auto &w : st) {
+        ar >> w;
+    }
+    e.set_state(st);
+}
+
+template <class Archive>
+inline void serialize(Archive &ar, pagmo::detail::xoshiro128ss &e, unsigned version)
+{
+    split_free(ar, e, version);
+}
+
 } // namespace serialization
 
 } // namespace boost
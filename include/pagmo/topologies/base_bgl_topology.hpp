@@ -30,6 +30,7 @@ see https://www.gnu.org/licenses/. */
 #define PAGMO_TOPOLOGIES_BASE_BGL_TOPOLOGY_HPP
 
 #include <cstddef>
+#include <memory>
 #include <mutex>
 #include <string>
 #include <utility>
@@ -83,6 +84,10 @@ class PAGMO_DLL_PUBLIC base_bgl_topology
     PAGMO_DLL_LOCAL void unsafe_check_vertex_indices(std::size_t, Args...) const;
     // Helper to detect adjacent vertices.
     PAGMO_DLL_LOCAL bool unsafe_are_adjacent(std::size_t, std::size_t) const;
+    // Helper to discard the CSR snapshot after a modification of the graph.
+    // NOTE: this is not marked as local because it is
+    // used in the serialization function.
+    void unsafe_reset_csr();
 
     // A few helpers to set/get the integral graph
     // object. These will lock the mutex, so they
@@ -120,10 +125,29 @@ private:
     {
         std::lock_guard<std::mutex> lock(m_mutex);
         detail::archive(ar, m_graph);
+        unsafe_reset_csr();
     }
 
+    // Compressed sparse row representation of the
+    // incoming edges of the graph.
+    struct csr_graph {
+        // The incoming edges of the vertex i are stored in
+        // the range [offsets[i], offsets[i + 1]) of sources and weights.
+        std::vector<std::size_t> offsets;
+        std::vector<std::size_t> sources;
+        vector_double weights;
+    };
+    // Fetch the current CSR snapshot, building it if necessary.
+    PAGMO_DLL_LOCAL std::shared_ptr<const csr_graph> get_csr() const;
+
     mutable std::mutex m_mutex;
     bgl_graph_t m_graph;
+    // NOTE: the CSR snapshot is immutable. It is built on demand
+    // by get_connections(), and it is discarded by any modification
+    // of the graph. It is accessed via atomic operations, so that
+    // get_connections() does not need to lock the mutex
+    // when a snapshot is available.
+    mutable std::shared_ptr<const csr_graph> m_csr;
 };
 
 } // namespace pagmo
@@ -34,6 +34,8 @@ see https://www.gnu.org/licenses/. */
 #include <stdexcept>
 #include <vector>
 
+#include <pagmo/bfe.hpp>
+#include <pagmo/detail/visibility.hpp>
 #include <pagmo/exceptions.hpp>
 #include <pagmo/problem.hpp>
 #include <pagmo/types.hpp>
@@ -242,6 +244,22 @@ vector_double estimate_gradient_h(Func f, const vector_double &x, double dx = 1e
     }
     return gradient;
 }
+
+// Heuristic to estimate the sparsity pattern (batched)
+PAGMO_DLL_PUBLIC sparsity_pattern estimate_sparsity(const bfe &, const problem &, const vector_double &,
+                                                    double = 1e-8);
+
+// Numerical computation of the gradient (low-order, batched)
+PAGMO_DLL_PUBLIC vector_double estimate_gradient(const bfe &, const problem &, const vector_double &, double = 1e-8);
+
+// Numerical computation of a sparse gradient (low-order, batched, with column grouping)
+PAGMO_DLL_PUBLIC vector_double estimate_gradient(const bfe &, const problem &, const vector_double &,
+                                                 const sparsity_pattern &, double = 1e-8);
+
+// Numerical computation of the gradient (high-order, batched)
+PAGMO_DLL_PUBLIC vector_double estimate_gradient_h(const bfe &, const problem &, const vector_double &,
+                                                   double = 1e-2);
+
 } // namespace pagmo
 // namespace pagmo
 
@@ -0,0 +1,178 @@
+/* Copyright 2017-2021 PaGMO development team
+
+This file is part of the PaGMO library.
+
+The PaGMO library is free software; you can redistribute it and/or modify
+it under the terms of either:
+
+  * the GNU Lesser General Public License as published by the Free
+    Software Foundation; either version 3 of the License, or (at your
+    option) any later version.
+
+or
+
+  * the GNU General Public License as published by the Free Software
+    Foundation; either version 3 of the License, or (at your option) any
+    later version.
+
+or both in parallel, as here.
+
+The PaGMO library is distributed in the hope that it will be useful, but
+WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+for more details.
+
+You should have received copies of the GNU General Public License and the
+GNU Lesser General Public License along with the PaGMO library.  If not,
+see https://www.gnu.org/licenses/. */
+
+#ifndef PAGMO_UTILS_INCREMENTAL_HYPERVOLUME_HPP
+#define PAGMO_UTILS_INCREMENTAL_HYPERVOLUME_HPP
+
+#include <map>
+#include <set>
+#include <utility>
+#include <vector>
+
+#include <pagmo/detail/visibility.hpp>
+#include <pagmo/s11n.hpp>
+#include <pagmo/types.hpp>
+
+namespace pagmo
+{
+
+/// Incremental hypervolume
+/**
+ * This class maintains a set of 2- or 3-dimensional points together with a fixed reference point,
+ * and it keeps track of the hypervolume of the set and of the exclusive contributions of the points
+ * while points are inserted into and removed from the set. It is meant to be used in steady-state,
+ * indicator-based selection schemes (e.g., SMS-EMOA), which repeatedly insert one point into the set
+ * and remove the least contributor.
+ *
+ * In the 2-dimensional case the updates are local: inserting or removing a point changes only the
+ * contributions of its neighbours on the non-dominated front, and each update costs \f$ O\left(\log n\right) \f$
+ * plus the number of points whose dominance status changes and of the dominated points lying between
+ * the neighbours. The least and greatest contributors are found in logarithmic time.
+ *
+ * In the 3-dimensional case the contributions are recomputed, when needed, via the \f$ O\left(n\log n\right) \f$
+ * HyCon3D algorithm (see pagmo::hv3d). The recomputation is performed lazily, so that any number of insertions
+ * and removals between two queries costs a single recomputation. The dominated and duplicate points are filtered out
+ * before the recomputation, and the contributions of the few front points which are the only ones dominating some
+ * of the dominated points are then corrected individually.
+ *
+ * The points are stored contiguously and identified by their index in the vector returned by
+ * incremental_hypervolume::get_points(). Inserted points are appended at the end of the vector, while
+ * the removal of a point moves the last point into the position of the removed one.
+ *
+ * \verbatim embed:rst:leading-asterisk
+ * .. note::
+ *
+ *    In the 3-dimensional case, the const methods of this class may update an internal cache,
+ *    and thus they must not be called concurrently on the same object.
+ *
+ * .. versionadded:: 2.20
+ *
+ * \endverbatim
+ */
+class PAGMO_DLL_PUBLIC incremental_hypervolume
+{
+public:
+    // Size type.
+    using size_type = std::vector<vector_double>::size_type;
+
+    // Default constructor.
+    incremental_hypervolume();
+    // Constructor from reference point.
+    explicit incremental_hypervolume(const vector_double &);
+    // Constructor from points and reference point.
+    explicit incremental_hypervolume(const std::vector<vector_double> &, const vector_double &);
+
+    // Copy/move ctors and assignment operators.
+    incremental_hypervolume(const incremental_hypervolume &);
+    incremental_hypervolume(incremental_hypervolume &&) noexcept;
+    incremental_hypervolume &operator=(const incremental_hypervolume &);
+    incremental_hypervolume &operator=(incremental_hypervolume &&) noexcept;
+    ~incremental_hypervolume();
+
+    // Insert a point.
+    void insert(const vector_double &);
+    // Remove a point.
+    void erase(size_type);
+
+    // Number of points.
+    size_type size() const;
+    // Get the points.
+    const std::vector<vector_double> &get_points() const;
+    // Get the reference point.
+    const vector_double &get_refpoint() const;
+
+    // Hypervolume of the set.
+    double compute() const;
+    // Exclusive contribution of a point.
+    double exclusive(size_type) const;
+    // Exclusive contributions of all the points.
+    std::vector<double> contributions() const;
+    // Index of the least contributor.
+    size_type least_contributor() const;
+    // Index of the greatest contributor.
+    size_type greatest_contributor() const;
+
+private:
+    // Object serialization
+    friend class boost::serialization::access;
+    template <typename Archive>
+    void save(Archive &ar, unsigned) const
+    {
+        detail::to_archive(ar, m_ref, m_points);
+    }
+    template <typename Archive>
+    void load(Archive &ar, unsigned)
+    {
+        vector_double ref;
+        std::vector<vector_double> points;
+        detail::from_archive(ar, ref, points);
+        *this = incremental_hypervolume(points, ref);
+    }
+    BOOST_SERIALIZATION_SPLIT_MEMBER()
+
+    // The key of a 2-dimensional point.
+    using key2d_t = std::pair<double, double>;
+
+    PAGMO_DLL_LOCAL void check_point(const vector_double &) const;
+    PAGMO_DLL_LOCAL void check_index(size_type) const;
+    PAGMO_DLL_LOCAL void set_contrib(size_type, double);
+    PAGMO_DLL_LOCAL void refresh_2d(const key2d_t &);
+    PAGMO_DLL_LOCAL void insert_2d(size_type);
+    PAGMO_DLL_LOCAL void erase_2d(const key2d_t &);
+    PAGMO_DLL_LOCAL void update_3d() const;
+
+    // The reference point.
+    vector_double m_ref;
+    // The points.
+    std::vector<vector_double> m_points;
+    // The exclusive contributions of the points.
+    // NOTE: in the 3-dimensional case, these are computed lazily.
+    mutable std::vector<double> m_contrib;
+
+    // 2-dimensional case.
+    // All the points, ordered lexicographically, mapped to their indices.
+    std::multimap<key2d_t, size_type> m_all;
+    // Iterators into m_all, one per point.
+    std::vector<std::multimap<key2d_t, size_type>::iterator> m_all_its;
+    // The non-dominated front (without duplicates),
+    // ordered by increasing first coordinate.
+    std::set<key2d_t> m_front;
+    // The points ordered by (contribution, index).
+    std::set<std::pair<double, size_type>> m_order;
+
+    // 3-dimensional case.
+    // Flag signalling that the hypervolume and the contributions
+    // need to be recomputed.
+    mutable bool m_dirty = false;
+    // The hypervolume.
+    mutable double m_hv3d = 0.;
+};
+
+} // namespace pagmo
+
+#endif
@@ -36,6 +36,7 @@ see https://www.gnu.org/licenses/. */
 #include <stdexcept>
 #include <string>
 #include <tuple>
+#include <utility>
 #include <vector>
 
 #include <boost/numeric/conversion/cast.hpp>
@@ -71,6 +72,12 @@ using fnds_return_type = std::tuple<std::vector<std::vector<pop_size_t>>, std::v
 // Fast non dominated sorting
 PAGMO_DLL_PUBLIC fnds_return_type fast_non_dominated_sorting(const std::vector<vector_double> &);
 
+/// Return type for the fast_non_dominated_fronts algorithm
+using fndf_return_type = std::pair<std::vector<std::vector<pop_size_t>>, std::vector<pop_size_t>>;
+
+// Fast non dominated fronts
+PAGMO_DLL_PUBLIC fndf_return_type fast_non_dominated_fronts(const std::vector<vector_double> &);
+
 // Crowding distance
 PAGMO_DLL_PUBLIC vector_double crowding_distance(const std::vector<vector_double> &);
 
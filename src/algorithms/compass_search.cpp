@@ -32,6 +32,7 @@ see https://www.gnu.org/licenses/. */
 #include <stdexcept>
 #include <string>
 #include <utility>
+#include <vector>
 
 #include <pagmo/algorithm.hpp>
 #include <pagmo/algorithms/compass_search.hpp>
@@ -120,21 +121,31 @@ population compass_search::evolve(population pop) const
 
     double newrange = m_start_range;
 
-    while (newrange > m_stop_range && fevals <= m_max_fevals) {
+    // The component changed by each move, for the incremental fitness evaluation
+    std::vector<vector_double::size_type> changed(1u);
+    // If the moves are evaluated incrementally, one fitness evaluation of the budget
+    // is reserved to recompute from scratch the fitness of the final best point
+    const bool incremental = prob.has_incremental_fitness();
+    const unsigned reserved = incremental ? 1u : 0u;
+    bool moved = false;
+
+    while (newrange > m_stop_range && fevals + reserved <= m_max_fevals) {
         flag = false;
         for (decltype(dim) i = 0u; i < dim; i++) {
             auto x_trial = cur_best_x;
+            changed[0] = i;
             // move up
             x_trial[i] = cur_best_x[i] + newrange * (ub[i] - lb[i]);
             // feasibility correction
             if (x_trial[i] > ub[i]) x_trial[i] = ub[i];
             // objective function evaluation
-            auto f_trial = prob.fitness(x_trial);
+            auto f_trial = prob.incremental_fitness(x_trial, cur_best_x, cur_best_f, changed);
             fevals++;
             if (compare_fc(f_trial, cur_best_f, prob.get_nec(), prob.get_c_tol())) {
                 cur_best_f = f_trial;
                 cur_best_x = x_trial;
                 flag = true;
+                moved = true;
                 break; // accept
             }
 
@@ -143,12 +154,13 @@ population compass_search::evolve(population pop) const
             // feasibility correction
             if (x_trial[i] < lb[i]) x_trial[i] = lb[i];
             // objective function evaluation
-            f_trial = prob.fitness(x_trial);
+            f_trial = prob.incremental_fitness(x_trial, cur_best_x, cur_best_f, changed);
             fevals++;
             if (compare_fc(f_trial, cur_best_f, prob.get_nec(), prob.get_c_tol())) {
                 cur_best_f = f_trial;
                 cur_best_x = x_trial;
                 flag = true;
+                moved = true;
                 break; // accept
             }
         }
@@ -180,6 +192,12 @@ population compass_search::evolve(population pop) const
         }
     } // end while
 
+    // Prevent the accumulation of rounding errors in the incremental fitness evaluations
+    if (incremental && moved) {
+        cur_best_f = prob.fitness(cur_best_x);
+        fevals++;
+    }
+
     if (m_verbosity) {
         if (newrange <= m_stop_range) {
             std::cout << "Exit condition -- range: " << newrange << " <= " << m_stop_range << "\n";
@@ -26,7 +26,9 @@ You should have received copies of the GNU General Public License and the
 GNU Lesser General Public License along with the PaGMO library.  If not,
 see https://www.gnu.org/licenses/. */
 
+#include <algorithm>
 #include <cmath>
+#include <cstddef>
 #include <iomanip>
 #include <iostream>
 #include <numeric>
@@ -38,6 +40,8 @@ see https://www.gnu.org/licenses/. */
 
 #include <pagmo/algorithm.hpp>
 #include <pagmo/algorithms/de.hpp>
+#include <pagmo/bfe.hpp>
+#include <pagmo/detail/de_trial.hpp>
 #include <pagmo/exceptions.hpp>
 #include <pagmo/io.hpp>
 #include <pagmo/population.hpp>
@@ -45,6 +49,10 @@ see https://www.gnu.org/licenses/. */
 #include <pagmo/types.hpp>
 #include <pagmo/utils/generic.hpp>
 
+// NOTE: apparently this must be included *after*
+// the other serialization headers.
+#include <boost/serialization/optional.hpp>
+
 namespace pagmo
 {
 
@@ -116,10 +124,7 @@ population de::evolve(population pop) const
     m_log.clear();
 
     // Some vectors used during evolution are declared.
-    vector_double tmp(dim);                              // contains the mutated candidate
-    std::uniform_real_distribution<double> drng(0., 1.); // to generate a number in [0, 1)
-    std::uniform_int_distribution<vector_double::size_type> c_idx(
-        0u, dim - 1u); // to generate a random index for the chromosome
+    vector_double tmp(dim); // contains the mutated candidate
 
     // We extract from pop the chromosomes and fitness associated
     auto popold = pop.get_x();
@@ -135,6 +140,27 @@ population de::evolve(population pop) const
     auto gbIter = gbX;
     std::vector<vector_double::size_type> r(5); // indexes of 5 selected population members
 
+    // Selection between the trial vector in tmp[] and the i-th individual.
+    auto select_trial = [&](population::size_type i, const vector_double &newfitness) {
+        if (newfitness[0] <= fit[i][0]) { /* improved objective function value ? */
+            fit[i] = newfitness;
+            popnew[i] = tmp;
+            // updates the individual in pop (avoiding to recompute the objective function)
+            pop.set_xf(i, popnew[i], newfitness);
+
+            if (newfitness[0] <= gbfit[0]) {
+                /* if so...*/
+                gbfit = newfitness; /* reset gbfit to new low...*/
+                gbX = popnew[i];
+            }
+        } else {
+            popnew[i] = popold[i];
+        }
+    };
+    // If a bfe is available, the trial vectors of each generation are stored
+    // here and evaluated all at once at the end of the generation.
+    vector_double batch_dvs(m_bfe ? NP * dim : 0u);
+
     // Main DE iterations
     for (decltype(m_gen) gen = 1u; gen <= m_gen; ++gen) {
         // Start of the loop through the population
@@ -148,152 +174,31 @@ population de::evolve(population pop) const
                 std::swap(idxs[idx], idxs[NP - 1u - j]);
             }
 
-            /*-------DE/best/1/exp--------------------------------------------------------------------*/
-            /*-------The oldest DE variant but still not bad. However, we have found several---------*/
-            /*-------optimization problems where misconvergence occurs.-------------------------------*/
-            if (m_variant == 1u) {
-                tmp = popold[i];
-                auto n = c_idx(m_e);
-                auto L = 0u;
-                do {
-                    tmp[n] = gbIter[n] + m_F * (popold[r[1]][n] - popold[r[2]][n]);
-                    n = (n + 1u) % dim;
-                    ++L;
-                } while ((drng(m_e) < m_CR) && (L < dim));
-            }
-
-            /*-------DE/rand/1/exp-------------------------------------------------------------------*/
-            /*-------This is one of my favourite strategies. It works especially well when the-------*/
-            /*-------"gbIter[]"-schemes experience misconvergence. Try e.g. m_F=0.7 and m_CR=0.5---------*/
-            /*-------as a first guess.---------------------------------------------------------------*/
-            else if (m_variant == 2u) {
-                tmp = popold[i];
-                auto n = c_idx(m_e);
-                decltype(dim) L = 0u;
-                do {
-                    tmp[n] = popold[r[0]][n] + m_F * (popold[r[1]][n] - popold[r[2]][n]);
-                    n = (n + 1u) % dim;
-                    ++L;
-                } while ((drng(m_e) < m_CR) && (L < dim));
-            }
-            /*-------DE/rand-to-best/1/exp-----------------------------------------------------------*/
-            /*-------This variant seems to be one of the best strategies. Try m_F=0.85 and m_CR=1.------*/
-            /*-------If you get misconvergence try to increase NP. If this doesn't help you----------*/
-            /*-------should play around with all three control variables.----------------------------*/
-            else if (m_variant == 3u) {
-                tmp = popold[i];
-                auto n = c_idx(m_e);
-                auto L = 0u;
-                do {
-                    tmp[n] = tmp[n] + m_F * (gbIter[n] - tmp[n]) + m_F * (popold[r[0]][n] - popold[r[1]][n]);
-                    n = (n + 1u) % dim;
-                    ++L;
-                } while ((drng(m_e) < m_CR) && (L < dim));
-            }
-            /*-------DE/best/2/exp is another powerful variant worth trying--------------------------*/
-            else if (m_variant == 4u) {
-                tmp = popold[i];
-                auto n = c_idx(m_e);
-                auto L = 0u;
-                do {
-                    tmp[n] = gbIter[n] + (popold[r[0]][n] + popold[r[1]][n] - popold[r[2]][n] - popold[r[3]][n]) * m_F;
-                    n = (n + 1u) % dim;
-                    ++L;
-                } while ((drng(m_e) < m_CR) && (L < dim));
-            }
-            /*-------DE/rand/2/exp seems to be a robust optimizer for many functions-------------------*/
-            else if (m_variant == 5u) {
-                tmp = popold[i];
-                auto n = c_idx(m_e);
-                auto L = 0u;
-                do {
-                    tmp[n] = popold[r[4]][n]
-                             + (popold[r[0]][n] + popold[r[1]][n] - popold[r[2]][n] - popold[r[3]][n]) * m_F;
-                    n = (n + 1u) % dim;
-                    ++L;
-                } while ((drng(m_e) < m_CR) && (L < dim));
-            }
-
-            /*=======Essentially same strategies but BINOMIAL CROSSOVER===============================*/
-            /*-------DE/best/1/bin--------------------------------------------------------------------*/
-            else if (m_variant == 6u) {
-                tmp = popold[i];
-                auto n = c_idx(m_e);
-                for (decltype(dim) L = 0u; L < dim; ++L) {     /* perform Dc binomial trials */
-                    if ((drng(m_e) < m_CR) || L + 1u == dim) { /* change at least one parameter */
-                        tmp[n] = gbIter[n] + m_F * (popold[r[1]][n] - popold[r[2]][n]);
-                    }
-                    n = (n + 1u) % dim;
-                }
-            }
-            /*-------DE/rand/1/bin-------------------------------------------------------------------*/
-            else if (m_variant == 7u) {
-                tmp = popold[i];
-                auto n = c_idx(m_e);
-                for (decltype(dim) L = 0u; L < dim; ++L) {     /* perform Dc binomial trials */
-                    if ((drng(m_e) < m_CR) || L + 1u == dim) { /* change at least one parameter */
-                        tmp[n] = popold[r[0]][n] + m_F * (popold[r[1]][n] - popold[r[2]][n]);
-                    }
-                    n = (n + 1u) % dim;
-                }
-            }
-            /*-------DE/rand-to-best/1/bin-----------------------------------------------------------*/
-            else if (m_variant == 8u) {
-                tmp = popold[i];
-                auto n = c_idx(m_e);
-                for (decltype(dim) L = 0u; L < dim; ++L) {     /* perform Dc binomial trials */
-                    if ((drng(m_e) < m_CR) || L + 1u == dim) { /* change at least one parameter */
-                        tmp[n] = tmp[n] + m_F * (gbIter[n] - tmp[n]) + m_F * (popold[r[0]][n] - popold[r[1]][n]);
-                    }
-                    n = (n + 1u) % dim;
-                }
-            }
-            /*-------DE/best/2/bin--------------------------------------------------------------------*/
-            else if (m_variant == 9u) {
-                tmp = popold[i];
-                auto n = c_idx(m_e);
-                for (decltype(dim) L = 0u; L < dim; ++L) {     /* perform Dc binomial trials */
-                    if ((drng(m_e) < m_CR) || L + 1u == dim) { /* change at least one parameter */
-                        tmp[n]
-                            = gbIter[n] + (popold[r[0]][n] + popold[r[1]][n] - popold[r[2]][n] - popold[r[3]][n]) * m_F;
-                    }
-                    n = (n + 1u) % dim;
-                }
-            }
-            /*-------DE/rand/2/bin--------------------------------------------------------------------*/
-            else if (m_variant == 10u) {
-                tmp = popold[i];
-                auto n = c_idx(m_e);
-                for (decltype(dim) L = 0u; L < dim; ++L) {     /* perform Dc binomial trials */
-                    if ((drng(m_e) < m_CR) || L + 1u == dim) { /* change at least one parameter */
-                        tmp[n] = popold[r[4]][n]
-                                 + (popold[r[0]][n] + popold[r[1]][n] - popold[r[2]][n] - popold[r[3]][n]) * m_F;
-                    }
-                    n = (n + 1u) % dim;
-                }
-            }
+            detail::de_make_trial(tmp, m_variant, m_F, m_CR, popold, i, r, gbIter, m_e);
 
             // Trial mutation now in tmp. force feasibility and see how good this choice really was.
             // a) feasibility
             // detail::force_bounds_reflection(tmp, lb, ub); // TODO: check if this choice is better
             detail::force_bounds_random(tmp, lb, ub, m_e);
             // b) how good?
-            auto newfitness = prob.fitness(tmp); /* Evaluates tmp[] */
-            if (newfitness[0] <= fit[i][0]) {    /* improved objective function value ? */
-                fit[i] = newfitness;
-                popnew[i] = tmp;
-                // updates the individual in pop (avoiding to recompute the objective function)
-                pop.set_xf(i, popnew[i], newfitness);
-
-                if (newfitness[0] <= gbfit[0]) {
-                    /* if so...*/
-                    gbfit = newfitness; /* reset gbfit to new low...*/
-                    gbX = popnew[i];
-                }
+            if (m_bfe) {
+                // bfe is available: the evaluation is deferred to the end of the generation.
+                std::copy(tmp.begin(), tmp.end(), batch_dvs.begin() + static_cast<std::ptrdiff_t>(i * dim));
             } else {
-                popnew[i] = popold[i];
+                select_trial(i, prob.fitness(tmp)); /* Evaluates tmp[] */
             }
         } // End of one generation
+        if (m_bfe) {
+            // Evaluate all the trial vectors of the generation with the bfe.
+            // NOTE: the trial vectors are built only from the individuals of the previous
+            // generation, thus the outcome is the same as in the non-batch mode.
+            const auto batch_fvs = (*m_bfe)(pop.get_problem(), batch_dvs);
+            for (decltype(NP) i = 0u; i < NP; ++i) {
+                std::copy(batch_dvs.begin() + static_cast<std::ptrdiff_t>(i * dim),
+                          batch_dvs.begin() + static_cast<std::ptrdiff_t>((i + 1u) * dim), tmp.begin());
+                select_trial(i, {batch_fvs[i]});
+            }
+        }
         /* Save best population member of current iteration */
         gbIter = gbX;
         /* swap population arrays. New generation becomes old one */
@@ -363,6 +268,15 @@ void de::set_seed(unsigned seed)
     m_seed = seed;
 }
 
+/// Sets the batch function evaluation scheme
+/**
+ * @param b batch function evaluation object
+ */
+void de::set_bfe(const bfe &b)
+{
+    m_bfe = b;
+}
+
 /// Extra info
 /**
  * One of the optional methods of any user-defined algorithm (UDA).
@@ -379,9 +293,16 @@ std::string de::get_extra_info() const
 
 // Object serialization
 template <typename Archive>
-void de::serialize(Archive &ar, unsigned)
+void de::serialize(Archive &ar, unsigned version)
 {
     detail::archive(ar, m_gen, m_F, m_CR, m_variant, m_Ftol, m_xtol, m_e, m_seed, m_verbosity, m_log);
+    if (version > 0u) {
+        detail::archive(ar, m_bfe);
+    } else {
+        // NOTE: this can be reached only when loading an archive
+        // from a previous version.
+        m_bfe.reset();
+    }
 }
 
 } // namespace pagmo
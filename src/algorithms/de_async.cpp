@@ -0,0 +1,305 @@
+/* Copyright 2017-2021 PaGMO development team
+
+This file is part of the PaGMO library.
+
+The PaGMO library is free software; you can redistribute it and/or modify
+it under the terms of either:
+
+  * the GNU Lesser General Public License as published by the Free
+    Software Foundation; either version 3 of the License, or (at your
+    option) any later version.
+
+or
+
+  * the GNU General Public License as published by the Free Software
+    Foundation; either version 3 of the License, or (at your option) any
+    later version.
+
+or both in parallel, as here.
+
+The PaGMO library is distributed in the hope that it will be useful, but
+WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+for more details.
+
+You should have received copies of the GNU General Public License and the
+GNU Lesser General Public License along with the PaGMO library.  If not,
+see https://www.gnu.org/licenses/. */
+
+#include <cassert>
+#include <cmath>
+#include <iomanip>
+#include <iostream>
+#include <numeric>
+#include <random>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <tuple>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include <pagmo/algorithm.hpp>
+#include <pagmo/algorithms/de_async.hpp>
+#include <pagmo/async_evaluator.hpp>
+#include <pagmo/detail/de_trial.hpp>
+#include <pagmo/exceptions.hpp>
+#include <pagmo/io.hpp>
+#include <pagmo/population.hpp>
+#include <pagmo/s11n.hpp>
+#include <pagmo/threading.hpp>
+#include <pagmo/types.hpp>
+#include <pagmo/utils/generic.hpp>
+
+namespace pagmo
+{
+
+de_async::de_async(unsigned gen, double F, double CR, unsigned variant, double ftol, double xtol, unsigned n_workers,
+                   unsigned seed)
+    : m_gen(gen), m_F(F), m_CR(CR), m_variant(variant), m_Ftol(ftol), m_xtol(xtol), m_n_workers(n_workers), m_e(seed),
+      m_seed(seed), m_verbosity(0u), m_log()
+{
+    if (variant < 1u || variant > 10u) {
+        pagmo_throw(std::invalid_argument,
+                    "The Differential Evolution variant must be in [1, .., 10], while a value of "
+                        + std::to_string(variant) + " was detected.");
+    }
+    if (CR < 0. || F < 0. || CR > 1. || F > 1.) {
+        pagmo_throw(std::invalid_argument, "The F and CR parameters must be in the [0,1] range");
+    }
+}
+
+/// Algorithm evolve method
+/**
+ * Evolves the population for a maximum number of generations, until one of
+ * tolerances set on the population flatness (x_tol, f_tol) are met.
+ *
+ * @param pop population to be evolved
+ * @return evolved population
+ * @throws std::invalid_argument if the problem is multi-objective or constrained or stochastic
+ * @throws std::invalid_argument if the problem does not provide at least the basic thread safety level
+ * @throws std::invalid_argument if the population size is not at least 5
+ * @throws unspecified any exception thrown by the fitness evaluations
+ */
+population de_async::evolve(population pop) const
+{
+    // We store some useful variables
+    const auto &prob = pop.get_problem();
+    auto dim = prob.get_nx();
+    const auto bounds = prob.get_bounds();
+    const auto &lb = bounds.first;
+    const auto &ub = bounds.second;
+    auto NP = pop.size();
+    auto fevals0 = prob.get_fevals(); // discount for the already made fevals
+    unsigned count = 1u;              // regulates the screen output
+
+    // PREAMBLE-------------------------------------------------------------------------------------------------
+    // We start by checking that the problem is suitable for this
+    // particular algorithm.
+    if (prob.get_nc() != 0u) {
+        pagmo_throw(std::invalid_argument, "Non linear constraints detected in " + prob.get_name() + " instance. "
+                                               + get_name() + " cannot deal with them");
+    }
+    if (prob.get_nf() != 1u) {
+        pagmo_throw(std::invalid_argument, "Multiple objectives detected in " + prob.get_name() + " instance. "
+                                               + get_name() + " cannot deal with them");
+    }
+    if (prob.is_stochastic()) {
+        pagmo_throw(std::invalid_argument,
+                    "The problem appears to be stochastic " + get_name() + " cannot deal with it");
+    }
+    if (prob.get_thread_safety() < thread_safety::basic) {
+        pagmo_throw(std::invalid_argument, "The problem " + prob.get_name()
+                                               + " does not provide the basic thread safety level required by "
+                                               + get_name());
+    }
+    // Get out if there is nothing to do.
+    if (m_gen == 0u) {
+        return pop;
+    }
+    if (pop.size() < 5u) {
+        pagmo_throw(std::invalid_argument, get_name() + " needs at least 5 individuals in the population, "
+                                               + std::to_string(pop.size()) + " detected");
+    }
+    // ---------------------------------------------------------------------------------------------------------
+
+    // No throws, all valid: we clear the logs
+    m_log.clear();
+
+    // The current decision vectors of the population. These are kept
+    // in sync with pop, and they are used to build the trial vectors.
+    auto popx = pop.get_x();
+
+    // The current best individual.
+    auto best_idx = pop.best_idx();
+    vector_double::size_type worst_idx = 0u;
+    auto gbX = popx[best_idx];
+    auto gbfit = pop.get_f()[best_idx];
+
+    vector_double tmp(dim);                     // contains the mutated candidate
+    std::vector<vector_double::size_type> r(5); // indexes of 5 selected population members
+    std::vector<vector_double::size_type> idxs(NP);
+
+    // Build the trial vector for the i-th individual into tmp.
+    auto make_trial = [&](population::size_type i) {
+        /*-----We select at random 5 indexes from the population---------------------------------*/
+        std::iota(idxs.begin(), idxs.end(), vector_double::size_type(0u));
+        for (auto j = 0u; j < 5u; ++j) { // Durstenfeld's algorithm to select 5 indexes at random
+            auto idx = std::uniform_int_distribution<vector_double::size_type>(0u, NP - 1u - j)(m_e);
+            r[j] = idxs[idx];
+            std::swap(idxs[idx], idxs[NP - 1u - j]);
+        }
+        detail::de_make_trial(tmp, m_variant, m_F, m_CR, popx, i, r, gbX, m_e);
+        detail::force_bounds_random(tmp, lb, ub, m_e);
+    };
+
+    // The total number of evaluations.
+    const auto n_evals = static_cast<unsigned long long>(m_gen) * NP;
+    unsigned long long n_submitted = 0, n_completed = 0;
+    // The index of the next target individual.
+    population::size_type next_target = 0;
+    // The target individuals of the pending evaluations.
+    std::unordered_map<async_evaluator::ticket_type, population::size_type> targets;
+
+    async_evaluator ev(prob, m_n_workers);
+
+    // Build and submit a new trial vector.
+    auto submit_trial = [&]() {
+        make_trial(next_target);
+        targets.emplace(ev.submit(tmp), next_target);
+        next_target = (next_target + 1u) % NP;
+        ++n_submitted;
+    };
+
+    // Fill up the workers.
+    while (n_submitted < n_evals && n_submitted < ev.get_n_workers()) {
+        submit_trial();
+    }
+
+    // Main loop.
+    while (n_completed < n_evals) {
+        auto [ticket, dv, fv] = ev.retrieve();
+        ++n_completed;
+        pop.get_problem().increment_fevals(1);
+
+        const auto it = targets.find(ticket);
+        assert(it != targets.end());
+        const auto i = it->second;
+        targets.erase(it);
+
+        if (fv[0] <= pop.get_f()[i][0]) { /* improved objective function value ? */
+            popx[i] = dv;
+            // updates the individual in pop (avoiding to recompute the objective function)
+            pop.set_xf(i, std::move(dv), fv);
+
+            if (fv[0] <= gbfit[0]) {
+                /* if so...*/
+                gbfit = fv; /* reset gbfit to new low...*/
+                gbX = popx[i];
+            }
+        }
+
+        // Replace the completed evaluation with a new one.
+        if (n_submitted < n_evals) {
+            submit_trial();
+        }
+
+        if (n_completed % NP != 0u) {
+            continue;
+        }
+
+        // End of a generation.
+        const auto gen = static_cast<unsigned>(n_completed / NP);
+
+        // Check the exit conditions
+        double dx = 0., df = 0.;
+        best_idx = pop.best_idx();
+        worst_idx = pop.worst_idx();
+        for (decltype(dim) j = 0u; j < dim; ++j) {
+            dx += std::abs(pop.get_x()[worst_idx][j] - pop.get_x()[best_idx][j]);
+        }
+        if (dx < m_xtol) {
+            if (m_verbosity > 0u) {
+                std::cout << "Exit condition -- xtol < " << m_xtol << '\n';
+            }
+            return pop;
+        }
+
+        df = std::abs(pop.get_f()[worst_idx][0] - pop.get_f()[best_idx][0]);
+        if (df < m_Ftol) {
+            if (m_verbosity > 0u) {
+                std::cout << "Exit condition -- ftol < " << m_Ftol << '\n';
+            }
+            return pop;
+        }
+
+        // Logs and prints (verbosity modes > 1: a line is added every m_verbosity generations)
+        if (m_verbosity > 0u) {
+            // Every m_verbosity generations print a log line
+            if (gen % m_verbosity == 1u || m_verbosity == 1u) {
+                // Every 50 lines print the column names
+                if (count % 50u == 1u) {
+                    print("\n", std::setw(7), "Gen:", std::setw(15), "Fevals:", std::setw(15), "Best:", std::setw(15),
+                          "dx:", std::setw(15), "df:", '\n');
+                }
+                print(std::setw(7), gen, std::setw(15), prob.get_fevals() - fevals0, std::setw(15),
+                      pop.get_f()[best_idx][0], std::setw(15), dx, std::setw(15), df, '\n');
+                ++count;
+                // Logs
+                m_log.emplace_back(gen, prob.get_fevals() - fevals0, pop.get_f()[best_idx][0], dx, df);
+            }
+        }
+    }
+    if (m_verbosity) {
+        std::cout << "Exit condition -- generations = " << m_gen << '\n';
+    }
+    return pop;
+}
+
+/// Sets the seed
+/**
+ * @param seed the seed controlling the algorithm stochastic behaviour
+ */
+void de_async::set_seed(unsigned seed)
+{
+    m_e.seed(seed);
+    m_seed = seed;
+}
+
+/// Extra info
+/**
+ * One of the optional methods of any user-defined algorithm (UDA).
+ *
+ * @return a string containing extra info on the algorithm
+ */
+std::string de_async::get_extra_info() const
+{
+    std::ostringstream ss;
+    stream(ss, "\tGenerations: ", m_gen);
+    stream(ss, "\n\tParameter F: ", m_F);
+    stream(ss, "\n\tParameter CR: ", m_CR);
+    stream(ss, "\n\tVariant: ", m_variant);
+    stream(ss, "\n\tStopping xtol: ", m_xtol);
+    stream(ss, "\n\tStopping ftol: ", m_Ftol);
+    stream(ss, "\n\tWorkers: ");
+    if (m_n_workers == 0u) {
+        stream(ss, "auto");
+    } else {
+        stream(ss, m_n_workers);
+    }
+    stream(ss, "\n\tVerbosity: ", m_verbosity);
+    stream(ss, "\n\tSeed: ", m_seed);
+    return ss.str();
+}
+
+// Object serialization
+template <typename Archive>
+void de_async::serialize(Archive &ar, unsigned)
+{
+    detail::archive(ar, m_gen, m_F, m_CR, m_variant, m_Ftol, m_xtol, m_n_workers, m_e, m_seed, m_verbosity, m_log);
+}
+
+} // namespace pagmo
+
+PAGMO_S11N_ALGORITHM_IMPLEMENT(pagmo::de_async)
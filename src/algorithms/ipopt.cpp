@@ -327,17 +327,56 @@ struct ipopt_nlp final : Ipopt::TNLP {
         }
     }
 
+    // Invalidate the cached fitness and gradient.
+    void invalidate_cache()
+    {
+        m_fitness_cached = false;
+        m_gradient_cached = false;
+    }
+
+    // Fetch the fitness for x, reusing the cached value if possible.
+    // NOTE: the new_x boolean flag will be false if the last call to any of the eval_* functions
+    // used the same x value. Since in pagmo objective and constraints are computed together
+    // by fitness() (and their gradients by gradient()), we can avoid recomputing them
+    // when Ipopt asks separately for the objective and the constraints at the same point.
+    const vector_double &get_fitness(Index n, const Number *x, bool new_x)
+    {
+        if (new_x) {
+            invalidate_cache();
+        }
+        if (m_fitness_cached) {
+            ++m_fitness_reuse_counter;
+        } else {
+            std::copy(x, x + n, m_dv.begin());
+            m_fitness = m_prob.fitness(m_dv);
+            m_fitness_cached = true;
+        }
+        return m_fitness;
+    }
+
+    // Fetch the gradient for x, reusing the cached value if possible.
+    const vector_double &get_gradient(Index n, const Number *x, bool new_x)
+    {
+        if (new_x) {
+            invalidate_cache();
+        }
+        if (m_gradient_cached) {
+            ++m_gradient_reuse_counter;
+        } else {
+            std::copy(x, x + n, m_dv.begin());
+            m_gradient = m_prob.gradient(m_dv);
+            m_gradient_cached = true;
+        }
+        return m_gradient;
+    }
+
     // Method to return the objective value.
     bool eval_f(Index n, const Number *x, bool new_x, Number &obj_value) final
     {
         try {
             assert(n == boost::numeric_cast<Index>(m_prob.get_nx()));
-            // NOTE: the new_x boolean flag will be false if the last call to any of the eval_* function
-            // used the same x value. Probably we can ignore this in favour of the upcoming caches work.
-            (void)new_x;
 
-            std::copy(x, x + n, m_dv.begin());
-            const auto fitness = m_prob.fitness(m_dv);
+            const auto &fitness = get_fitness(n, x, new_x);
             obj_value = fitness[0];
 
             // Update the log if requested.
@@ -383,11 +422,9 @@ struct ipopt_nlp final : Ipopt::TNLP {
     {
         try {
             assert(n == boost::numeric_cast<Index>(m_prob.get_nx()));
-            (void)new_x;
 
-            std::copy(x, x + n, m_dv.begin());
             // Compute the full gradient (this includes the constraints as well).
-            const auto gradient = m_prob.gradient(m_dv);
+            const auto &gradient = get_gradient(n, x, new_x);
 
             if (m_prob.has_gradient_sparsity()) {
                 // Sparse gradient case.
@@ -420,10 +457,8 @@ struct ipopt_nlp final : Ipopt::TNLP {
         try {
             assert(n == boost::numeric_cast<Index>(m_prob.get_nx()));
             assert(m == boost::numeric_cast<Index>(m_prob.get_nc()));
-            (void)new_x;
 
-            std::copy(x, x + n, m_dv.begin());
-            const auto fitness = m_prob.fitness(m_dv);
+            const auto &fitness = get_fitness(n, x, new_x);
 
             // Eq. constraints.
             std::copy(fitness.data() + 1, fitness.data() + 1 + m_prob.get_nec(), g);
@@ -448,17 +483,19 @@ struct ipopt_nlp final : Ipopt::TNLP {
             assert(n == boost::numeric_cast<Index>(m_prob.get_nx()));
             assert(m == boost::numeric_cast<Index>(m_prob.get_nc()));
             assert(nele_jac == boost::numeric_cast<Index>(m_jac_sp.size()));
-            (void)new_x;
 
             if (values) {
-                std::copy(x, x + n, m_dv.begin());
-                const auto gradient = m_prob.gradient(m_dv);
+                const auto &gradient = get_gradient(n, x, new_x);
                 // NOTE: here we need the gradients of the constraints only, so we need to discard the gradient of the
                 // objfun. If the gradient sparsity is user-provided, then the size of the objfun sparse gradient is
                 // m_obj_g_sp.size(), otherwise the gradient is dense and its size is nx.
                 std::copy(gradient.data() + (m_prob.has_gradient_sparsity() ? m_obj_g_sp.size() : m_prob.get_nx()),
                           gradient.data() + gradient.size(), values);
             } else {
+                if (new_x) {
+                    // Keep the cached fitness and gradient in sync with x.
+                    invalidate_cache();
+                }
                 for (decltype(m_jac_sp.size()) k = 0; k < m_jac_sp.size(); ++k) {
                     iRow[k] = m_jac_sp[k].first;
                     jCol[k] = m_jac_sp[k].second;
@@ -482,9 +519,13 @@ struct ipopt_nlp final : Ipopt::TNLP {
             assert(n == boost::numeric_cast<Index>(m_prob.get_nx()));
             assert(m == boost::numeric_cast<Index>(m_prob.get_nc()));
             assert(nele_hess == boost::numeric_cast<Index>(m_lag_sp.size()));
-            (void)new_x;
             (void)new_lambda;
 
+            if (new_x) {
+                // Keep the cached fitness and gradient in sync with x.
+                invalidate_cache();
+            }
+
             if (!m_prob.has_hessians()) {
                 pagmo_throw(
                     std::invalid_argument,
@@ -635,6 +676,16 @@ struct ipopt_nlp final : Ipopt::TNLP {
     const unsigned m_verbosity;
     // Objfun counter.
     unsigned long m_objfun_counter = 0;
+    // Fitness and gradient of the last evaluated x, with
+    // flags signalling if they are valid.
+    vector_double m_fitness;
+    vector_double m_gradient;
+    bool m_fitness_cached = false;
+    bool m_gradient_cached = false;
+    // Counters for the fitness and gradient evaluations
+    // served from the cache.
+    unsigned long m_fitness_reuse_counter = 0;
+    unsigned long m_gradient_reuse_counter = 0;
     // Log.
     log_type m_log;
     // This exception pointer will be null, unless an error is raised in one of the virtual methods. If not null, it
@@ -756,6 +807,32 @@ unsigned ipopt_internal_test()
     ret += ipopt_test_check(std::abs(jac_g[6] - (-x[0] * x[1] * x[3])) < 1E-8);
     ret += ipopt_test_check(std::abs(jac_g[7] - (-x[0] * x[1] * x[2])) < 1E-8);
 
+    // Reuse of the fitness and gradient at the same x.
+    ret += ipopt_test_check_equal(nlp.m_fitness_reuse_counter, 0ul);
+    ret += ipopt_test_check_equal(nlp.m_gradient_reuse_counter, 0ul);
+    nlp.eval_f(4, x.data(), true, objval);
+    std::fill(g.begin(), g.end(), 0.);
+    nlp.eval_g(4, x.data(), false, 2, g.data());
+    ret += ipopt_test_check(std::abs(g[0] - (x[0] * x[0] + x[1] * x[1] + x[2] * x[2] + x[3] * x[3] - 40.)) < 1E-8);
+    ret += ipopt_test_check(std::abs(g[1] - (25. - x[0] * x[1] * x[2] * x[3])) < 1E-8);
+    ret += ipopt_test_check_equal(nlp.m_fitness_reuse_counter, 1ul);
+    nlp.eval_grad_f(4, x.data(), false, grad_f.data());
+    std::fill(jac_g.begin(), jac_g.end(), 0.);
+    nlp.eval_jac_g(4, x.data(), false, 2, 8, iRow.data(), jCol.data(), jac_g.data());
+    ret += ipopt_test_check(std::abs(jac_g[0] - (2 * x[0])) < 1E-8);
+    ret += ipopt_test_check(std::abs(jac_g[7] - (-x[0] * x[1] * x[2])) < 1E-8);
+    ret += ipopt_test_check_equal(nlp.m_gradient_reuse_counter, 1ul);
+    // A new x invalidates the cache.
+    const vector_double x2{3.1, 3.2, 3.3, 3.4};
+    nlp.eval_g(4, x2.data(), true, 2, g.data());
+    ret += ipopt_test_check(std::abs(g[1] - (25. - x2[0] * x2[1] * x2[2] * x2[3])) < 1E-8);
+    ret += ipopt_test_check_equal(nlp.m_fitness_reuse_counter, 1ul);
+    // Also when signalled by a query for the structure of the Jacobian.
+    nlp.eval_jac_g(4, x.data(), true, 2, 8, iRow.data(), jCol.data(), nullptr);
+    nlp.eval_g(4, x.data(), false, 2, g.data());
+    ret += ipopt_test_check(std::abs(g[1] - (25. - x[0] * x[1] * x[2] * x[3])) < 1E-8);
+    ret += ipopt_test_check_equal(nlp.m_fitness_reuse_counter, 1ul);
+
     // eval_h().
     const vector_double lambda{2., 3.};
     vector_double h(10);
@@ -905,9 +982,14 @@ population ipopt::evolve(population pop) const
     }
     // Run the optimisation.
     m_last_opt_res = app->OptimizeTNLP(nlp);
+    // Record the reused evaluations.
+    m_last_fitness_reuses = inlp.m_fitness_reuse_counter;
+    m_last_gradient_reuses = inlp.m_gradient_reuse_counter;
     if (m_verbosity) {
         // Print to screen the result of the optimisation, if we are being verbose.
         std::cout << "\nOptimisation return status: " << detail::ipopt_results.at(m_last_opt_res) << '\n';
+        std::cout << "Reused fitness evaluations: " << m_last_fitness_reuses << '\n';
+        std::cout << "Reused gradient evaluations: " << m_last_gradient_reuses << '\n';
     }
     // Replace the log.
     m_log = std::move(inlp.m_log);
@@ -952,10 +1034,18 @@ std::string ipopt::get_extra_info() const
 
 // Serialization.
 template <typename Archive>
-void ipopt::serialize(Archive &ar, unsigned)
+void ipopt::serialize(Archive &ar, unsigned version)
 {
     detail::archive(ar, boost::serialization::base_object<not_population_based>(*this), m_string_opts, m_integer_opts,
                     m_numeric_opts, m_last_opt_res, m_verbosity, m_log);
+    if (version > 0u) {
+        detail::archive(ar, m_last_fitness_reuses, m_last_gradient_reuses);
+    } else {
+        // NOTE: this can be reached only when loading an archive
+        // from a previous version.
+        m_last_fitness_reuses = 0;
+        m_last_gradient_reuses = 0;
+    }
 }
 
 /// Set string option.
@@ -36,6 +36,7 @@ see https://www.gnu.org/licenses/. */
 #include <sstream>
 #include <stdexcept>
 #include <string>
+#include <utility>
 #include <vector>
 
 #include <boost/math/constants/constants.hpp>
@@ -173,8 +174,8 @@ population maco::evolve(population pop) const
         // I store the sol_archive fitness values together with the fitness of the current population
         //(except for the very first generation, in which they would be the same)
         if ((m_counter == 1 && m_memory == true) || (gen == 1 && m_memory == false)) {
-            auto fnds = fast_non_dominated_sorting(fit);
-            auto ndf = std::get<0>(fnds);
+            auto fnds = fast_non_dominated_fronts(fit);
+            auto ndf = std::move(fnds.first);
             vector_double::size_type i_arch = 0;
             unsigned front = 0u;
             for (const auto &front_idxs : ndf) {
@@ -320,8 +321,8 @@ population maco::evolve(population pop) const
         if ((m_counter > 1 && m_memory == true) || (gen > 1 && m_memory == false)) {
             // This returns a std::tuple containing: -the non dominated fronts, -the domination list, -the domination
             // count, -the non domination rank
-            auto fnds = fast_non_dominated_sorting(merged_fit);
-            auto ndf = std::get<0>(fnds);
+            auto fnds = fast_non_dominated_fronts(merged_fit);
+            auto ndf = std::move(fnds.first);
             // We now loop through the ndf tuple
             vector_double::size_type i_arch = 0;
             unsigned front = 0u;
@@ -40,6 +40,7 @@ see https://www.gnu.org/licenses/. */
 #include <algorithm>
 #include <cassert>
 #include <cmath>
+#include <cstring>
 #include <exception>
 #include <initializer_list>
 #include <iomanip>
@@ -338,6 +339,46 @@ struct nlopt_obj {
         }
     }
 
+    // Point the cache to x. If x differs (bitwise) from the
+    // cached decision vector, the cache is invalidated.
+    void set_cache_dv(unsigned dim, const double *x)
+    {
+        assert(m_dv.size() == dim);
+        if (std::memcmp(x, m_dv.data(), sizeof(double) * dim)) {
+            std::copy(x, x + dim, m_dv.begin());
+            m_fitness_cached = false;
+            m_gradient_cached = false;
+        }
+    }
+    // Fetch the fitness for x, reusing the last computed fitness if possible.
+    // NOTE: NLopt invokes separately the objective function and the constraints
+    // callbacks, usually at the same point. Since in pagmo objective and constraints
+    // are computed together by fitness() (and their gradients by gradient()),
+    // we cache the results for the last evaluated point.
+    const vector_double &get_fitness(unsigned dim, const double *x)
+    {
+        set_cache_dv(dim, x);
+        if (m_fitness_cached) {
+            ++m_fitness_hits;
+        } else {
+            m_fitness = m_prob.fitness(m_dv);
+            m_fitness_cached = true;
+        }
+        return m_fitness;
+    }
+    // Fetch the gradient for x, reusing the last computed gradient if possible.
+    const vector_double &get_gradient(unsigned dim, const double *x)
+    {
+        set_cache_dv(dim, x);
+        if (m_gradient_cached) {
+            ++m_gradient_hits;
+        } else {
+            m_gradient = m_prob.gradient(m_dv);
+            m_gradient_cached = true;
+        }
+        return m_gradient;
+    }
+
     // Delete all other ctors/assignment ops.
     nlopt_obj(const nlopt_obj &) = delete;
     nlopt_obj(nlopt_obj &&) = delete;
@@ -349,7 +390,18 @@ struct nlopt_obj {
     problem &m_prob;
     sparsity_pattern m_sp;
     std::unique_ptr<std::remove_pointer<::nlopt_opt>::type, void (*)(::nlopt_opt)> m_value;
+    // Temporary dv used for fitness computation. It also
+    // stores the decision vector of the cached fitness/gradient.
     vector_double m_dv;
+    // Fitness and gradient of the last evaluated dv, with
+    // flags signalling if they are valid.
+    vector_double m_fitness;
+    vector_double m_gradient;
+    bool m_fitness_cached = false;
+    bool m_gradient_cached = false;
+    // Counters for the cache hits.
+    unsigned long m_fitness_hits = 0;
+    unsigned long m_gradient_hits = 0;
     unsigned m_verbosity;
     unsigned long m_objfun_counter = 0;
     log_type m_log;
@@ -373,14 +425,13 @@ double nlopt_objfun_wrapper(unsigned dim, const double *x, double *grad, void *f
     try {
         // A few shortcuts.
         auto &p = nlo.m_prob;
-        auto &dv = nlo.m_dv;
         const auto verb = nlo.m_verbosity;
         auto &f_count = nlo.m_objfun_counter;
         auto &log = nlo.m_log;
 
         // A couple of sanity checks.
         assert(dim == p.get_nx());
-        assert(dv.size() == dim);
+        assert(nlo.m_dv.size() == dim);
 
         if (grad && !p.has_gradient()) {
             // If grad is not null, it means we are in an algorithm
@@ -393,16 +444,12 @@ double nlopt_objfun_wrapper(unsigned dim, const double *x, double *grad, void *f
                             + p.get_name() + "' does not provide it");
         }
 
-        // Copy the decision vector in our temporary dv vector_double,
-        // for use in the pagmo API.
-        std::copy(x, x + dim, dv.begin());
-
         // Compute fitness.
-        const auto fitness = p.fitness(dv);
+        const auto &fitness = nlo.get_fitness(dim, x);
 
         // Compute gradient, if needed.
         if (grad) {
-            const auto gradient = p.gradient(dv);
+            const auto &gradient = nlo.get_gradient(dim, x);
 
             if (p.has_gradient_sparsity()) {
                 // Sparse gradient case.
@@ -481,11 +528,10 @@ void nlopt_ineq_c_wrapper(unsigned m, double *result, unsigned dim, const double
     try {
         // A few shortcuts.
         auto &p = nlo.m_prob;
-        auto &dv = nlo.m_dv;
 
         // A couple of sanity checks.
         assert(dim == p.get_nx());
-        assert(dv.size() == dim);
+        assert(nlo.m_dv.size() == dim);
         assert(m == p.get_nic());
         (void)m;
 
@@ -500,18 +546,14 @@ void nlopt_ineq_c_wrapper(unsigned m, double *result, unsigned dim, const double
                                                    + p.get_name() + "' does not provide it");
         }
 
-        // Copy the decision vector in our temporary dv vector_double,
-        // for use in the pagmo API.
-        std::copy(x, x + dim, dv.begin());
-
         // Compute fitness and write IC to the output.
         // NOTE: fitness is nobj + nec + nic.
-        const auto fitness = p.fitness(dv);
+        const auto &fitness = nlo.get_fitness(dim, x);
         nlopt_obj::unchecked_copy(p.get_nic(), fitness.data() + 1 + p.get_nec(), result);
 
         if (grad) {
             // Handle gradient, if requested.
-            const auto gradient = p.gradient(dv);
+            const auto &gradient = nlo.get_gradient(dim, x);
 
             if (p.has_gradient_sparsity()) {
                 // Sparse gradient.
@@ -568,11 +610,10 @@ void nlopt_eq_c_wrapper(unsigned m, double *result, unsigned dim, const double *
     try {
         // A few shortcuts.
         auto &p = nlo.m_prob;
-        auto &dv = nlo.m_dv;
 
         // A couple of sanity checks.
         assert(dim == p.get_nx());
-        assert(dv.size() == dim);
+        assert(nlo.m_dv.size() == dim);
         assert(m == p.get_nec());
 
         if (grad && !p.has_gradient()) {
@@ -586,18 +627,14 @@ void nlopt_eq_c_wrapper(unsigned m, double *result, unsigned dim, const double *
                             + p.get_name() + "' does not provide it");
         }
 
-        // Copy the decision vector in our temporary dv vector_double,
-        // for use in the pagmo API.
-        std::copy(x, x + dim, dv.begin());
-
         // Compute fitness and write EC to the output.
         // NOTE: fitness is nobj + nec + nic.
-        const auto fitness = p.fitness(dv);
+        const auto &fitness = nlo.get_fitness(dim, x);
         nlopt_obj::unchecked_copy(p.get_nec(), fitness.data() + 1, result);
 
         if (grad) {
             // Handle gradient, if requested.
-            const auto gradient = p.gradient(dv);
+            const auto &gradient = nlo.get_gradient(dim, x);
 
             if (p.has_gradient_sparsity()) {
                 // Sparse gradient case.
@@ -741,6 +778,7 @@ nlopt::nlopt(const std::string &algo) : m_algo(algo)
  */
 nlopt::nlopt(const nlopt &other)
     : not_population_based(other), m_algo(other.m_algo), m_last_opt_result(other.m_last_opt_result),
+      m_last_fitness_reuses(other.m_last_fitness_reuses), m_last_gradient_reuses(other.m_last_gradient_reuses),
       m_sc_stopval(other.m_sc_stopval), m_sc_ftol_rel(other.m_sc_ftol_rel), m_sc_ftol_abs(other.m_sc_ftol_abs),
       m_sc_xtol_rel(other.m_sc_xtol_rel), m_sc_xtol_abs(other.m_sc_xtol_abs), m_sc_maxeval(other.m_sc_maxeval),
       m_sc_maxtime(other.m_sc_maxtime), m_verbosity(other.m_verbosity), m_log(other.m_log),
@@ -822,9 +860,14 @@ population nlopt::evolve(population pop) const
     // Run the optimisation and store the status returned by NLopt.
     double objval;
     m_last_opt_result = ::nlopt_optimize(no.m_value.get(), initial_guess.data(), &objval);
+    // Record the reused evaluations.
+    m_last_fitness_reuses = no.m_fitness_hits;
+    m_last_gradient_reuses = no.m_gradient_hits;
     if (m_verbosity) {
         // Print to screen the result of the optimisation, if we are being verbose.
         std::cout << "\nOptimisation return status: " << detail::nlopt_res2string(m_last_opt_result) << '\n';
+        std::cout << "Reused fitness evaluations: " << m_last_fitness_reuses << '\n';
+        std::cout << "Reused gradient evaluations: " << m_last_gradient_reuses << '\n';
     }
     // Replace the log.
     m_log = std::move(no.m_log);
@@ -1010,7 +1053,7 @@ void nlopt::save(Archive &ar, unsigned) const
 {
     detail::to_archive(ar, boost::serialization::base_object<not_population_based>(*this), m_algo, m_last_opt_result,
                        m_sc_stopval, m_sc_ftol_rel, m_sc_ftol_abs, m_sc_xtol_rel, m_sc_xtol_abs, m_sc_maxeval,
-                       m_sc_maxtime, m_verbosity, m_log);
+                       m_sc_maxtime, m_verbosity, m_log, m_last_fitness_reuses, m_last_gradient_reuses);
     if (m_loc_opt) {
         detail::to_archive(ar, true, *m_loc_opt);
     } else {
@@ -1020,11 +1063,19 @@ void nlopt::save(Archive &ar, unsigned) const
 
 // Load from archive.
 template <typename Archive>
-void nlopt::load(Archive &ar, unsigned)
+void nlopt::load(Archive &ar, unsigned version)
 {
     detail::from_archive(ar, boost::serialization::base_object<not_population_based>(*this), m_algo, m_last_opt_result,
                          m_sc_stopval, m_sc_ftol_rel, m_sc_ftol_abs, m_sc_xtol_rel, m_sc_xtol_abs, m_sc_maxeval,
                          m_sc_maxtime, m_verbosity, m_log);
+    if (version > 0u) {
+        detail::from_archive(ar, m_last_fitness_reuses, m_last_gradient_reuses);
+    } else {
+        // NOTE: this can be reached only when loading an archive
+        // from a previous version.
+        m_last_fitness_reuses = 0;
+        m_last_gradient_reuses = 0;
+    }
     bool with_local;
     ar >> with_local;
     if (with_local) {
@@ -51,7 +51,7 @@ namespace pagmo
  */
 not_population_based::not_population_based()
     : m_select(std::string("best")), m_replace(std::string("best")), m_rselect_seed(random_device::next()),
-      m_e(static_cast<std::mt19937::result_type>(m_rselect_seed))
+      m_e(static_cast<detail::random_engine_type::result_type>(m_rselect_seed))
 {
 }
 
@@ -63,7 +63,7 @@ not_population_based::not_population_based()
 void not_population_based::set_random_sr_seed(unsigned seed)
 {
     m_rselect_seed = seed;
-    m_e.seed(static_cast<std::mt19937::result_type>(m_rselect_seed));
+    m_e.seed(static_cast<detail::random_engine_type::result_type>(m_rselect_seed));
 }
 
 /// Set the individual selection policy.
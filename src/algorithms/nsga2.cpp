@@ -181,10 +181,10 @@ population nsga2::evolve(population pop) const
         std::shuffle(shuffle2.begin(), shuffle2.end(), m_e);
 
         // 1 - We compute crowding distance and non dominated rank for the current population
-        auto fnds_res = fast_non_dominated_sorting(pop.get_f());
-        auto ndf = std::get<0>(fnds_res); // non dominated fronts [[0,3,2],[1,5,6],[4],...]
-        vector_double pop_cd(NP);         // crowding distances of the whole population
-        auto ndr = std::get<3>(fnds_res); // non domination rank [0,1,0,0,2,1,1, ... ]
+        auto fnds_res = fast_non_dominated_fronts(pop.get_f());
+        auto ndf = std::move(fnds_res.first);  // non dominated fronts [[0,3,2],[1,5,6],[4],...]
+        vector_double pop_cd(NP);              // crowding distances of the whole population
+        auto ndr = std::move(fnds_res.second); // non domination rank [0,1,0,0,2,1,1, ... ]
         for (const auto &front_idxs : ndf) {
             if (front_idxs.size() == 1u) { // handles the case where the front has collapsed to one point
                 pop_cd[front_idxs[0]] = std::numeric_limits<double>::infinity();
@@ -159,7 +159,7 @@ population nspso::evolve(population pop) const
         auto dvs = pop.get_x();
         // This returns a std::tuple containing: -the non dominated fronts, -the domination list, -the domination
         // count, -the non domination rank
-        auto fnds_res = fast_non_dominated_sorting(fit);
+        auto fnds_res = fast_non_dominated_fronts(fit);
         // 0 - Logs and prints (verbosity modes > 1: a line is added every m_verbosity generations)
         if (m_verbosity > 0u) {
             // Every m_verbosity generations print a log line
@@ -194,7 +194,7 @@ population nspso::evolve(population pop) const
 
         // 1 - Calculate non-dominated population
         if (m_diversity_mechanism == "crowding distance") {
-            auto ndf = std::get<0>(fnds_res);
+            auto ndf = fnds_res.first;
             auto best_non_dom_indices_tmp = sort_population_mo(fit);
             std::vector<vector_double::size_type> dummy(ndf[0].size());
             for (decltype(dummy.size()) i = 0u; i < dummy.size(); ++i) {
@@ -210,7 +210,7 @@ population nspso::evolve(population pop) const
             }
 
         } else if (m_diversity_mechanism == "niche count") {
-            auto ndf = std::get<0>(fnds_res);
+            auto ndf = fnds_res.first;
             auto best_ndi_tmp = sort_population_mo(fit);
             std::vector<vector_double> non_dom_chromosomes(ndf[0].size());
 
@@ -374,7 +374,6 @@ population nspso::evolve(population pop) const
         }
         std::vector<vector_double::size_type> best_next_pop_indices(swarm_size, 0);
         if (m_diversity_mechanism != "max min") {
-            auto fnds_res_next = fast_non_dominated_sorting(next_pop_fit);
             auto best_next_pop_indices_tmp = sort_population_mo(next_pop_fit);
             for (decltype(swarm_size) i = 0u; i < swarm_size; ++i) {
                 best_next_pop_indices[i] = best_next_pop_indices_tmp[i];
@@ -26,7 +26,9 @@ You should have received copies of the GNU General Public License and the
 GNU Lesser General Public License along with the PaGMO library.  If not,
 see https://www.gnu.org/licenses/. */
 
+#include <algorithm>
 #include <cmath>
+#include <cstddef>
 #include <iomanip>
 #include <iostream>
 #include <numeric>
@@ -39,6 +41,7 @@ see https://www.gnu.org/licenses/. */
 
 #include <pagmo/algorithm.hpp>
 #include <pagmo/algorithms/sade.hpp>
+#include <pagmo/bfe.hpp>
 #include <pagmo/exceptions.hpp>
 #include <pagmo/io.hpp>
 #include <pagmo/population.hpp>
@@ -46,6 +49,10 @@ see https://www.gnu.org/licenses/. */
 #include <pagmo/types.hpp>
 #include <pagmo/utils/generic.hpp>
 
+// NOTE: apparently this must be included *after*
+// the other serialization headers.
+#include <boost/serialization/optional.hpp>
+
 namespace pagmo
 {
 
@@ -160,6 +167,34 @@ population sade::evolve(population pop) const
     double gbCR = m_CR[0]; // initialization to the 0 ind, will soon be forgotten
     double gbIterF = gbF;
     double gbIterCR = gbCR;
+
+    // Selection between the trial vector in tmp[], generated with the parameters
+    // F and CR, and the i-th individual.
+    auto select_trial = [&](population::size_type i, const vector_double &newfitness, double F, double CR) {
+        if (newfitness[0] <= fit[i][0]) { /* improved objective function value ? */
+            fit[i] = newfitness;
+            popnew[i] = tmp;
+            // updates the individual in pop (avoiding to recompute the objective function)
+            pop.set_xf(i, popnew[i], newfitness);
+            // Update the adapted parameters
+            m_CR[i] = CR;
+            m_F[i] = F;
+
+            if (newfitness[0] <= gbfit[0]) {
+                /* if so...*/
+                gbfit = newfitness; /* reset gbfit to new low...*/
+                gbX = popnew[i];
+                gbF = F;   /* these were forgotten in PaGMOlegacy */
+                gbCR = CR; /* these were forgotten in PaGMOlegacy */
+            }
+        } else {
+            popnew[i] = popold[i];
+        }
+    };
+    // If a bfe is available, the trial vectors of each generation (together with the parameters
+    // used to generate them) are stored here and evaluated all at once at the end of the generation.
+    vector_double batch_dvs(m_bfe ? NP * dim : 0u);
+    std::vector<double> batch_F(m_bfe ? NP : 0u), batch_CR(m_bfe ? NP : 0u);
     // We initialize the global best for F and CR as the first individual (this will soon be forgotten)
 
     // Main DE iterations
@@ -501,27 +536,24 @@ population sade::evolve(population pop) const
                 }
             }
             // b) how good?
-            auto newfitness = prob.fitness(tmp); /* Evaluates tmp[] */
-            if (newfitness[0] <= fit[i][0]) {    /* improved objective function value ? */
-                fit[i] = newfitness;
-                popnew[i] = tmp;
-                // updates the individual in pop (avoiding to recompute the objective function)
-                pop.set_xf(i, popnew[i], newfitness);
-                // Update the adapted parameters
-                m_CR[i] = CR;
-                m_F[i] = F;
-
-                if (newfitness[0] <= gbfit[0]) {
-                    /* if so...*/
-                    gbfit = newfitness; /* reset gbfit to new low...*/
-                    gbX = popnew[i];
-                    gbF = F;   /* these were forgotten in PaGMOlegacy */
-                    gbCR = CR; /* these were forgotten in PaGMOlegacy */
-                }
+            if (m_bfe) {
+                // bfe is available: the evaluation is deferred to the end of the generation.
+                std::copy(tmp.begin(), tmp.end(), batch_dvs.begin() + static_cast<std::ptrdiff_t>(i * dim));
+                batch_F[i] = F;
+                batch_CR[i] = CR;
             } else {
-                popnew[i] = popold[i];
+                select_trial(i, prob.fitness(tmp), F, CR); /* Evaluates tmp[] */
             }
         } // End of one generation
+        if (m_bfe) {
+            // Evaluate all the trial vectors of the generation with the bfe.
+            const auto batch_fvs = (*m_bfe)(pop.get_problem(), batch_dvs);
+            for (decltype(NP) i = 0u; i < NP; ++i) {
+                std::copy(batch_dvs.begin() + static_cast<std::ptrdiff_t>(i * dim),
+                          batch_dvs.begin() + static_cast<std::ptrdiff_t>((i + 1u) * dim), tmp.begin());
+                select_trial(i, {batch_fvs[i]}, batch_F[i], batch_CR[i]);
+            }
+        }
         /* Save best population member of current iteration */
         gbIter = gbX;
         gbIterF = gbF;
@@ -596,6 +628,15 @@ void sade::set_seed(unsigned seed)
     m_seed = seed;
 }
 
+/// Sets the batch function evaluation scheme
+/**
+ * @param b batch function evaluation object
+ */
+void sade::set_bfe(const bfe &b)
+{
+    m_bfe = b;
+}
+
 /// Extra info
 /**
  * One of the optional methods of any user-defined algorithm (UDA).
@@ -618,10 +659,17 @@ std::string sade::get_extra_info() const
 
 // Object serialization
 template <typename Archive>
-void sade::serialize(Archive &ar, unsigned)
+void sade::serialize(Archive &ar, unsigned version)
 {
     detail::archive(ar, m_gen, m_F, m_CR, m_variant, m_variant_adptv, m_Ftol, m_xtol, m_memory, m_e, m_seed,
                     m_verbosity, m_log);
+    if (version > 0u) {
+        detail::archive(ar, m_bfe);
+    } else {
+        // NOTE: this can be reached only when loading an archive
+        // from a previous version.
+        m_bfe.reset();
+    }
 }
 
 } // namespace pagmo
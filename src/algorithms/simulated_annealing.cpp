@@ -145,6 +145,9 @@ population simulated_annealing::evolve(population pop) const
 
     // Stores the number of accepted points for each component
     std::vector<int> acp(dim, 0u);
+    // The component changed by each move, for the incremental fitness evaluation
+    std::vector<vector_double::size_type> changed(1u);
+    const bool incremental = prob.has_incremental_fitness();
     double ratio = 0., currentT = m_Ts, probab = 0.;
 
     // Main SA loops
@@ -159,8 +162,10 @@ population simulated_annealing::evolve(population pop) const
                     auto width = step[nter] * (ub[nter] - lb[nter]);
                     xNEW[nter] = uniform_real_from_range(std::max(xOLD[nter] - width, lb[nter]),
                                                          std::min(xOLD[nter] + width, ub[nter]), m_e);
-                    // And we valuate the objective function for the new point
-                    fNEW = prob.fitness(xNEW);
+                    // And we valuate the objective function for the new point (incrementally,
+                    // if the problem supports it, as xNEW differs from xOLD only in the nter component)
+                    changed[0] = nter;
+                    fNEW = prob.incremental_fitness(xNEW, xOLD, fOLD, changed);
                     // We decide whether to accept or discard the point
                     if (fNEW[0] <= fOLD[0]) {
                         // accept
@@ -229,6 +234,11 @@ population simulated_annealing::evolve(population pop) const
     }
     // We update the decision vector in pop, but only if things have improved
     if (best_f[0] <= fit0[0]) {
+        // NOTE: the incremental fitness evaluations may have accumulated rounding errors,
+        // thus the fitness written into pop is recomputed from scratch.
+        if (incremental && best_x != x0) {
+            best_f = prob.fitness(best_x);
+        }
         replace_individual(pop, best_x, best_f);
     }
     return pop;
@@ -30,12 +30,18 @@ see https://www.gnu.org/licenses/. */
 #include <atomic>
 #include <cassert>
 #include <cstddef>
-#include <cstdlib>
+#include <cstdint>
+#include <cstdio>
+#include <exception>
+#include <fstream>
+#include <functional>
 #include <iostream>
 #include <iterator>
 #include <limits>
 #include <memory>
 #include <mutex>
+#include <random>
+#include <sstream>
 #include <stdexcept>
 #include <string>
 #include <tuple>
@@ -45,10 +51,19 @@ see https://www.gnu.org/licenses/. */
 
 #include <boost/numeric/conversion/cast.hpp>
 
+#include <tbb/blocked_range.h>
+#include <tbb/parallel_for.h>
+
+#include <pagmo/algorithm.hpp>
 #include <pagmo/archipelago.hpp>
 #include <pagmo/exceptions.hpp>
 #include <pagmo/io.hpp>
 #include <pagmo/island.hpp>
+#include <pagmo/population.hpp>
+#include <pagmo/r_policy.hpp>
+#include <pagmo/s11n.hpp>
+#include <pagmo/s_policy.hpp>
+#include <pagmo/threading.hpp>
 #include <pagmo/topology.hpp>
 #include <pagmo/types.hpp>
 
@@ -61,6 +76,98 @@ see https://www.gnu.org/licenses/. */
 namespace pagmo
 {
 
+// The state of the migration log. The state is never replaced
+// while it is in use: changes of configuration create a new
+// state, which is then atomically swapped in.
+struct archipelago::migr_log_state {
+    explicit migr_log_state(migration_log_mode m, size_type capacity = 0, migration_log_sink_t s = {})
+        : mode(m), sink(std::move(s))
+    {
+        if (mode == migration_log_mode::bounded) {
+            recent = std::make_unique<detail::ring_log<migration_entry_t>>(boost::numeric_cast<std::size_t>(capacity));
+        }
+    }
+
+    void append(migration_log_t &&mlog)
+    {
+        switch (mode) {
+            case migration_log_mode::unbounded:
+                all.append(std::move(mlog));
+                break;
+            case migration_log_mode::bounded:
+                recent->append(std::move(mlog));
+                break;
+            case migration_log_mode::stream:
+                if (!mlog.empty()) {
+                    sink(mlog);
+                }
+                break;
+            case migration_log_mode::off:
+                break;
+        }
+    }
+
+    migration_log_t get_all() const
+    {
+        switch (mode) {
+            case migration_log_mode::unbounded:
+                return all.get_all();
+            case migration_log_mode::bounded:
+                return recent->get_all();
+            default:
+                return {};
+        }
+    }
+
+    // NOTE: in the off and stream modes there
+    // are no stored entries to be replaced.
+    void set_all(migration_log_t &&mlog)
+    {
+        switch (mode) {
+            case migration_log_mode::unbounded:
+                all.set_all(std::move(mlog));
+                break;
+            case migration_log_mode::bounded:
+                recent->clear();
+                recent->append(std::move(mlog));
+                break;
+            default:;
+        }
+    }
+
+    // Create a new state with the same configuration
+    // and a copy of the stored entries.
+    std::shared_ptr<migr_log_state> clone() const
+    {
+        auto retval = std::make_shared<migr_log_state>(mode, recent ? recent->capacity() : 0u, sink);
+        retval->set_all(get_all());
+        return retval;
+    }
+
+    const migration_log_mode mode;
+    const migration_log_sink_t sink;
+    // Storage for the unbounded mode.
+    detail::append_only_log<migration_entry_t> all;
+    // Storage for the bounded mode.
+    std::unique_ptr<detail::ring_log<migration_entry_t>> recent;
+};
+
+// Fetch the state of the migration log, creating
+// the default state if necessary.
+std::shared_ptr<archipelago::migr_log_state> archipelago::get_migr_log_state() const
+{
+    auto state = std::atomic_load(&m_migr_log);
+    if (!state) {
+        auto new_state = std::make_shared<migr_log_state>(migration_log_mode::unbounded);
+        // NOTE: if another thread created the state in the meantime,
+        // state will be set to it and new_state will be discarded.
+        if (std::atomic_compare_exchange_strong(&m_migr_log, &state, new_state)) {
+            state = std::move(new_state);
+        }
+    }
+    return state;
+}
+
 // NOTE: same utility method as in pagmo::island, see there.
 void archipelago::wait_check_ignore()
 {
@@ -103,10 +210,13 @@ archipelago::archipelago(const archipelago &other)
     }
 
     // Set the migrants.
-    m_migrants = other.get_migrants_db();
+    m_migrants.set_all(other.get_migrants_db());
 
-    // Set the migration log.
-    m_migr_log = other.get_migration_log();
+    // Set the migration log. If the state of other has not
+    // been created yet, this will also use the default state.
+    if (const auto state = std::atomic_load(&other.m_migr_log)) {
+        m_migr_log = state->clone();
+    }
 
     // Set the topology.
     m_topology = other.get_topology();
@@ -142,19 +252,16 @@ archipelago::archipelago(archipelago &&other) noexcept
         iptr->m_ptr->archi_ptr = this;
     }
 
-    // Move over the indices, clear other.
-    // NOTE: the indices are still valid as above we just moved in a vector
+    // NOTE: the island indices are still valid as above we just moved in a vector
     // of unique_ptrs, without changing their content.
-    m_idx_map = std::move(other.m_idx_map);
-    other.m_idx_map.clear();
 
     // Move over the migrants, clear other.
-    m_migrants = std::move(other.m_migrants);
-    other.m_migrants.clear();
+    m_migrants.swap(other.m_migrants);
+    other.m_migrants.resize(0);
 
-    // Move over the migration log, clear other.
+    // Move over the migration log. other will be left
+    // with an empty log in the default mode.
     m_migr_log = std::move(other.m_migr_log);
-    other.m_migr_log.clear();
 
     // Move over the topology. No need to clear here as we know
     // in which state the topology will be in after the move.
@@ -212,17 +319,13 @@ archipelago &archipelago::operator=(archipelago &&other) noexcept
             iptr->m_ptr->archi_ptr = this;
         }
 
-        // Move the indices map, clear other.
-        m_idx_map = std::move(other.m_idx_map);
-        other.m_idx_map.clear();
-
         // Move over the migrants, clear other.
-        m_migrants = std::move(other.m_migrants);
-        other.m_migrants.clear();
+        m_migrants.swap(other.m_migrants);
+        other.m_migrants.resize(0);
 
-        // Move over the migration log, clear other.
+        // Move over the migration log. other will be left
+        // with an empty log in the default mode.
         m_migr_log = std::move(other.m_migr_log);
-        other.m_migr_log.clear();
 
         // Move over the topology.
         m_topology = std::move(other.m_topology);
@@ -246,16 +349,14 @@ archipelago::~archipelago()
     // destroying things, so that the destruction order will not matter.
     wait_check_ignore();
 
-    // NOTE: we made sure in the move ctor/assignment that the island vector, the migrants and the indices
-    // map are all cleared out after a move. Thus we can safely assert the following.
+    // NOTE: we made sure in the move ctor/assignment that the island vector and the migrants
+    // are all cleared out after a move. Thus we can safely assert the following.
     assert(std::all_of(m_islands.begin(), m_islands.end(),
                        [this](const std::unique_ptr<island> &iptr) { return iptr->m_ptr->archi_ptr == this; }));
-    assert(m_idx_map.size() == m_islands.size());
 #if !defined(NDEBUG)
     for (size_type i = 0; i < m_islands.size(); ++i) {
-        // Ensure the map of indices is correct.
-        assert(m_idx_map.find(m_islands[i].get()) != m_idx_map.end());
-        assert(m_idx_map.find(m_islands[i].get())->second == i);
+        // Ensure the island indices are correct.
+        assert(m_islands[i]->m_ptr->archi_idx == i);
     }
 #endif
 }
@@ -392,7 +493,7 @@ void archipelago::wait_check()
  */
 evolve_status archipelago::status() const
 {
-    decltype(m_islands.size()) n_idle = 0, n_busy = 0, n_idle_error = 0, n_busy_error = 0;
+    decltype(m_islands.size()) n_idle = 0, n_busy = 0, n_idle_error = 0;
     for (const auto &iptr : m_islands) {
         switch (iptr->status()) {
             case evolve_status::idle:
@@ -405,25 +506,21 @@ evolve_status archipelago::status() const
                 ++n_idle_error;
                 break;
             case evolve_status::busy_error:
-                ++n_busy_error;
-                break;
+                // A single busy error determines the global state,
+                // no need to look at the other islands.
+                return evolve_status::busy_error;
         }
-    }
 
-    // If we have at last one busy error, the global state
-    // is also busy error.
-    if (n_busy_error) {
-        return evolve_status::busy_error;
+        // At least one island is idle with error and at least one island is busy:
+        // the global state is busy error, regardless of the remaining islands.
+        if (n_idle_error && n_busy) {
+            return evolve_status::busy_error;
+        }
     }
 
-    // The other error case: at least one island is idle with error.
+    // At least one island is idle with error, and no island is busy
+    // (otherwise we would have returned busy error in the loop above).
     if (n_idle_error) {
-        if (n_busy) {
-            // At least one island is idle with error and at least one island is busy:
-            // return busy error.
-            return evolve_status::busy_error;
-        }
-        // No island is busy at all, at least one island is idle with error.
         return evolve_status::idle_error;
     }
 
@@ -432,34 +529,77 @@ evolve_status archipelago::status() const
     return n_idle == m_islands.size() ? evolve_status::idle : evolve_status::busy;
 }
 
+/// Status of the islands.
+/**
+ * \verbatim embed:rst:leading-asterisk
+ * .. versionadded:: 2.20
+ * \endverbatim
+ *
+ * This method will return the values of island::status() for all the islands
+ * of the archipelago (following the order in which the islands were inserted into
+ * the archipelago). It is meant for monitoring loops which need the per-island
+ * status without querying the islands one by one via the archipelago's iterators.
+ *
+ * @return a vector containing the status of each island.
+ *
+ * @throws unspecified any exception thrown by memory errors in standard containers.
+ */
+std::vector<evolve_status> archipelago::get_islands_status() const
+{
+    std::vector<evolve_status> retval;
+    retval.reserve(m_islands.size());
+    for (const auto &iptr : m_islands) {
+        retval.push_back(iptr->status());
+    }
+    return retval;
+}
+
 /// Get the fitness vectors of the islands' champions.
 /**
+ * \verbatim embed:rst:leading-asterisk
+ * .. versionchanged:: 2.20
+ *
+ *    The champions are read via island::get_champion_f(), without copying the
+ *    islands' populations.
+ *
+ * \endverbatim
+ *
  * @return a collection of the fitness vectors of the islands' champions.
  *
- * @throws unspecified any exception thrown by population::champion_f() or
+ * @throws unspecified any exception thrown by island::get_champion_f() or
  * by memory errors in standard containers.
  */
 std::vector<vector_double> archipelago::get_champions_f() const
 {
     std::vector<vector_double> retval;
+    retval.reserve(m_islands.size());
     for (const auto &isl_ptr : m_islands) {
-        retval.emplace_back(isl_ptr->get_population().champion_f());
+        retval.emplace_back(isl_ptr->get_champion_f());
     }
     return retval;
 }
 
 /// Get the decision vectors of the islands' champions.
 /**
+ * \verbatim embed:rst:leading-asterisk
+ * .. versionchanged:: 2.20
+ *
+ *    The champions are read via island::get_champion_x(), without copying the
+ *    islands' populations.
+ *
+ * \endverbatim
+ *
  * @return a collection of the decision vectors of the islands' champions.
  *
- * @throws unspecified any exception thrown by population::champion_x() or
+ * @throws unspecified any exception thrown by island::get_champion_x() or
  * by memory errors in standard containers.
  */
 std::vector<vector_double> archipelago::get_champions_x() const
 {
     std::vector<vector_double> retval;
+    retval.reserve(m_islands.size());
     for (const auto &isl_ptr : m_islands) {
-        retval.emplace_back(isl_ptr->get_population().champion_x());
+        retval.emplace_back(isl_ptr->get_champion_x());
     }
     return retval;
 }
@@ -476,6 +616,7 @@ void archipelago::push_back_impl(std::unique_ptr<island> &&new_island)
     // we implement archipelago-based checks in the dtor
     // of island. This is not the case at the moment.
     new_island->m_ptr->archi_ptr = this;
+    new_island->m_ptr->archi_idx = m_islands.size();
 
     // Try to make space for the new island in the islands vector.
     // LCOV_EXCL_START
@@ -485,39 +626,18 @@ void archipelago::push_back_impl(std::unique_ptr<island> &&new_island)
     // LCOV_EXCL_STOP
     m_islands.reserve(m_islands.size() + 1u);
 
-    // Try to make space for the new migrants entry.
-    // LCOV_EXCL_START
-    if (m_migrants.size() == std::numeric_limits<decltype(m_migrants.size())>::max()) {
-        pagmo_throw(std::overflow_error, "cannot add a new island to an archipelago due to an overflow condition");
-    }
-    // LCOV_EXCL_STOP
+    // Add an empty entry to the migrants db.
     {
         std::lock_guard<std::mutex> lock(m_migrants_mutex);
-        m_migrants.reserve(m_migrants.size() + 1u);
-    }
 
-    // Map the new island idx.
-    {
-        // NOTE: if anything fails here, we won't have modified the state of the archi
-        // (apart from reserving memory).
-        std::lock_guard<std::mutex> lock(m_idx_map_mutex);
-        assert(m_idx_map.find(new_island.get()) == m_idx_map.end());
-        m_idx_map.emplace(new_island.get(), m_islands.size());
-    }
-
-    // Add an empty entry to the migrants db.
-    try {
-        std::lock_guard<std::mutex> lock(m_migrants_mutex);
-        m_migrants.emplace_back();
-    } catch (...) {
         // LCOV_EXCL_START
-        // NOTE: we get here only if the lock throws, because we made space for the
-        // new migrants above already. Better to abort in such case, as we have no
-        // reasonable path for recovering from this.
-        std::cerr << "An unrecoverable error arose while adding an island to the archipelago, aborting now."
-                  << std::endl;
-        std::abort();
+        if (m_migrants.size() == std::numeric_limits<decltype(m_migrants.size())>::max()) {
+            pagmo_throw(std::overflow_error, "cannot add a new island to an archipelago due to an overflow condition");
+        }
         // LCOV_EXCL_STOP
+
+        // NOTE: if this fails, the migrants db will be left untouched.
+        m_migrants.resize(m_migrants.size() + 1u);
     }
 
     // Actually add the island. This cannot fail as we already reserved space.
@@ -529,18 +649,55 @@ void archipelago::push_back_impl(std::unique_ptr<island> &&new_island)
     m_topology.push_back();
 }
 
+void archipelago::push_back_n(size_type n, const std::function<std::unique_ptr<island>(size_type)> &f, bool par)
+{
+    if (n == 0u) {
+        return;
+    }
+
+    std::vector<std::unique_ptr<island>> new_islands(n);
+
+    // Construct the first island sequentially. It is used to check
+    // the thread safety guarantees of the algorithm and the problem.
+    // NOTE: the construction of the other islands will copy the algorithm
+    // and the problem concurrently, and it will evaluate the fitnesses of
+    // the initial populations concurrently on different copies of the problem.
+    // This is allowed if both provide at least the basic thread safety guarantee.
+    new_islands[0] = f(0);
+    const auto &idata = *new_islands[0]->m_ptr;
+    par = par && idata.algo->get_thread_safety() >= thread_safety::basic
+          && idata.pop->get_problem().get_thread_safety() >= thread_safety::basic;
+
+    if (par) {
+        tbb::parallel_for(tbb::blocked_range<size_type>(1, n), [&new_islands, &f](const auto &range) {
+            for (auto i = range.begin(); i != range.end(); ++i) {
+                new_islands[i] = f(i);
+            }
+        });
+    } else {
+        for (size_type i = 1; i < n; ++i) {
+            new_islands[i] = f(i);
+        }
+    }
+
+    // Insert the islands, in order.
+    for (auto &isl_ptr : new_islands) {
+        push_back_impl(std::move(isl_ptr));
+    }
+}
+
 // Get the index of an island.
 // This function will return the index of the island \p isl in the archipelago. If \p isl does
 // not belong to the archipelago, an error will be raised.
+// NOTE: the index is stored in the island itself, so that
+// no lookup in a shared data structure is needed.
 archipelago::size_type archipelago::get_island_idx(const island &isl) const
 {
-    std::lock_guard<std::mutex> lock(m_idx_map_mutex);
-    const auto ret = m_idx_map.find(&isl);
-    if (ret == m_idx_map.end()) {
+    if (isl.m_ptr->archi_ptr != this) {
         pagmo_throw(std::invalid_argument,
                     "the index of an island in an archipelago was requested, but the island is not in the archipelago");
     }
-    return ret->second;
+    return isl.m_ptr->archi_idx;
 }
 
 /// Get the database of migrants.
@@ -560,7 +717,7 @@ archipelago::size_type archipelago::get_island_idx(const island &isl) const
 archipelago::migrants_db_t archipelago::get_migrants_db() const
 {
     std::lock_guard<std::mutex> lock(m_migrants_mutex);
-    return m_migrants;
+    return m_migrants.get_all();
 }
 
 /// Set the database of migrants.
@@ -611,7 +768,7 @@ void archipelago::set_migrants_db(migrants_db_t mig)
     // removed.
 
     std::lock_guard<std::mutex> lock(m_migrants_mutex);
-    m_migrants = std::move(mig);
+    m_migrants.set_all(std::move(mig));
 }
 
 /// Get the migration log.
@@ -628,6 +785,11 @@ void archipelago::set_migrants_db(migrants_db_t mig)
  *
  * The migration log is a collection of migration entries.
  *
+ * .. versionchanged:: 2.20
+ *
+ *    Depending on the migration log mode (see :cpp:func:`~pagmo::archipelago::get_migration_log_mode()`),
+ *    the returned log may contain only the most recent entries, or no entry at all.
+ *
  * \endverbatim
  *
  * @return a copy of the migration log.
@@ -636,53 +798,941 @@ void archipelago::set_migrants_db(migrants_db_t mig)
  */
 archipelago::migration_log_t archipelago::get_migration_log() const
 {
+    return get_migr_log_state()->get_all();
+}
+
+/// Get the migration log mode.
+/**
+ * \verbatim embed:rst:leading-asterisk
+ * .. versionadded:: 2.20
+ *
+ * The default migration log mode is :cpp:enumerator:`~pagmo::migration_log_mode::unbounded`.
+ * \endverbatim
+ *
+ * @return the current migration log mode.
+ */
+migration_log_mode archipelago::get_migration_log_mode() const
+{
+    return get_migr_log_state()->mode;
+}
+
+/// Get the capacity of the migration log.
+/**
+ * \verbatim embed:rst:leading-asterisk
+ * .. versionadded:: 2.20
+ * \endverbatim
+ *
+ * @return the maximum number of entries stored in the migration log if the
+ * migration log mode is pagmo::migration_log_mode::bounded, zero otherwise.
+ */
+archipelago::size_type archipelago::get_migration_log_capacity() const
+{
+    const auto state = get_migr_log_state();
+    return state->recent ? boost::numeric_cast<size_type>(state->recent->capacity()) : 0u;
+}
+
+/// Store all the migration entries.
+/**
+ * \verbatim embed:rst:leading-asterisk
+ * .. versionadded:: 2.20
+ *
+ * This method will set the migration log mode to :cpp:enumerator:`~pagmo::migration_log_mode::unbounded`.
+ * The entries currently stored in the migration log will be preserved.
+ *
+ * It is safe to call this method while the archipelago is evolving, but the
+ * migration entries produced during the change of configuration may be lost.
+ * \endverbatim
+ *
+ * @throws unspecified any exception thrown by threading primitives or by memory allocation errors.
+ */
+void archipelago::set_migration_log_unbounded()
+{
+    auto new_state = std::make_shared<migr_log_state>(migration_log_mode::unbounded);
+
     std::lock_guard<std::mutex> lock(m_migr_log_mutex);
-    return m_migr_log;
+    new_state->set_all(get_migr_log_state()->get_all());
+    std::atomic_store(&m_migr_log, std::move(new_state));
 }
 
-// Append entries to the migration log.
-void archipelago::append_migration_log(const migration_log_t &mlog)
+/// Store only the most recent migration entries.
+/**
+ * \verbatim embed:rst:leading-asterisk
+ * .. versionadded:: 2.20
+ *
+ * This method will set the migration log mode to :cpp:enumerator:`~pagmo::migration_log_mode::bounded`.
+ * In this mode, the migration log behaves as a circular buffer retaining only the
+ * most recent ``n`` entries. The most recent ``n`` entries currently stored in the
+ * migration log will be preserved.
+ *
+ * It is safe to call this method while the archipelago is evolving, but the
+ * migration entries produced during the change of configuration may be lost.
+ * \endverbatim
+ *
+ * @param n the maximum number of entries in the migration log.
+ *
+ * @throws std::invalid_argument if \p n is zero.
+ * @throws unspecified any exception thrown by threading primitives or by memory allocation errors.
+ */
+void archipelago::set_migration_log_bounded(size_type n)
 {
-    // Don't do anything if mlog is empty.
-    if (mlog.empty()) {
-        return;
+    if (n == 0u) {
+        pagmo_throw(std::invalid_argument, "the capacity of a bounded migration log cannot be zero");
+    }
+
+    auto new_state = std::make_shared<migr_log_state>(migration_log_mode::bounded, n);
+
+    std::lock_guard<std::mutex> lock(m_migr_log_mutex);
+    new_state->set_all(get_migr_log_state()->get_all());
+    std::atomic_store(&m_migr_log, std::move(new_state));
+}
+
+/// Disable the migration log.
+/**
+ * \verbatim embed:rst:leading-asterisk
+ * .. versionadded:: 2.20
+ *
+ * This method will set the migration log mode to :cpp:enumerator:`~pagmo::migration_log_mode::off`.
+ * The entries currently stored in the migration log will be discarded, and
+ * the islands will not record any further migration.
+ * \endverbatim
+ *
+ * @throws unspecified any exception thrown by threading primitives or by memory allocation errors.
+ */
+void archipelago::set_migration_log_off()
+{
+    auto new_state = std::make_shared<migr_log_state>(migration_log_mode::off);
+
+    std::lock_guard<std::mutex> lock(m_migr_log_mutex);
+    std::atomic_store(&m_migr_log, std::move(new_state));
+}
+
+/// Stream the migration log to a sink.
+/**
+ * \verbatim embed:rst:leading-asterisk
+ * .. versionadded:: 2.20
+ *
+ * This method will set the migration log mode to :cpp:enumerator:`~pagmo::migration_log_mode::stream`.
+ * The entries currently stored in the migration log will be discarded. During migration,
+ * the islands will invoke ``sink`` with the batches of migration entries they produce,
+ * instead of storing them in the archipelago. ``sink`` will be invoked from the threads
+ * of execution of the islands, possibly concurrently, and thus it must be thread-safe.
+ * Exceptions thrown by ``sink`` will be re-raised by :cpp:func:`~pagmo::archipelago::wait_check()`.
+ *
+ * See :cpp:func:`~pagmo::archipelago::migration_log_file_sink()` for a sink writing
+ * the migration entries to a binary file.
+ * \endverbatim
+ *
+ * @param sink the migration log sink.
+ *
+ * @throws std::invalid_argument if \p sink is empty.
+ * @throws unspecified any exception thrown by threading primitives or by memory allocation errors.
+ */
+void archipelago::set_migration_log_sink(migration_log_sink_t sink)
+{
+    if (!sink) {
+        pagmo_throw(std::invalid_argument, "the sink of a streaming migration log cannot be empty");
+    }
+
+    auto new_state = std::make_shared<migr_log_state>(migration_log_mode::stream, 0u, std::move(sink));
+
+    std::lock_guard<std::mutex> lock(m_migr_log_mutex);
+    std::atomic_store(&m_migr_log, std::move(new_state));
+}
+
+namespace detail
+{
+
+namespace
+{
+
+// The magic string at the beginning of the migration log files.
+constexpr char migr_log_file_magic[] = "pagmo_migration_log_v1";
+
+template <typename T>
+void migr_log_file_write(std::ostream &os, const T &x)
+{
+    os.write(reinterpret_cast<const char *>(&x), sizeof(T));
+}
+
+void migr_log_file_write_vd(std::ostream &os, const vector_double &v)
+{
+    migr_log_file_write(os, static_cast<std::uint64_t>(v.size()));
+    os.write(reinterpret_cast<const char *>(v.data()),
+             boost::numeric_cast<std::streamsize>(v.size() * sizeof(double)));
+}
+
+template <typename T>
+void migr_log_file_read(std::istream &is, T &x, const std::string &filename)
+{
+    if (!is.read(reinterpret_cast<char *>(&x), sizeof(T))) {
+        pagmo_throw(std::runtime_error, "the migration log file '" + filename + "' is truncated");
+    }
+}
+
+vector_double migr_log_file_read_vd(std::istream &is, const std::string &filename)
+{
+    std::uint64_t size{};
+    migr_log_file_read(is, size, filename);
+    vector_double retval(boost::numeric_cast<vector_double::size_type>(size));
+    if (!is.read(reinterpret_cast<char *>(retval.data()),
+                 boost::numeric_cast<std::streamsize>(retval.size() * sizeof(double)))) {
+        pagmo_throw(std::runtime_error, "the migration log file '" + filename + "' is truncated");
+    }
+    return retval;
+}
+
+} // namespace
+
+} // namespace detail
+
+/// Create a sink writing the migration log to a binary file.
+/**
+ * \verbatim embed:rst:leading-asterisk
+ * .. versionadded:: 2.20
+ *
+ * This function will create the file ``filename`` (overwriting it if it
+ * exists already), and it will return a sink suitable for use in
+ * :cpp:func:`~pagmo::archipelago::set_migration_log_sink()`. The sink will
+ * write the migration entries to the file as compact binary records,
+ * flushing the file after each batch of entries. The sink can be safely
+ * invoked from multiple threads.
+ *
+ * The file can be read back via :cpp:func:`~pagmo::archipelago::read_migration_log_file()`.
+ * The records are written in the native binary representation of the
+ * machine, and thus the file is not portable across architectures.
+ * \endverbatim
+ *
+ * @param filename the name of the file.
+ *
+ * @return a sink writing the migration log to \p filename.
+ *
+ * @throws std::runtime_error if the file cannot be opened.
+ * @throws unspecified any exception thrown by memory allocation errors.
+ */
+archipelago::migration_log_sink_t archipelago::migration_log_file_sink(const std::string &filename)
+{
+    struct file_data {
+        std::mutex mutex;
+        std::ofstream ofs;
+    };
+
+    auto fd = std::make_shared<file_data>();
+    fd->ofs.open(filename, std::ios::binary | std::ios::trunc);
+    if (!fd->ofs) {
+        pagmo_throw(std::runtime_error, "cannot open the migration log file '" + filename + "' for writing");
+    }
+    fd->ofs.write(detail::migr_log_file_magic, sizeof(detail::migr_log_file_magic));
+    fd->ofs.flush();
+
+    return [fd, filename](const migration_log_t &mlog) {
+        std::lock_guard<std::mutex> lock(fd->mutex);
+
+        for (const auto &entry : mlog) {
+            detail::migr_log_file_write(fd->ofs, std::get<0>(entry));
+            detail::migr_log_file_write(fd->ofs, static_cast<std::uint64_t>(std::get<1>(entry)));
+            detail::migr_log_file_write(fd->ofs, static_cast<std::uint64_t>(std::get<4>(entry)));
+            detail::migr_log_file_write(fd->ofs, static_cast<std::uint64_t>(std::get<5>(entry)));
+            detail::migr_log_file_write_vd(fd->ofs, std::get<2>(entry));
+            detail::migr_log_file_write_vd(fd->ofs, std::get<3>(entry));
+        }
+        fd->ofs.flush();
+
+        if (!fd->ofs) {
+            pagmo_throw(std::runtime_error, "error writing to the migration log file '" + filename + "'");
+        }
+    };
+}
+
+/// Read a migration log file.
+/**
+ * \verbatim embed:rst:leading-asterisk
+ * .. versionadded:: 2.20
+ *
+ * This function will read the migration entries written to ``filename``
+ * by a sink created via :cpp:func:`~pagmo::archipelago::migration_log_file_sink()`.
+ * \endverbatim
+ *
+ * @param filename the name of the file.
+ *
+ * @return the migration entries stored in \p filename.
+ *
+ * @throws std::runtime_error if the file cannot be opened, or if it is
+ * not a valid migration log file.
+ * @throws unspecified any exception thrown by memory allocation errors.
+ */
+archipelago::migration_log_t archipelago::read_migration_log_file(const std::string &filename)
+{
+    std::ifstream ifs(filename, std::ios::binary);
+    if (!ifs) {
+        pagmo_throw(std::runtime_error, "cannot open the migration log file '" + filename + "' for reading");
+    }
+
+    char magic[sizeof(detail::migr_log_file_magic)] = {};
+    if (!ifs.read(magic, sizeof(magic))
+        || !std::equal(magic, magic + sizeof(magic), static_cast<const char *>(detail::migr_log_file_magic))) {
+        pagmo_throw(std::runtime_error, "the file '" + filename + "' is not a valid migration log file");
+    }
+
+    migration_log_t retval;
+    while (ifs.peek() != std::ifstream::traits_type::eof()) {
+        double ts{};
+        std::uint64_t id{}, src{}, dst{};
+        detail::migr_log_file_read(ifs, ts, filename);
+        detail::migr_log_file_read(ifs, id, filename);
+        detail::migr_log_file_read(ifs, src, filename);
+        detail::migr_log_file_read(ifs, dst, filename);
+        auto x = detail::migr_log_file_read_vd(ifs, filename);
+        auto f = detail::migr_log_file_read_vd(ifs, filename);
+
+        retval.emplace_back(ts, boost::numeric_cast<unsigned long long>(id), std::move(x), std::move(f),
+                            boost::numeric_cast<size_type>(src), boost::numeric_cast<size_type>(dst));
+    }
+
+    return retval;
+}
+
+namespace detail
+{
+
+namespace
+{
+
+// The magic string at the beginning of the checkpoint files.
+// NOTE: the array is zero-padded to 32 bytes, so that
+// all the data following it is 8-byte aligned.
+constexpr char archi_ckpt_magic[32] = "pagmo_archipelago_checkpoint";
+
+// The version of the checkpoint file format.
+constexpr std::uint64_t archi_ckpt_format_version = 1;
+
+// The marker at the end of a checkpoint file ("pagmoend").
+constexpr std::uint64_t archi_ckpt_end_marker = 0x646e656f6d676170ull;
+
+// The size of the file header: magic, format version, token and
+// the end offset of the last committed trailer.
+constexpr std::uint64_t archi_ckpt_header_size = sizeof(archi_ckpt_magic) + 3u * sizeof(std::uint64_t);
+
+// The offset of the end of the last committed trailer within the header.
+constexpr std::uint64_t archi_ckpt_committed_offset = sizeof(archi_ckpt_magic) + 2u * sizeof(std::uint64_t);
+
+// The size of the trailer: the end offset of the previous trailer (zero
+// if there is none), the offset of the index and the end marker.
+constexpr std::uint64_t archi_ckpt_trailer_size = 3u * sizeof(std::uint64_t);
+
+template <typename T>
+void archi_ckpt_write(std::ostream &os, const T &x)
+{
+    os.write(reinterpret_cast<const char *>(&x), sizeof(T));
+}
+
+// Write a blob of bytes, preceded by its size and
+// followed by zero padding up to a multiple of 8 bytes.
+void archi_ckpt_write_blob(std::ostream &os, const std::string &blob)
+{
+    archi_ckpt_write(os, static_cast<std::uint64_t>(blob.size()));
+    os.write(blob.data(), boost::numeric_cast<std::streamsize>(blob.size()));
+    const char pad[8] = {};
+    os.write(pad, static_cast<std::streamsize>((8u - blob.size() % 8u) % 8u));
+}
+
+// Write the data of a vector of equally-sized vectors contiguously.
+template <typename T>
+void archi_ckpt_write_matrix(std::ostream &os, const std::vector<T> &v)
+{
+    for (const auto &row : v) {
+        os.write(reinterpret_cast<const char *>(row.data()),
+                 boost::numeric_cast<std::streamsize>(row.size() * sizeof(typename T::value_type)));
+    }
+}
+
+[[noreturn]] void archi_ckpt_corrupted(const std::string &filename)
+{
+    pagmo_throw(std::runtime_error, "the checkpoint file '" + filename + "' is truncated or corrupted");
+}
+
+void archi_ckpt_read_bytes(std::istream &is, char *ptr, std::uint64_t n, const std::string &filename)
+{
+    if (!is.read(ptr, boost::numeric_cast<std::streamsize>(n))) {
+        archi_ckpt_corrupted(filename);
+    }
+}
+
+template <typename T>
+void archi_ckpt_read(std::istream &is, T &x, const std::string &filename)
+{
+    archi_ckpt_read_bytes(is, reinterpret_cast<char *>(&x), sizeof(T), filename);
+}
+
+// Read a blob written by archi_ckpt_write_blob(). max_size
+// is the number of bytes left in the file.
+std::string archi_ckpt_read_blob(std::istream &is, std::uint64_t max_size, const std::string &filename)
+{
+    std::uint64_t size{};
+    archi_ckpt_read(is, size, filename);
+    if (size > max_size) {
+        archi_ckpt_corrupted(filename);
+    }
+    std::string retval(boost::numeric_cast<std::string::size_type>(size), '\0');
+    archi_ckpt_read_bytes(is, &retval[0], size, filename);
+    char pad[8];
+    archi_ckpt_read_bytes(is, pad, (8u - size % 8u) % 8u, filename);
+    return retval;
+}
+
+// Read into a vector of equally-sized vectors the data written
+// by archi_ckpt_write_matrix(). The rows must have been already
+// sized appropriately.
+template <typename T>
+void archi_ckpt_read_matrix(std::istream &is, std::vector<T> &v, const std::string &filename)
+{
+    for (auto &row : v) {
+        archi_ckpt_read_bytes(is, reinterpret_cast<char *>(row.data()), row.size() * sizeof(typename T::value_type),
+                              filename);
+    }
+}
+
+std::uint64_t archi_ckpt_tell(std::ostream &os)
+{
+    return static_cast<std::uint64_t>(static_cast<std::streamoff>(os.tellp()));
+}
+
+} // namespace
+
+} // namespace detail
+
+// Write the record of the island at index idx in the checkpoint file.
+// The returned value is the version of the island which was written.
+// NOTE: the layout of an island record is:
+// - the number of individuals, nx and nf (8 bytes each),
+// - a blob containing the UDI, the algorithm, the r/s policies, the problem,
+//   the champion, the random engine and the seed of the population, serialised
+//   with a Boost binary archive,
+// - the IDs of the individuals, as contiguous 64-bit unsigned integers,
+// - the decision vectors of the individuals, as a contiguous row-major matrix of doubles,
+// - the fitness vectors of the individuals, as a contiguous row-major matrix of doubles.
+// Everything is 8-byte aligned.
+unsigned long long archipelago::write_ckpt_island(std::ostream &os, size_type idx) const
+{
+    auto &idata = *m_islands[idx]->m_ptr;
+
+    // NOTE: fetch the version before the algorithm and the population:
+    // the version is updated after the algorithm and the population are
+    // changed, hence at worst we will be writing a state more recent than
+    // the returned version, which will then be written again in the next
+    // checkpoint.
+    const auto version = idata.version.load();
+
+    // NOTE: as in island::get_algorithm()/get_population(), the objects
+    // pointed to by algo and pop are never modified while other references
+    // to them exist, thus we can read from them after releasing the locks.
+    std::shared_ptr<algorithm> algo_ptr;
+    {
+        std::lock_guard<std::mutex> lock(idata.algo_mutex);
+        algo_ptr = idata.algo;
+    }
+    std::shared_ptr<population> pop_ptr;
+    {
+        std::lock_guard<std::mutex> lock(idata.pop_mutex);
+        pop_ptr = idata.pop;
+    }
+    const auto &pop = *pop_ptr;
+
+    std::ostringstream oss;
+    {
+        boost::archive::binary_oarchive oarchive(oss);
+        detail::to_archive(oarchive, idata.isl_ptr, *algo_ptr, idata.r_pol, idata.s_pol, pop.m_prob,
+                           pop.m_champion_x, pop.m_champion_f, pop.m_e, pop.m_seed);
     }
 
-    // Lock & append.
+    detail::archi_ckpt_write(os, static_cast<std::uint64_t>(pop.m_ID.size()));
+    detail::archi_ckpt_write(os, static_cast<std::uint64_t>(pop.m_prob.get_nx()));
+    detail::archi_ckpt_write(os, static_cast<std::uint64_t>(pop.m_prob.get_nf()));
+    detail::archi_ckpt_write_blob(os, oss.str());
+    os.write(reinterpret_cast<const char *>(pop.m_ID.data()),
+             boost::numeric_cast<std::streamsize>(pop.m_ID.size() * sizeof(unsigned long long)));
+    detail::archi_ckpt_write_matrix(os, pop.m_x);
+    detail::archi_ckpt_write_matrix(os, pop.m_f);
+
+    return version;
+}
+
+// Read an island record written by write_ckpt_island(). max_size
+// is the number of bytes left in the file.
+std::unique_ptr<island> archipelago::read_ckpt_island(std::istream &is, unsigned long long max_size,
+                                                      const std::string &filename)
+{
+    std::uint64_t size{}, nx{}, nf{};
+    detail::archi_ckpt_read(is, size, filename);
+    detail::archi_ckpt_read(is, nx, filename);
+    detail::archi_ckpt_read(is, nf, filename);
+
+    const auto blob = detail::archi_ckpt_read_blob(is, max_size, filename);
+
+    std::unique_ptr<detail::isl_inner_base> isl_ptr;
+    algorithm algo;
+    r_policy r_pol;
+    s_policy s_pol;
+    population pop;
+    {
+        std::istringstream iss(blob);
+        boost::archive::binary_iarchive iarchive(iss);
+        detail::from_archive(iarchive, isl_ptr, algo, r_pol, s_pol, pop.m_prob, pop.m_champion_x, pop.m_champion_f,
+                             pop.m_e, pop.m_seed);
+    }
+
+    // Check the dimensions before allocating memory.
+    if (nx != pop.m_prob.get_nx() || nf != pop.m_prob.get_nf() || size > max_size / (1u + nx + nf) / 8u) {
+        detail::archi_ckpt_corrupted(filename);
+    }
+
+    const auto s = boost::numeric_cast<population::size_type>(size);
+    pop.m_ID.resize(s);
+    detail::archi_ckpt_read_bytes(is, reinterpret_cast<char *>(pop.m_ID.data()), size * sizeof(unsigned long long),
+                                  filename);
+    pop.m_x.resize(s, vector_double(boost::numeric_cast<vector_double::size_type>(nx)));
+    detail::archi_ckpt_read_matrix(is, pop.m_x, filename);
+    pop.m_f.resize(s, vector_double(boost::numeric_cast<vector_double::size_type>(nf)));
+    detail::archi_ckpt_read_matrix(is, pop.m_f, filename);
+
+    auto retval = std::make_unique<island>();
+    retval->m_ptr = std::make_unique<detail::island_data>(std::move(isl_ptr), std::move(algo), std::move(pop), r_pol,
+                                                          s_pol);
+
+    return retval;
+}
+
+/// Save a checkpoint.
+/**
+ * \verbatim embed:rst:leading-asterisk
+ * .. versionadded:: 2.20
+ *
+ * This method will save the state of the archipelago into the binary checkpoint
+ * file ``filename``, which can be read back via :cpp:func:`~pagmo::archipelago::load_checkpoint()`.
+ * The state saved in the checkpoint is the same saved by the serialization of the archipelago.
+ *
+ * The checkpoint file is an alternative to the serialization of the archipelago, designed
+ * for frequent snapshots of large archipelagos:
+ *
+ * * the decision and fitness vectors of the population of each island are stored
+ *   as contiguous, 8-byte aligned row-major matrices of doubles (preceded by
+ *   the IDs of the individuals). The offsets of the islands' data within the file
+ *   are recorded in an index at the end of the file, so that the matrices can be read
+ *   (or memory-mapped by external tools) without any parsing. The rest of the state
+ *   (the UDIs, the algorithms, the problems, the topology, etc.) is stored as
+ *   Boost binary archives;
+ * * the checkpoints are incremental: if ``filename`` is the last checkpoint file
+ *   written (or read) by this archipelago, only the islands whose algorithm or population
+ *   changed since then are appended to the file, followed by a new index. Otherwise, or
+ *   when the data superseded by the incremental checkpoints exceeds the size of the
+ *   current data, the file is written from scratch, and it atomically replaces
+ *   the previous file (if any).
+ *
+ * It is safe to call this method while the archipelago is evolving, in which case
+ * the state of each island will be a snapshot taken at some point during the
+ * execution of this method.
+ *
+ * The data is written in the native binary representation of the machine, and thus
+ * the checkpoint files are not portable across architectures. The incremental
+ * checkpoints assume that ``filename`` is not modified by other means in between
+ * calls to this method.
+ *
+ * The incremental checkpoints never overwrite the data of the previous checkpoint: each
+ * index is followed by a trailer pointing to the trailer of the previous checkpoint in the file,
+ * and the header of the file records the end of the last checkpoint which was completely written.
+ * If an incremental checkpoint is interrupted (e.g., due to an exception or a crash),
+ * :cpp:func:`~pagmo::archipelago::load_checkpoint()` will thus fall back to the last
+ * checkpoint in the file which can be read back, and the next checkpoint will be
+ * written from scratch.
+ *
+ * \endverbatim
+ *
+ * @param filename the name of the checkpoint file.
+ *
+ * @return the number of islands written to the checkpoint file.
+ *
+ * @throws std::runtime_error if the file cannot be written.
+ * @throws unspecified any exception thrown by:
+ * - threading primitives,
+ * - the serialization of the islands' and of the archipelago's state,
+ * - memory errors in standard containers.
+ */
+archipelago::size_type archipelago::save_checkpoint(const std::string &filename) const
+{
+    std::lock_guard<std::mutex> lock(m_ckpt_mutex);
+
+    const auto n_islands = m_islands.size();
+
+    // Establish if we can append to the last checkpoint: the file must
+    // be the one we last wrote/read, unchanged since then, and not bloated
+    // by the data superseded by previous incremental checkpoints.
+    bool incremental = false;
+    if (!m_ckpt.filename.empty() && m_ckpt.filename == filename && m_ckpt.file_size <= 2u * m_ckpt.live_size) {
+        std::ifstream ifs(filename, std::ios::binary | std::ios::ate);
+        if (ifs && static_cast<std::streamoff>(ifs.tellg()) == boost::numeric_cast<std::streamoff>(m_ckpt.file_size)
+            && ifs.seekg(static_cast<std::streamoff>(sizeof(detail::archi_ckpt_magic) + sizeof(std::uint64_t)))) {
+            std::uint64_t token{};
+            incremental = ifs.read(reinterpret_cast<char *>(&token), sizeof(token)) && token == m_ckpt.token;
+        }
+    }
+
+    // NOTE: the new state is committed to m_ckpt only on success.
+    // On failure, m_ckpt is reset so that the next checkpoint
+    // will be written from scratch.
+    ckpt_state new_ckpt;
+    size_type n_written = 0;
+    const auto tmp_filename = filename + ".tmp";
+
+    try {
+        std::ofstream ofs;
+        if (incremental) {
+            new_ckpt = m_ckpt;
+            ofs.open(filename, std::ios::binary | std::ios::in | std::ios::out);
+            ofs.seekp(0, std::ios::end);
+        } else {
+            new_ckpt.filename = filename;
+            // NOTE: the token identifies the checkpoint file written from scratch,
+            // it is used to detect if the file has been overwritten by someone else.
+            std::random_device rd;
+            new_ckpt.token = (static_cast<unsigned long long>(rd()) << 32) ^ rd();
+
+            ofs.open(tmp_filename, std::ios::binary | std::ios::trunc);
+            ofs.write(detail::archi_ckpt_magic, sizeof(detail::archi_ckpt_magic));
+            detail::archi_ckpt_write(ofs, detail::archi_ckpt_format_version);
+            detail::archi_ckpt_write(ofs, static_cast<std::uint64_t>(new_ckpt.token));
+            // NOTE: the end of the last committed trailer is filled in below.
+            detail::archi_ckpt_write(ofs, std::uint64_t(0));
+        }
+        if (!ofs) {
+            pagmo_throw(std::runtime_error, "cannot open the checkpoint file '" + filename + "' for writing");
+        }
+
+        // Write the records of the new and changed islands.
+        new_ckpt.offsets.resize(n_islands);
+        new_ckpt.sizes.resize(n_islands);
+        new_ckpt.versions.resize(n_islands);
+        for (size_type i = 0; i < n_islands; ++i) {
+            if (incremental && i < m_ckpt.versions.size()
+                && m_ckpt.versions[i] == m_islands[i]->m_ptr->version.load()) {
+                continue;
+            }
+
+            const auto offset = detail::archi_ckpt_tell(ofs);
+            new_ckpt.versions[i] = write_ckpt_island(ofs, i);
+            new_ckpt.offsets[i] = offset;
+            new_ckpt.sizes[i] = detail::archi_ckpt_tell(ofs) - offset;
+            ++n_written;
+        }
+
+        // Write the index: the islands' offsets and the state of the archipelago.
+        // NOTE: the index is followed by the trailer, which records the end
+        // of the previous trailer, the offset of the index and the end marker.
+        std::ostringstream oss;
+        {
+            boost::archive::binary_oarchive oarchive(oss);
+            detail::to_archive(oarchive, get_migrants_db(), get_migration_log(), get_topology(),
+                               m_migr_type.load(std::memory_order_relaxed),
+                               m_migr_handling.load(std::memory_order_relaxed));
+        }
+        const auto index_offset = detail::archi_ckpt_tell(ofs);
+        detail::archi_ckpt_write(ofs, static_cast<std::uint64_t>(n_islands));
+        for (const auto &offset : new_ckpt.offsets) {
+            detail::archi_ckpt_write(ofs, static_cast<std::uint64_t>(offset));
+        }
+        detail::archi_ckpt_write_blob(ofs, oss.str());
+        detail::archi_ckpt_write(ofs, static_cast<std::uint64_t>(incremental ? m_ckpt.file_size : 0u));
+        detail::archi_ckpt_write(ofs, index_offset);
+        detail::archi_ckpt_write(ofs, detail::archi_ckpt_end_marker);
+        new_ckpt.file_size = detail::archi_ckpt_tell(ofs);
+
+        // Commit the new trailer in the header, after the rest of the data
+        // has been handed over to the OS.
+        // NOTE: if the process dies before this point, the header
+        // still points to the trailer of the previous checkpoint.
+        ofs.flush();
+        ofs.seekp(static_cast<std::streamoff>(detail::archi_ckpt_committed_offset));
+        detail::archi_ckpt_write(ofs, static_cast<std::uint64_t>(new_ckpt.file_size));
+        ofs.close();
+        if (!ofs) {
+            pagmo_throw(std::runtime_error, "error writing to the checkpoint file '" + filename + "'");
+        }
+
+        if (!incremental) {
+            // NOTE: std::rename() fails on some platforms if the destination
+            // exists. In such case, remove the destination and try again.
+            if (std::rename(tmp_filename.c_str(), filename.c_str()) != 0) {
+                std::remove(filename.c_str());
+                if (std::rename(tmp_filename.c_str(), filename.c_str()) != 0) {
+                    pagmo_throw(std::runtime_error, "cannot replace the checkpoint file '" + filename + "'");
+                }
+            }
+        }
+
+        new_ckpt.live_size = detail::archi_ckpt_header_size + (new_ckpt.file_size - index_offset);
+        for (const auto &s : new_ckpt.sizes) {
+            new_ckpt.live_size += s;
+        }
+    } catch (...) {
+        if (!incremental) {
+            std::remove(tmp_filename.c_str());
+        }
+        m_ckpt = ckpt_state{};
+        throw;
+    }
+
+    m_ckpt = std::move(new_ckpt);
+
+    return n_written;
+}
+
+/// Load a checkpoint.
+/**
+ * \verbatim embed:rst:leading-asterisk
+ * .. versionadded:: 2.20
+ *
+ * This method will replace the state of the archipelago with the state
+ * stored in the checkpoint file ``filename``, written by
+ * :cpp:func:`~pagmo::archipelago::save_checkpoint()`. Before loading
+ * the checkpoint, this method will wait for any ongoing evolution to finish.
+ *
+ * If the last checkpoint in the file is incomplete (e.g., because an incremental checkpoint
+ * was interrupted), the most recent checkpoint in the file which can be read back will be
+ * loaded instead.
+ *
+ * After a successful load, the next checkpoint written to ``filename``
+ * by :cpp:func:`~pagmo::archipelago::save_checkpoint()` will be incremental, unless
+ * an older checkpoint was loaded.
+ * \endverbatim
+ *
+ * @param filename the name of the checkpoint file.
+ *
+ * @throws std::runtime_error if the file cannot be opened, if it is not
+ * a valid checkpoint file, or if it was written with an unsupported version
+ * of the checkpoint format.
+ * @throws unspecified any exception thrown by:
+ * - the deserialization of the islands' and of the archipelago's state,
+ * - the public interface of pagmo::archipelago,
+ * - memory errors in standard containers.
+ */
+void archipelago::load_checkpoint(const std::string &filename)
+{
+    // Make sure all evolutions are finished before
+    // attempting to load the checkpoint.
+    wait_check_ignore();
+
+    std::ifstream ifs(filename, std::ios::binary | std::ios::ate);
+    if (!ifs) {
+        pagmo_throw(std::runtime_error, "cannot open the checkpoint file '" + filename + "' for reading");
+    }
+    const auto file_size = static_cast<std::uint64_t>(static_cast<std::streamoff>(ifs.tellg()));
+    ifs.seekg(0);
+
+    // The header.
+    char magic[sizeof(detail::archi_ckpt_magic)] = {};
+    if (file_size < detail::archi_ckpt_header_size + detail::archi_ckpt_trailer_size || !ifs.read(magic, sizeof(magic))
+        || !std::equal(magic, magic + sizeof(magic), static_cast<const char *>(detail::archi_ckpt_magic))) {
+        pagmo_throw(std::runtime_error, "the file '" + filename + "' is not a valid archipelago checkpoint file");
+    }
+    std::uint64_t format_version{}, token{}, committed_end{};
+    detail::archi_ckpt_read(ifs, format_version, filename);
+    if (format_version != detail::archi_ckpt_format_version) {
+        pagmo_throw(std::runtime_error, "the checkpoint file '" + filename + "' was written with version "
+                                            + std::to_string(format_version)
+                                            + " of the checkpoint format, but only version "
+                                            + std::to_string(detail::archi_ckpt_format_version) + " is supported");
+    }
+    detail::archi_ckpt_read(ifs, token, filename);
+    detail::archi_ckpt_read(ifs, committed_end, filename);
+
+    // Check if a trailer ending at the offset end could be present in the file.
+    auto valid_end = [file_size](std::uint64_t end) {
+        return end >= detail::archi_ckpt_header_size + detail::archi_ckpt_trailer_size && end <= file_size
+               && end % 8u == 0u;
+    };
+
+    // Read the trailer ending at the offset end. Returns the end of the previous
+    // trailer and the offset of the index.
+    auto read_trailer = [&ifs, &filename](std::uint64_t end) {
+        std::uint64_t prev_end{}, index_offset{}, end_marker{};
+        ifs.clear();
+        ifs.seekg(boost::numeric_cast<std::streamoff>(end - detail::archi_ckpt_trailer_size));
+        detail::archi_ckpt_read(ifs, prev_end, filename);
+        detail::archi_ckpt_read(ifs, index_offset, filename);
+        detail::archi_ckpt_read(ifs, end_marker, filename);
+        if (end_marker != detail::archi_ckpt_end_marker || index_offset < detail::archi_ckpt_header_size
+            || index_offset > end - detail::archi_ckpt_trailer_size) {
+            detail::archi_ckpt_corrupted(filename);
+        }
+        return std::make_pair(prev_end, index_offset);
+    };
+
+    migrants_db_t tmp_migrants;
+    migration_log_t tmp_migr_log;
+    topology tmp_topology;
+    migration_type tmp_migr_type{};
+    migrant_handling tmp_migr_handling{};
+    container_t tmp_islands;
+    std::vector<std::uint64_t> offsets;
+    std::vector<unsigned long long> sizes;
+    unsigned long long live_size = 0;
+
+    // Read into the temporaries above the checkpoint whose trailer ends at the offset end.
+    auto read_snapshot = [&](std::uint64_t end) {
+        // The trailer.
+        const auto index_offset = read_trailer(end).second;
+
+        // The index.
+        ifs.seekg(boost::numeric_cast<std::streamoff>(index_offset));
+        std::uint64_t n_islands{};
+        detail::archi_ckpt_read(ifs, n_islands, filename);
+        if (n_islands > (end - index_offset) / sizeof(std::uint64_t)) {
+            detail::archi_ckpt_corrupted(filename);
+        }
+        offsets.resize(boost::numeric_cast<std::vector<std::uint64_t>::size_type>(n_islands));
+        for (auto &offset : offsets) {
+            detail::archi_ckpt_read(ifs, offset, filename);
+            if (offset < detail::archi_ckpt_header_size || offset >= index_offset) {
+                detail::archi_ckpt_corrupted(filename);
+            }
+        }
+        const auto blob = detail::archi_ckpt_read_blob(ifs, end - index_offset, filename);
+        {
+            std::istringstream iss(blob);
+            boost::archive::binary_iarchive iarchive(iss);
+            detail::from_archive(iarchive, tmp_migrants, tmp_migr_log, tmp_topology, tmp_migr_type,
+                                 tmp_migr_handling);
+        }
+
+        // The islands.
+        tmp_islands.clear();
+        sizes.clear();
+        live_size = detail::archi_ckpt_header_size + (end - index_offset);
+        for (const auto &offset : offsets) {
+            ifs.seekg(boost::numeric_cast<std::streamoff>(offset));
+            tmp_islands.push_back(read_ckpt_island(ifs, index_offset - offset, filename));
+            sizes.push_back(static_cast<std::uint64_t>(static_cast<std::streamoff>(ifs.tellg())) - offset);
+            live_size += sizes.back();
+        }
+    };
+
+    // Locate the most recent checkpoint in the file. This is normally the one
+    // at the end of the file. If its trailer is not there (e.g., because an
+    // incremental checkpoint was interrupted), use the last committed one.
+    auto end = file_size;
+    try {
+        read_trailer(end);
+    } catch (const std::runtime_error &) {
+        if (!valid_end(committed_end)) {
+            throw;
+        }
+        end = committed_end;
+    }
+
+    // Read the checkpoint. If it cannot be read back (e.g., because the
+    // data preceding its trailer did not reach the disk), walk back the
+    // chain of trailers until a readable checkpoint is found.
+    std::exception_ptr first_error;
+    while (true) {
+        try {
+            read_snapshot(end);
+            break;
+        } catch (const std::exception &) {
+            if (!first_error) {
+                first_error = std::current_exception();
+            }
+        }
+
+        std::uint64_t prev_end{};
+        try {
+            prev_end = read_trailer(end).first;
+        } catch (const std::runtime_error &) {
+        }
+        if (!valid_end(prev_end) || prev_end >= end) {
+            std::rethrow_exception(first_error);
+        }
+        end = prev_end;
+    }
+
+    // NOTE: from here on, mirror the deserialization of the archipelago.
+    try {
+        m_islands = std::move(tmp_islands);
+
+        // Assign the archi pointers and the island indices.
+        for (size_type i = 0; i < m_islands.size(); ++i) {
+            m_islands[i]->m_ptr->archi_ptr = this;
+            m_islands[i]->m_ptr->archi_idx = i;
+        }
+
+        m_migrants.set_all(std::move(tmp_migrants));
+        set_migration_log_entries(std::move(tmp_migr_log));
+        m_topology = std::move(tmp_topology);
+        m_migr_type.store(tmp_migr_type, std::memory_order_relaxed);
+        m_migr_handling.store(tmp_migr_handling, std::memory_order_relaxed);
+    } catch (...) {
+        *this = archipelago{};
+        throw;
+    }
+
+    // Record the layout of the file, so that the next
+    // checkpoint can be incremental.
+    ckpt_state new_ckpt;
+    new_ckpt.filename = filename;
+    new_ckpt.token = token;
+    // NOTE: if the checkpoint is not the last one in the file, the size
+    // recorded here will not match the size of the file, and the next
+    // checkpoint will be written from scratch.
+    new_ckpt.file_size = end;
+    new_ckpt.live_size = live_size;
+    new_ckpt.offsets.assign(offsets.begin(), offsets.end());
+    new_ckpt.sizes = std::move(sizes);
+    for (const auto &iptr : m_islands) {
+        new_ckpt.versions.push_back(iptr->m_ptr->version.load());
+    }
+
+    std::lock_guard<std::mutex> lock(m_ckpt_mutex);
+    m_ckpt = std::move(new_ckpt);
+}
+
+// Check if the migration entries need to be
+// produced by the islands.
+bool archipelago::migration_log_enabled() const
+{
+    return get_migr_log_state()->mode != migration_log_mode::off;
+}
+
+// Append entries to the migration log.
+void archipelago::append_migration_log(migration_log_t &&mlog)
+{
+    // NOTE: keep a reference to the current state, so that
+    // it is not destroyed by a concurrent change of configuration.
+    get_migr_log_state()->append(std::move(mlog));
+}
+
+// Replace the entries of the migration log.
+void archipelago::set_migration_log_entries(migration_log_t &&mlog)
+{
     std::lock_guard<std::mutex> lock(m_migr_log_mutex);
-    m_migr_log.insert(m_migr_log.end(), mlog.begin(), mlog.end());
+    get_migr_log_state()->set_all(std::move(mlog));
 }
 
 // Extract the migrants in the db entry for island i.
 // After extraction, the db entry will be empty.
 individuals_group_t archipelago::extract_migrants(size_type i)
 {
-    std::lock_guard<std::mutex> lock(m_migrants_mutex);
-
+    // NOTE: no locking needed, the slots of the
+    // migrants db are accessed atomically.
     if (i >= m_migrants.size()) {
         pagmo_throw(std::out_of_range, "cannot access the migrants of the island at index " + std::to_string(i)
                                            + ": the migrants database has a size of only "
                                            + std::to_string(m_migrants.size()));
     }
 
-    // Move-construct the return value.
-    individuals_group_t retval(std::move(m_migrants[i]));
-
-    // Ensure the tuple we moved-from is completely
-    // cleared out.
-    std::get<0>(m_migrants[i]).clear();
-    std::get<1>(m_migrants[i]).clear();
-    std::get<2>(m_migrants[i]).clear();
-
-    return retval;
+    return m_migrants.extract(i);
 }
 
 // Get the migrants in the db entry for island i.
 // This function will *not* clear out the db entry.
 individuals_group_t archipelago::get_migrants(size_type i) const
 {
-    std::lock_guard<std::mutex> lock(m_migrants_mutex);
-
     if (i >= m_migrants.size()) {
         pagmo_throw(std::out_of_range, "cannot access the migrants of the island at index " + std::to_string(i)
                                            + ": the migrants database has a size of only "
@@ -690,24 +1740,19 @@ individuals_group_t archipelago::get_migrants(size_type i) const
     }
 
     // Return a copy of the migrants for island i.
-    return m_migrants[i];
+    return m_migrants.get(i);
 }
 
 // Move-insert in the db entry for island i a set of migrants.
 void archipelago::set_migrants(size_type i, individuals_group_t &&inds)
 {
-    std::lock_guard<std::mutex> lock(m_migrants_mutex);
-
     if (i >= m_migrants.size()) {
         pagmo_throw(std::out_of_range, "cannot access the migrants of the island at index " + std::to_string(i)
                                            + ": the migrants database has a size of only "
                                            + std::to_string(m_migrants.size()));
     }
 
-    // Move in the new individuals.
-    std::get<0>(m_migrants[i]) = std::move(std::get<0>(inds));
-    std::get<1>(m_migrants[i]) = std::move(std::get<1>(inds));
-    std::get<2>(m_migrants[i]) = std::move(std::get<2>(inds));
+    m_migrants.set(i, std::move(inds));
 }
 
 /// Get a copy of the topology.
@@ -854,6 +1899,7 @@ std::ostream &operator<<(std::ostream &os, const archipelago &archi)
     stream(os, "Topology: ", archi.get_topology().get_name(), "\n");
     stream(os, "Migration type: ", archi.get_migration_type(), "\n");
     stream(os, "Migrant handling policy: ", archi.get_migrant_handling(), "\n");
+    stream(os, "Migration log mode: ", archi.get_migration_log_mode(), "\n");
     stream(os, "Status: ", archi.status(), "\n\n");
     stream(os, "Islands summaries:\n\n");
     detail::table t({"#", "Type", "Algo", "Prob", "Size", "Status"}, "\t");
@@ -868,7 +1914,8 @@ std::ostream &operator<<(std::ostream &os, const archipelago &archi)
 
 #if !defined(PAGMO_DOXYGEN_INVOKED)
 
-// Provide the stream operator overloads for migration_type and migrant_handling.
+// Provide the stream operator overloads for migration_type, migrant_handling
+// and migration_log_mode.
 std::ostream &operator<<(std::ostream &os, migration_type mt)
 {
     os << (mt == migration_type::p2p ? "point-to-point" : "broadcast");
@@ -881,6 +1928,24 @@ std::ostream &operator<<(std::ostream &os, migrant_handling mh)
     return os;
 }
 
+std::ostream &operator<<(std::ostream &os, migration_log_mode mlm)
+{
+    switch (mlm) {
+        case migration_log_mode::unbounded:
+            os << "unbounded";
+            break;
+        case migration_log_mode::bounded:
+            os << "bounded";
+            break;
+        case migration_log_mode::off:
+            os << "off";
+            break;
+        case migration_log_mode::stream:
+            os << "stream";
+    }
+    return os;
+}
+
 #endif
 
 } // namespace pagmo
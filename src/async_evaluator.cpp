@@ -0,0 +1,251 @@
+/* Copyright 2017-2021 PaGMO development team
+
+This file is part of the PaGMO library.
+
+The PaGMO library is free software; you can redistribute it and/or modify
+it under the terms of either:
+
+  * the GNU Lesser General Public License as published by the Free
+    Software Foundation; either version 3 of the License, or (at your
+    option) any later version.
+
+or
+
+  * the GNU General Public License as published by the Free Software
+    Foundation; either version 3 of the License, or (at your option) any
+    later version.
+
+or both in parallel, as here.
+
+The PaGMO library is distributed in the hope that it will be useful, but
+WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+for more details.
+
+You should have received copies of the GNU General Public License and the
+GNU Lesser General Public License along with the PaGMO library.  If not,
+see https://www.gnu.org/licenses/. */
+
+#include <algorithm>
+#include <cassert>
+#include <condition_variable>
+#include <cstdlib>
+#include <deque>
+#include <exception>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <tuple>
+#include <utility>
+#include <vector>
+
+#include <pagmo/async_evaluator.hpp>
+#include <pagmo/exceptions.hpp>
+#include <pagmo/problem.hpp>
+#include <pagmo/threading.hpp>
+#include <pagmo/types.hpp>
+
+namespace pagmo
+{
+
+struct async_evaluator::impl {
+    // An evaluation (either pending or completed).
+    struct job {
+        ticket_type ticket;
+        vector_double dv;
+        vector_double fv;
+        std::exception_ptr eptr;
+    };
+
+    explicit impl(const problem &p, unsigned n_workers) : m_prob(p)
+    {
+        const auto ts = m_prob.get_thread_safety();
+        if (ts < thread_safety::basic) {
+            pagmo_throw(std::invalid_argument,
+                        "Cannot use an async_evaluator on the problem '" + m_prob.get_name()
+                            + "', which does not provide the required level of thread safety");
+        }
+
+        if (n_workers == 0u) {
+            n_workers = std::max(1u, std::thread::hardware_concurrency());
+        }
+
+        // If the problem provides only the basic thread safety level,
+        // each worker will use its own copy of the problem. Otherwise,
+        // all the workers share m_prob.
+        if (ts == thread_safety::basic) {
+            for (auto i = 0u; i < n_workers; ++i) {
+                m_copies.push_back(std::make_unique<const problem>(m_prob));
+            }
+        }
+
+        try {
+            for (auto i = 0u; i < n_workers; ++i) {
+                m_workers.emplace_back([this, i]() { this->run_worker(m_copies.empty() ? m_prob : *m_copies[i]); });
+            }
+            // LCOV_EXCL_START
+        } catch (...) {
+            stop();
+            throw;
+            // LCOV_EXCL_STOP
+        }
+    }
+    ~impl()
+    {
+        stop();
+    }
+
+    // Stop and join the workers. The evaluations which
+    // have not started yet are discarded.
+    void stop() noexcept
+    {
+        {
+            std::unique_lock lock(m_mutex);
+            m_stop = true;
+            m_queue.clear();
+        }
+        m_cond_in.notify_all();
+        for (auto &t : m_workers) {
+            t.join();
+        }
+        m_workers.clear();
+    }
+
+    void run_worker(const problem &prob)
+    {
+        try {
+            while (true) {
+                std::unique_lock lock(m_mutex);
+
+                m_cond_in.wait(lock, [this]() { return m_stop || !m_queue.empty(); });
+
+                if (m_stop) {
+                    break;
+                }
+
+                auto cur(std::move(m_queue.front()));
+                m_queue.pop_front();
+
+                lock.unlock();
+
+                // Run the evaluation, storing any exception that might be thrown.
+                try {
+                    cur.fv = prob.fitness(cur.dv);
+                    if (&prob != &m_prob) {
+                        // Keep the evaluation counter of m_prob consistent.
+                        m_prob.increment_fevals(1);
+                    }
+                } catch (...) {
+                    cur.eptr = std::current_exception();
+                }
+
+                lock.lock();
+                m_done.push_back(std::move(cur));
+                lock.unlock();
+
+                m_cond_out.notify_one();
+            }
+            // LCOV_EXCL_START
+        } catch (...) {
+            // The errors we could get here come from the threading primitives
+            // or from memory allocation failures in the queues. There is not
+            // much that can be done to recover from this.
+            std::abort();
+            // LCOV_EXCL_STOP
+        }
+    }
+
+    problem m_prob;
+    std::vector<std::unique_ptr<const problem>> m_copies;
+    // NOTE: all the members below are protected by m_mutex.
+    bool m_stop = false;
+    ticket_type m_next_ticket = 0;
+    unsigned long long m_n_pending = 0;
+    std::deque<job> m_queue;
+    std::deque<job> m_done;
+    mutable std::mutex m_mutex;
+    std::condition_variable m_cond_in;
+    std::condition_variable m_cond_out;
+    // NOTE: this must come last, so that the workers
+    // are started after all the other members have been inited.
+    std::vector<std::thread> m_workers;
+};
+
+// Ctor from problem and number of worker threads.
+async_evaluator::async_evaluator(const problem &p, unsigned n_workers)
+    : m_impl(std::make_unique<impl>(p, n_workers))
+{
+}
+
+// NOTE: the workers are stopped and joined by the impl dtor.
+async_evaluator::~async_evaluator() = default;
+
+// Submit a decision vector for evaluation.
+async_evaluator::ticket_type async_evaluator::submit(vector_double dv)
+{
+    if (dv.size() != m_impl->m_prob.get_nx()) {
+        pagmo_throw(std::invalid_argument, "Cannot submit a decision vector of size " + std::to_string(dv.size())
+                                               + " to an async_evaluator for a problem of dimension "
+                                               + std::to_string(m_impl->m_prob.get_nx()));
+    }
+
+    ticket_type ticket;
+    {
+        std::unique_lock lock(m_impl->m_mutex);
+        ticket = m_impl->m_next_ticket;
+        m_impl->m_queue.push_back(impl::job{ticket, std::move(dv), {}, {}});
+        ++m_impl->m_next_ticket;
+        ++m_impl->m_n_pending;
+    }
+    m_impl->m_cond_in.notify_one();
+
+    return ticket;
+}
+
+// Wait for the next completed evaluation.
+async_evaluator::result_type async_evaluator::retrieve()
+{
+    std::unique_lock lock(m_impl->m_mutex);
+
+    if (m_impl->m_n_pending == 0u) {
+        pagmo_throw(std::invalid_argument, "Cannot retrieve an evaluation from an async_evaluator with no pending "
+                                           "evaluations");
+    }
+
+    m_impl->m_cond_out.wait(lock, [this]() { return !m_impl->m_done.empty(); });
+
+    auto cur(std::move(m_impl->m_done.front()));
+    m_impl->m_done.pop_front();
+    --m_impl->m_n_pending;
+
+    lock.unlock();
+
+    if (cur.eptr) {
+        std::rethrow_exception(cur.eptr);
+    }
+
+    return result_type(cur.ticket, std::move(cur.dv), std::move(cur.fv));
+}
+
+// Number of pending evaluations.
+unsigned long long async_evaluator::get_n_pending() const
+{
+    std::unique_lock lock(m_impl->m_mutex);
+    return m_impl->m_n_pending;
+}
+
+// Number of worker threads.
+unsigned async_evaluator::get_n_workers() const
+{
+    return static_cast<unsigned>(m_impl->m_workers.size());
+}
+
+// Problem getter.
+const problem &async_evaluator::get_problem() const
+{
+    return m_impl->m_prob;
+}
+
+} // namespace pagmo
@@ -28,9 +28,15 @@ see https://www.gnu.org/licenses/. */
 
 #include <algorithm>
 #include <cassert>
+#include <cstddef>
 #include <iterator>
 #include <limits>
+#include <memory>
+#include <mutex>
 #include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
 
 #if defined(_MSC_VER)
 
@@ -60,8 +66,64 @@ see https://www.gnu.org/licenses/. */
 namespace pagmo
 {
 
+namespace detail
+{
+
+namespace
+{
+
+// Pool of copies of a problem, used by thread_bfe
+// for problems providing only the basic thread safety level.
+// The copies are checked out by the parallel tasks and returned
+// to the pool when the task is done, so that later tasks can reuse
+// them. The pool lives only for the duration of a single call to
+// thread_bfe::operator(), thus no copy (and no mutable state
+// within a copy) outlives the call.
+class thread_bfe_pool
+{
+public:
+    explicit thread_bfe_pool(const problem &p) : m_prob(p) {}
+
+    // Check out a copy of the problem.
+    std::unique_ptr<const problem> get()
+    {
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            if (!m_copies.empty()) {
+                auto retval = std::move(m_copies.back());
+                m_copies.pop_back();
+                return retval;
+            }
+        }
+
+        // NOTE: copy outside the lock.
+        return std::make_unique<const problem>(m_prob);
+    }
+    // Return a copy to the pool.
+    void put(std::unique_ptr<const problem> &&c)
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_copies.push_back(std::move(c));
+    }
+
+private:
+    const problem &m_prob;
+    std::mutex m_mutex;
+    std::vector<std::unique_ptr<const problem>> m_copies;
+};
+
+} // namespace
+
+} // namespace detail
+
+// Default ctor.
+thread_bfe::thread_bfe() : thread_bfe(0) {}
+
+// Ctor from grain size.
+thread_bfe::thread_bfe(std::size_t grain_size) : m_grain_size(grain_size) {}
+
 // Call operator.
-vector_double thread_bfe::operator()(problem p, const vector_double &dvs) const
+vector_double thread_bfe::operator()(const problem &p, const vector_double &dvs) const
 {
     // Fetch a few quantities from the problem.
     // Problem dimension.
@@ -88,15 +150,29 @@ vector_double thread_bfe::operator()(problem p, const vector_double &dvs) const
     // LCOV_EXCL_STOP
     vector_double retval(n_dvs * f_dim);
 
+    // Check if the UDP can compute fitnesses directly from/into
+    // the input/output buffers.
+    const auto use_fitness_into = p.has_fitness_into();
+
     // Functor to implement the fitness evaluation of a range of input dvs. begin/end are the indices
     // of the individuals in dv (ranging from 0 to n_dvs), the resulting fitnesses will be written directly into
     // retval.
-    auto range_evaluator = [&dvs, &retval, n_dim, f_dim, n_dvs](const problem &prob, decltype(dvs.size()) begin,
-                                                                decltype(dvs.size()) end) {
+    auto range_evaluator = [&dvs, &retval, n_dim, f_dim, n_dvs, use_fitness_into](
+                               const problem &prob, decltype(dvs.size()) begin, decltype(dvs.size()) end) {
         assert(begin <= end);
         assert(end <= n_dvs);
         (void)n_dvs;
 
+        if (use_fitness_into) {
+            // No need for temporary storage, evaluate
+            // directly from dvs into retval.
+            for (; begin != end; ++begin) {
+                prob.fitness_into(dvs.data() + begin * n_dim, retval.data() + begin * f_dim);
+            }
+
+            return;
+        }
+
         // Temporary dv that will be used for fitness evaluation.
         vector_double tmp_dv(n_dim);
         for (; begin != end; ++begin) {
@@ -123,17 +199,24 @@ vector_double thread_bfe::operator()(problem p, const vector_double &dvs) const
     };
 
     using range_t = tbb::blocked_range<decltype(dvs.size())>;
+    const auto grain_size = m_grain_size ? static_cast<decltype(dvs.size())>(m_grain_size) : 1u;
     if (p.get_thread_safety() >= thread_safety::constant) {
-        // We can concurrently call the objfun on the input prob, hence we can
+        // We can concurrently call the objfun on a copy of the input prob, hence we can
         // capture it by reference and do all the fitness calls on the same object.
-        tbb::parallel_for(range_t(0u, n_dvs), [&p, &range_evaluator](const range_t &range) {
-            range_evaluator(p, range.begin(), range.end());
+        // NOTE: we make a copy in order to leave the fevals counter of p untouched.
+        const problem p_copy(p);
+        tbb::parallel_for(range_t(0u, n_dvs, grain_size), [&p_copy, &range_evaluator](const range_t &range) {
+            range_evaluator(p_copy, range.begin(), range.end());
         });
     } else if (p.get_thread_safety() == thread_safety::basic) {
-        // We cannot concurrently call the objfun on the input prob. We will need
-        // to make a copy of p for each parallel iteration.
-        tbb::parallel_for(range_t(0u, n_dvs), [p, &range_evaluator](const range_t &range) {
-            range_evaluator(p, range.begin(), range.end());
+        // We cannot concurrently call the objfun on the same problem. Each task
+        // will check out a copy of p from a pool which is destroyed at the end
+        // of this call, so that copies are reused only within a single call.
+        detail::thread_bfe_pool pool(p);
+        tbb::parallel_for(range_t(0u, n_dvs, grain_size), [&pool, &range_evaluator](const range_t &range) {
+            auto p_copy = pool.get();
+            range_evaluator(*p_copy, range.begin(), range.end());
+            pool.put(std::move(p_copy));
         });
     } else {
         pagmo_throw(std::invalid_argument, "Cannot use a thread_bfe on the problem '" + p.get_name()
@@ -143,10 +226,34 @@ vector_double thread_bfe::operator()(problem p, const vector_double &dvs) const
     return retval;
 }
 
+// Extra info.
+std::string thread_bfe::get_extra_info() const
+{
+    if (m_grain_size) {
+        return "\tGrain size: " + std::to_string(m_grain_size);
+    }
+    return "";
+}
+
 // Serialization support.
 template <typename Archive>
-void thread_bfe::serialize(Archive &, unsigned)
+void thread_bfe::save(Archive &ar, unsigned) const
 {
+    ar << m_grain_size;
+}
+
+template <typename Archive>
+void thread_bfe::load(Archive &ar, unsigned version)
+{
+    if (version > 0u) {
+        ar >> m_grain_size;
+    } else {
+        // LCOV_EXCL_START
+        // NOTE: version 0 had no
+        // grain size.
+        m_grain_size = 0;
+        // LCOV_EXCL_STOP
+    }
 }
 
 } // namespace pagmo
@@ -0,0 +1,178 @@
+/* Copyright 2017-2021 PaGMO development team
+
+This file is part of the PaGMO library.
+
+The PaGMO library is free software; you can redistribute it and/or modify
+it under the terms of either:
+
+  * the GNU Lesser General Public License as published by the Free
+    Software Foundation; either version 3 of the License, or (at your
+    option) any later version.
+
+or
+
+  * the GNU General Public License as published by the Free Software
+    Foundation; either version 3 of the License, or (at your option) any
+    later version.
+
+or both in parallel, as here.
+
+The PaGMO library is distributed in the hope that it will be useful, but
+WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+for more details.
+
+You should have received copies of the GNU General Public License and the
+GNU Lesser General Public License along with the PaGMO library.  If not,
+see https://www.gnu.org/licenses/. */
+
+#include <random>
+#include <vector>
+
+#include <pagmo/detail/de_trial.hpp>
+#include <pagmo/rng.hpp>
+#include <pagmo/types.hpp>
+
+namespace pagmo
+{
+
+namespace detail
+{
+
+void de_make_trial(vector_double &tmp, unsigned variant, double F, double CR, const std::vector<vector_double> &popold,
+                   vector_double::size_type i, const std::vector<vector_double::size_type> &r,
+                   const vector_double &gbIter, random_engine_type &e)
+{
+    auto dim = tmp.size();
+    std::uniform_real_distribution<double> drng(0., 1.); // to generate a number in [0, 1)
+    std::uniform_int_distribution<vector_double::size_type> c_idx(
+        0u, dim - 1u); // to generate a random index for the chromosome
+
+    /*-------DE/best/1/exp--------------------------------------------------------------------*/
+    /*-------The oldest DE variant but still not bad. However, we have found several---------*/
+    /*-------optimization problems where misconvergence occurs.-------------------------------*/
+    if (variant == 1u) {
+        tmp = popold[i];
+        auto n = c_idx(e);
+        auto L = 0u;
+        do {
+            tmp[n] = gbIter[n] + F * (popold[r[1]][n] - popold[r[2]][n]);
+            n = (n + 1u) % dim;
+            ++L;
+        } while ((drng(e) < CR) && (L < dim));
+    }
+
+    /*-------DE/rand/1/exp-------------------------------------------------------------------*/
+    /*-------This is one of my favourite strategies. It works especially well when the-------*/
+    /*-------"gbIter[]"-schemes experience misconvergence. Try e.g. F=0.7 and CR=0.5---------*/
+    /*-------as a first guess.---------------------------------------------------------------*/
+    else if (variant == 2u) {
+        tmp = popold[i];
+        auto n = c_idx(e);
+        decltype(dim) L = 0u;
+        do {
+            tmp[n] = popold[r[0]][n] + F * (popold[r[1]][n] - popold[r[2]][n]);
+            n = (n + 1u) % dim;
+            ++L;
+        } while ((drng(e) < CR) && (L < dim));
+    }
+    /*-------DE/rand-to-best/1/exp-----------------------------------------------------------*/
+    /*-------This variant seems to be one of the best strategies. Try F=0.85 and CR=1.------*/
+    /*-------If you get misconvergence try to increase NP. If this doesn't help you----------*/
+    /*-------should play around with all three control variables.----------------------------*/
+    else if (variant == 3u) {
+        tmp = popold[i];
+        auto n = c_idx(e);
+        auto L = 0u;
+        do {
+            tmp[n] = tmp[n] + F * (gbIter[n] - tmp[n]) + F * (popold[r[0]][n] - popold[r[1]][n]);
+            n = (n + 1u) % dim;
+            ++L;
+        } while ((drng(e) < CR) && (L < dim));
+    }
+    /*-------DE/best/2/exp is another powerful variant worth trying--------------------------*/
+    else if (variant == 4u) {
+        tmp = popold[i];
+        auto n = c_idx(e);
+        auto L = 0u;
+        do {
+            tmp[n] = gbIter[n] + (popold[r[0]][n] + popold[r[1]][n] - popold[r[2]][n] - popold[r[3]][n]) * F;
+            n = (n + 1u) % dim;
+            ++L;
+        } while ((drng(e) < CR) && (L < dim));
+    }
+    /*-------DE/rand/2/exp seems to be a robust optimizer for many functions-------------------*/
+    else if (variant == 5u) {
+        tmp = popold[i];
+        auto n = c_idx(e);
+        auto L = 0u;
+        do {
+            tmp[n] = popold[r[4]][n]
+                     + (popold[r[0]][n] + popold[r[1]][n] - popold[r[2]][n] - popold[r[3]][n]) * F;
+            n = (n + 1u) % dim;
+            ++L;
+        } while ((drng(e) < CR) && (L < dim));
+    }
+
+    /*=======Essentially same strategies but BINOMIAL CROSSOVER===============================*/
+    /*-------DE/best/1/bin--------------------------------------------------------------------*/
+    else if (variant == 6u) {
+        tmp = popold[i];
+        auto n = c_idx(e);
+        for (decltype(dim) L = 0u; L < dim; ++L) { /* perform Dc binomial trials */
+            if ((drng(e) < CR) || L + 1u == dim) { /* change at least one parameter */
+                tmp[n] = gbIter[n] + F * (popold[r[1]][n] - popold[r[2]][n]);
+            }
+            n = (n + 1u) % dim;
+        }
+    }
+    /*-------DE/rand/1/bin-------------------------------------------------------------------*/
+    else if (variant == 7u) {
+        tmp = popold[i];
+        auto n = c_idx(e);
+        for (decltype(dim) L = 0u; L < dim; ++L) { /* perform Dc binomial trials */
+            if ((drng(e) < CR) || L + 1u == dim) { /* change at least one parameter */
+                tmp[n] = popold[r[0]][n] + F * (popold[r[1]][n] - popold[r[2]][n]);
+            }
+            n = (n + 1u) % dim;
+        }
+    }
+    /*-------DE/rand-to-best/1/bin-----------------------------------------------------------*/
+    else if (variant == 8u) {
+        tmp = popold[i];
+        auto n = c_idx(e);
+        for (decltype(dim) L = 0u; L < dim; ++L) { /* perform Dc binomial trials */
+            if ((drng(e) < CR) || L + 1u == dim) { /* change at least one parameter */
+                tmp[n] = tmp[n] + F * (gbIter[n] - tmp[n]) + F * (popold[r[0]][n] - popold[r[1]][n]);
+            }
+            n = (n + 1u) % dim;
+        }
+    }
+    /*-------DE/best/2/bin--------------------------------------------------------------------*/
+    else if (variant == 9u) {
+        tmp = popold[i];
+        auto n = c_idx(e);
+        for (decltype(dim) L = 0u; L < dim; ++L) { /* perform Dc binomial trials */
+            if ((drng(e) < CR) || L + 1u == dim) { /* change at least one parameter */
+                tmp[n] = gbIter[n] + (popold[r[0]][n] + popold[r[1]][n] - popold[r[2]][n] - popold[r[3]][n]) * F;
+            }
+            n = (n + 1u) % dim;
+        }
+    }
+    /*-------DE/rand/2/bin--------------------------------------------------------------------*/
+    else if (variant == 10u) {
+        tmp = popold[i];
+        auto n = c_idx(e);
+        for (decltype(dim) L = 0u; L < dim; ++L) { /* perform Dc binomial trials */
+            if ((drng(e) < CR) || L + 1u == dim) { /* change at least one parameter */
+                tmp[n] = popold[r[4]][n]
+                         + (popold[r[0]][n] + popold[r[1]][n] - popold[r[2]][n] - popold[r[3]][n]) * F;
+            }
+            n = (n + 1u) % dim;
+        }
+    }
+}
+
+} // namespace detail
+
+} // namespace pagmo
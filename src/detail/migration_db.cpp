@@ -0,0 +1,200 @@
+/* Copyright 2017-2021 PaGMO development team
+
+This file is part of the PaGMO library.
+
+The PaGMO library is free software; you can redistribute it and/or modify
+it under the terms of either:
+
+  * the GNU Lesser General Public License as published by the Free
+    Software Foundation; either version 3 of the License, or (at your
+    option) any later version.
+
+or
+
+  * the GNU General Public License as published by the Free Software
+    Foundation; either version 3 of the License, or (at your option) any
+    later version.
+
+or both in parallel, as here.
+
+The PaGMO library is distributed in the hope that it will be useful, but
+WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+for more details.
+
+You should have received copies of the GNU General Public License and the
+GNU Lesser General Public License along with the PaGMO library.  If not,
+see https://www.gnu.org/licenses/. */
+
+#include <atomic>
+#include <cassert>
+#include <cstddef>
+#include <limits>
+#include <memory>
+#include <utility>
+#include <vector>
+
+#include <pagmo/detail/migration_db.hpp>
+#include <pagmo/types.hpp>
+
+namespace pagmo::detail
+{
+
+namespace
+{
+
+// Segment index and offset within the segment
+// for the slot at index i.
+std::pair<std::size_t, std::size_t> slot_location(std::size_t i)
+{
+    // NOTE: segment k begins at index 2**k - 1.
+    assert(i < std::numeric_limits<std::size_t>::max());
+    const auto j = i + 1u;
+    std::size_t k = 0;
+    for (auto tmp = j >> 1; tmp != 0u; tmp >>= 1) {
+        ++k;
+    }
+
+    return {k, j - (std::size_t(1) << k)};
+}
+
+} // namespace
+
+migrants_slots::migrants_slots() : m_size(0)
+{
+    for (auto &seg : m_segments) {
+        seg.store(nullptr, std::memory_order_relaxed);
+    }
+}
+
+migrants_slots::~migrants_slots()
+{
+    for (auto &seg : m_segments) {
+        delete[] seg.load(std::memory_order_relaxed);
+    }
+}
+
+void migrants_slots::swap(migrants_slots &other) noexcept
+{
+    for (std::size_t i = 0; i < n_segments; ++i) {
+        auto tmp = m_segments[i].load(std::memory_order_relaxed);
+        m_segments[i].store(other.m_segments[i].load(std::memory_order_relaxed), std::memory_order_relaxed);
+        other.m_segments[i].store(tmp, std::memory_order_relaxed);
+    }
+
+    auto tmp_size = m_size.load(std::memory_order_relaxed);
+    m_size.store(other.m_size.load(std::memory_order_relaxed), std::memory_order_relaxed);
+    other.m_size.store(tmp_size, std::memory_order_relaxed);
+}
+
+migrants_slots::size_type migrants_slots::size() const
+{
+    return m_size.load(std::memory_order_acquire);
+}
+
+// Access the slot at index i. The segment
+// containing the slot must have been allocated.
+migrants_slots::group_ptr &migrants_slots::slot(size_type i) const
+{
+    const auto [k, offset] = slot_location(i);
+    const auto seg = m_segments[k].load(std::memory_order_acquire);
+    assert(seg != nullptr);
+
+    return seg[offset];
+}
+
+void migrants_slots::resize(size_type new_size)
+{
+    const auto old_size = m_size.load(std::memory_order_relaxed);
+
+    if (new_size > old_size) {
+        // Allocate the missing segments.
+        // NOTE: if the allocation fails, the
+        // size will be left untouched.
+        const auto last_seg = slot_location(new_size - 1u).first;
+        for (std::size_t k = 0; k <= last_seg; ++k) {
+            if (m_segments[k].load(std::memory_order_relaxed) == nullptr) {
+                m_segments[k].store(new group_ptr[std::size_t(1) << k], std::memory_order_release);
+            }
+        }
+
+        // Make sure the new slots are empty. They might
+        // contain migrants from before a shrinking.
+        for (auto i = old_size; i < new_size; ++i) {
+            std::atomic_store(&slot(i), group_ptr{});
+        }
+    } else {
+        // Clear out the slots which are being removed.
+        for (auto i = new_size; i < old_size; ++i) {
+            std::atomic_store(&slot(i), group_ptr{});
+        }
+    }
+
+    // Publish the new size.
+    m_size.store(new_size, std::memory_order_release);
+}
+
+individuals_group_t migrants_slots::get(size_type i) const
+{
+    assert(i < size());
+
+    // NOTE: the group pointed to by a slot is never
+    // modified after publication, thus we can copy
+    // from it without holding any lock.
+    const auto ptr = std::atomic_load(&slot(i));
+
+    return ptr ? *ptr : individuals_group_t{};
+}
+
+individuals_group_t migrants_slots::extract(size_type i)
+{
+    assert(i < size());
+
+    const auto ptr = std::atomic_exchange(&slot(i), group_ptr{});
+
+    // NOTE: concurrent get() calls which loaded the pointer before
+    // the exchange may still be reading from the group. use_count()
+    // does not synchronise with the release of their references,
+    // thus we always copy instead of moving the individuals out.
+    return ptr ? *ptr : individuals_group_t{};
+}
+
+void migrants_slots::set(size_type i, individuals_group_t &&inds)
+{
+    assert(i < size());
+
+    std::atomic_store(&slot(i), std::make_shared<individuals_group_t>(std::move(inds)));
+}
+
+std::vector<individuals_group_t> migrants_slots::get_all() const
+{
+    const auto s = size();
+
+    std::vector<individuals_group_t> retval;
+    retval.reserve(s);
+    for (size_type i = 0; i < s; ++i) {
+        retval.push_back(get(i));
+    }
+
+    return retval;
+}
+
+void migrants_slots::set_all(std::vector<individuals_group_t> &&db)
+{
+    // NOTE: build the new groups first, so that
+    // if anything throws we won't have modified
+    // the slots.
+    std::vector<group_ptr> new_groups;
+    new_groups.reserve(db.size());
+    for (auto &ig : db) {
+        new_groups.push_back(std::make_shared<individuals_group_t>(std::move(ig)));
+    }
+
+    resize(db.size());
+
+    for (size_type i = 0; i < new_groups.size(); ++i) {
+        std::atomic_store(&slot(i), std::move(new_groups[i]));
+    }
+}
+
+} // namespace pagmo::detail
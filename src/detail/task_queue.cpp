@@ -32,6 +32,22 @@ see https://www.gnu.org/licenses/. */
 #include <mutex>
 #include <utility>
 
+#if defined(_MSC_VER)
+
+// Disable a warning from MSVC in the TBB code.
+#pragma warning(push)
+#pragma warning(disable : 4324)
+
+#endif
+
+#include <tbb/task_arena.h>
+
+#if defined(_MSC_VER)
+
+#pragma warning(pop)
+
+#endif
+
 #include <pagmo/detail/task_queue.hpp>
 
 namespace pagmo::detail
@@ -148,4 +164,123 @@ task_queue::~task_queue()
     }
 }
 
+namespace
+{
+
+// The global thread pool used by pool_task_queue.
+// NOTE: the arena is sized according to the hardware
+// concurrency, and no slot is reserved for master threads,
+// as no thread ever joins the arena explicitly.
+tbb::task_arena &get_task_arena()
+{
+    static tbb::task_arena arena(tbb::task_arena::automatic, 0);
+
+    return arena;
+}
+
+} // namespace
+
+pool_task_queue::pool_task_queue() = default;
+
+std::future<void> pool_task_queue::enqueue_impl(task_type &&task)
+{
+    auto res = task.get_future();
+
+    std::unique_lock lock(m_mutex);
+
+    m_tasks.push(std::move(task));
+
+    if (!m_scheduled) {
+        // NOTE: if no work was scheduled, the queue
+        // was empty before the push() above.
+        assert(m_tasks.size() == 1u);
+
+        try {
+            get_task_arena().enqueue([this]() { this->run_next(); });
+            // LCOV_EXCL_START
+        } catch (...) {
+            // Remove the task we just pushed
+            // before re-throwing.
+            m_tasks.pop();
+            throw;
+            // LCOV_EXCL_STOP
+        }
+
+        m_scheduled = true;
+    }
+
+    return res;
+}
+
+// NOTE: this is the function which is executed
+// by the threads in the pool. Only one invocation
+// of this function per queue can be active at any time.
+void pool_task_queue::run_next()
+{
+    try {
+        std::unique_lock lock(m_mutex);
+
+        assert(m_scheduled);
+        assert(!m_tasks.empty());
+
+        // Pop the first task from the queue.
+        auto task(std::move(m_tasks.front()));
+        m_tasks.pop();
+
+        // Release the lock, so that we can enqueue
+        // more tasks while the current one is running.
+        lock.unlock();
+
+        // Run the current task.
+        task();
+
+        lock.lock();
+
+        if (m_tasks.empty()) {
+            // No more tasks, flag the queue as idle
+            // and notify wait_all().
+            // NOTE: notify while holding the lock: as soon
+            // as the lock is released, wait_all() may return
+            // and the queue may be destroyed.
+            m_scheduled = false;
+            m_cond.notify_all();
+        } else {
+            // More tasks are available. Instead of running them
+            // here, we submit them again to the pool so that
+            // the tasks from other queues are given a chance to run.
+            get_task_arena().enqueue([this]() { this->run_next(); });
+        }
+        // LCOV_EXCL_START
+    } catch (...) {
+        // NOTE: same as in the task_queue thread, there is not much
+        // that can be done to recover from this.
+        std::abort();
+        // LCOV_EXCL_STOP
+    }
+}
+
+// Wait for all the enqueued tasks to be processed.
+void pool_task_queue::wait_all()
+{
+    std::unique_lock lock(m_mutex);
+
+    m_cond.wait(lock, [this]() { return !m_scheduled; });
+
+    assert(m_tasks.empty());
+}
+
+pool_task_queue::~pool_task_queue()
+{
+    // NOTE: the pool holds references to this
+    // object until all tasks have been consumed,
+    // thus we must wait before destruction.
+    try {
+        wait_all();
+        // LCOV_EXCL_START
+    } catch (...) {
+        std::abort();
+        // LCOV_EXCL_STOP
+    }
+}
+
 } // namespace pagmo::detail
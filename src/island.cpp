@@ -28,12 +28,14 @@ see https://www.gnu.org/licenses/. */
 
 #include <pagmo/config.hpp>
 
+#include <atomic>
 #include <cassert>
 #include <chrono>
 #include <exception>
 #include <future>
 #include <initializer_list>
 #include <iostream>
+#include <iterator>
 #include <memory>
 #include <mutex>
 #include <optional>
@@ -43,6 +45,7 @@ see https://www.gnu.org/licenses/. */
 #include <tuple>
 #include <typeindex>
 #include <unordered_map>
+#include <unordered_set>
 #include <utility>
 #include <vector>
 
@@ -264,6 +267,15 @@ std::unique_ptr<task_queue> get_task_queue()
     return retval;
 }
 
+unsigned long long new_island_version()
+{
+    // NOTE: start from 1, so that 0 can be used
+    // as an invalid version.
+    static std::atomic<unsigned long long> counter(1);
+
+    return counter.fetch_add(1, std::memory_order_relaxed);
+}
+
 // NOTE: thread_island is ok as default choice, as the null_prob/null_algo
 // are both thread safe.
 island_data::island_data()
@@ -285,11 +297,17 @@ island_data::island_data(std::unique_ptr<isl_inner_base> &&ptr, algorithm &&a, p
 
 island_data::~island_data()
 {
-    // Consume all tasks in the queue.
-    queue->wait_all();
+    if (pool_queue) {
+        // Consume all tasks in the queue. The pool
+        // queue will then be destroyed.
+        pool_queue->wait_all();
+    } else {
+        // Consume all tasks in the queue.
+        queue->wait_all();
 
-    // Move the queue to the cache.
-    get_task_queue_cache()->push(std::move(queue));
+        // Move the queue to the cache.
+        get_task_queue_cache()->push(std::move(queue));
+    }
 }
 
 namespace
@@ -302,6 +320,13 @@ const std::unordered_map<evolve_status, std::string> island_statuses
        {evolve_status::idle_error, "idle - **error occurred**"},
        {evolve_status::busy_error, "busy - **error occurred**"}};
 
+// A map to link a human-readable description to island_backend.
+const std::unordered_map<island_backend, std::string> island_backends
+    = {{island_backend::thread, "thread"}, {island_backend::pool, "pool"}};
+
+// The currently active island backend.
+std::atomic<island_backend> cur_island_backend(island_backend::thread);
+
 } // namespace
 
 } // namespace detail
@@ -314,8 +339,59 @@ std::ostream &operator<<(std::ostream &os, evolve_status es)
     return os << detail::island_statuses.at(es);
 }
 
+// Provide the stream operator overload for island_backend.
+std::ostream &operator<<(std::ostream &os, island_backend b)
+{
+    return os << detail::island_backends.at(b);
+}
+
 #endif
 
+/// Get the island execution backend.
+/**
+ * \verbatim embed:rst:leading-asterisk
+ * .. versionadded:: 2.20
+ * \endverbatim
+ *
+ * This function is thread-safe.
+ *
+ * @return the execution backend that will be used by newly-constructed islands.
+ */
+island_backend get_island_backend()
+{
+    return detail::cur_island_backend.load();
+}
+
+/// Set the island execution backend.
+/**
+ * \verbatim embed:rst:leading-asterisk
+ * .. versionadded:: 2.20
+ * \endverbatim
+ *
+ * This function will set the execution backend used by the islands constructed
+ * after the invocation of this function. Existing islands will keep on using
+ * the backend that was active at the time of their construction. Note that this
+ * includes the copy constructor of pagmo::island: a copy of an island
+ * will use the currently active backend, regardless of the backend of the original island.
+ *
+ * With the default pagmo::island_backend::thread backend, each island owns a separate
+ * thread of execution, so that the number of threads created by an
+ * archipelago is proportional to the number of islands.
+ * With the pagmo::island_backend::pool backend, the evolution tasks are instead consumed
+ * by a global work-stealing thread pool, so that the number of threads is bounded by the hardware
+ * concurrency regardless of the number of islands. The semantics of island::evolve(), island::wait(),
+ * island::wait_check() and island::status() are the same for both backends. In particular,
+ * the tasks of each island are still executed one at a time, in FIFO order.
+ *
+ * This function is thread-safe.
+ *
+ * @param b the new island execution backend.
+ */
+void set_island_backend(island_backend b)
+{
+    detail::cur_island_backend.store(b);
+}
+
 // NOTE: the idea in the move members and the dtor is that
 // we want to wait *and* erase any future in the island, before doing
 // the move/destruction. Thus we use this small wrapper.
@@ -435,7 +511,7 @@ void island::evolve(unsigned n)
         // Move assign a new future provided by the enqueue() method.
         // NOTE: enqueue either returns a valid future, or throws without
         // having enqueued any task.
-        m_ptr->futures.back() = m_ptr->queue->enqueue([this, n]() {
+        m_ptr->futures.back() = m_ptr->enqueue([this, n]() {
             // Random engine for use in the migration logic.
             // Wrap it in an optional so that, if we don't need
             // it, we don't waste CPU/memory.
@@ -473,17 +549,23 @@ void island::evolve(unsigned n)
                         const auto mt = aptr->get_migration_type();
                         const auto mh = aptr->get_migrant_handling();
 
-                        // Small helper to turn a group of individuals into
-                        // an ID -> (dv, fv) map. inds will be destroyed
-                        // in the process.
-                        using inds_map_t
-                            = std::unordered_map<unsigned long long, std::pair<vector_double, vector_double>>;
-                        auto group_to_map = [](individuals_group_t &&inds) -> inds_map_t {
-                            inds_map_t retval;
-
-                            for (decltype(std::get<0>(inds).size()) j = 0; j < std::get<0>(inds).size(); ++j) {
-                                retval[std::get<0>(inds)[j]]
-                                    = std::make_pair(std::move(std::get<1>(inds)[j]), std::move(std::get<2>(inds)[j]));
+                        // Small helper to locate the candidate migrants with IDs mig_IDs
+                        // in the group of individuals new_inds resulting from the replacement.
+                        // It returns an ID -> index in new_inds map.
+                        // NOTE: only the IDs of the candidate migrants are
+                        // stored in the map, so that the cost of building the migration
+                        // log does not depend on the size of the island's population.
+                        using pos_map_t = std::unordered_map<unsigned long long,
+                                                             std::vector<unsigned long long>::size_type>;
+                        auto locate_migrants = [](const individuals_group_t &new_inds,
+                                                  const std::vector<unsigned long long> &mig_IDs) -> pos_map_t {
+                            const std::unordered_set<unsigned long long> mig_IDs_set(mig_IDs.begin(), mig_IDs.end());
+
+                            pos_map_t retval;
+                            for (decltype(std::get<0>(new_inds).size()) j = 0; j < std::get<0>(new_inds).size(); ++j) {
+                                if (mig_IDs_set.find(std::get<0>(new_inds)[j]) != mig_IDs_set.end()) {
+                                    retval[std::get<0>(new_inds)[j]] = j;
+                                }
                             }
 
                             return retval;
@@ -507,7 +589,7 @@ void island::evolve(unsigned n)
                                                           : aptr->extract_migrants(src_idx);
 
                                 // Extract the migration data from this island.
-                                const auto mig_data = this->get_migration_data();
+                                auto mig_data = this->get_migration_data();
 
                                 // Run the replacement policy.
                                 auto new_inds = this->m_ptr->r_pol.replace(std::get<0>(mig_data), std::get<1>(mig_data),
@@ -515,29 +597,32 @@ void island::evolve(unsigned n)
                                                                            std::get<4>(mig_data), std::get<5>(mig_data),
                                                                            std::get<6>(mig_data), migrants);
 
-                                // Set the new individuals.
-                                this->set_individuals(new_inds);
-
                                 // Compute the migration timestamp.
                                 const std::chrono::duration<double> mig_ts
                                     = std::chrono::steady_clock::now() - detail::initial_timestamp;
 
-                                // Turn new_inds into an ID -> (dv, fv) map in order to build the log.
-                                const auto new_inds_map = group_to_map(std::move(new_inds));
-
-                                // Build the migration log.
+                                // Build the migration log, unless it is disabled.
                                 archipelago::migration_log_t mlog;
-                                for (auto mig_ID : std::get<0>(migrants)) {
-                                    const auto it = new_inds_map.find(mig_ID);
-
-                                    if (it != new_inds_map.end()) {
-                                        mlog.emplace_back(mig_ts.count(), mig_ID, it->second.first, it->second.second,
-                                                          src_idx, isl_idx);
+                                if (aptr->migration_log_enabled()) {
+                                    const auto mig_pos = locate_migrants(new_inds, std::get<0>(migrants));
+                                    for (auto mig_ID : std::get<0>(migrants)) {
+                                        const auto it = mig_pos.find(mig_ID);
+
+                                        if (it != mig_pos.end()) {
+                                            mlog.emplace_back(mig_ts.count(), mig_ID, std::get<1>(new_inds)[it->second],
+                                                              std::get<2>(new_inds)[it->second], src_idx, isl_idx);
+                                        }
                                     }
                                 }
 
-                                // Append it.
-                                aptr->append_migration_log(mlog);
+                                // Set the new individuals.
+                                // NOTE: release first the copy of the original
+                                // individuals, which is not needed any more.
+                                std::get<0>(mig_data) = individuals_group_t{};
+                                this->set_individuals(std::move(new_inds));
+
+                                // Append the log.
+                                aptr->append_migration_log(std::move(mlog));
                             }
                         } else {
                             // Broadcast migration.
@@ -547,11 +632,10 @@ void island::evolve(unsigned n)
                             // We will build this below iteratively.
                             individuals_group_t migrants;
 
-                            // Vector to pair source island indices to the corresponding
-                            // candidate migrants. This will contain the same set of individuals
-                            // as migrants, but split according to the source island. This is needed
-                            // to build the migration log.
-                            std::vector<std::pair<archipelago::size_type, individuals_group_t>> split_migrants;
+                            // Vector to pair source island indices to the IDs of the corresponding
+                            // candidate migrants. This is needed to build the migration log.
+                            std::vector<std::pair<archipelago::size_type, std::vector<unsigned long long>>>
+                                split_migrants;
 
                             for (decltype(connections.first.size()) j = 0; j < connections.first.size(); ++j) {
                                 // Throw the dice against the migration probability.
@@ -564,24 +648,26 @@ void island::evolve(unsigned n)
                                                             ? aptr->get_migrants(src_idx)
                                                             : aptr->extract_migrants(src_idx);
 
-                                    // Add them to the global migrants vector.
+                                    // Move them into the global migrants vector.
                                     std::get<0>(migrants).insert(std::get<0>(migrants).end(),
                                                                  std::get<0>(cur_migrants).begin(),
                                                                  std::get<0>(cur_migrants).end());
-                                    std::get<1>(migrants).insert(std::get<1>(migrants).end(),
-                                                                 std::get<1>(cur_migrants).begin(),
-                                                                 std::get<1>(cur_migrants).end());
-                                    std::get<2>(migrants).insert(std::get<2>(migrants).end(),
-                                                                 std::get<2>(cur_migrants).begin(),
-                                                                 std::get<2>(cur_migrants).end());
-
-                                    // Add them to split_migrants too.
-                                    split_migrants.emplace_back(src_idx, std::move(cur_migrants));
+                                    std::get<1>(migrants).insert(
+                                        std::get<1>(migrants).end(),
+                                        std::make_move_iterator(std::get<1>(cur_migrants).begin()),
+                                        std::make_move_iterator(std::get<1>(cur_migrants).end()));
+                                    std::get<2>(migrants).insert(
+                                        std::get<2>(migrants).end(),
+                                        std::make_move_iterator(std::get<2>(cur_migrants).begin()),
+                                        std::make_move_iterator(std::get<2>(cur_migrants).end()));
+
+                                    // Record their IDs in split_migrants.
+                                    split_migrants.emplace_back(src_idx, std::move(std::get<0>(cur_migrants)));
                                 }
                             }
 
                             // Extract the migration data from this island.
-                            const auto mig_data = this->get_migration_data();
+                            auto mig_data = this->get_migration_data();
 
                             // Run the replacement policy.
                             auto new_inds = this->m_ptr->r_pol.replace(std::get<0>(mig_data), std::get<1>(mig_data),
@@ -589,33 +675,34 @@ void island::evolve(unsigned n)
                                                                        std::get<4>(mig_data), std::get<5>(mig_data),
                                                                        std::get<6>(mig_data), migrants);
 
-                            // Set the new individuals.
-                            this->set_individuals(new_inds);
-
                             // Compute the migration timestamp.
                             const std::chrono::duration<double> mig_ts
                                 = std::chrono::steady_clock::now() - detail::initial_timestamp;
 
-                            // Turn new_inds into an ID -> (dv, fv) map in order to build the log.
-                            const auto new_inds_map = group_to_map(std::move(new_inds));
-
-                            // Build the migration log.
+                            // Build the migration log, unless it is disabled.
                             archipelago::migration_log_t mlog;
-                            for (const auto &p : split_migrants) {
-                                const auto src_idx = p.first;
-
-                                for (auto mig_ID : std::get<0>(p.second)) {
-                                    const auto it = new_inds_map.find(mig_ID);
-
-                                    if (it != new_inds_map.end()) {
-                                        mlog.emplace_back(mig_ts.count(), mig_ID, it->second.first, it->second.second,
-                                                          src_idx, isl_idx);
+                            if (aptr->migration_log_enabled()) {
+                                const auto mig_pos = locate_migrants(new_inds, std::get<0>(migrants));
+                                for (const auto &p : split_migrants) {
+                                    const auto src_idx = p.first;
+
+                                    for (auto mig_ID : p.second) {
+                                        const auto it = mig_pos.find(mig_ID);
+
+                                        if (it != mig_pos.end()) {
+                                            mlog.emplace_back(mig_ts.count(), mig_ID, std::get<1>(new_inds)[it->second],
+                                                              std::get<2>(new_inds)[it->second], src_idx, isl_idx);
+                                        }
                                     }
                                 }
                             }
 
-                            // Append it.
-                            aptr->append_migration_log(mlog);
+                            // Set the new individuals.
+                            std::get<0>(mig_data) = individuals_group_t{};
+                            this->set_individuals(std::move(new_inds));
+
+                            // Append the log.
+                            aptr->append_migration_log(std::move(mlog));
                         }
                     }
                 }
@@ -845,6 +932,9 @@ void island::set_algorithm(const algorithm &algo)
         m_ptr->algo = new_algo_ptr;
     }
 
+    // Update the version.
+    m_ptr->version.store(detail::new_island_version());
+
     // NOTE: upon exit, the refcount of old_ptr and
     // new_algo_ptr will be decreased, possibly invoking
     // the dtor of the contained objects.
@@ -892,6 +982,71 @@ void island::set_population(const population &pop)
         old_ptr = m_ptr->pop;
         m_ptr->pop = new_pop_ptr;
     }
+
+    m_ptr->version.store(detail::new_island_version());
+}
+
+/// Get the decision vector of the population's champion.
+/**
+ * \verbatim embed:rst:leading-asterisk
+ * .. versionadded:: 2.20
+ * \endverbatim
+ *
+ * This method is equivalent to calling population::champion_x() on the
+ * population returned by get_population(), but it does not copy the population:
+ * only the champion's decision vector is copied out of the island. The champion
+ * is updated every time the island's population is replaced (e.g., at the end
+ * of an evolution or via set_population()), thus this method is suitable for
+ * monitoring the island while it is evolving.
+ *
+ * It is safe to call this method while the island is evolving.
+ *
+ * @return a copy of the decision vector of the champion of the island's population.
+ *
+ * @throws unspecified any exception thrown by population::champion_x(), by threading
+ * primitives or by memory errors in standard containers.
+ */
+vector_double island::get_champion_x() const
+{
+    // NOTE: same pattern as in get_migration_data(): the population
+    // pointed to by m_ptr->pop is never modified while other references
+    // to it exist, thus we can read from it after releasing the lock.
+    std::shared_ptr<population> pop_ptr;
+    {
+        std::lock_guard<std::mutex> lock(m_ptr->pop_mutex);
+        pop_ptr = m_ptr->pop;
+    }
+
+    return pop_ptr->champion_x();
+}
+
+/// Get the fitness vector of the population's champion.
+/**
+ * \verbatim embed:rst:leading-asterisk
+ * .. versionadded:: 2.20
+ * \endverbatim
+ *
+ * This method is equivalent to calling population::champion_f() on the
+ * population returned by get_population(), but it does not copy the population:
+ * only the champion's fitness vector is copied out of the island.
+ *
+ * It is safe to call this method while the island is evolving.
+ *
+ * @return a copy of the fitness vector of the champion of the island's population.
+ *
+ * @throws unspecified any exception thrown by population::champion_f(), by threading
+ * primitives or by memory errors in standard containers.
+ */
+vector_double island::get_champion_f() const
+{
+    // NOTE: see get_champion_x().
+    std::shared_ptr<population> pop_ptr;
+    {
+        std::lock_guard<std::mutex> lock(m_ptr->pop_mutex);
+        pop_ptr = m_ptr->pop;
+    }
+
+    return pop_ptr->champion_f();
 }
 
 /// Get the replacement policy.
@@ -1004,8 +1159,8 @@ std::ostream &operator<<(std::ostream &os, const island &isl)
 
     // NOTE: don't print champion info for MO or stochastic problems.
     if (pop.get_problem().get_nobj() == 1u && !pop.get_problem().is_stochastic()) {
-        stream(os, "\tChampion decision vector: ", isl.get_population().champion_x(), "\n");
-        stream(os, "\tChampion fitness: ", isl.get_population().champion_f(), "\n");
+        stream(os, "\tChampion decision vector: ", pop.champion_x(), "\n");
+        stream(os, "\tChampion fitness: ", pop.champion_f(), "\n");
     }
 
     return os;
@@ -1034,52 +1189,90 @@ island::migration_data_t island::get_migration_data() const
         auto gte = detail::gte_getter();
         (void)gte;
 
-        // Get a copy of the population.
-        auto tmp_pop(get_population());
+        // Fetch the current population. No copy of the population
+        // is made here: the population pointed to by m_ptr->pop is
+        // never modified while other references to it exist
+        // (see set_individuals()), thus we can read from it
+        // after releasing the lock.
+        std::shared_ptr<population> pop_ptr;
+        {
+            std::lock_guard<std::mutex> lock(m_ptr->pop_mutex);
+            pop_ptr = m_ptr->pop;
+        }
+        const auto &pop = *pop_ptr;
 
-        // Move out the individuals.
-        std::get<0>(std::get<0>(retval)) = std::move(tmp_pop.m_ID);
-        std::get<1>(std::get<0>(retval)) = std::move(tmp_pop.m_x);
-        std::get<2>(std::get<0>(retval)) = std::move(tmp_pop.m_f);
+        // Copy the individuals.
+        std::get<0>(std::get<0>(retval)) = pop.m_ID;
+        std::get<1>(std::get<0>(retval)) = pop.m_x;
+        std::get<2>(std::get<0>(retval)) = pop.m_f;
 
         // nx, nix, nobj, nec, nic.
-        std::get<1>(retval) = tmp_pop.get_problem().get_nx();
-        std::get<2>(retval) = tmp_pop.get_problem().get_nix();
-        std::get<3>(retval) = tmp_pop.get_problem().get_nobj();
-        std::get<4>(retval) = tmp_pop.get_problem().get_nec();
-        std::get<5>(retval) = tmp_pop.get_problem().get_nic();
+        std::get<1>(retval) = pop.get_problem().get_nx();
+        std::get<2>(retval) = pop.get_problem().get_nix();
+        std::get<3>(retval) = pop.get_problem().get_nobj();
+        std::get<4>(retval) = pop.get_problem().get_nec();
+        std::get<5>(retval) = pop.get_problem().get_nic();
 
         // The vector of tolerances.
-        std::get<6>(retval) = tmp_pop.get_problem().get_c_tol();
+        std::get<6>(retval) = pop.get_problem().get_c_tol();
     }
 
     return retval;
 }
 
 // Set all the individuals in the population.
-void island::set_individuals(const individuals_group_t &inds)
+void island::set_individuals(individuals_group_t &&inds)
 {
-    // Create copy for move semantics below.
-    auto tmp_inds(inds);
+    // NOTE: this helper is called from the separate
+    // thread of execution within pagmo::island. We need to protect
+    // with a gte.
+    auto gte = detail::gte_getter();
+    (void)gte;
+
+    std::shared_ptr<population> old_ptr;
 
     {
-        // NOTE: this helper is called from the separate
-        // thread of execution within pagmo::island. We need to protect
-        // with a gte.
-        auto gte = detail::gte_getter();
-        (void)gte;
+        std::lock_guard<std::mutex> lock(m_ptr->pop_mutex);
 
-        // Get out a copy of the population.
-        auto tmp_pop(get_population());
+        // NOTE: new references to the current population can be acquired
+        // only while holding the lock. Thus, if m_ptr->pop is the only reference
+        // to the current population, nobody else can be accessing it, and we can
+        // move in the individuals in place.
+        if (m_ptr->pop.use_count() == 1) {
+            // NOTE: synchronise with the release of the references
+            // previously held by other threads.
+            std::atomic_thread_fence(std::memory_order_acquire);
+
+            m_ptr->pop->m_ID = std::move(std::get<0>(inds));
+            m_ptr->pop->m_x = std::move(std::get<1>(inds));
+            m_ptr->pop->m_f = std::move(std::get<2>(inds));
+            m_ptr->version.store(detail::new_island_version());
+
+            return;
+        }
 
-        // Move in the individuals.
-        tmp_pop.m_ID = std::move(std::get<0>(tmp_inds));
-        tmp_pop.m_x = std::move(std::get<1>(tmp_inds));
-        tmp_pop.m_f = std::move(std::get<2>(tmp_inds));
+        old_ptr = m_ptr->pop;
+    }
 
-        // Set the new population.
-        set_population(tmp_pop);
+    // The current population is being accessed elsewhere: assemble a new population from
+    // the current one, without copying the current individuals.
+    auto new_pop_ptr = std::make_shared<population>();
+    new_pop_ptr->m_prob = old_ptr->m_prob;
+    new_pop_ptr->m_ID = std::move(std::get<0>(inds));
+    new_pop_ptr->m_x = std::move(std::get<1>(inds));
+    new_pop_ptr->m_f = std::move(std::get<2>(inds));
+    new_pop_ptr->m_champion_x = old_ptr->m_champion_x;
+    new_pop_ptr->m_champion_f = old_ptr->m_champion_f;
+    new_pop_ptr->m_e = old_ptr->m_e;
+    new_pop_ptr->m_seed = old_ptr->m_seed;
+
+    // Set the new population.
+    {
+        std::lock_guard<std::mutex> lock(m_ptr->pop_mutex);
+        m_ptr->pop.swap(new_pop_ptr);
     }
+
+    m_ptr->version.store(detail::new_island_version());
 }
 
 } // namespace pagmo
@@ -26,22 +26,30 @@ You should have received copies of the GNU General Public License and the
 GNU Lesser General Public License along with the PaGMO library.  If not,
 see https://www.gnu.org/licenses/. */
 
+#include <algorithm>
 #include <atomic>
 #include <cassert>
 #include <cerrno>
 #include <csignal>
 #include <cstddef>
+#include <cstdint>
 #include <cstdlib>
 #include <cstring>
 #include <exception>
+#include <initializer_list>
 #include <ios>
 #include <iostream>
+#include <memory>
+#include <mutex>
 #include <sstream>
 #include <stdexcept>
 #include <string>
 #include <tuple>
+#include <unordered_set>
 #include <utility>
+#include <vector>
 
+#include <pthread.h>
 #include <sys/types.h>
 #include <sys/wait.h>
 #include <unistd.h>
@@ -51,7 +59,10 @@ see https://www.gnu.org/licenses/. */
 #include <pagmo/island.hpp>
 #include <pagmo/islands/fork_island.hpp>
 #include <pagmo/population.hpp>
+#include <pagmo/problem.hpp>
+#include <pagmo/rng.hpp>
 #include <pagmo/s11n.hpp>
+#include <pagmo/types.hpp>
 
 namespace pagmo
 {
@@ -62,12 +73,65 @@ namespace detail
 namespace
 {
 
+// The registry of the file descriptors of all the pipes
+// currently opened by fork_island.
+// NOTE: a child process created via fork() inherits copies of all the
+// file descriptors of the parent, including the ends of the pipes used
+// by other fork_island instances. If the child is long-lived (as in
+// the persistent mode), it would then keep open the pipes of other islands,
+// thus preventing the detection of EOF. In order to avoid this, after fork()
+// the child closes all the registered descriptors which it does not need.
+std::mutex &get_fd_registry_mutex()
+{
+    static std::mutex m;
+
+    return m;
+}
+
+std::unordered_set<int> &get_fd_registry()
+{
+    static std::unordered_set<int> r;
+
+    return r;
+}
+
+// Fork the calling process. In the child process, all the registered
+// descriptors not appearing in keep will be closed.
+pid_t fork_and_close(std::initializer_list<int> keep)
+{
+    // NOTE: hold the lock during fork(), so that the registry
+    // is in a consistent state in the child.
+    std::unique_lock lock(get_fd_registry_mutex());
+
+    const auto child_pid = ::fork();
+
+    if (child_pid == 0) {
+        // NOTE: in the child, only the calling thread exists,
+        // thus we can modify the registry and then
+        // release the lock normally.
+        auto &reg = get_fd_registry();
+        for (auto it = reg.begin(); it != reg.end();) {
+            if (std::find(keep.begin(), keep.end(), *it) == keep.end()) {
+                ::close(*it);
+                it = reg.erase(it);
+            } else {
+                ++it;
+            }
+        }
+    }
+
+    return child_pid;
+}
+
 // Small RAII wrapper around a pipe.
 struct pipe_t {
     // Def ctor: will create the pipe.
     pipe_t() : r_status(true), w_status(true)
     {
         int fd[2];
+
+        std::lock_guard lock(get_fd_registry_mutex());
+
         // LCOV_EXCL_START
         if (pipe(fd) == -1) {
             pagmo_throw(std::runtime_error, "Unable to create a pipe with the pipe() function. The error code is "
@@ -79,11 +143,25 @@ struct pipe_t {
         // the r/w descriptors.
         rd = fd[0];
         wd = fd[1];
+        // Add them to the registry.
+        try {
+            get_fd_registry().insert(rd);
+            get_fd_registry().insert(wd);
+            // LCOV_EXCL_START
+        } catch (...) {
+            get_fd_registry().erase(rd);
+            ::close(rd);
+            ::close(wd);
+            throw;
+            // LCOV_EXCL_STOP
+        }
     }
     // Try to close the reading end if it has not been closed already.
     void close_r()
     {
         if (r_status) {
+            std::lock_guard lock(get_fd_registry_mutex());
+            get_fd_registry().erase(rd);
             // LCOV_EXCL_START
             if (close(rd) == -1) {
                 pagmo_throw(std::runtime_error,
@@ -98,6 +176,8 @@ struct pipe_t {
     void close_w()
     {
         if (w_status) {
+            std::lock_guard lock(get_fd_registry_mutex());
+            get_fd_registry().erase(wd);
             // LCOV_EXCL_START
             if (close(wd) == -1) {
                 pagmo_throw(std::runtime_error,
@@ -150,6 +230,54 @@ struct pipe_t {
         // LCOV_EXCL_STOP
         return retval;
     }
+    // Read exactly count bytes. If EOF is reached before
+    // reading any byte, false will be returned.
+    bool read_all(void *buf, std::size_t count) const
+    {
+        auto ptr = static_cast<char *>(buf);
+        std::size_t tot = 0;
+        while (tot < count) {
+            const auto read_bytes = read(static_cast<void *>(ptr + tot), count - tot);
+            if (!read_bytes) {
+                if (!tot) {
+                    return false;
+                }
+                pagmo_throw(std::runtime_error, "Unexpected EOF while reading from a pipe");
+            }
+            tot += static_cast<std::size_t>(read_bytes);
+        }
+        return true;
+    }
+    // Write exactly count bytes.
+    void write_all(const void *buf, std::size_t count) const
+    {
+        auto ptr = static_cast<const char *>(buf);
+        std::size_t tot = 0;
+        while (tot < count) {
+            tot += static_cast<std::size_t>(write(static_cast<const void *>(ptr + tot), count - tot));
+        }
+    }
+    // Send a message, preceded by its size.
+    void write_msg(const std::string &msg) const
+    {
+        const auto size = static_cast<std::uint64_t>(msg.size());
+        write_all(static_cast<const void *>(&size), sizeof(size));
+        write_all(static_cast<const void *>(msg.data()), msg.size());
+    }
+    // Receive a message sent via write_msg(). If EOF
+    // is reached before the message starts, false will be returned.
+    bool read_msg(std::string &msg) const
+    {
+        std::uint64_t size;
+        if (!read_all(static_cast<void *>(&size), sizeof(size))) {
+            return false;
+        }
+        msg.resize(static_cast<std::string::size_type>(size));
+        if (size && !read_all(static_cast<void *>(&msg[0]), msg.size())) {
+            pagmo_throw(std::runtime_error, "Unexpected EOF while reading from a pipe");
+        }
+        return true;
+    }
     // The file descriptors of the two ends of the pipe.
     int rd, wd;
     // Flag to signal the status of the two ends
@@ -157,11 +285,207 @@ struct pipe_t {
     bool r_status, w_status;
 };
 
+// Small raii helper to ensure that the pid of the child is atomically
+// set on construction, and reset to zero by the dtor.
+struct pid_setter {
+    explicit pid_setter(std::atomic<pid_t> &ap, pid_t pid) : m_ap(ap)
+    {
+        m_ap.store(pid);
+    }
+    ~pid_setter()
+    {
+        m_ap.store(0);
+    }
+    std::atomic<pid_t> &m_ap;
+};
+
+// RAII helper to block SIGPIPE in the calling thread while writing
+// to a child process. If the child process died, the write will then fail
+// with an error, rather than terminating the parent process.
+struct sigpipe_blocker {
+    sigpipe_blocker()
+    {
+        sigemptyset(&m_set);
+        sigaddset(&m_set, SIGPIPE);
+        sigset_t pending;
+        sigpending(&pending);
+        m_was_pending = sigismember(&pending, SIGPIPE) == 1;
+        pthread_sigmask(SIG_BLOCK, &m_set, &m_old);
+    }
+    ~sigpipe_blocker()
+    {
+        if (!m_was_pending) {
+            // Consume a SIGPIPE generated while it was blocked,
+            // before restoring the original signal mask.
+            sigset_t pending;
+            sigpending(&pending);
+            if (sigismember(&pending, SIGPIPE) == 1) {
+                int sig;
+                sigwait(&m_set, &sig);
+            }
+        }
+        pthread_sigmask(SIG_SETMASK, &m_old, nullptr);
+    }
+    sigset_t m_set, m_old;
+    bool m_was_pending;
+};
+
+// Helpers to convert serialisable objects to/from byte strings.
+template <typename T>
+std::string to_bytes(const T &x)
+{
+    std::ostringstream oss;
+    {
+        boost::archive::binary_oarchive oarchive(oss);
+        oarchive << x;
+    }
+    return oss.str();
+}
+
+template <typename T>
+void from_bytes(const std::string &str, T &x)
+{
+    std::istringstream iss(str);
+    boost::archive::binary_iarchive iarchive(iss);
+    iarchive >> x;
+}
+
+// The differences between two groups of individuals. The group
+// is resized to size, and the individuals at the indices
+// idx are replaced by the ones in ID/x/f.
+struct inds_delta {
+    using size_type = std::vector<unsigned long long>::size_type;
+
+    size_type size = 0;
+    std::vector<size_type> idx;
+    std::vector<unsigned long long> ID;
+    std::vector<vector_double> x, f;
+
+    template <typename Archive>
+    void serialize(Archive &ar, unsigned)
+    {
+        detail::archive(ar, size, idx, ID, x, f);
+    }
+};
+
+// Compute the delta transforming the old group of individuals into the new one.
+inds_delta make_delta(const std::vector<unsigned long long> &old_ID, const std::vector<vector_double> &old_x,
+                      const std::vector<vector_double> &old_f, const std::vector<unsigned long long> &new_ID,
+                      const std::vector<vector_double> &new_x, const std::vector<vector_double> &new_f)
+{
+    inds_delta retval;
+    retval.size = new_ID.size();
+
+    for (inds_delta::size_type i = 0; i < new_ID.size(); ++i) {
+        if (i >= old_ID.size() || old_ID[i] != new_ID[i] || old_x[i] != new_x[i] || old_f[i] != new_f[i]) {
+            retval.idx.push_back(i);
+            retval.ID.push_back(new_ID[i]);
+            retval.x.push_back(new_x[i]);
+            retval.f.push_back(new_f[i]);
+        }
+    }
+
+    return retval;
+}
+
+// Apply a delta to a group of individuals.
+void apply_delta(std::vector<unsigned long long> &ID, std::vector<vector_double> &x, std::vector<vector_double> &f,
+                 inds_delta &&d)
+{
+    ID.resize(d.size);
+    x.resize(d.size);
+    f.resize(d.size);
+
+    for (inds_delta::size_type i = 0; i < d.idx.size(); ++i) {
+        const auto j = d.idx[i];
+        if (j >= d.size) {
+            pagmo_throw(std::invalid_argument, "Invalid index detected while applying a delta of individuals");
+        }
+        ID[j] = d.ID[i];
+        x[j] = std::move(d.x[i]);
+        f[j] = std::move(d.f[i]);
+    }
+}
+
+// The message sent from the parent to the persistent child:
+// - the serialised algorithm (empty if the child already holds it),
+// - the serialised problem (empty if the child already holds it),
+// - the changes to the individuals held by the child,
+// - the champion decision/fitness vectors,
+// - the population's random engine and seed.
+using worker_input_t
+    = std::tuple<std::string, std::string, inds_delta, vector_double, vector_double, random_engine_type, unsigned>;
+
+// The message sent from the persistent child to the parent:
+// - int, status flag,
+// - string, error message,
+// - the serialised algorithm used for evolution,
+// - the changes to the individuals operated by the evolution,
+// - the champion decision/fitness vectors,
+// - the population's random engine and seed,
+// - the increments of the fitness/gradient/hessians evaluation counters.
+using worker_output_t
+    = std::tuple<int, std::string, std::string, inds_delta, vector_double, vector_double, random_engine_type,
+                 unsigned, unsigned long long, unsigned long long, unsigned long long>;
+
 } // namespace
 
+// The state of the persistent child process, as seen by the parent.
+struct fork_worker {
+    fork_worker() = default;
+    fork_worker(const fork_worker &) = delete;
+    fork_worker(fork_worker &&) = delete;
+    fork_worker &operator=(const fork_worker &) = delete;
+    fork_worker &operator=(fork_worker &&) = delete;
+    ~fork_worker()
+    {
+        // NOTE: make sure that the child is terminated
+        // only from the process which created it.
+        if (pid > 0 && ::getpid() == parent_pid) {
+            // NOTE: the child is not evolving at this point, it is
+            // either waiting for a message or it has already exited.
+            // Ignore the return values, as we are just trying to clean up here.
+            ::kill(pid, SIGTERM);
+            ::waitpid(pid, nullptr, 0);
+        }
+    }
+
+    // The pipes for the communication parent -> child
+    // and child -> parent.
+    pipe_t to_child, from_child;
+    // The child PID.
+    pid_t pid = 0;
+    // The PID of the process which created the child.
+    pid_t parent_pid = ::getpid();
+    // The algorithm, problem and individuals currently held
+    // by the child.
+    std::string algo_bytes, prob_bytes;
+    std::vector<unsigned long long> ID;
+    std::vector<vector_double> x, f;
+};
+
 } // namespace detail
 
+fork_island::fork_island() : fork_island(false) {}
+
+fork_island::fork_island(bool persistent) : m_pid(0), m_persistent(persistent) {}
+
+fork_island::fork_island(const fork_island &other) : fork_island(other.m_persistent) {}
+
+fork_island::fork_island(fork_island &&other) noexcept : fork_island(other.m_persistent) {}
+
+fork_island::~fork_island() = default;
+
 void fork_island::run_evolve(island &isl) const
+{
+    if (m_persistent) {
+        run_evolve_persistent(isl);
+    } else {
+        run_evolve_fork(isl);
+    }
+}
+
+void fork_island::run_evolve_fork(island &isl) const
 {
     // The structure we use to pass messages from the child to the parent:
     // - int, status flag,
@@ -174,7 +498,7 @@ void fork_island::run_evolve(island &isl) const
     // The pipe.
     detail::pipe_t p;
     // Try to fork now.
-    auto child_pid = fork();
+    auto child_pid = detail::fork_and_close({p.rd, p.wd});
     // LCOV_EXCL_START
     if (child_pid == -1) {
         // Forking failed.
@@ -185,20 +509,7 @@ void fork_island::run_evolve(island &isl) const
     // LCOV_EXCL_STOP
     if (child_pid) {
         // We are in the parent.
-        // Small raii helper to ensure that the pid of the child is atomically
-        // set on construction, and reset to zero by the dtor.
-        struct pid_setter {
-            explicit pid_setter(std::atomic<pid_t> &ap, pid_t pid) : m_ap(ap)
-            {
-                m_ap.store(pid);
-            }
-            ~pid_setter()
-            {
-                m_ap.store(0);
-            }
-            std::atomic<pid_t> &m_ap;
-        };
-        pid_setter ps(m_pid, child_pid);
+        detail::pid_setter ps(m_pid, child_pid);
         try {
             // Close the write descriptor, we don't need to send anything to the child.
             p.close_w();
@@ -359,20 +670,254 @@ void fork_island::run_evolve(island &isl) const
     }
 }
 
+void fork_island::run_evolve_persistent(island &isl) const
+{
+    // Fetch copies of the algorithm and population.
+    auto algo = isl.get_algorithm();
+    auto pop = isl.get_population();
+
+    // Serialise algorithm and problem, in order to detect
+    // if they differ from the ones held by the child.
+    auto algo_bytes = detail::to_bytes(algo);
+    auto prob_bytes = detail::to_bytes(pop.get_problem());
+
+    if (!m_worker) {
+        // Create the persistent child.
+        auto w = std::make_unique<detail::fork_worker>();
+
+        auto child_pid
+            = detail::fork_and_close({w->to_child.rd, w->to_child.wd, w->from_child.rd, w->from_child.wd});
+        // LCOV_EXCL_START
+        if (child_pid == -1) {
+            pagmo_throw(std::runtime_error,
+                        "Cannot fork the process in a fork_island with the fork() function. The error code is "
+                            + std::to_string(errno) + " and the error message is: '" + std::strerror(errno) + "'");
+        }
+        if (child_pid == 0) {
+            // We are in the child. Close the unneeded ends
+            // of the pipes and start serving the parent.
+            try {
+                w->to_child.close_w();
+                w->from_child.close_r();
+            } catch (...) {
+                std::exit(1);
+            }
+            worker_loop(*w);
+        }
+        // LCOV_EXCL_STOP
+
+        // We are in the parent.
+        w->pid = child_pid;
+        w->to_child.close_r();
+        w->from_child.close_w();
+
+        m_worker = std::move(w);
+    }
+
+    auto &w = *m_worker;
+
+    try {
+        // Assemble the message for the child. Algorithm and problem
+        // are sent only if they changed, the individuals are sent
+        // as a delta wrt those held by the child.
+        detail::worker_input_t in_msg;
+        if (algo_bytes != w.algo_bytes) {
+            std::get<0>(in_msg) = std::move(algo_bytes);
+        }
+        if (prob_bytes != w.prob_bytes) {
+            std::get<1>(in_msg) = std::move(prob_bytes);
+        }
+        std::get<2>(in_msg) = detail::make_delta(w.ID, w.x, w.f, pop.m_ID, pop.m_x, pop.m_f);
+        std::get<3>(in_msg) = pop.m_champion_x;
+        std::get<4>(in_msg) = pop.m_champion_f;
+        std::get<5>(in_msg) = pop.m_e;
+        std::get<6>(in_msg) = pop.m_seed;
+
+        // Send the message and wait for the reply.
+        detail::worker_output_t out_msg;
+        {
+            detail::pid_setter ps(m_pid, w.pid);
+
+            {
+                detail::sigpipe_blocker spb;
+                w.to_child.write_msg(detail::to_bytes(in_msg));
+            }
+
+            std::string out_str;
+            if (!w.from_child.read_msg(out_str)) {
+                pagmo_throw(std::runtime_error,
+                            "The persistent child process of a fork_island terminated unexpectedly");
+            }
+            detail::from_bytes(out_str, out_msg);
+        }
+
+        if (std::get<0>(out_msg)) {
+            pagmo_throw(std::runtime_error, "The run_evolve() method of fork_island raised an error in the "
+                                            "child process. The full error message reported by the child is:\n"
+                                                + std::get<1>(out_msg));
+        }
+
+        // Record the algorithm and problem now held by the child.
+        if (!std::get<0>(in_msg).empty()) {
+            w.algo_bytes = std::move(std::get<0>(in_msg));
+        }
+        if (!std::get<1>(in_msg).empty()) {
+            w.prob_bytes = std::move(std::get<1>(in_msg));
+        }
+
+        // Rebuild the evolved algorithm and population.
+        detail::from_bytes(std::get<2>(out_msg), algo);
+        detail::apply_delta(pop.m_ID, pop.m_x, pop.m_f, std::move(std::get<3>(out_msg)));
+        pop.m_champion_x = std::move(std::get<4>(out_msg));
+        pop.m_champion_f = std::move(std::get<5>(out_msg));
+        pop.m_e = std::get<6>(out_msg);
+        pop.m_seed = std::get<7>(out_msg);
+        pop.m_prob.increment_fevals(std::get<8>(out_msg));
+        pop.m_prob.increment_gevals(std::get<9>(out_msg));
+        pop.m_prob.increment_hevals(std::get<10>(out_msg));
+
+        // Update the state held by the child.
+        w.algo_bytes = std::move(std::get<2>(out_msg));
+        w.prob_bytes = detail::to_bytes(pop.get_problem());
+        w.ID = pop.m_ID;
+        w.x = pop.m_x;
+        w.f = pop.m_f;
+    } catch (...) {
+        // NOTE: in case of errors, the state of the child
+        // is unknown. Terminate it, a new child will be created
+        // at the next evolution.
+        m_worker.reset();
+        throw;
+    }
+
+    isl.set_algorithm(algo);
+    isl.set_population(pop);
+}
+
+// NOTE: we won't get any coverage data from the child process, so just disable
+// lcov for this whole function.
+//
+// LCOV_EXCL_START
+void fork_island::worker_loop(detail::fork_worker &w)
+{
+    // The algorithm and population held by the child.
+    algorithm algo;
+    population pop;
+
+    while (true) {
+        // Wait for the next message from the parent. If the parent
+        // closed the pipe, we can exit.
+        std::string in_str;
+        try {
+            if (!w.to_child.read_msg(in_str)) {
+                std::exit(0);
+            }
+        } catch (...) {
+            std::exit(1);
+        }
+
+        detail::worker_output_t out_msg;
+        try {
+            detail::worker_input_t in_msg;
+            detail::from_bytes(in_str, in_msg);
+
+            // Update the state of the child.
+            if (!std::get<0>(in_msg).empty()) {
+                detail::from_bytes(std::get<0>(in_msg), algo);
+            }
+            if (!std::get<1>(in_msg).empty()) {
+                problem prob;
+                detail::from_bytes(std::get<1>(in_msg), prob);
+                // NOTE: pass explicitly the seed, so that the global
+                // random device is never used in the child.
+                pop = population(std::move(prob), 0u, 0u);
+            }
+            detail::apply_delta(pop.m_ID, pop.m_x, pop.m_f, std::move(std::get<2>(in_msg)));
+            pop.m_champion_x = std::move(std::get<3>(in_msg));
+            pop.m_champion_f = std::move(std::get<4>(in_msg));
+            pop.m_e = std::get<5>(in_msg);
+            pop.m_seed = std::get<6>(in_msg);
+
+            // Run the evolution.
+            auto new_pop = algo.evolve(pop);
+
+            // Assemble the reply.
+            const auto &old_prob = pop.get_problem();
+            const auto &new_prob = new_pop.get_problem();
+            auto counter_diff = [](unsigned long long o, unsigned long long n) { return n > o ? n - o : 0ull; };
+
+            std::get<2>(out_msg) = detail::to_bytes(algo);
+            std::get<3>(out_msg)
+                = detail::make_delta(pop.m_ID, pop.m_x, pop.m_f, new_pop.m_ID, new_pop.m_x, new_pop.m_f);
+            std::get<4>(out_msg) = new_pop.m_champion_x;
+            std::get<5>(out_msg) = new_pop.m_champion_f;
+            std::get<6>(out_msg) = new_pop.m_e;
+            std::get<7>(out_msg) = new_pop.m_seed;
+            std::get<8>(out_msg) = counter_diff(old_prob.get_fevals(), new_prob.get_fevals());
+            std::get<9>(out_msg) = counter_diff(old_prob.get_gevals(), new_prob.get_gevals());
+            std::get<10>(out_msg) = counter_diff(old_prob.get_hevals(), new_prob.get_hevals());
+
+            pop = std::move(new_pop);
+        } catch (const std::exception &e) {
+            // NOTE: the parent will terminate the child
+            // after receiving an error message.
+            try {
+                out_msg = detail::worker_output_t{};
+                std::get<0>(out_msg) = 1;
+                std::get<1>(out_msg) = e.what();
+            } catch (...) {
+                std::exit(1);
+            }
+        } catch (...) {
+            out_msg = detail::worker_output_t{};
+            std::get<0>(out_msg) = 1;
+        }
+
+        // Send the reply to the parent.
+        try {
+            w.from_child.write_msg(detail::to_bytes(out_msg));
+        } catch (...) {
+            std::cerr << "An unrecoverable error was raised while trying to send data back to the parent process "
+                         "from the persistent child process of a fork_island. Giving up now."
+                      << std::endl;
+            std::exit(1);
+        }
+    }
+}
+// LCOV_EXCL_STOP
+
 // Extra info: report the child process' ID, if evolution
 // is active.
 std::string fork_island::get_extra_info() const
 {
     const auto pid = m_pid.load();
+    const std::string persistent_str = std::string("\n\tPersistent child process: ") + (m_persistent ? "yes" : "no");
     if (pid) {
-        return "\tChild PID: " + std::to_string(pid);
+        return "\tChild PID: " + std::to_string(pid) + persistent_str;
     }
-    return "\tNo active child";
+    return "\tNo active child" + persistent_str;
 }
 
 template <typename Archive>
-void fork_island::serialize(Archive &, unsigned)
+void fork_island::save(Archive &ar, unsigned) const
 {
+    ar << m_persistent;
+}
+
+template <typename Archive>
+void fork_island::load(Archive &ar, unsigned version)
+{
+    if (version > 0u) {
+        ar >> m_persistent;
+    } else {
+        // LCOV_EXCL_START
+        // NOTE: if loading from version 0,
+        // set the flag to false (as the version 0
+        // of fork_island had no support for
+        // a persistent child process).
+        m_persistent = false;
+        // LCOV_EXCL_STOP
+    }
 }
 
 } // namespace pagmo
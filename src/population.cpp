@@ -27,6 +27,7 @@ GNU Lesser General Public License along with the PaGMO library.  If not,
 see https://www.gnu.org/licenses/. */
 
 #include <algorithm>
+#include <atomic>
 #include <cassert>
 #include <iostream>
 #include <iterator>
@@ -36,13 +37,16 @@ see https://www.gnu.org/licenses/. */
 #include <string>
 #include <type_traits>
 #include <utility>
+#include <vector>
 
+#include <pagmo/batch_evaluators/thread_bfe.hpp>
 #include <pagmo/bfe.hpp>
 #include <pagmo/detail/custom_comparisons.hpp>
 #include <pagmo/exceptions.hpp>
 #include <pagmo/io.hpp>
 #include <pagmo/population.hpp>
 #include <pagmo/problem.hpp>
+#include <pagmo/threading.hpp>
 #include <pagmo/types.hpp>
 #include <pagmo/utils/constrained.hpp>
 #include <pagmo/utils/generic.hpp>
@@ -50,6 +54,58 @@ see https://www.gnu.org/licenses/. */
 namespace pagmo
 {
 
+namespace detail
+{
+
+namespace
+{
+
+// The parallel initialisation policy of populations.
+std::atomic<bool> population_parallel_init(false);
+
+} // namespace
+
+} // namespace detail
+
+/// Get the parallel initialisation policy of populations.
+/**
+ * \verbatim embed:rst:leading-asterisk
+ * .. versionadded:: 2.20
+ * \endverbatim
+ *
+ * This function is thread-safe.
+ *
+ * @return \p true if the parallel initialisation of populations is enabled, \p false otherwise.
+ */
+bool get_population_parallel_init()
+{
+    return detail::population_parallel_init.load();
+}
+
+/// Set the parallel initialisation policy of populations.
+/**
+ * \verbatim embed:rst:leading-asterisk
+ * .. versionadded:: 2.20
+ * \endverbatim
+ *
+ * If the parallel initialisation is enabled, the constructor of pagmo::population from a problem
+ * and a size will evaluate the fitnesses of the initial individuals in parallel via pagmo::thread_bfe,
+ * provided that the problem offers at least the pagmo::thread_safety::basic guarantee. Otherwise,
+ * the fitnesses are evaluated sequentially. The decision vectors of the initial individuals
+ * are the same in both cases.
+ *
+ * The parallel initialisation is disabled by default, as it requires the fitness function
+ * of the problem to be safe to call concurrently on different copies of the problem.
+ *
+ * This function is thread-safe.
+ *
+ * @param flag \p true to enable the parallel initialisation of populations, \p false to disable it.
+ */
+void set_population_parallel_init(bool flag)
+{
+    detail::population_parallel_init.store(flag);
+}
+
 /// Default constructor
 /**
  * Constructs an empty population with a default-constructed problem.
@@ -61,6 +117,14 @@ population::population() : population(problem{}, 0u, 0u) {}
 
 void population::prob_ctor_impl(size_type pop_size)
 {
+    if (pop_size > 1u && detail::population_parallel_init.load()
+        && m_prob.get_thread_safety() >= thread_safety::basic) {
+        // NOTE: the ctor from bfe generates the same dvs as the
+        // sequential implementation below.
+        constructor_from_bfe_impl(bfe{thread_bfe{}}, pop_size, std::true_type{});
+        return;
+    }
+
     // NOTE: generate the random decision vectors in temporary storage,
     // and only at the end move them into the population. This ensures
     // that, for a given rng seed, the generated dvs are identical
@@ -30,6 +30,7 @@ see https://www.gnu.org/licenses/. */
 #include <atomic>
 #include <cassert>
 #include <cmath>
+#include <functional>
 #include <initializer_list>
 #include <iostream>
 #include <limits>
@@ -425,6 +426,152 @@ vector_double problem::batch_fitness(const vector_double &dvs) const
     return retval;
 }
 
+/// Fitness into a caller-provided buffer.
+/**
+ * \verbatim embed:rst:leading-asterisk
+ * .. versionadded:: 2.20
+ * \endverbatim
+ *
+ * This method will compute the fitness of the decision vector stored in the \f$n_x\f$ contiguous
+ * elements starting at \p dv, and it will write it into the \f$n_f\f$ contiguous elements starting at \p fv.
+ * It is meant to be used in performance-critical code (e.g., in the implementation of
+ * batch fitness evaluators), as it does not require the caller to store the input and output values
+ * in separate vector_double objects.
+ *
+ * \verbatim embed:rst:leading-asterisk
+ * If :cpp:func:`pagmo::problem::has_fitness_into()` returns ``true``, this method will forward ``dv`` and ``fv``
+ * to the ``fitness_into()`` method of the UDP, which is expected to write into ``fv`` the
+ * fitness of ``dv`` without performing any memory allocation. Otherwise, this method will copy
+ * the input decision vector into a :cpp:type:`~pagmo::vector_double`, compute its fitness via
+ * :cpp:func:`pagmo::problem::fitness()`, and copy the result into ``fv``.
+ * \endverbatim
+ *
+ * Since the sizes of the input and output ranges are implicitly given by the problem's properties,
+ * no sanity check on the decision and fitness vectors is performed if the UDP
+ * provides <tt>%fitness_into()</tt>. A successful call of this method will increase the internal fitness
+ * evaluation counter (see problem::get_fevals()).
+ *
+ * @param dv a pointer to the beginning of the decision vector.
+ * @param fv a pointer to the beginning of the output fitness vector.
+ *
+ * @throws unspecified any exception thrown by problem::fitness(), or by the <tt>%fitness_into()</tt> method of
+ * the UDP.
+ */
+void problem::fitness_into(const double *dv, double *fv) const
+{
+    if (has_fitness_into()) {
+        // NOTE: the thread safety here depends on the thread safety of the UDP.
+        ptr()->fitness_into(dv, fv);
+
+        // Increment the fitness evaluation counter.
+        increment_fevals(1);
+    } else {
+        const auto retval = fitness(vector_double(dv, dv + get_nx()));
+        std::copy(
+#if defined(_MSC_VER)
+            retval.begin(), retval.end(), stdext::make_checked_array_iterator(fv, retval.size())
+#else
+            retval.begin(), retval.end(), fv
+#endif
+        );
+    }
+}
+
+/// Incremental fitness.
+/**
+ * \verbatim embed:rst:leading-asterisk
+ * .. versionadded:: 2.20
+ * \endverbatim
+ *
+ * This method will compute the fitness of the decision vector \p dv, given a decision vector \p dv_old
+ * which differs from \p dv only in the components whose indices are listed in \p idx, and
+ * the fitness \p fv_old of \p dv_old. It is meant to be used by algorithms performing local moves
+ * (e.g., perturbing one component at a time), as it allows problems whose fitness
+ * is (partially) separable to compute the new fitness by updating only the terms affected by
+ * the changed components.
+ *
+ * \verbatim embed:rst:leading-asterisk
+ * If the UDP satisfies :cpp:class:`pagmo::has_incremental_fitness`, this method will forward the
+ * arguments to the ``incremental_fitness()`` method of the UDP after sanity checks. The output of the
+ * ``incremental_fitness()`` method of the UDP will also be checked before being returned. Otherwise,
+ * this method will return the output of :cpp:func:`pagmo::problem::fitness()` on ``dv``, after the same
+ * sanity checks on the input arguments.
+ * The indices passed to the ``incremental_fitness()`` method of the UDP are sorted in ascending order
+ * and without duplicates.
+ *
+ * .. note::
+ *
+ *    If ``dv`` and ``dv_old`` differ in components not listed in ``idx``, or if ``fv_old`` is not
+ *    the fitness of ``dv_old``, the return value is unspecified. The fitness computed by
+ *    an incremental update may also differ from the output of :cpp:func:`pagmo::problem::fitness()`
+ *    due to floating-point rounding, and the differences can accumulate over chains of
+ *    incremental updates.
+ *
+ * \endverbatim
+ *
+ * A successful call of this method will increase the internal fitness evaluation counter (see
+ * problem::get_fevals()).
+ *
+ * @param dv the decision vector.
+ * @param dv_old the previous decision vector.
+ * @param fv_old the fitness of \p dv_old.
+ * @param idx the indices of the components in which \p dv and \p dv_old differ.
+ *
+ * @return the fitness of \p dv.
+ *
+ * @throws std::invalid_argument if either
+ * - the lengths of \p dv or \p dv_old differ from the value returned by get_nx(),
+ * - the length of \p fv_old or of the returned fitness vector differs from the value returned by get_nf(), or
+ * - an index in \p idx is not less than the value returned by get_nx().
+ * @throws unspecified any exception thrown by problem::fitness(), or by the <tt>%incremental_fitness()</tt>
+ * method of the UDP.
+ */
+vector_double problem::incremental_fitness(const vector_double &dv, const vector_double &dv_old,
+                                           const vector_double &fv_old,
+                                           const std::vector<vector_double::size_type> &idx) const
+{
+    // Check the input values.
+    // NOTE: the checks are performed also when falling back
+    // to fitness(), so that invalid input is reported consistently
+    // regardless of the capabilities of the UDP.
+    detail::prob_check_dv(*this, dv.data(), dv.size());
+    detail::prob_check_dv(*this, dv_old.data(), dv_old.size());
+    detail::prob_check_fv(*this, fv_old.data(), fv_old.size());
+    for (auto i : idx) {
+        if (i >= get_nx()) {
+            pagmo_throw(std::invalid_argument, "An invalid index of " + std::to_string(i)
+                                                   + " was passed to the incremental fitness of a problem of type '"
+                                                   + get_name() + "' with " + std::to_string(get_nx())
+                                                   + " dimensions");
+        }
+    }
+
+    if (!has_incremental_fitness()) {
+        return fitness(dv);
+    }
+
+    // NOTE: the UDP receives the indices sorted and without duplicates.
+    // Make a sorted copy only if needed, in order to avoid allocations
+    // in the common case of a single index.
+    std::vector<vector_double::size_type> sorted_idx;
+    if (std::adjacent_find(idx.begin(), idx.end(), std::greater_equal<vector_double::size_type>{}) != idx.end()) {
+        sorted_idx = idx;
+        std::sort(sorted_idx.begin(), sorted_idx.end());
+        sorted_idx.erase(std::unique(sorted_idx.begin(), sorted_idx.end()), sorted_idx.end());
+    }
+
+    // NOTE: the thread safety here depends on the thread safety of the UDP.
+    auto retval = ptr()->incremental_fitness(dv, dv_old, fv_old, sorted_idx.empty() ? idx : sorted_idx);
+
+    // Check the fitness vector.
+    detail::prob_check_fv(*this, retval.data(), retval.size());
+
+    // Increment the fitness evaluation counter.
+    increment_fevals(1);
+
+    return retval;
+}
+
 /// Gradient.
 /**
  * This method will compute the gradient of the input decision vector \p dv by invoking
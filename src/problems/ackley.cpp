@@ -26,12 +26,30 @@ You should have received copies of the GNU General Public License and the
 GNU Lesser General Public License along with the PaGMO library.  If not,
 see https://www.gnu.org/licenses/. */
 
+#include <cassert>
 #include <cmath>
 #include <initializer_list>
 #include <stdexcept>
 #include <string>
 #include <utility>
 
+#if defined(_MSC_VER)
+
+// Disable a warning from MSVC in the TBB code.
+#pragma warning(push)
+#pragma warning(disable : 4324)
+
+#endif
+
+#include <tbb/blocked_range.h>
+#include <tbb/parallel_for.h>
+
+#if defined(_MSC_VER)
+
+#pragma warning(pop)
+
+#endif
+
 #include <pagmo/detail/constants.hpp>
 #include <pagmo/exceptions.hpp>
 #include <pagmo/problem.hpp>
@@ -42,6 +60,31 @@ see https://www.gnu.org/licenses/. */
 namespace pagmo
 {
 
+namespace detail
+{
+
+namespace
+{
+
+// Ackley function of the vector of size n starting at x.
+double ackley_impl(const double *x, vector_double::size_type n)
+{
+    double omega = 2. * pi();
+    double s1 = 0., s2 = 0.;
+    double nepero = std::exp(1.0);
+
+    for (decltype(n) i = 0u; i < n; i++) {
+        s1 += x[i] * x[i];
+        s2 += std::cos(omega * x[i]);
+    }
+    return -20 * std::exp(-0.2 * std::sqrt(1.0 / static_cast<double>(n) * s1))
+           - std::exp(1.0 / static_cast<double>(n) * s2) + 20 + nepero;
+}
+
+} // namespace
+
+} // namespace detail
+
 ackley::ackley(unsigned dim) : m_dim(dim)
 {
     if (dim < 1u) {
@@ -60,19 +103,34 @@ ackley::ackley(unsigned dim) : m_dim(dim)
  */
 vector_double ackley::fitness(const vector_double &x) const
 {
-    vector_double f(1, 0.);
-    auto n = x.size();
-    double omega = 2. * detail::pi();
-    double s1 = 0., s2 = 0.;
-    double nepero = std::exp(1.0);
+    return {detail::ackley_impl(x.data(), x.size())};
+}
 
-    for (decltype(n) i = 0u; i < n; i++) {
-        s1 += x[i] * x[i];
-        s2 += std::cos(omega * x[i]);
-    }
-    f[0] = -20 * std::exp(-0.2 * std::sqrt(1.0 / static_cast<double>(n) * s1))
-           - std::exp(1.0 / static_cast<double>(n) * s2) + 20 + nepero;
-    return f;
+/// Batch fitness computation
+/**
+ * Computes the fitnesses of the decision vectors stored contiguously in \p xs.
+ * Each decision vector is read in place by the same kernel used by ackley::fitness(),
+ * which accumulates the squares and the cosines in a single pass, and the blocks of
+ * decision vectors are evaluated in parallel using TBB.
+ *
+ * @param xs the decision vectors.
+ *
+ * @return the fitnesses of \p xs.
+ */
+vector_double ackley::batch_fitness(const vector_double &xs) const
+{
+    const vector_double::size_type n = m_dim;
+    assert(xs.size() % n == 0u);
+    const auto n_dvs = xs.size() / n;
+
+    vector_double retval(n_dvs);
+    using range_t = tbb::blocked_range<decltype(xs.size())>;
+    tbb::parallel_for(range_t(0, n_dvs), [&xs, &retval, n](const range_t &range) {
+        for (auto i = range.begin(); i != range.end(); ++i) {
+            retval[i] = detail::ackley_impl(xs.data() + i * n, n);
+        }
+    });
+    return retval;
 }
 
 /// Box-bounds
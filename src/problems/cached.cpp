@@ -0,0 +1,665 @@
+/* Copyright 2017-2021 PaGMO development team
+
+This file is part of the PaGMO library.
+
+The PaGMO library is free software; you can redistribute it and/or modify
+it under the terms of either:
+
+  * the GNU Lesser General Public License as published by the Free
+    Software Foundation; either version 3 of the License, or (at your
+    option) any later version.
+
+or
+
+  * the GNU General Public License as published by the Free Software
+    Foundation; either version 3 of the License, or (at your option) any
+    later version.
+
+or both in parallel, as here.
+
+The PaGMO library is distributed in the hope that it will be useful, but
+WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+for more details.
+
+You should have received copies of the GNU General Public License and the
+GNU Lesser General Public License along with the PaGMO library.  If not,
+see https://www.gnu.org/licenses/. */
+
+#include <algorithm>
+#include <cassert>
+#include <cstddef>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <pagmo/detail/custom_comparisons.hpp>
+#include <pagmo/exceptions.hpp>
+#include <pagmo/problem.hpp>
+#include <pagmo/problems/cached.hpp>
+#include <pagmo/s11n.hpp>
+#include <pagmo/threading.hpp>
+#include <pagmo/types.hpp>
+
+// MINGW-specific warnings.
+#if defined(__GNUC__) && defined(__MINGW32__)
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wsuggest-attribute=pure"
+#pragma GCC diagnostic ignored "-Wsuggest-attribute=const"
+#endif
+
+namespace pagmo
+{
+
+namespace detail
+{
+
+namespace
+{
+
+// Maximum number of shards in the cache.
+constexpr std::size_t cached_max_n_shards = 16;
+
+} // namespace
+
+} // namespace detail
+
+/// Default constructor.
+/**
+ * The constructor will initialize a default-constructed pagmo::problem
+ * with a cache capacity of 10000.
+ */
+cached::cached() : m_capacity(10000u)
+{
+    generic_ctor_impl();
+}
+
+void cached::generic_ctor_impl()
+{
+    if (!m_capacity) {
+        pagmo_throw(std::invalid_argument, "The capacity of the cache of a cached problem must be nonzero");
+    }
+    init_storage();
+}
+
+// Setup a new, empty cache storage, distributing
+// the total capacity among the shards as evenly as possible.
+void cached::init_storage()
+{
+    assert(m_capacity > 0u);
+    const auto n_shards = std::min(m_capacity, detail::cached_max_n_shards);
+    auto st = std::make_shared<storage>();
+    st->m_shards.reserve(n_shards);
+    for (std::size_t i = 0; i < n_shards; ++i) {
+        st->m_shards.emplace_back(new shard);
+        st->m_shards.back()->m_capacity = m_capacity / n_shards + static_cast<std::size_t>(i < m_capacity % n_shards);
+    }
+    m_storage = std::move(st);
+}
+
+/// Copy constructor.
+/**
+ * The copy constructor will deep copy the inner problem of \p other. The cache
+ * and the hit/miss counters are not copied, but shared with \p other.
+ *
+ * @param other the source object.
+ *
+ * @throws unspecified any exception thrown by the copy constructor of pagmo::problem.
+ */
+cached::cached(const cached &other)
+    : m_problem(other.m_problem), m_capacity(other.m_capacity), m_storage(other.m_storage)
+{
+}
+
+/// Move constructor.
+/**
+ * @param other the source object.
+ */
+cached::cached(cached &&other) noexcept
+    : m_problem(std::move(other.m_problem)), m_capacity(other.m_capacity), m_storage(std::move(other.m_storage))
+{
+}
+
+/// Copy assignment operator.
+/**
+ * @param other the assignment argument.
+ *
+ * @return a reference to \p this.
+ *
+ * @throws unspecified any exception thrown by the copy constructor.
+ */
+cached &cached::operator=(const cached &other)
+{
+    if (this != &other) {
+        *this = cached(other);
+    }
+    return *this;
+}
+
+/// Move assignment operator.
+/**
+ * @param other the assignment argument.
+ *
+ * @return a reference to \p this.
+ */
+cached &cached::operator=(cached &&other) noexcept
+{
+    if (this != &other) {
+        m_problem = std::move(other.m_problem);
+        m_capacity = other.m_capacity;
+        m_storage = std::move(other.m_storage);
+    }
+    return *this;
+}
+
+cached::~cached() = default;
+
+cached::shard &cached::get_shard(std::size_t h) const
+{
+    assert(m_storage && !m_storage->m_shards.empty());
+    return *m_storage->m_shards[h % m_storage->m_shards.size()];
+}
+
+// Look up x (with hash h) in the cache. If x is found, its fitness
+// is written into f, x is marked as the most recently used entry and true
+// is returned. Otherwise, false is returned.
+bool cached::lookup(const vector_double &x, std::size_t h, vector_double &f) const
+{
+    auto &s = get_shard(h);
+
+    std::lock_guard<std::mutex> lock(s.m_mutex);
+    const auto it = s.m_map.find(x);
+    if (it == s.m_map.end()) {
+        return false;
+    }
+    s.m_lru.splice(s.m_lru.begin(), s.m_lru, it->second.second);
+    f = it->second.first;
+    return true;
+}
+
+// Insert the fitness f of x (with hash h) into the cache,
+// evicting the least recently used entry if necessary.
+void cached::insert(const vector_double &x, std::size_t h, const vector_double &f) const
+{
+    auto &s = get_shard(h);
+
+    std::lock_guard<std::mutex> lock(s.m_mutex);
+    const auto it = s.m_map.find(x);
+    if (it != s.m_map.end()) {
+        // NOTE: another thread might have inserted x
+        // in the meantime. Just mark it as recently used.
+        s.m_lru.splice(s.m_lru.begin(), s.m_lru, it->second.second);
+        return;
+    }
+
+    if (s.m_map.size() == s.m_capacity) {
+        // Evict the least recently used entry.
+        assert(!s.m_lru.empty());
+        const auto old_it = s.m_map.find(*s.m_lru.back());
+        assert(old_it != s.m_map.end());
+        s.m_lru.pop_back();
+        s.m_map.erase(old_it);
+    }
+
+    auto res = s.m_map.emplace(x, std::make_pair(f, shard::lru_list_t::iterator{}));
+    assert(res.second);
+    s.m_lru.push_front(&res.first->first);
+    res.first->second.second = s.m_lru.begin();
+}
+
+/// Fitness.
+/**
+ * If \p x is in the cache, the cached fitness is returned. Otherwise, the fitness
+ * computation is forwarded to the inner problem and the result is stored in the cache.
+ *
+ * @param x the decision vector.
+ *
+ * @return the fitness of \p x.
+ *
+ * @throws unspecified any exception thrown by memory errors in standard containers,
+ * threading primitives, or by problem::fitness().
+ */
+vector_double cached::fitness(const vector_double &x) const
+{
+    const auto h = detail::hash_vf<double>{}(x);
+
+    vector_double f;
+    if (lookup(x, h, f)) {
+        ++m_storage->m_hits;
+        return f;
+    }
+
+    ++m_storage->m_misses;
+    f = m_problem.fitness(x);
+    insert(x, h, f);
+
+    return f;
+}
+
+/// Fitness into a caller-provided buffer.
+/**
+ * \verbatim embed:rst:leading-asterisk
+ * .. versionadded:: 2.20
+ * \endverbatim
+ *
+ * If the decision vector at \p dv is in the cache, the cached fitness is written into \p fv. Otherwise, the
+ * fitness computation is forwarded to problem::fitness_into() of the inner problem and the result is
+ * stored in the cache.
+ *
+ * @param dv a pointer to the beginning of the decision vector.
+ * @param fv a pointer to the beginning of the output fitness vector.
+ *
+ * @throws unspecified any exception thrown by memory errors in standard containers,
+ * threading primitives, or by problem::fitness_into().
+ */
+void cached::fitness_into(const double *dv, double *fv) const
+{
+    // NOTE: the cache is keyed on vector_double, thus
+    // a copy of the decision vector is needed anyway.
+    const vector_double x(dv, dv + m_problem.get_nx());
+    const auto h = detail::hash_vf<double>{}(x);
+
+    vector_double f;
+    if (lookup(x, h, f)) {
+        ++m_storage->m_hits;
+    } else {
+        ++m_storage->m_misses;
+        f.resize(m_problem.get_nf());
+        m_problem.fitness_into(dv, f.data());
+        insert(x, h, f);
+    }
+
+    std::copy(f.begin(), f.end(), fv);
+}
+
+/// Check if the inner problem provides fitness_into().
+/**
+ * \verbatim embed:rst:leading-asterisk
+ * .. versionadded:: 2.20
+ * \endverbatim
+ *
+ * @return the output of problem::has_fitness_into() of the inner problem.
+ */
+bool cached::has_fitness_into() const
+{
+    return m_problem.has_fitness_into();
+}
+
+/// Batch fitness.
+/**
+ * The decision vectors in \p xs which are present in the cache are not re-evaluated.
+ * The remaining decision vectors are evaluated in a single call to the batch fitness
+ * function of the inner problem, and the results are stored in the cache.
+ *
+ * @param xs the input decision vectors.
+ *
+ * @return the fitnesses of \p xs.
+ *
+ * @throws unspecified any exception thrown by memory errors in standard containers,
+ * threading primitives, or by problem::batch_fitness().
+ */
+vector_double cached::batch_fitness(const vector_double &xs) const
+{
+    const auto nx = m_problem.get_nx();
+    const auto nf = m_problem.get_nf();
+    // Assume xs is sane.
+    assert(xs.size() % nx == 0u);
+    const auto n_dvs = xs.size() / nx;
+
+    vector_double retval(n_dvs * nf), x(nx), f;
+    // Indices and hashes of the dvs not in the cache,
+    // and the dvs themselves.
+    std::vector<std::pair<vector_double::size_type, std::size_t>> misses;
+    vector_double xs_miss;
+
+    for (vector_double::size_type i = 0; i < n_dvs; ++i) {
+        std::copy(xs.data() + i * nx, xs.data() + (i + 1u) * nx, x.data());
+        const auto h = detail::hash_vf<double>{}(x);
+
+        if (lookup(x, h, f)) {
+            assert(f.size() == nf);
+            std::copy(f.begin(), f.end(), retval.data() + i * nf);
+        } else {
+            misses.emplace_back(i, h);
+            xs_miss.insert(xs_miss.end(), x.begin(), x.end());
+        }
+    }
+
+    m_storage->m_hits += n_dvs - misses.size();
+    m_storage->m_misses += misses.size();
+
+    if (misses.empty()) {
+        return retval;
+    }
+
+    // Invoke batch_fitness() from m_problem on the missed dvs.
+    // NOTE: in non-debug mode, use the helper that avoids calling the checks in m_problem.batch_fitness().
+    // The cached metaproblem does not change the dimensionality of the problem
+    // or of the fitness, thus all the checks run by m_problem.batch_fitness()
+    // are redundant.
+#if defined(NDEBUG)
+    const auto fs_miss = detail::prob_invoke_mem_batch_fitness(m_problem, xs_miss, true);
+#else
+    const auto fs_miss = m_problem.batch_fitness(xs_miss);
+#endif
+    assert(fs_miss.size() == misses.size() * nf);
+
+    f.resize(nf);
+    for (decltype(misses.size()) j = 0; j < misses.size(); ++j) {
+        const auto i = misses[j].first;
+        std::copy(fs_miss.data() + j * nf, fs_miss.data() + (j + 1u) * nf, retval.data() + i * nf);
+        std::copy(xs_miss.data() + j * nx, xs_miss.data() + (j + 1u) * nx, x.data());
+        std::copy(fs_miss.data() + j * nf, fs_miss.data() + (j + 1u) * nf, f.data());
+        insert(x, misses[j].second, f);
+    }
+
+    return retval;
+}
+
+/// Check if the inner problem can compute fitnesses in batch mode.
+/**
+ * @return the output of the <tt>has_batch_fitness()</tt> member function invoked
+ * by the inner problem.
+ */
+bool cached::has_batch_fitness() const
+{
+    return m_problem.has_batch_fitness();
+}
+
+/// Box-bounds.
+/**
+ * @return the box-bounds of the inner problem.
+ *
+ * @throws unspecified any exception thrown by problem::get_bounds().
+ */
+std::pair<vector_double, vector_double> cached::get_bounds() const
+{
+    return m_problem.get_bounds();
+}
+
+/// Number of objectives.
+/**
+ * @return the number of objectives of the inner problem.
+ */
+vector_double::size_type cached::get_nobj() const
+{
+    return m_problem.get_nobj();
+}
+
+/// Equality constraint dimension.
+/**
+ * @return the number of equality constraints of the inner problem.
+ */
+vector_double::size_type cached::get_nec() const
+{
+    return m_problem.get_nec();
+}
+
+/// Inequality constraint dimension.
+/**
+ * @return the number of inequality constraints of the inner problem.
+ */
+vector_double::size_type cached::get_nic() const
+{
+    return m_problem.get_nic();
+}
+
+/// Integer dimension
+/**
+ * @return the integer dimension of the inner problem.
+ */
+vector_double::size_type cached::get_nix() const
+{
+    return m_problem.get_nix();
+}
+
+/// Checks if the inner problem has gradients.
+/**
+ * @return a flag signalling the availability of the gradient in the inner problem.
+ */
+bool cached::has_gradient() const
+{
+    return m_problem.has_gradient();
+}
+
+/// Gradients.
+/**
+ * The gradients computation is forwarded to the inner problem. Gradients are not cached.
+ *
+ * @param x the decision vector.
+ *
+ * @return the gradient of the fitness function.
+ *
+ * @throws unspecified any exception thrown by <tt>problem::gradient()</tt>.
+ */
+vector_double cached::gradient(const vector_double &x) const
+{
+    return m_problem.gradient(x);
+}
+
+/// Checks if the inner problem has gradient sparisty implemented.
+/**
+ * @return a flag signalling the availability of the gradient sparisty in the inner problem.
+ */
+bool cached::has_gradient_sparsity() const
+{
+    return m_problem.has_gradient_sparsity();
+}
+
+/// Gradient sparsity.
+/**
+ * @return the gradient sparsity of the inner problem.
+ */
+sparsity_pattern cached::gradient_sparsity() const
+{
+    return m_problem.gradient_sparsity();
+}
+
+/// Checks if the inner problem has hessians.
+/**
+ * @return a flag signalling the availability of the hessians in the inner problem.
+ */
+bool cached::has_hessians() const
+{
+    return m_problem.has_hessians();
+}
+
+/// Hessians.
+/**
+ * The hessians computation is forwarded to the inner problem. Hessians are not cached.
+ *
+ * @param x the decision vector.
+ *
+ * @return the hessians of the fitness function computed at \p x.
+ *
+ * @throws unspecified any exception thrown by problem::hessians().
+ */
+std::vector<vector_double> cached::hessians(const vector_double &x) const
+{
+    return m_problem.hessians(x);
+}
+
+/// Checks if the inner problem has hessians sparisty implemented.
+/**
+ * @return a flag signalling the availability of the hessians sparisty in the inner problem.
+ */
+bool cached::has_hessians_sparsity() const
+{
+    return m_problem.has_hessians_sparsity();
+}
+
+/// Hessians sparsity.
+/**
+ * @return the hessians sparsity of the inner problem.
+ */
+std::vector<sparsity_pattern> cached::hessians_sparsity() const
+{
+    return m_problem.hessians_sparsity();
+}
+
+/// Calls <tt>has_set_seed()</tt> of the inner problem.
+/**
+ * @return a flag signalling whether the inner problem is stochastic.
+ */
+bool cached::has_set_seed() const
+{
+    return m_problem.has_set_seed();
+}
+
+/// Calls <tt>set_seed()</tt> of the inner problem.
+/**
+ * Calls the method <tt>set_seed()</tt> of the inner problem and sets up a new, empty cache,
+ * as the cached fitnesses are not valid any more for the new seed. The cache shared
+ * with the copies of \p this is left untouched.
+ *
+ * @param seed seed to be set.
+ *
+ * @throws unspecified any exception thrown by the method <tt>set_seed()</tt> of the inner problem,
+ * or by memory errors in standard containers.
+ */
+void cached::set_seed(unsigned seed)
+{
+    m_problem.set_seed(seed);
+    init_storage();
+}
+
+/// Problem name
+/**
+ * This method will add <tt>[cached]</tt> to the name provided by the inner problem.
+ *
+ * @return a string containing the problem name.
+ *
+ * @throws unspecified any exception thrown by <tt>problem::get_name()</tt> or memory errors in standard classes.
+ */
+std::string cached::get_name() const
+{
+    return m_problem.get_name() + " [cached]";
+}
+
+/// Extra info
+/**
+ * This method will append a description of the state of the cache to the extra info provided
+ * by the inner problem.
+ *
+ * @return a string containing extra info on the problem.
+ *
+ * @throws unspecified any exception thrown by problem::get_extra_info(), threading primitives
+ * or memory errors in standard classes.
+ */
+std::string cached::get_extra_info() const
+{
+    return m_problem.get_extra_info() + "\n\tCache capacity: " + std::to_string(m_capacity)
+           + "\n\tCache size: " + std::to_string(get_cache_size()) + "\n\tCache hits: " + std::to_string(get_hits())
+           + "\n\tCache misses: " + std::to_string(get_misses());
+}
+
+/// Problem's thread safety level.
+/**
+ * The cache is protected by internal locking, thus the thread safety of this meta-problem
+ * is defined by the thread safety of the inner pagmo::problem.
+ *
+ * @return the thread safety level of the inner pagmo::problem.
+ */
+thread_safety cached::get_thread_safety() const
+{
+    return m_problem.get_thread_safety();
+}
+
+/// Cache capacity.
+/**
+ * @return the maximum number of fitness evaluations that can be stored in the cache.
+ */
+std::size_t cached::get_capacity() const
+{
+    return m_capacity;
+}
+
+/// Number of entries currently in the cache.
+/**
+ * @return the number of fitness evaluations currently stored in the cache.
+ *
+ * @throws unspecified any exception thrown by threading primitives.
+ */
+std::size_t cached::get_cache_size() const
+{
+    std::size_t retval = 0;
+    for (const auto &s : m_storage->m_shards) {
+        std::lock_guard<std::mutex> lock(s->m_mutex);
+        retval += s->m_map.size();
+    }
+    return retval;
+}
+
+/// Number of cache hits.
+/**
+ * @return the number of fitness evaluations that were served from the cache.
+ */
+unsigned long long cached::get_hits() const
+{
+    return m_storage->m_hits.load(std::memory_order_relaxed);
+}
+
+/// Number of cache misses.
+/**
+ * @return the number of fitness evaluations that were forwarded to the inner problem.
+ */
+unsigned long long cached::get_misses() const
+{
+    return m_storage->m_misses.load(std::memory_order_relaxed);
+}
+
+/// Clear the cache.
+/**
+ * This method will remove all the entries from the cache and reset
+ * the hit/miss counters to zero. The change is visible to all the copies
+ * of \p this sharing the same cache.
+ *
+ * @throws unspecified any exception thrown by threading primitives.
+ */
+void cached::clear_cache()
+{
+    for (auto &s : m_storage->m_shards) {
+        std::lock_guard<std::mutex> lock(s->m_mutex);
+        s->m_map.clear();
+        s->m_lru.clear();
+    }
+    m_storage->m_hits.store(0, std::memory_order_relaxed);
+    m_storage->m_misses.store(0, std::memory_order_relaxed);
+}
+
+const problem &cached::get_inner_problem() const
+{
+    return m_problem;
+}
+
+problem &cached::get_inner_problem()
+{
+    // NOTE: the inner problem may be modified via the returned
+    // reference, thus stop sharing the cache with the copies.
+    init_storage();
+    return m_problem;
+}
+
+// Object serialization
+template <typename Archive>
+void cached::save(Archive &ar, unsigned) const
+{
+    detail::to_archive(ar, m_problem, m_capacity);
+}
+
+template <typename Archive>
+void cached::load(Archive &ar, unsigned)
+{
+    cached tmp;
+    detail::from_archive(ar, tmp.m_problem, tmp.m_capacity);
+    tmp.generic_ctor_impl();
+
+    *this = std::move(tmp);
+}
+
+} // namespace pagmo
+
+PAGMO_S11N_PROBLEM_IMPLEMENT(pagmo::cached)
@@ -149,6 +149,51 @@ vector_double decompose::fitness(const vector_double &x) const
     return decompose_objectives(f, m_weight, m_z, m_method);
 }
 
+/// Fitness into a caller-provided buffer.
+/**
+ * \verbatim embed:rst:leading-asterisk
+ * .. versionadded:: 2.20
+ * \endverbatim
+ *
+ * The decision vector at \p dv is forwarded to problem::fitness_into() of the inner problem, and the
+ * resulting fitness is decomposed as in decompose::fitness() and written into \p fv.
+ *
+ * @param dv a pointer to the beginning of the decision vector.
+ * @param fv a pointer to the beginning of the output fitness vector.
+ *
+ * @throws unspecified any exception thrown by memory errors in standard containers,
+ * by problem::fitness_into(), or by the fitness decomposition.
+ */
+void decompose::fitness_into(const double *dv, double *fv) const
+{
+    // we compute the fitness of the original multiobjective problem
+    vector_double f(m_problem.get_nobj());
+    m_problem.fitness_into(dv, f.data());
+    // if necessary we update the reference point
+    if (m_adapt_ideal) {
+        for (decltype(f.size()) i = 0u; i < f.size(); ++i) {
+            if (f[i] < m_z[i]) {
+                m_z[i] = f[i]; // its mutable so its ok
+            }
+        }
+    }
+    // we write the decomposed fitness
+    fv[0] = decompose_objectives(f, m_weight, m_z, m_method)[0];
+}
+
+/// Check if the inner problem provides fitness_into().
+/**
+ * \verbatim embed:rst:leading-asterisk
+ * .. versionadded:: 2.20
+ * \endverbatim
+ *
+ * @return the output of problem::has_fitness_into() of the inner problem.
+ */
+bool decompose::has_fitness_into() const
+{
+    return m_problem.has_fitness_into();
+}
+
 /// Fitness of the original problem.
 /**
  * Returns the fitness of the original multi-objective problem used to construct the decomposed problem.
@@ -26,6 +26,8 @@ You should have received copies of the GNU General Public License and the
 GNU Lesser General Public License along with the PaGMO library.  If not,
 see https://www.gnu.org/licenses/. */
 
+#include <algorithm>
+#include <cassert>
 #include <cmath>
 #include <initializer_list>
 #include <limits>
@@ -33,6 +35,23 @@ see https://www.gnu.org/licenses/. */
 #include <string>
 #include <utility>
 
+#if defined(_MSC_VER)
+
+// Disable a warning from MSVC in the TBB code.
+#pragma warning(push)
+#pragma warning(disable : 4324)
+
+#endif
+
+#include <tbb/blocked_range.h>
+#include <tbb/parallel_for.h>
+
+#if defined(_MSC_VER)
+
+#pragma warning(pop)
+
+#endif
+
 #include <pagmo/detail/constants.hpp>
 #include <pagmo/exceptions.hpp>
 #include <pagmo/population.hpp>
@@ -83,26 +102,38 @@ dtlz::dtlz(unsigned prob_id, vector_double::size_type dim, vector_double::size_t
  */
 vector_double dtlz::fitness(const vector_double &x) const
 {
-    vector_double retval;
-    switch (m_prob_id) {
-        case 1:
-            retval = f1_objfun_impl(x);
-            break;
-        case 2:
-        case 3:
-            retval = f23_objfun_impl(x);
-            break;
-        case 4:
-            retval = f4_objfun_impl(x);
-            break;
-        case 5:
-        case 6:
-            retval = f56_objfun_impl(x);
-            break;
-        case 7:
-            retval = f7_objfun_impl(x);
-            break;
-    }
+    return (this->*get_fitness_impl())(x);
+}
+
+/// Batch fitness computation
+/**
+ * Computes the fitnesses of the decision vectors stored contiguously in \p xs.
+ * The DTLZ function matching the problem id is selected once for the whole batch. Since the
+ * DTLZ functions operate on pagmo::vector_double, each block of decision vectors evaluated
+ * in parallel by TBB reuses a single buffer for its decision vectors, while each evaluation
+ * still allocates its own fitness vector.
+ *
+ * @param xs the decision vectors.
+ *
+ * @return the fitnesses of \p xs.
+ */
+vector_double dtlz::batch_fitness(const vector_double &xs) const
+{
+    assert(xs.size() % m_dim == 0u);
+    const auto n_dvs = xs.size() / m_dim;
+
+    vector_double retval(n_dvs * m_fdim);
+    const auto impl = get_fitness_impl();
+    using range_t = tbb::blocked_range<decltype(xs.size())>;
+    tbb::parallel_for(range_t(0, n_dvs), [&xs, &retval, impl, this](const range_t &range) {
+        vector_double x(m_dim);
+        for (auto i = range.begin(); i != range.end(); ++i) {
+            std::copy(xs.data() + i * m_dim, xs.data() + (i + 1u) * m_dim, x.data());
+            const auto f = (this->*impl)(x);
+            assert(f.size() == m_fdim);
+            std::copy(f.begin(), f.end(), retval.data() + i * m_fdim);
+        }
+    });
     return retval;
 }
 
@@ -255,6 +286,27 @@ double dtlz::h7_func(const vector_double &f, double g) const
     return static_cast<double>(m_fdim) - y;
 }
 
+// Select the objective function
+// corresponding to the problem id.
+dtlz::fitness_impl_t dtlz::get_fitness_impl() const
+{
+    switch (m_prob_id) {
+        case 1:
+            return &dtlz::f1_objfun_impl;
+        case 2:
+        case 3:
+            return &dtlz::f23_objfun_impl;
+        case 4:
+            return &dtlz::f4_objfun_impl;
+        case 5:
+        case 6:
+            return &dtlz::f56_objfun_impl;
+        default:
+            assert(m_prob_id == 7u);
+            return &dtlz::f7_objfun_impl;
+    }
+}
+
 vector_double dtlz::f1_objfun_impl(const vector_double &x) const
 {
     vector_double f(m_fdim);
@@ -26,12 +26,30 @@ You should have received copies of the GNU General Public License and the
 GNU Lesser General Public License along with the PaGMO library.  If not,
 see https://www.gnu.org/licenses/. */
 
+#include <cassert>
 #include <cmath>
 #include <initializer_list>
 #include <stdexcept>
 #include <string>
 #include <utility>
 
+#if defined(_MSC_VER)
+
+// Disable a warning from MSVC in the TBB code.
+#pragma warning(push)
+#pragma warning(disable : 4324)
+
+#endif
+
+#include <tbb/blocked_range.h>
+#include <tbb/parallel_for.h>
+
+#if defined(_MSC_VER)
+
+#pragma warning(pop)
+
+#endif
+
 #include <pagmo/exceptions.hpp>
 #include <pagmo/problem.hpp>
 #include <pagmo/problems/griewank.hpp>
@@ -41,6 +59,32 @@ see https://www.gnu.org/licenses/. */
 namespace pagmo
 {
 
+namespace detail
+{
+
+namespace
+{
+
+// Griewank function of the vector of size n starting at x.
+double griewank_impl(const double *x, vector_double::size_type n)
+{
+    double fr = 4000.;
+    double retval = 0.;
+    double p = 1.;
+
+    for (decltype(n) i = 0u; i < n; i++) {
+        retval += x[i] * x[i];
+    }
+    for (decltype(n) i = 0u; i < n; i++) {
+        p *= std::cos(x[i] / std::sqrt(static_cast<double>(i) + 1.0));
+    }
+    return retval / fr - p + 1.;
+}
+
+} // namespace
+
+} // namespace detail
+
 griewank::griewank(unsigned dim) : m_dim(dim)
 {
     if (dim < 1u) {
@@ -59,20 +103,34 @@ griewank::griewank(unsigned dim) : m_dim(dim)
  */
 vector_double griewank::fitness(const vector_double &x) const
 {
-    vector_double f(1, 0.);
-    auto n = x.size();
-    double fr = 4000.;
-    double retval = 0.;
-    double p = 1.;
+    return {detail::griewank_impl(x.data(), x.size())};
+}
 
-    for (decltype(n) i = 0u; i < n; i++) {
-        retval += x[i] * x[i];
-    }
-    for (decltype(n) i = 0u; i < n; i++) {
-        p *= std::cos(x[i] / std::sqrt(static_cast<double>(i) + 1.0));
-    }
-    f[0] = (retval / fr - p + 1.);
-    return f;
+/// Batch fitness computation
+/**
+ * Computes the fitnesses of the decision vectors stored contiguously in \p xs.
+ * The sum of squares and the product of cosines of each decision vector are computed
+ * in place, without copying the decision vector, and the blocks of decision vectors
+ * are evaluated in parallel using TBB.
+ *
+ * @param xs the decision vectors.
+ *
+ * @return the fitnesses of \p xs.
+ */
+vector_double griewank::batch_fitness(const vector_double &xs) const
+{
+    const vector_double::size_type n = m_dim;
+    assert(xs.size() % n == 0u);
+    const auto n_dvs = xs.size() / n;
+
+    vector_double retval(n_dvs);
+    using range_t = tbb::blocked_range<decltype(xs.size())>;
+    tbb::parallel_for(range_t(0, n_dvs), [&xs, &retval, n](const range_t &range) {
+        for (auto i = range.begin(); i != range.end(); ++i) {
+            retval[i] = detail::griewank_impl(xs.data() + i * n, n);
+        }
+    });
+    return retval;
 }
 
 /// Box-bounds
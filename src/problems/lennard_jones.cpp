@@ -26,12 +26,14 @@ You should have received copies of the GNU General Public License and the
 GNU Lesser General Public License along with the PaGMO library.  If not,
 see https://www.gnu.org/licenses/. */
 
+#include <algorithm>
 #include <cmath>
 #include <initializer_list>
 #include <limits>
 #include <stdexcept>
 #include <string>
 #include <utility>
+#include <vector>
 
 #include <pagmo/exceptions.hpp>
 #include <pagmo/problem.hpp>
@@ -90,6 +92,72 @@ vector_double lennard_jones::fitness(const vector_double &x) const
     return f;
 }
 
+/// Incremental fitness computation
+/**
+ * \verbatim embed:rst:leading-asterisk
+ * .. versionadded:: 2.20
+ * \endverbatim
+ *
+ * Computes the fitness of \p x from the fitness \p f_old of \p x_old, updating only the
+ * pair potentials involving the atoms whose coordinates are listed in \p idx
+ * (see problem::incremental_fitness()). Moving \f$k\f$ atoms thus costs \f$\mathcal{O}(kN)\f$
+ * rather than \f$\mathcal{O}(N^2)\f$ operations. If \p f_old is not finite or
+ * if two atoms overlap in \p x, the fitness is computed from scratch.
+ *
+ * @param x the decision vector.
+ * @param x_old the previous decision vector.
+ * @param f_old the fitness of \p x_old.
+ * @param idx the indices of the components in which \p x and \p x_old differ.
+ *
+ * @return the fitness of \p x.
+ */
+vector_double lennard_jones::incremental_fitness(const vector_double &x, const vector_double &x_old,
+                                                 const vector_double &f_old,
+                                                 const std::vector<vector_double::size_type> &idx) const
+{
+    // NOTE: overlapping atoms saturate the fitness, which
+    // then cannot be updated incrementally.
+    if (!std::isfinite(f_old[0])) {
+        return fitness(x);
+    }
+
+    // Determine the moved atoms. As idx is sorted, they
+    // will be sorted as well.
+    std::vector<unsigned> moved;
+    for (auto i : idx) {
+        const auto atom = i == 0u ? 1u : (i < 3u ? 2u : static_cast<unsigned>(i / 3u) + 2u);
+        if (moved.empty() || moved.back() != atom) {
+            moved.push_back(atom);
+        }
+    }
+
+    auto dist2 = [this](unsigned i, unsigned j, const vector_double &y) {
+        return std::pow(_r(i, 0u, y) - _r(j, 0u, y), 2) + std::pow(_r(i, 1u, y) - _r(j, 1u, y), 2)
+               + std::pow(_r(i, 2u, y) - _r(j, 2u, y), 2);
+    };
+    auto potential = [](double dist) {
+        const auto sixth = std::pow(dist, -3);
+        return std::pow(sixth, 2) - sixth;
+    };
+
+    double delta = 0.;
+    for (auto i : moved) {
+        for (unsigned j = 0u; j < m_atoms; ++j) {
+            // NOTE: the pairs of moved atoms are accounted for only once.
+            if (j == i || (j < i && std::binary_search(moved.begin(), moved.end(), j))) {
+                continue;
+            }
+            const auto dist_new = dist2(i, j, x), dist_old = dist2(i, j, x_old);
+            if (dist_new == 0. || dist_old == 0.) {
+                return fitness(x);
+            }
+            delta += potential(dist_new) - potential(dist_old);
+        }
+    }
+
+    return {f_old[0] + 4 * delta};
+}
+
 /// Box-bounds
 /**
  * Returns the box-bounds for this UDP.
@@ -26,6 +26,7 @@ You should have received copies of the GNU General Public License and the
 GNU Lesser General Public License along with the PaGMO library.  If not,
 see https://www.gnu.org/licenses/. */
 
+#include <cassert>
 #include <cmath>
 #include <initializer_list>
 #include <stdexcept>
@@ -33,6 +34,23 @@ see https://www.gnu.org/licenses/. */
 #include <utility>
 #include <vector>
 
+#if defined(_MSC_VER)
+
+// Disable a warning from MSVC in the TBB code.
+#pragma warning(push)
+#pragma warning(disable : 4324)
+
+#endif
+
+#include <tbb/blocked_range.h>
+#include <tbb/parallel_for.h>
+
+#if defined(_MSC_VER)
+
+#pragma warning(pop)
+
+#endif
+
 #include <pagmo/detail/constants.hpp>
 #include <pagmo/exceptions.hpp>
 #include <pagmo/problem.hpp>
@@ -43,6 +61,28 @@ see https://www.gnu.org/licenses/. */
 namespace pagmo
 {
 
+namespace detail
+{
+
+namespace
+{
+
+// Rastrigin function of the vector of size n starting at x.
+double rastrigin_impl(const double *x, vector_double::size_type n)
+{
+    double retval = 0.;
+    const auto omega = 2. * pi();
+    for (decltype(n) i = 0u; i < n; ++i) {
+        retval += x[i] * x[i] - 10. * std::cos(omega * x[i]);
+    }
+    retval += 10. * static_cast<double>(n);
+    return retval;
+}
+
+} // namespace
+
+} // namespace detail
+
 rastrigin::rastrigin(unsigned dim) : m_dim(dim)
 {
     if (dim < 1u) {
@@ -61,14 +101,63 @@ rastrigin::rastrigin(unsigned dim) : m_dim(dim)
  */
 vector_double rastrigin::fitness(const vector_double &x) const
 {
-    vector_double f(1, 0.);
+    return {detail::rastrigin_impl(x.data(), x.size())};
+}
+
+/// Batch fitness computation
+/**
+ * Computes the fitnesses of the decision vectors stored contiguously in \p xs.
+ * Since the Rastrigin function is separable, each decision vector is reduced in place
+ * with a single pass over its components. The blocks of decision vectors are evaluated
+ * in parallel using TBB.
+ *
+ * @param xs the decision vectors.
+ *
+ * @return the fitnesses of \p xs.
+ */
+vector_double rastrigin::batch_fitness(const vector_double &xs) const
+{
+    const vector_double::size_type n = m_dim;
+    assert(xs.size() % n == 0u);
+    const auto n_dvs = xs.size() / n;
+
+    vector_double retval(n_dvs);
+    using range_t = tbb::blocked_range<decltype(xs.size())>;
+    tbb::parallel_for(range_t(0, n_dvs), [&xs, &retval, n](const range_t &range) {
+        for (auto i = range.begin(); i != range.end(); ++i) {
+            retval[i] = detail::rastrigin_impl(xs.data() + i * n, n);
+        }
+    });
+    return retval;
+}
+
+/// Incremental fitness computation
+/**
+ * \verbatim embed:rst:leading-asterisk
+ * .. versionadded:: 2.20
+ * \endverbatim
+ *
+ * Computes the fitness of \p x from the fitness \p f_old of \p x_old, updating only the terms
+ * of the sum associated to the components listed in \p idx (see problem::incremental_fitness()).
+ *
+ * @param x the decision vector.
+ * @param x_old the previous decision vector.
+ * @param f_old the fitness of \p x_old.
+ * @param idx the indices of the components in which \p x and \p x_old differ.
+ *
+ * @return the fitness of \p x.
+ */
+vector_double rastrigin::incremental_fitness(const vector_double &x, const vector_double &x_old,
+                                             const vector_double &f_old,
+                                             const std::vector<vector_double::size_type> &idx) const
+{
     const auto omega = 2. * pagmo::detail::pi();
-    auto n = x.size();
-    for (decltype(n) i = 0u; i < n; ++i) {
-        f[0] += x[i] * x[i] - 10. * std::cos(omega * x[i]);
+    double retval = f_old[0];
+    for (auto i : idx) {
+        retval += (x[i] * x[i] - 10. * std::cos(omega * x[i]))
+                  - (x_old[i] * x_old[i] - 10. * std::cos(omega * x_old[i]));
     }
-    f[0] += 10. * static_cast<double>(n);
-    return f;
+    return {retval};
 }
 
 /// Box-bounds
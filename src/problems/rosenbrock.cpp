@@ -26,10 +26,30 @@ You should have received copies of the GNU General Public License and the
 GNU Lesser General Public License along with the PaGMO library.  If not,
 see https://www.gnu.org/licenses/. */
 
+#include <algorithm>
+#include <cassert>
 #include <initializer_list>
 #include <stdexcept>
 #include <string>
 #include <utility>
+#include <vector>
+
+#if defined(_MSC_VER)
+
+// Disable a warning from MSVC in the TBB code.
+#pragma warning(push)
+#pragma warning(disable : 4324)
+
+#endif
+
+#include <tbb/blocked_range.h>
+#include <tbb/parallel_for.h>
+
+#if defined(_MSC_VER)
+
+#pragma warning(pop)
+
+#endif
 
 #include <pagmo/exceptions.hpp>
 #include <pagmo/problem.hpp>
@@ -40,6 +60,32 @@ see https://www.gnu.org/licenses/. */
 namespace pagmo
 {
 
+namespace detail
+{
+
+namespace
+{
+
+// The i-th term of the Rosenbrock function of the vector starting at x.
+double rosenbrock_term(const double *x, vector_double::size_type i)
+{
+    return 100. * (x[i] * x[i] - x[i + 1]) * (x[i] * x[i] - x[i + 1]) + (x[i] - 1) * (x[i] - 1);
+}
+
+// Rosenbrock function of the vector of size dim starting at x.
+double rosenbrock_impl(const double *x, vector_double::size_type dim)
+{
+    double retval = 0.;
+    for (decltype(dim) i = 0u; i < dim - 1u; ++i) {
+        retval += rosenbrock_term(x, i);
+    }
+    return retval;
+}
+
+} // namespace
+
+} // namespace detail
+
 rosenbrock::rosenbrock(vector_double::size_type dim) : m_dim(dim)
 {
     if (dim < 2u) {
@@ -58,9 +104,66 @@ rosenbrock::rosenbrock(vector_double::size_type dim) : m_dim(dim)
  */
 vector_double rosenbrock::fitness(const vector_double &x) const
 {
-    double retval = 0.;
-    for (decltype(m_dim) i = 0u; i < m_dim - 1u; ++i) {
-        retval += 100. * (x[i] * x[i] - x[i + 1]) * (x[i] * x[i] - x[i + 1]) + (x[i] - 1) * (x[i] - 1);
+    return {detail::rosenbrock_impl(x.data(), m_dim)};
+}
+
+/// Batch fitness computation
+/**
+ * Computes the fitnesses of the decision vectors stored contiguously in \p xs.
+ * The terms of the Rosenbrock function couple consecutive components, thus each decision
+ * vector is read in place as a whole, without being split across tasks. The blocks of
+ * decision vectors are evaluated in parallel using TBB.
+ *
+ * @param xs the decision vectors.
+ *
+ * @return the fitnesses of \p xs.
+ */
+vector_double rosenbrock::batch_fitness(const vector_double &xs) const
+{
+    assert(xs.size() % m_dim == 0u);
+    const auto n_dvs = xs.size() / m_dim;
+
+    vector_double retval(n_dvs);
+    using range_t = tbb::blocked_range<decltype(xs.size())>;
+    tbb::parallel_for(range_t(0, n_dvs), [&xs, &retval, this](const range_t &range) {
+        for (auto i = range.begin(); i != range.end(); ++i) {
+            retval[i] = detail::rosenbrock_impl(xs.data() + i * m_dim, m_dim);
+        }
+    });
+    return retval;
+}
+
+/// Incremental fitness computation
+/**
+ * \verbatim embed:rst:leading-asterisk
+ * .. versionadded:: 2.20
+ * \endverbatim
+ *
+ * Computes the fitness of \p x from the fitness \p f_old of \p x_old, updating only the terms
+ * of the sum which depend on the components listed in \p idx (see problem::incremental_fitness()).
+ * Each component appears in at most two terms of the sum.
+ *
+ * @param x the decision vector.
+ * @param x_old the previous decision vector.
+ * @param f_old the fitness of \p x_old.
+ * @param idx the indices of the components in which \p x and \p x_old differ.
+ *
+ * @return the fitness of \p x.
+ */
+vector_double rosenbrock::incremental_fitness(const vector_double &x, const vector_double &x_old,
+                                              const vector_double &f_old,
+                                              const std::vector<vector_double::size_type> &idx) const
+{
+    double retval = f_old[0];
+    // NOTE: the i-th component appears in the terms i - 1 and i. As idx is sorted,
+    // the terms to be updated are visited in ascending order, and we just need to
+    // skip the terms already updated.
+    vector_double::size_type next_term = 0;
+    for (auto i : idx) {
+        for (auto t = std::max(i == 0u ? i : i - 1u, next_term); t <= i && t < m_dim - 1u; ++t) {
+            retval += detail::rosenbrock_term(x.data(), t) - detail::rosenbrock_term(x_old.data(), t);
+            next_term = t + 1u;
+        }
     }
     return {retval};
 }
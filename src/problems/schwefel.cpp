@@ -26,12 +26,30 @@ You should have received copies of the GNU General Public License and the
 GNU Lesser General Public License along with the PaGMO library.  If not,
 see https://www.gnu.org/licenses/. */
 
+#include <cassert>
 #include <cmath>
 #include <initializer_list>
 #include <stdexcept>
 #include <string>
 #include <utility>
 
+#if defined(_MSC_VER)
+
+// Disable a warning from MSVC in the TBB code.
+#pragma warning(push)
+#pragma warning(disable : 4324)
+
+#endif
+
+#include <tbb/blocked_range.h>
+#include <tbb/parallel_for.h>
+
+#if defined(_MSC_VER)
+
+#pragma warning(pop)
+
+#endif
+
 #include <pagmo/exceptions.hpp>
 #include <pagmo/problem.hpp>
 #include <pagmo/problems/schwefel.hpp>
@@ -41,6 +59,26 @@ see https://www.gnu.org/licenses/. */
 namespace pagmo
 {
 
+namespace detail
+{
+
+namespace
+{
+
+// Schwefel function of the vector of size n starting at x.
+double schwefel_impl(const double *x, vector_double::size_type n)
+{
+    double retval = 0.;
+    for (decltype(n) i = 0u; i < n; i++) {
+        retval += x[i] * std::sin(std::sqrt(std::abs(x[i])));
+    }
+    return 418.9828872724338 * static_cast<double>(n) - retval;
+}
+
+} // namespace
+
+} // namespace detail
+
 schwefel::schwefel(unsigned dim) : m_dim(dim)
 {
     if (dim < 1u) {
@@ -59,13 +97,33 @@ schwefel::schwefel(unsigned dim) : m_dim(dim)
  */
 vector_double schwefel::fitness(const vector_double &x) const
 {
-    vector_double f(1, 0.);
-    auto n = x.size();
-    for (decltype(n) i = 0u; i < n; i++) {
-        f[0] += x[i] * std::sin(std::sqrt(std::abs(x[i])));
-    }
-    f[0] = 418.9828872724338 * static_cast<double>(n) - f[0];
-    return f;
+    return {detail::schwefel_impl(x.data(), x.size())};
+}
+
+/// Batch fitness computation
+/**
+ * Computes the fitnesses of the decision vectors stored contiguously in \p xs.
+ * The constant term \f$ 418.9828872724338 \, n \f$ is shared by all the decision vectors,
+ * which are read in place and evaluated in parallel using TBB.
+ *
+ * @param xs the decision vectors.
+ *
+ * @return the fitnesses of \p xs.
+ */
+vector_double schwefel::batch_fitness(const vector_double &xs) const
+{
+    const vector_double::size_type n = m_dim;
+    assert(xs.size() % n == 0u);
+    const auto n_dvs = xs.size() / n;
+
+    vector_double retval(n_dvs);
+    using range_t = tbb::blocked_range<decltype(xs.size())>;
+    tbb::parallel_for(range_t(0, n_dvs), [&xs, &retval, n](const range_t &range) {
+        for (auto i = range.begin(); i != range.end(); ++i) {
+            retval[i] = detail::schwefel_impl(xs.data() + i * n, n);
+        }
+    });
+    return retval;
 }
 
 /// Box-bounds
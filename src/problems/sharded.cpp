@@ -0,0 +1,577 @@
+/* Copyright 2017-2021 PaGMO development team
+
+This file is part of the PaGMO library.
+
+The PaGMO library is free software; you can redistribute it and/or modify
+it under the terms of either:
+
+  * the GNU Lesser General Public License as published by the Free
+    Software Foundation; either version 3 of the License, or (at your
+    option) any later version.
+
+or
+
+  * the GNU General Public License as published by the Free Software
+    Foundation; either version 3 of the License, or (at your option) any
+    later version.
+
+or both in parallel, as here.
+
+The PaGMO library is distributed in the hope that it will be useful, but
+WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+for more details.
+
+You should have received copies of the GNU General Public License and the
+GNU Lesser General Public License along with the PaGMO library.  If not,
+see https://www.gnu.org/licenses/. */
+
+#include <algorithm>
+#include <cassert>
+#include <cstddef>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include <pagmo/problem.hpp>
+#include <pagmo/problems/sharded.hpp>
+#include <pagmo/s11n.hpp>
+#include <pagmo/threading.hpp>
+#include <pagmo/types.hpp>
+
+// MINGW-specific warnings.
+#if defined(__GNUC__) && defined(__MINGW32__)
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wsuggest-attribute=pure"
+#pragma GCC diagnostic ignored "-Wsuggest-attribute=const"
+#endif
+
+namespace pagmo
+{
+
+namespace detail
+{
+
+namespace
+{
+
+// Number of shards in the pool of clones.
+constexpr std::size_t sharded_n_shards = 16;
+
+} // namespace
+
+} // namespace detail
+
+/// Default constructor.
+/**
+ * The constructor will initialize a default-constructed pagmo::problem.
+ */
+sharded::sharded()
+{
+    generic_ctor_impl();
+}
+
+void sharded::generic_ctor_impl()
+{
+    init_shards();
+}
+
+void sharded::init_shards()
+{
+    // NOTE: the idle clones are spread evenly among the shards,
+    // so that at least hardware_concurrency() of them can be kept.
+    // hardware_concurrency() may return zero if the value is not computable.
+    const auto max_size = std::max(
+        std::size_t(1), (std::size_t(std::thread::hardware_concurrency()) + detail::sharded_n_shards - 1u)
+                            / detail::sharded_n_shards);
+
+    m_shards.clear();
+    m_shards.reserve(detail::sharded_n_shards);
+    for (std::size_t i = 0; i < detail::sharded_n_shards; ++i) {
+        m_shards.emplace_back(new shard);
+        m_shards.back()->m_clones.reserve(max_size);
+        m_shards.back()->m_max_size = max_size;
+    }
+}
+
+/// Copy constructor.
+/**
+ * The copy constructor will deep copy the inner problem of \p other. The clones
+ * of \p other are not copied.
+ *
+ * @param other the source object.
+ *
+ * @throws unspecified any exception thrown by the copy constructor of pagmo::problem,
+ * by memory errors in standard containers or by threading primitives.
+ */
+sharded::sharded(const sharded &other)
+    : m_problem([&other]() {
+          std::lock_guard<std::mutex> lock(other.m_problem_mutex);
+          return other.m_problem;
+      }())
+{
+    init_shards();
+}
+
+/// Move constructor.
+/**
+ * @param other the source object.
+ */
+sharded::sharded(sharded &&other) noexcept
+    : m_problem(std::move(other.m_problem)), m_shards(std::move(other.m_shards))
+{
+}
+
+/// Copy assignment operator.
+/**
+ * @param other the assignment argument.
+ *
+ * @return a reference to \p this.
+ *
+ * @throws unspecified any exception thrown by the copy constructor.
+ */
+sharded &sharded::operator=(const sharded &other)
+{
+    if (this != &other) {
+        *this = sharded(other);
+    }
+    return *this;
+}
+
+/// Move assignment operator.
+/**
+ * @param other the assignment argument.
+ *
+ * @return a reference to \p this.
+ */
+sharded &sharded::operator=(sharded &&other) noexcept
+{
+    if (this != &other) {
+        m_problem = std::move(other.m_problem);
+        m_shards = std::move(other.m_shards);
+    }
+    return *this;
+}
+
+sharded::~sharded() = default;
+
+// The handle owns the clone while it is checked out,
+// and returns it to the pool upon destruction.
+class sharded::clone_handle
+{
+public:
+    explicit clone_handle(const sharded &s, std::unique_ptr<const problem> &&p) : m_s(s), m_p(std::move(p)) {}
+    clone_handle(const clone_handle &) = delete;
+    clone_handle(clone_handle &&) = delete;
+    clone_handle &operator=(const clone_handle &) = delete;
+    clone_handle &operator=(clone_handle &&) = delete;
+    ~clone_handle()
+    {
+        m_s.return_clone(std::move(m_p));
+    }
+    const problem *operator->() const
+    {
+        return m_p.get();
+    }
+
+private:
+    const sharded &m_s;
+    std::unique_ptr<const problem> m_p;
+};
+
+// Check out an idle clone of the inner problem,
+// creating a new one if the pool is empty.
+sharded::clone_handle sharded::get_clone() const
+{
+    assert(!m_shards.empty());
+
+    // NOTE: start looking from the shard associated to the calling
+    // thread, so that different threads tend to use different shards.
+    const auto start = std::hash<std::thread::id>{}(std::this_thread::get_id()) % m_shards.size();
+    for (std::size_t i = 0; i < m_shards.size(); ++i) {
+        auto &s = *m_shards[(start + i) % m_shards.size()];
+
+        std::lock_guard<std::mutex> lock(s.m_mutex);
+        if (!s.m_clones.empty()) {
+            auto retval = std::move(s.m_clones.back());
+            s.m_clones.pop_back();
+            return clone_handle(*this, std::move(retval));
+        }
+    }
+
+    // NOTE: copy the inner problem outside the shard locks,
+    // so that other threads can keep on using the pool.
+    std::unique_ptr<const problem> new_clone;
+    {
+        std::lock_guard<std::mutex> lock(m_problem_mutex);
+        new_clone.reset(new problem(m_problem));
+    }
+
+    return clone_handle(*this, std::move(new_clone));
+}
+
+// Return a checked out clone to the pool. If the pool
+// is full, the clone is destroyed.
+void sharded::return_clone(std::unique_ptr<const problem> &&p) const noexcept
+{
+    // NOTE: the shards are absent only in a moved-from object,
+    // which cannot have clones checked out.
+    assert(!m_shards.empty());
+
+    const auto start = std::hash<std::thread::id>{}(std::this_thread::get_id()) % m_shards.size();
+    for (std::size_t i = 0; i < m_shards.size(); ++i) {
+        auto &s = *m_shards[(start + i) % m_shards.size()];
+
+        try {
+            std::lock_guard<std::mutex> lock(s.m_mutex);
+            if (s.m_clones.size() < s.m_max_size) {
+                // NOTE: the capacity was reserved in init_shards()
+                // and it is never released, thus this cannot throw.
+                s.m_clones.push_back(std::move(p));
+                return;
+            }
+        } catch (...) {
+            // NOTE: locking the mutex can throw only on system errors,
+            // in which case we just destroy the clone.
+            return;
+        }
+    }
+}
+
+void sharded::clear_clones()
+{
+    for (auto &s : m_shards) {
+        std::lock_guard<std::mutex> lock(s->m_mutex);
+        s->m_clones.clear();
+    }
+}
+
+/// Fitness.
+/**
+ * The fitness computation is forwarded to a clone of the inner problem
+ * checked out of the pool for the duration of the call.
+ *
+ * @param x the decision vector.
+ *
+ * @return the fitness of \p x.
+ *
+ * @throws unspecified any exception thrown by memory errors in standard containers,
+ * threading primitives, the copy constructor of pagmo::problem or problem::fitness().
+ */
+vector_double sharded::fitness(const vector_double &x) const
+{
+    return get_clone()->fitness(x);
+}
+
+/// Batch fitness.
+/**
+ * The batch fitness computation is forwarded to a clone of the inner problem
+ * checked out of the pool for the duration of the call.
+ *
+ * @param xs the input decision vectors.
+ *
+ * @return the fitnesses of \p xs.
+ *
+ * @throws unspecified any exception thrown by memory errors in standard containers,
+ * threading primitives, the copy constructor of pagmo::problem or problem::batch_fitness().
+ */
+vector_double sharded::batch_fitness(const vector_double &xs) const
+{
+    return get_clone()->batch_fitness(xs);
+}
+
+/// Check if the inner problem can compute fitnesses in batch mode.
+/**
+ * @return the output of the <tt>has_batch_fitness()</tt> member function invoked
+ * by the inner problem.
+ */
+bool sharded::has_batch_fitness() const
+{
+    return m_problem.has_batch_fitness();
+}
+
+/// Box-bounds.
+/**
+ * @return the box-bounds of the inner problem.
+ *
+ * @throws unspecified any exception thrown by problem::get_bounds().
+ */
+std::pair<vector_double, vector_double> sharded::get_bounds() const
+{
+    return m_problem.get_bounds();
+}
+
+/// Number of objectives.
+/**
+ * @return the number of objectives of the inner problem.
+ */
+vector_double::size_type sharded::get_nobj() const
+{
+    return m_problem.get_nobj();
+}
+
+/// Equality constraint dimension.
+/**
+ * @return the number of equality constraints of the inner problem.
+ */
+vector_double::size_type sharded::get_nec() const
+{
+    return m_problem.get_nec();
+}
+
+/// Inequality constraint dimension.
+/**
+ * @return the number of inequality constraints of the inner problem.
+ */
+vector_double::size_type sharded::get_nic() const
+{
+    return m_problem.get_nic();
+}
+
+/// Integer dimension
+/**
+ * @return the integer dimension of the inner problem.
+ */
+vector_double::size_type sharded::get_nix() const
+{
+    return m_problem.get_nix();
+}
+
+/// Checks if the inner problem has gradients.
+/**
+ * @return a flag signalling the availability of the gradient in the inner problem.
+ */
+bool sharded::has_gradient() const
+{
+    return m_problem.has_gradient();
+}
+
+/// Gradients.
+/**
+ * The gradients computation is forwarded to a clone of the inner problem
+ * checked out of the pool for the duration of the call.
+ *
+ * @param x the decision vector.
+ *
+ * @return the gradient of the fitness function.
+ *
+ * @throws unspecified any exception thrown by memory errors in standard containers,
+ * threading primitives, the copy constructor of pagmo::problem or <tt>problem::gradient()</tt>.
+ */
+vector_double sharded::gradient(const vector_double &x) const
+{
+    return get_clone()->gradient(x);
+}
+
+/// Checks if the inner problem has gradient sparisty implemented.
+/**
+ * @return a flag signalling the availability of the gradient sparisty in the inner problem.
+ */
+bool sharded::has_gradient_sparsity() const
+{
+    return m_problem.has_gradient_sparsity();
+}
+
+/// Gradient sparsity.
+/**
+ * @return the gradient sparsity of the inner problem.
+ *
+ * @throws unspecified any exception thrown by threading primitives or by <tt>problem::gradient_sparsity()</tt>.
+ */
+sparsity_pattern sharded::gradient_sparsity() const
+{
+    std::lock_guard<std::mutex> lock(m_problem_mutex);
+    return m_problem.gradient_sparsity();
+}
+
+/// Checks if the inner problem has hessians.
+/**
+ * @return a flag signalling the availability of the hessians in the inner problem.
+ */
+bool sharded::has_hessians() const
+{
+    return m_problem.has_hessians();
+}
+
+/// Hessians.
+/**
+ * The hessians computation is forwarded to a clone of the inner problem
+ * checked out of the pool for the duration of the call.
+ *
+ * @param x the decision vector.
+ *
+ * @return the hessians of the fitness function computed at \p x.
+ *
+ * @throws unspecified any exception thrown by memory errors in standard containers,
+ * threading primitives, the copy constructor of pagmo::problem or problem::hessians().
+ */
+std::vector<vector_double> sharded::hessians(const vector_double &x) const
+{
+    return get_clone()->hessians(x);
+}
+
+/// Checks if the inner problem has hessians sparisty implemented.
+/**
+ * @return a flag signalling the availability of the hessians sparisty in the inner problem.
+ */
+bool sharded::has_hessians_sparsity() const
+{
+    return m_problem.has_hessians_sparsity();
+}
+
+/// Hessians sparsity.
+/**
+ * @return the hessians sparsity of the inner problem.
+ *
+ * @throws unspecified any exception thrown by threading primitives or by <tt>problem::hessians_sparsity()</tt>.
+ */
+std::vector<sparsity_pattern> sharded::hessians_sparsity() const
+{
+    std::lock_guard<std::mutex> lock(m_problem_mutex);
+    return m_problem.hessians_sparsity();
+}
+
+/// Calls <tt>has_set_seed()</tt> of the inner problem.
+/**
+ * @return a flag signalling whether the inner problem is stochastic.
+ */
+bool sharded::has_set_seed() const
+{
+    return m_problem.has_set_seed();
+}
+
+/// Calls <tt>set_seed()</tt> of the inner problem.
+/**
+ * Calls the method <tt>set_seed()</tt> of the inner problem and destroys the clones,
+ * which will be re-created from the re-seeded inner problem when needed.
+ *
+ * @param seed seed to be set.
+ *
+ * @throws unspecified any exception thrown by the method <tt>set_seed()</tt> of the inner problem
+ * or by threading primitives.
+ */
+void sharded::set_seed(unsigned seed)
+{
+    m_problem.set_seed(seed);
+    clear_clones();
+}
+
+/// Problem name
+/**
+ * This method will add <tt>[sharded]</tt> to the name provided by the inner problem.
+ *
+ * @return a string containing the problem name.
+ *
+ * @throws unspecified any exception thrown by <tt>problem::get_name()</tt> or memory errors in standard classes.
+ */
+std::string sharded::get_name() const
+{
+    return m_problem.get_name() + " [sharded]";
+}
+
+/// Extra info
+/**
+ * This method will append the number of clones to the extra info provided
+ * by the inner problem.
+ *
+ * @return a string containing extra info on the problem.
+ *
+ * @throws unspecified any exception thrown by problem::get_extra_info(), threading primitives
+ * or memory errors in standard classes.
+ */
+std::string sharded::get_extra_info() const
+{
+    std::string retval;
+    {
+        std::lock_guard<std::mutex> lock(m_problem_mutex);
+        retval = m_problem.get_extra_info();
+    }
+    return retval + "\n\tNumber of clones: " + std::to_string(get_n_clones());
+}
+
+/// Problem's thread safety level.
+/**
+ * If the thread safety level of the inner problem is at least pagmo::thread_safety::basic,
+ * this meta-problem provides the pagmo::thread_safety::constant level. Otherwise,
+ * pagmo::thread_safety::none is returned.
+ *
+ * @return the thread safety level of this meta-problem.
+ */
+thread_safety sharded::get_thread_safety() const
+{
+    return m_problem.get_thread_safety() == thread_safety::none ? thread_safety::none : thread_safety::constant;
+}
+
+/// Number of clones.
+/**
+ * @return the number of idle clones of the inner problem currently stored in the pool.
+ *
+ * @throws unspecified any exception thrown by threading primitives.
+ */
+std::size_t sharded::get_n_clones() const
+{
+    std::size_t retval = 0;
+    for (const auto &s : m_shards) {
+        std::lock_guard<std::mutex> lock(s->m_mutex);
+        retval += s->m_clones.size();
+    }
+    return retval;
+}
+
+/// Const getter for the inner problem.
+/**
+ * @return a const reference to the inner pagmo::problem.
+ */
+const problem &sharded::get_inner_problem() const
+{
+    return m_problem;
+}
+
+/// Getter for the inner problem.
+/**
+ * The clones are destroyed by this method, so that any modification
+ * of the inner problem made via the returned reference will be reflected by
+ * the clones created afterwards.
+ *
+ * \verbatim embed:rst:leading-asterisk
+ * .. warning::
+ *
+ *    The ability to extract a mutable reference to the problem is provided solely in order to
+ *    allow calling non-const methods on the internal :cpp:class:`pagmo::problem` instance. Assigning
+ *    a new :cpp:class:`pagmo::problem` via this reference is undefined behaviour.
+ *
+ * \endverbatim
+ *
+ * @return a reference to the inner pagmo::problem.
+ *
+ * @throws unspecified any exception thrown by threading primitives.
+ */
+problem &sharded::get_inner_problem()
+{
+    clear_clones();
+    return m_problem;
+}
+
+// Object serialization
+template <typename Archive>
+void sharded::save(Archive &ar, unsigned) const
+{
+    detail::to_archive(ar, m_problem);
+}
+
+template <typename Archive>
+void sharded::load(Archive &ar, unsigned)
+{
+    sharded tmp;
+    detail::from_archive(ar, tmp.m_problem);
+
+    *this = std::move(tmp);
+}
+
+} // namespace pagmo
+
+PAGMO_S11N_PROBLEM_IMPLEMENT(pagmo::sharded)
@@ -163,6 +163,41 @@ bool translate::has_batch_fitness() const
     return m_problem.has_batch_fitness();
 }
 
+/// Fitness into a caller-provided buffer.
+/**
+ * \verbatim embed:rst:leading-asterisk
+ * .. versionadded:: 2.20
+ * \endverbatim
+ *
+ * The decision vector at \p dv is translated into a temporary vector, which is then forwarded,
+ * together with \p fv, to problem::fitness_into() of the inner problem.
+ *
+ * @param dv a pointer to the beginning of the decision vector.
+ * @param fv a pointer to the beginning of the output fitness vector.
+ *
+ * @throws unspecified any exception thrown by memory errors in standard containers,
+ * or by problem::fitness_into().
+ */
+void translate::fitness_into(const double *dv, double *fv) const
+{
+    vector_double x_deshifted(m_translation.size());
+    std::transform(dv, dv + m_translation.size(), m_translation.begin(), x_deshifted.begin(), std::minus<double>{});
+    m_problem.fitness_into(x_deshifted.data(), fv);
+}
+
+/// Check if the inner problem provides fitness_into().
+/**
+ * \verbatim embed:rst:leading-asterisk
+ * .. versionadded:: 2.20
+ * \endverbatim
+ *
+ * @return the output of problem::has_fitness_into() of the inner problem.
+ */
+bool translate::has_fitness_into() const
+{
+    return m_problem.has_fitness_into();
+}
+
 /// Box-bounds.
 /**
  * The box-bounds returned by this method are the translated box-bounds of the inner UDP.
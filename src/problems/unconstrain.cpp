@@ -119,6 +119,48 @@ vector_double unconstrain::fitness(const vector_double &x) const
     return new_fitness;
 }
 
+/// Fitness into a caller-provided buffer.
+/**
+ * \verbatim embed:rst:leading-asterisk
+ * .. versionadded:: 2.20
+ * \endverbatim
+ *
+ * The decision vector at \p dv is forwarded to problem::fitness_into() of the inner problem, and the
+ * resulting fitness is penalized as in unconstrain::fitness() and written into \p fv.
+ *
+ * @param dv a pointer to the beginning of the decision vector.
+ * @param fv a pointer to the beginning of the output fitness vector.
+ *
+ * @throws unspecified any exception thrown by memory errors in standard containers,
+ * or by problem::fitness_into().
+ */
+void unconstrain::fitness_into(const double *dv, double *fv) const
+{
+    vector_double original_fitness(m_problem.get_nf()), new_fitness;
+    m_problem.fitness_into(dv, original_fitness.data());
+    penalize(original_fitness, new_fitness);
+    std::copy(
+#if defined(_MSC_VER)
+        new_fitness.begin(), new_fitness.end(), stdext::make_checked_array_iterator(fv, new_fitness.size())
+#else
+        new_fitness.begin(), new_fitness.end(), fv
+#endif
+    );
+}
+
+/// Check if the inner problem provides fitness_into().
+/**
+ * \verbatim embed:rst:leading-asterisk
+ * .. versionadded:: 2.20
+ * \endverbatim
+ *
+ * @return the output of problem::has_fitness_into() of the inner problem.
+ */
+bool unconstrain::has_fitness_into() const
+{
+    return m_problem.has_fitness_into();
+}
+
 /// Penalize.
 /**
  * The unconstrained fitness computation.
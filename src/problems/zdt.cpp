@@ -27,6 +27,7 @@ GNU Lesser General Public License along with the PaGMO library.  If not,
 see https://www.gnu.org/licenses/. */
 
 #include <algorithm>
+#include <cassert>
 #include <cmath>
 #include <initializer_list>
 #include <iterator>
@@ -35,6 +36,23 @@ see https://www.gnu.org/licenses/. */
 #include <utility>
 #include <vector>
 
+#if defined(_MSC_VER)
+
+// Disable a warning from MSVC in the TBB code.
+#pragma warning(push)
+#pragma warning(disable : 4324)
+
+#endif
+
+#include <tbb/blocked_range.h>
+#include <tbb/parallel_for.h>
+
+#if defined(_MSC_VER)
+
+#pragma warning(pop)
+
+#endif
+
 #include <pagmo/detail/constants.hpp>
 #include <pagmo/exceptions.hpp>
 #include <pagmo/population.hpp>
@@ -75,27 +93,36 @@ zdt::zdt(unsigned prob_id, unsigned param) : m_prob_id(prob_id), m_param(param)
  */
 vector_double zdt::fitness(const vector_double &x) const
 {
-    vector_double retval;
-    switch (m_prob_id) {
-        case 1u:
-            retval = zdt1_fitness(x);
-            break;
-        case 2u:
-            retval = zdt2_fitness(x);
-            break;
-        case 3u:
-            retval = zdt3_fitness(x);
-            break;
-        case 4u:
-            retval = zdt4_fitness(x);
-            break;
-        case 5u:
-            retval = zdt5_fitness(x);
-            break;
-        case 6u:
-            retval = zdt6_fitness(x);
-            break;
-    }
+    vector_double retval(2, 0.);
+    (this->*get_fitness_impl())(x.data(), x.size(), retval.data());
+    return retval;
+}
+
+/// Batch fitness computation
+/**
+ * Computes the fitnesses of the decision vectors stored contiguously in \p xs.
+ * The ZDT function matching the problem id is selected once for the whole batch, and
+ * it writes the two objectives of each decision vector directly into the output vector.
+ * The blocks of decision vectors are evaluated in parallel using TBB.
+ *
+ * @param xs the decision vectors.
+ *
+ * @return the fitnesses of \p xs.
+ */
+vector_double zdt::batch_fitness(const vector_double &xs) const
+{
+    const auto nx = get_bounds().first.size();
+    assert(xs.size() % nx == 0u);
+    const auto n_dvs = xs.size() / nx;
+
+    vector_double retval(n_dvs * 2u, 0.);
+    const auto impl = get_fitness_impl();
+    using range_t = tbb::blocked_range<decltype(xs.size())>;
+    tbb::parallel_for(range_t(0, n_dvs), [&xs, &retval, nx, impl, this](const range_t &range) {
+        for (auto i = range.begin(); i != range.end(); ++i) {
+            (this->*impl)(xs.data() + i * nx, nx, retval.data() + i * 2u);
+        }
+    });
     return retval;
 }
 
@@ -230,12 +257,33 @@ void zdt::serialize(Archive &ar, unsigned)
     detail::archive(ar, m_prob_id, m_param);
 }
 
-vector_double zdt::zdt1_fitness(const vector_double &x) const
+// Select the fitness implementation
+// corresponding to the problem id.
+zdt::fitness_impl_t zdt::get_fitness_impl() const
+{
+    switch (m_prob_id) {
+        case 1u:
+            return &zdt::zdt1_fitness;
+        case 2u:
+            return &zdt::zdt2_fitness;
+        case 3u:
+            return &zdt::zdt3_fitness;
+        case 4u:
+            return &zdt::zdt4_fitness;
+        case 5u:
+            return &zdt::zdt5_fitness;
+        default:
+            assert(m_prob_id == 6u);
+            return &zdt::zdt6_fitness;
+    }
+}
+
+// NOTE: the implementations below read the decision vector of size N
+// starting at x, and write the two objectives into f.
+void zdt::zdt1_fitness(const double *x, vector_double::size_type N, double *f) const
 {
     double g = 0.;
-    vector_double f(2, 0.);
     f[0] = x[0];
-    auto N = x.size();
 
     for (decltype(N) i = 1u; i < N; ++i) {
         g += x[i];
@@ -243,47 +291,35 @@ vector_double zdt::zdt1_fitness(const vector_double &x) const
     g = 1. + (9. * g) / static_cast<double>(N - 1u);
 
     f[1] = g * (1. - std::sqrt(x[0] / g));
-    return f;
 }
 
-vector_double zdt::zdt2_fitness(const vector_double &x) const
+void zdt::zdt2_fitness(const double *x, vector_double::size_type N, double *f) const
 {
     double g = 0.;
-    vector_double f(2, 0.);
     f[0] = x[0];
-    auto N = x.size();
 
     for (decltype(N) i = 1u; i < N; ++i) {
         g += x[i];
     }
     g = 1. + (9. * g) / static_cast<double>(N - 1u);
     f[1] = g * (1. - (x[0] / g) * (x[0] / g));
-
-    return f;
 }
 
-vector_double zdt::zdt3_fitness(const vector_double &x) const
+void zdt::zdt3_fitness(const double *x, vector_double::size_type N, double *f) const
 {
     double g = 0.;
-    vector_double f(2, 0.);
     f[0] = x[0];
-    auto N = x.size();
 
     for (decltype(N) i = 1u; i < N; ++i) {
         g += x[i];
     }
     g = 1. + (9. * g) / static_cast<double>(N - 1u);
     f[1] = g * (1. - std::sqrt(x[0] / g) - x[0] / g * std::sin(10. * detail::pi() * x[0]));
-
-    return f;
 }
 
-vector_double zdt::zdt4_fitness(const vector_double &x) const
+void zdt::zdt4_fitness(const double *x, vector_double::size_type N, double *f) const
 {
     double g = 0.;
-    vector_double f(2, 0.);
-    f[0] = x[0];
-    auto N = x.size();
 
     g = 1 + 10 * static_cast<double>(N - 1u);
     f[0] = x[0];
@@ -291,15 +327,11 @@ vector_double zdt::zdt4_fitness(const vector_double &x) const
         g += x[i] * x[i] - 10. * std::cos(4. * detail::pi() * x[i]);
     }
     f[1] = g * (1. - std::sqrt(x[0] / g));
-
-    return f;
 }
 
-vector_double zdt::zdt5_fitness(const vector_double &x_double) const
+void zdt::zdt5_fitness(const double *x_double, vector_double::size_type size_x, double *f) const
 {
     double g = 0.;
-    vector_double f(2, 0.);
-    auto size_x = x_double.size();
     auto n_vectors = ((size_x - 30u) / 5u) + 1u;
 
     unsigned k = 30;
@@ -308,8 +340,7 @@ vector_double zdt::zdt5_fitness(const vector_double &x_double) const
 
     // Convert the input vector into rounded values (integers)
     vector_double x;
-    std::transform(x_double.begin(), x_double.end(), std::back_inserter(x),
-                   [](double item) { return std::round(item); });
+    std::transform(x_double, x_double + size_x, std::back_inserter(x), [](double item) { return std::round(item); });
     f[0] = x[0];
 
     // Counts how many 1s are there in the first (30 dim)
@@ -335,15 +366,11 @@ vector_double zdt::zdt5_fitness(const vector_double &x_double) const
         g += static_cast<double>(v[i]);
     }
     f[1] = g * (1. / f[0]);
-    return f;
 }
 
-vector_double zdt::zdt6_fitness(const vector_double &x) const
+void zdt::zdt6_fitness(const double *x, vector_double::size_type N, double *f) const
 {
     double g = 0.;
-    vector_double f(2, 0.);
-    f[0] = x[0];
-    auto N = x.size();
 
     f[0] = 1 - std::exp(-4 * x[0]) * std::pow(std::sin(6 * detail::pi() * x[0]), 6);
     for (decltype(N) i = 1; i < N; ++i) {
@@ -351,8 +378,6 @@ vector_double zdt::zdt6_fitness(const vector_double &x) const
     }
     g = 1 + 9 * std::pow((g / static_cast<double>(N - 1u)), 0.25);
     f[1] = g * (1 - (f[0] / g) * (f[0] / g));
-
-    return f;
 }
 
 double zdt::zdt123_p_distance(const vector_double &x) const
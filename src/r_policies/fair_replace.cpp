@@ -108,6 +108,13 @@ individuals_group_t fair_replace::replace(const individuals_group_t &inds, const
     // for migration is not larger than mig_size.
     assert(n_migr <= mig_size);
 
+    // NOTE: the merged population is formed by the original individuals plus the
+    // top n_migr migrants. In order to avoid copying the individuals, the merged
+    // population is represented via indices: an index i < inds_size refers to the i-th
+    // original individual, an index i >= inds_size refers to the migrant
+    // at index mig_ind_sort[i - inds_size].
+    std::vector<pop_size_t> mig_ind_sort, merged_pop_ind_sort;
+
     // NOTE: currently this replacement policy can handle:
     // - single-objective (un)constrained optimisation,
     // - multiobjective unconstrained optimisation.
@@ -117,107 +124,73 @@ individuals_group_t fair_replace::replace(const individuals_group_t &inds, const
         // Single-objective, unconstrained.
 
         // Sort (indirectly) the migrants according to their fitness.
-        std::vector<pop_size_t> mig_ind_sort;
         mig_ind_sort.resize(boost::numeric_cast<decltype(mig_ind_sort.size())>(mig_size));
         std::iota(mig_ind_sort.begin(), mig_ind_sort.end(), pop_size_t(0));
         std::sort(mig_ind_sort.begin(), mig_ind_sort.end(), [&mig](pop_size_t idx1, pop_size_t idx2) {
             return detail::less_than_f(std::get<2>(mig)[idx1][0], std::get<2>(mig)[idx2][0]);
         });
 
-        // Build the merged population from the original individuals plus the
-        // top n_migr migrants.
-        auto merged_pop(inds);
-        for (pop_size_t i = 0; i < n_migr; ++i) {
-            std::get<0>(merged_pop).push_back(std::get<0>(mig)[mig_ind_sort[i]]);
-            std::get<1>(merged_pop).push_back(std::get<1>(mig)[mig_ind_sort[i]]);
-            std::get<2>(merged_pop).push_back(std::get<2>(mig)[mig_ind_sort[i]]);
-        }
+        // Fetch the fitness of an individual in the merged population.
+        auto merged_f = [&inds, &mig, &mig_ind_sort, inds_size](pop_size_t idx) {
+            return idx < inds_size ? std::get<2>(inds)[idx][0] : std::get<2>(mig)[mig_ind_sort[idx - inds_size]][0];
+        };
 
         // Sort (indirectly) the merged population.
-        std::vector<pop_size_t> merged_pop_ind_sort;
-        merged_pop_ind_sort.resize(
-            boost::numeric_cast<decltype(merged_pop_ind_sort.size())>(std::get<0>(merged_pop).size()));
+        merged_pop_ind_sort.resize(boost::numeric_cast<decltype(merged_pop_ind_sort.size())>(inds_size + n_migr));
         std::iota(merged_pop_ind_sort.begin(), merged_pop_ind_sort.end(), pop_size_t(0));
         std::sort(merged_pop_ind_sort.begin(), merged_pop_ind_sort.end(),
-                  [&merged_pop](pop_size_t idx1, pop_size_t idx2) {
-                      return detail::less_than_f(std::get<2>(merged_pop)[idx1][0], std::get<2>(merged_pop)[idx2][0]);
+                  [&merged_f](pop_size_t idx1, pop_size_t idx2) {
+                      return detail::less_than_f(merged_f(idx1), merged_f(idx2));
                   });
+    } else {
+        if (nobj == 1u) {
+            // Single-objective, constrained.
+            assert(nic || nec);
 
-        // Create and return the output pop.
-        individuals_group_t retval;
-        std::get<0>(retval).reserve(std::get<0>(inds).size());
-        std::get<1>(retval).reserve(std::get<1>(inds).size());
-        std::get<2>(retval).reserve(std::get<2>(inds).size());
-        for (pop_size_t i = 0; i < inds_size; ++i) {
-            std::get<0>(retval).push_back(std::get<0>(merged_pop)[merged_pop_ind_sort[i]]);
-            std::get<1>(retval).push_back(std::get<1>(merged_pop)[merged_pop_ind_sort[i]]);
-            std::get<2>(retval).push_back(std::get<2>(merged_pop)[merged_pop_ind_sort[i]]);
-        }
-
-        return retval;
-    } else if (nobj == 1u && (nic || nec)) {
-        // Single-objective, constrained.
-
-        // Sort indirectly the input migrants, taking into accounts
-        // constraints satisfaction and tolerances.
-        const auto mig_ind_sort = sort_population_con(std::get<2>(mig), nec, tol);
-
-        // Build the merged population from the original individuals plus the
-        // top n_migr migrants.
-        auto merged_pop(inds);
-        for (pop_size_t i = 0; i < n_migr; ++i) {
-            std::get<0>(merged_pop).push_back(std::get<0>(mig)[mig_ind_sort[i]]);
-            std::get<1>(merged_pop).push_back(std::get<1>(mig)[mig_ind_sort[i]]);
-            std::get<2>(merged_pop).push_back(std::get<2>(mig)[mig_ind_sort[i]]);
-        }
+            // Sort indirectly the input migrants, taking into accounts
+            // constraints satisfaction and tolerances.
+            mig_ind_sort = sort_population_con(std::get<2>(mig), nec, tol);
+        } else {
+            // Multi-objective, unconstrained.
+            assert(nobj > 1u && !nic && !nec);
 
-        // Sort indirectly the merged population.
-        const auto merged_pop_ind_sort = sort_population_con(std::get<2>(merged_pop), nec, tol);
-
-        // Create and return the output pop.
-        individuals_group_t retval;
-        std::get<0>(retval).reserve(std::get<0>(inds).size());
-        std::get<1>(retval).reserve(std::get<1>(inds).size());
-        std::get<2>(retval).reserve(std::get<2>(inds).size());
-        for (pop_size_t i = 0; i < inds_size; ++i) {
-            std::get<0>(retval).push_back(std::get<0>(merged_pop)[merged_pop_ind_sort[i]]);
-            std::get<1>(retval).push_back(std::get<1>(merged_pop)[merged_pop_ind_sort[i]]);
-            std::get<2>(retval).push_back(std::get<2>(merged_pop)[merged_pop_ind_sort[i]]);
+            // Get the best n_migr migrants.
+            mig_ind_sort = select_best_N_mo(std::get<2>(mig), n_migr);
         }
 
-        return retval;
-    } else {
-        // Multi-objective, unconstrained.
-        assert(nobj > 1u && !nic && !nec);
-
-        // Get the best n_migr migrants.
-        const auto mig_ind_sort = select_best_N_mo(std::get<2>(mig), n_migr);
-
-        // Build the merged population from the original individuals plus the
-        // top n_migr migrants.
-        auto merged_pop(inds);
+        // Build the fitness vectors of the merged population.
+        // NOTE: the decision vectors are not needed for the ranking,
+        // thus we copy only the fitness vectors.
+        auto merged_f(std::get<2>(inds));
         for (pop_size_t i = 0; i < n_migr; ++i) {
-            std::get<0>(merged_pop).push_back(std::get<0>(mig)[mig_ind_sort[i]]);
-            std::get<1>(merged_pop).push_back(std::get<1>(mig)[mig_ind_sort[i]]);
-            std::get<2>(merged_pop).push_back(std::get<2>(mig)[mig_ind_sort[i]]);
+            merged_f.push_back(std::get<2>(mig)[mig_ind_sort[i]]);
         }
 
-        // Get the best inds_size individuals from the merged population.
-        const auto merged_pop_ind_sort = select_best_N_mo(std::get<2>(merged_pop), inds_size);
-
-        // Create and return the output pop.
-        individuals_group_t retval;
-        std::get<0>(retval).reserve(std::get<0>(inds).size());
-        std::get<1>(retval).reserve(std::get<1>(inds).size());
-        std::get<2>(retval).reserve(std::get<2>(inds).size());
-        for (pop_size_t i = 0; i < inds_size; ++i) {
-            std::get<0>(retval).push_back(std::get<0>(merged_pop)[merged_pop_ind_sort[i]]);
-            std::get<1>(retval).push_back(std::get<1>(merged_pop)[merged_pop_ind_sort[i]]);
-            std::get<2>(retval).push_back(std::get<2>(merged_pop)[merged_pop_ind_sort[i]]);
+        if (nobj == 1u) {
+            // Sort indirectly the merged population.
+            merged_pop_ind_sort = sort_population_con(merged_f, nec, tol);
+        } else {
+            // Get the best inds_size individuals from the merged population.
+            merged_pop_ind_sort = select_best_N_mo(merged_f, inds_size);
         }
+    }
 
-        return retval;
+    // Create and return the output pop.
+    individuals_group_t retval;
+    std::get<0>(retval).reserve(std::get<0>(inds).size());
+    std::get<1>(retval).reserve(std::get<1>(inds).size());
+    std::get<2>(retval).reserve(std::get<2>(inds).size());
+    for (pop_size_t i = 0; i < inds_size; ++i) {
+        const auto idx = merged_pop_ind_sort[i];
+        const auto &src = idx < inds_size ? inds : mig;
+        const auto src_idx = idx < inds_size ? idx : mig_ind_sort[idx - inds_size];
+
+        std::get<0>(retval).push_back(std::get<0>(src)[src_idx]);
+        std::get<1>(retval).push_back(std::get<1>(src)[src_idx]);
+        std::get<2>(retval).push_back(std::get<2>(src)[src_idx]);
     }
+
+    return retval;
 }
 
 // Extra info.
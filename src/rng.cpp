@@ -26,11 +26,22 @@ You should have received copies of the GNU General Public License and the
 GNU Lesser General Public License along with the PaGMO library.  If not,
 see https://www.gnu.org/licenses/. */
 
-#include <mutex>
 #include <random>
 
+#include <pagmo/config.hpp>
 #include <pagmo/rng.hpp>
 
+#if defined(PAGMO_WITH_XOSHIRO)
+
+#include <atomic>
+#include <cstdint>
+
+#else
+
+#include <mutex>
+
+#endif
+
 namespace pagmo
 {
 
@@ -40,11 +51,29 @@ namespace detail
 namespace
 {
 
+#if defined(PAGMO_WITH_XOSHIRO)
+
+// The increment of the splitmix64 generator.
+constexpr std::uint64_t global_rng_gamma = 0x9e3779b97f4a7c15ull;
+
+// The state of the global rng, inited on startup with a random number.
+// NOTE: splitmix64 is a counter-based generator: its state is advanced by a constant
+// at every step, and the output is a function of the state only. Thus the state can be
+// advanced atomically, without locking.
+std::atomic<std::uint64_t> global_rng_state(static_cast<std::uint64_t>(std::random_device()()));
+
+#else
+
 // The global rng is inited on startup with a random number.
+// NOTE: without xoshiro support, we keep the Mersenne Twister
+// so that the sequences generated after set_seed() are
+// the same as in the previous versions.
 random_engine_type global_rng(static_cast<random_engine_type::result_type>(std::random_device()()));
 
 std::mutex global_rng_mutex;
 
+#endif
+
 } // namespace
 
 } // namespace detail
@@ -53,12 +82,25 @@ std::mutex global_rng_mutex;
 /**
  * This static method returns the next element of the PRS.
  *
+ * If pagmo was built with the \p PAGMO_WITH_XOSHIRO option, this function is lock-free
+ * (as long as \p std::atomic<std::uint64_t> is).
+ *
  * @returns the next element of the PRS
  */
 unsigned random_device::next()
 {
+#if defined(PAGMO_WITH_XOSHIRO)
+    auto z = detail::global_rng_state.fetch_add(detail::global_rng_gamma, std::memory_order_relaxed)
+             + detail::global_rng_gamma;
+    z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ull;
+    z = (z ^ (z >> 27)) * 0x94d049bb133111ebull;
+    z ^= (z >> 31);
+    // NOTE: return the high bits.
+    return static_cast<unsigned>(z >> 32);
+#else
     std::lock_guard<std::mutex> lock(detail::global_rng_mutex);
     return static_cast<unsigned>(detail::global_rng());
+#endif
 }
 
 #if !defined(PAGMO_DOXYGEN_INVOKED)
@@ -73,8 +115,12 @@ unsigned random_device::next()
  */
 void random_device::set_seed(unsigned seed)
 {
+#if defined(PAGMO_WITH_XOSHIRO)
+    detail::global_rng_state.store(static_cast<std::uint64_t>(seed), std::memory_order_relaxed);
+#else
     std::lock_guard<std::mutex> lock(detail::global_rng_mutex);
     detail::global_rng.seed(static_cast<detail::random_engine_type::result_type>(seed));
+#endif
 }
 
 #endif
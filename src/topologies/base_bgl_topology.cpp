@@ -29,6 +29,7 @@ see https://www.gnu.org/licenses/. */
 #include <algorithm>
 #include <cassert>
 #include <cstddef>
+#include <memory>
 #include <mutex>
 #include <sstream>
 #include <stdexcept>
@@ -98,6 +99,7 @@ bgl_graph_t base_bgl_topology::get_graph() const
 bgl_graph_t base_bgl_topology::move_graph()
 {
     std::lock_guard<std::mutex> lock(m_mutex);
+    unsafe_reset_csr();
     return std::move(m_graph);
 }
 
@@ -105,6 +107,51 @@ void base_bgl_topology::set_graph(bgl_graph_t &&g)
 {
     std::lock_guard<std::mutex> lock(m_mutex);
     m_graph = std::move(g);
+    unsafe_reset_csr();
+}
+
+void base_bgl_topology::unsafe_reset_csr()
+{
+    std::atomic_store(&m_csr, std::shared_ptr<const csr_graph>{});
+}
+
+std::shared_ptr<const base_bgl_topology::csr_graph> base_bgl_topology::get_csr() const
+{
+    // Fast path: a snapshot is available.
+    if (auto retval = std::atomic_load(&m_csr)) {
+        return retval;
+    }
+
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    // Another thread might have built the
+    // snapshot in the meantime.
+    if (auto retval = std::atomic_load(&m_csr)) {
+        return retval;
+    }
+
+    auto csr = std::make_shared<csr_graph>();
+    const auto nv = detail::scast(boost::num_vertices(m_graph));
+    const auto ne = detail::scast(boost::num_edges(m_graph));
+    csr->offsets.reserve(nv + 1u);
+    csr->sources.reserve(ne);
+    csr->weights.reserve(ne);
+
+    csr->offsets.push_back(0);
+    for (auto vs = boost::vertices(m_graph); vs.first != vs.second; ++vs.first) {
+        // NOTE: the incoming edges are visited in the same
+        // order as the inverse adjacent vertices.
+        for (auto ies = boost::in_edges(*vs.first, m_graph); ies.first != ies.second; ++ies.first) {
+            csr->sources.push_back(detail::scast(boost::source(*ies.first, m_graph)));
+            csr->weights.push_back(m_graph[*ies.first]);
+        }
+        csr->offsets.push_back(csr->sources.size());
+    }
+
+    std::shared_ptr<const csr_graph> retval(std::move(csr));
+    std::atomic_store(&m_csr, retval);
+
+    return retval;
 }
 
 base_bgl_topology::base_bgl_topology(const base_bgl_topology &other) : m_graph(other.get_graph()) {}
@@ -131,6 +178,7 @@ void base_bgl_topology::add_vertex()
 {
     std::lock_guard<std::mutex> lock(m_mutex);
     boost::add_vertex(m_graph);
+    unsafe_reset_csr();
 }
 
 std::size_t base_bgl_topology::num_vertices() const
@@ -168,6 +216,7 @@ void base_bgl_topology::add_edge(std::size_t i, std::size_t j, double w)
         = boost::add_edge(boost::vertex(detail::vcast(i), m_graph), boost::vertex(detail::vcast(j), m_graph), m_graph);
     assert(result.second);
     m_graph[result.first] = w;
+    unsafe_reset_csr();
 }
 
 void base_bgl_topology::remove_edge(std::size_t i, std::size_t j)
@@ -179,6 +228,7 @@ void base_bgl_topology::remove_edge(std::size_t i, std::size_t j)
                                                + std::to_string(i) + " to " + std::to_string(j));
     }
     boost::remove_edge(boost::vertex(detail::vcast(i), m_graph), boost::vertex(detail::vcast(j), m_graph), m_graph);
+    unsafe_reset_csr();
 }
 
 void base_bgl_topology::set_all_weights(double w)
@@ -190,6 +240,7 @@ void base_bgl_topology::set_all_weights(double w)
     for (auto e_range = boost::edges(m_graph); e_range.first != e_range.second; ++e_range.first) {
         m_graph[*e_range.first] = w;
     }
+    unsafe_reset_csr();
 }
 
 void base_bgl_topology::set_weight(std::size_t i, std::size_t j, double w)
@@ -204,6 +255,7 @@ void base_bgl_topology::set_weight(std::size_t i, std::size_t j, double w)
         = boost::edge(boost::vertex(detail::vcast(i), m_graph), boost::vertex(detail::vcast(j), m_graph), m_graph);
     if (ret.second) {
         m_graph[ret.first] = w;
+        unsafe_reset_csr();
     } else {
         pagmo_throw(std::invalid_argument, "cannot set the weight of an edge in a BGL topology: the vertex "
                                                + std::to_string(i) + " is not connected to vertex "
@@ -213,20 +265,20 @@ void base_bgl_topology::set_weight(std::size_t i, std::size_t j, double w)
 
 std::pair<std::vector<std::size_t>, vector_double> base_bgl_topology::get_connections(std::size_t i) const
 {
-    std::lock_guard<std::mutex> lock(m_mutex);
+    // NOTE: read from the CSR snapshot, without locking
+    // the mutex (unless the snapshot needs to be rebuilt).
+    const auto csr = get_csr();
 
-    unsafe_check_vertex_indices(i);
+    const auto nv = csr->offsets.size() - 1u;
+    if (i >= nv) {
+        pagmo_throw(std::invalid_argument, "invalid vertex index in a BGL topology: the index is " + std::to_string(i)
+                                               + ", but the number of vertices is only " + std::to_string(nv));
+    }
 
-    std::pair<std::vector<std::size_t>, vector_double> retval;
+    const auto begin = csr->offsets[i], end = csr->offsets[i + 1u];
 
-    const auto vi = boost::vertex(detail::vcast(i), m_graph);
-    for (auto iav = boost::inv_adjacent_vertices(vi, m_graph); iav.first != iav.second; ++iav.first) {
-        const auto e = boost::edge(boost::vertex(*iav.first, m_graph), vi, m_graph);
-        assert(e.second);
-        retval.first.emplace_back(detail::scast(*iav.first));
-        retval.second.emplace_back(m_graph[e.first]);
-    }
-    return retval;
+    return {std::vector<std::size_t>(csr->sources.data() + begin, csr->sources.data() + end),
+            vector_double(csr->weights.data() + begin, csr->weights.data() + end)};
 }
 
 double base_bgl_topology::get_edge_weight(std::size_t i, std::size_t j) const
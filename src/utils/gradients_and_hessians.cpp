@@ -0,0 +1,379 @@
+/* Copyright 2017-2021 PaGMO development team
+
+This file is part of the PaGMO library.
+
+The PaGMO library is free software; you can redistribute it and/or modify
+it under the terms of either:
+
+  * the GNU Lesser General Public License as published by the Free
+    Software Foundation; either version 3 of the License, or (at your
+    option) any later version.
+
+or
+
+  * the GNU General Public License as published by the Free Software
+    Foundation; either version 3 of the License, or (at your option) any
+    later version.
+
+or both in parallel, as here.
+
+The PaGMO library is distributed in the hope that it will be useful, but
+WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+for more details.
+
+You should have received copies of the GNU General Public License and the
+GNU Lesser General Public License along with the PaGMO library.  If not,
+see https://www.gnu.org/licenses/. */
+
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include <pagmo/bfe.hpp>
+#include <pagmo/exceptions.hpp>
+#include <pagmo/problem.hpp>
+#include <pagmo/types.hpp>
+#include <pagmo/utils/gradients_and_hessians.hpp>
+
+namespace pagmo
+{
+
+namespace detail
+{
+
+namespace
+{
+
+// Check the input point of the batched numerical differentiation functions.
+void fd_check_input(const problem &p, const vector_double &x)
+{
+    if (x.size() != p.get_nx()) {
+        pagmo_throw(std::invalid_argument, "The dimension of the point at which the derivatives are estimated ("
+                                               + std::to_string(x.size())
+                                               + ") differs from the dimension of the problem ("
+                                               + std::to_string(p.get_nx()) + ")");
+    }
+}
+
+// Step size for the j-th component of x.
+double fd_step(const vector_double &x, vector_double::size_type j, double dx)
+{
+    return std::max(std::abs(x[j]), 1.0) * dx;
+}
+
+// Append to the batch dvs a copy of x.
+// Returns a pointer to the beginning of the copy.
+double *fd_push_x(vector_double &dvs, const vector_double &x)
+{
+    const auto offset = dvs.size();
+    dvs.insert(dvs.end(), x.begin(), x.end());
+    return dvs.data() + offset;
+}
+
+// Greedy Curtis-Powell-Reid grouping of the columns of a sparse Jacobian: two columns
+// can be placed in the same group (i.e., perturbed together) if they do not have nonzero
+// elements in the same row. Returns, for each column, the index of its group, and writes
+// the total number of groups into n_groups.
+std::vector<vector_double::size_type> fd_cpr_groups(const sparsity_pattern &sp, vector_double::size_type nf,
+                                                    vector_double::size_type nx, vector_double::size_type &n_groups)
+{
+    // Rows touched by each column.
+    std::vector<std::vector<vector_double::size_type>> col_rows(nx);
+    for (const auto &ij : sp) {
+        col_rows[ij.second].push_back(ij.first);
+    }
+
+    // For each group, a mask of the rows already
+    // touched by the columns in the group.
+    std::vector<std::vector<char>> group_rows;
+    std::vector<vector_double::size_type> retval(nx);
+    for (decltype(col_rows.size()) j = 0; j < nx; ++j) {
+        const auto &rows = col_rows[j];
+        decltype(group_rows.size()) g = 0;
+        for (; g < group_rows.size(); ++g) {
+            const auto &mask = group_rows[g];
+            if (std::none_of(rows.begin(), rows.end(), [&mask](vector_double::size_type i) { return mask[i]; })) {
+                break;
+            }
+        }
+        if (g == group_rows.size()) {
+            group_rows.emplace_back(nf, char(0));
+        }
+        for (auto i : rows) {
+            group_rows[g][i] = 1;
+        }
+        retval[j] = g;
+    }
+
+    n_groups = group_rows.size();
+    return retval;
+}
+
+} // namespace
+
+} // namespace detail
+
+/// Heuristic to estimate the sparsity pattern (batched)
+/**
+ * \verbatim embed:rst:leading-asterisk
+ * .. versionadded:: 2.20
+ * \endverbatim
+ *
+ * This function is equivalent to the callable-based overload of pagmo::estimate_sparsity() invoked
+ * with the fitness function of \p p, but all the \f$n + 1\f$ required fitness evaluations
+ * are performed in a single call to the batch fitness evaluator \p b.
+ *
+ * @param b the batch fitness evaluator.
+ * @param p the problem.
+ * @param x decision vector to test the sparisty around.
+ * @param dx To detect the sparsity each component of the input decision vector \p x will be changed by \f$\max(|x_i|,
+ * 1) * \f$ \p dx.
+ *
+ * @return the sparsity_pattern of the fitness of \p p as detected around \p x.
+ *
+ * @throw std::invalid_argument if the size of \p x differs from the dimension of \p p.
+ * @throw unspecified any exception thrown by the invocation of \p b.
+ */
+sparsity_pattern estimate_sparsity(const bfe &b, const problem &p, const vector_double &x, double dx)
+{
+    detail::fd_check_input(p, x);
+    const auto nx = x.size();
+    const auto nf = p.get_nf();
+
+    // Assemble the batch: the reference point first,
+    // then one perturbed point per component.
+    vector_double dvs;
+    dvs.reserve((nx + 1u) * nx);
+    detail::fd_push_x(dvs, x);
+    for (decltype(x.size()) j = 0u; j < nx; ++j) {
+        detail::fd_push_x(dvs, x)[j] += detail::fd_step(x, j, dx);
+    }
+
+    const auto fvs = b(p, dvs);
+    assert(fvs.size() == (nx + 1u) * nf);
+
+    sparsity_pattern retval;
+    for (decltype(x.size()) j = 0u; j < nx; ++j) {
+        for (decltype(p.get_nf()) i = 0u; i < nf; ++i) {
+            if (fvs[(j + 1u) * nf + i] != fvs[i]) {
+                retval.emplace_back(i, j);
+            }
+        }
+    }
+    // Restore the lexicographic order required by pagmo::problem::gradient_sparsity
+    std::sort(retval.begin(), retval.end());
+    return retval;
+}
+
+/// Numerical computation of the gradient (low-order, batched)
+/**
+ * \verbatim embed:rst:leading-asterisk
+ * .. versionadded:: 2.20
+ * \endverbatim
+ *
+ * This function is equivalent to the callable-based overload of pagmo::estimate_gradient() invoked
+ * with the fitness function of \p p, but all the \f$2n\f$ perturbed points are evaluated
+ * in a single call to the batch fitness evaluator \p b (e.g., in parallel via pagmo::thread_bfe).
+ *
+ * @param b the batch fitness evaluator.
+ * @param p the problem.
+ * @param x decision vector around which the gradient is estimated.
+ * @param dx To detect the numerical derivative each component of the input decision vector \p x will be varied by
+ * \f$\max(|x_i|,1) * \f$ \p dx.
+ *
+ * @return the dense gradient of the fitness of \p p approximated around \p x, in the format
+ * required by pagmo::problem::gradient().
+ *
+ * @throw std::invalid_argument if the size of \p x differs from the dimension of \p p.
+ * @throw unspecified any exception thrown by the invocation of \p b.
+ */
+vector_double estimate_gradient(const bfe &b, const problem &p, const vector_double &x, double dx)
+{
+    detail::fd_check_input(p, x);
+    const auto nx = x.size();
+    const auto nf = p.get_nf();
+
+    // Assemble the batch: for each component, the right
+    // and the left perturbed points.
+    vector_double dvs;
+    dvs.reserve(2u * nx * nx);
+    for (decltype(x.size()) j = 0u; j < nx; ++j) {
+        const auto h = detail::fd_step(x, j, dx);
+        detail::fd_push_x(dvs, x)[j] += h;
+        detail::fd_push_x(dvs, x)[j] -= h;
+    }
+
+    const auto fvs = b(p, dvs);
+    assert(fvs.size() == 2u * nx * nf);
+
+    vector_double gradient(nf * nx);
+    for (decltype(x.size()) j = 0u; j < nx; ++j) {
+        const auto h = detail::fd_step(x, j, dx);
+        const auto f_r = fvs.data() + 2u * j * nf;
+        const auto f_l = f_r + nf;
+        for (decltype(p.get_nf()) i = 0u; i < nf; ++i) {
+            gradient[j + i * nx] = (f_r[i] - f_l[i]) / 2. / h;
+        }
+    }
+    return gradient;
+}
+
+/// Numerical computation of a sparse gradient (low-order, batched, with column grouping)
+/**
+ * \verbatim embed:rst:leading-asterisk
+ * .. versionadded:: 2.20
+ * \endverbatim
+ *
+ * This function estimates, via central differences, only the nonzero components of the gradient of the
+ * fitness of \p p, as specified by the sparsity pattern \p sp (which can be, e.g., the output of
+ * pagmo::problem::gradient_sparsity() or of pagmo::estimate_sparsity()).
+ *
+ * The columns of the sparse Jacobian are partitioned into groups of structurally independent columns
+ * (i.e., columns whose nonzero elements never appear in the same row) according to the greedy
+ * Curtis-Powell-Reid heuristic. All the components of \p x in a group are perturbed at the same time,
+ * so that the overall cost, in terms of fitness evaluations, is \f$2g\f$, where \f$g \leq n\f$ is the number of
+ * groups. All the perturbed points are evaluated in a single call to the batch fitness evaluator \p b.
+ *
+ * See: Curtis, A. R., Powell, M. J., and Reid, J. K. "On the estimation of sparse Jacobian matrices."
+ * IMA Journal of Applied Mathematics 13.1 (1974): 117-119.
+ *
+ * @param b the batch fitness evaluator.
+ * @param p the problem.
+ * @param x decision vector around which the gradient is estimated.
+ * @param sp the sparsity pattern of the gradient.
+ * @param dx To detect the numerical derivative each component of the input decision vector \p x will be varied by
+ * \f$\max(|x_i|,1) * \f$ \p dx.
+ *
+ * @return the sparse gradient of the fitness of \p p approximated around \p x, i.e., the values of the
+ * derivatives corresponding to the elements of \p sp, in the same order.
+ *
+ * @throw std::invalid_argument if the size of \p x differs from the dimension of \p p, or if \p sp
+ * contains indices incompatible with the dimensions of \p p.
+ * @throw unspecified any exception thrown by the invocation of \p b.
+ */
+vector_double estimate_gradient(const bfe &b, const problem &p, const vector_double &x, const sparsity_pattern &sp,
+                                double dx)
+{
+    detail::fd_check_input(p, x);
+    const auto nx = x.size();
+    const auto nf = p.get_nf();
+    for (const auto &ij : sp) {
+        if (ij.first >= nf || ij.second >= nx) {
+            pagmo_throw(std::invalid_argument, "Invalid pair detected in the sparsity pattern: ("
+                                                   + std::to_string(ij.first) + ", " + std::to_string(ij.second)
+                                                   + ")\nFitness dimension is: " + std::to_string(nf)
+                                                   + "\nDecision vector dimension is: " + std::to_string(nx));
+        }
+    }
+
+    if (sp.empty()) {
+        return {};
+    }
+
+    // Group the columns.
+    vector_double::size_type n_groups = 0;
+    const auto groups = detail::fd_cpr_groups(sp, nf, nx, n_groups);
+
+    // Assemble the batch: for each group, the right and the left
+    // perturbed points, in which all the components of the group are perturbed.
+    vector_double dvs;
+    dvs.reserve(2u * n_groups * nx);
+    for (decltype(n_groups) g = 0u; g < n_groups; ++g) {
+        detail::fd_push_x(dvs, x);
+        const auto x_l = detail::fd_push_x(dvs, x);
+        const auto x_r = x_l - nx;
+        for (decltype(x.size()) j = 0u; j < nx; ++j) {
+            if (groups[j] == g) {
+                const auto h = detail::fd_step(x, j, dx);
+                x_r[j] += h;
+                x_l[j] -= h;
+            }
+        }
+    }
+
+    const auto fvs = b(p, dvs);
+    assert(fvs.size() == 2u * n_groups * nf);
+
+    // NOTE: since the columns in a group do not share rows, the change in the i-th
+    // component of the fitness is due only to the column j.
+    vector_double retval;
+    retval.reserve(sp.size());
+    for (const auto &ij : sp) {
+        const auto h = detail::fd_step(x, ij.second, dx);
+        const auto f_r = fvs.data() + 2u * groups[ij.second] * nf;
+        const auto f_l = f_r + nf;
+        retval.push_back((f_r[ij.first] - f_l[ij.first]) / 2. / h);
+    }
+    return retval;
+}
+
+/// Numerical computation of the gradient (high-order, batched)
+/**
+ * \verbatim embed:rst:leading-asterisk
+ * .. versionadded:: 2.20
+ * \endverbatim
+ *
+ * This function is equivalent to the callable-based overload of pagmo::estimate_gradient_h() invoked
+ * with the fitness function of \p p, but all the \f$6n\f$ perturbed points are evaluated
+ * in a single call to the batch fitness evaluator \p b.
+ *
+ * @param b the batch fitness evaluator.
+ * @param p the problem.
+ * @param x decision vector around which the gradient is estimated.
+ * @param dx To detect the numerical derivative each component of the input decision vector \p x will be varied by
+ * \f$\max(|x_i|,1) * \f$ \p dx.
+ *
+ * @return the dense gradient of the fitness of \p p approximated around \p x, in the format
+ * required by pagmo::problem::gradient().
+ *
+ * @throw std::invalid_argument if the size of \p x differs from the dimension of \p p.
+ * @throw unspecified any exception thrown by the invocation of \p b.
+ */
+vector_double estimate_gradient_h(const bfe &b, const problem &p, const vector_double &x, double dx)
+{
+    detail::fd_check_input(p, x);
+    const auto nx = x.size();
+    const auto nf = p.get_nf();
+
+    // Assemble the batch: for each component, the points
+    // x + h, x - h, x + 2h, x - 2h, x + 3h, x - 3h.
+    vector_double dvs;
+    dvs.reserve(6u * nx * nx);
+    for (decltype(x.size()) j = 0u; j < nx; ++j) {
+        const auto h = detail::fd_step(x, j, dx);
+        for (auto k = 1; k <= 3; ++k) {
+            detail::fd_push_x(dvs, x)[j] = x[j] + k * h;
+            detail::fd_push_x(dvs, x)[j] = x[j] - k * h;
+        }
+    }
+
+    const auto fvs = b(p, dvs);
+    assert(fvs.size() == 6u * nx * nf);
+
+    vector_double gradient(nf * nx);
+    for (decltype(x.size()) j = 0u; j < nx; ++j) {
+        const auto h = detail::fd_step(x, j, dx);
+        const auto f_r1 = fvs.data() + 6u * j * nf;
+        const auto f_l1 = f_r1 + nf;
+        const auto f_r2 = f_l1 + nf;
+        const auto f_l2 = f_r2 + nf;
+        const auto f_r3 = f_l2 + nf;
+        const auto f_l3 = f_r3 + nf;
+        for (decltype(p.get_nf()) i = 0u; i < nf; ++i) {
+            double m1 = (f_r1[i] - f_l1[i]) / 2.;
+            double m2 = (f_r2[i] - f_l2[i]) / 4.;
+            double m3 = (f_r3[i] - f_l3[i]) / 6.;
+            double fifteen_m1 = 15. * m1;
+            double six_m2 = 6. * m2;
+            double ten_h = 10. * h;
+            gradient[j + i * nx] = ((fifteen_m1 - six_m2) + m3) / ten_h;
+        }
+    }
+    return gradient;
+}
+
+} // namespace pagmo
@@ -0,0 +1,665 @@
+/* Copyright 2017-2021 PaGMO development team
+
+This file is part of the PaGMO library.
+
+The PaGMO library is free software; you can redistribute it and/or modify
+it under the terms of either:
+
+  * the GNU Lesser General Public License as published by the Free
+    Software Foundation; either version 3 of the License, or (at your
+    option) any later version.
+
+or
+
+  * the GNU General Public License as published by the Free Software
+    Foundation; either version 3 of the License, or (at your option) any
+    later version.
+
+or both in parallel, as here.
+
+The PaGMO library is distributed in the hope that it will be useful, but
+WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+for more details.
+
+You should have received copies of the GNU General Public License and the
+GNU Lesser General Public License along with the PaGMO library.  If not,
+see https://www.gnu.org/licenses/. */
+
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+#include <iterator>
+#include <limits>
+#include <map>
+#include <numeric>
+#include <set>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <pagmo/exceptions.hpp>
+#include <pagmo/types.hpp>
+#include <pagmo/utils/hv_algos/hv_algorithm.hpp>
+#include <pagmo/utils/hv_algos/hv_hv3d.hpp>
+#include <pagmo/utils/hv_algos/hv_hvwfg.hpp>
+#include <pagmo/utils/incremental_hypervolume.hpp>
+
+namespace pagmo
+{
+
+namespace detail
+{
+
+namespace
+{
+
+// Check if any two points share a coordinate.
+bool ihv_has_ties(const std::vector<vector_double> &points)
+{
+    vector_double coords(points.size());
+    for (decltype(points[0].size()) d = 0; d < points[0].size(); ++d) {
+        std::transform(points.begin(), points.end(), coords.begin(), [d](const vector_double &p) { return p[d]; });
+        std::sort(coords.begin(), coords.end());
+        if (std::adjacent_find(coords.begin(), coords.end()) != coords.end()) {
+            return true;
+        }
+    }
+    return false;
+}
+
+} // namespace
+
+} // namespace detail
+
+/// Default constructor.
+/**
+ * Initialises an empty set of 2-dimensional points with reference point \f$ \left(0, 0\right) \f$.
+ */
+incremental_hypervolume::incremental_hypervolume() : incremental_hypervolume(vector_double{0., 0.}) {}
+
+/// Constructor from reference point.
+/**
+ * Initialises an empty set of points with reference point \p r_point.
+ *
+ * @param r_point the reference point.
+ *
+ * @throws std::invalid_argument if the dimension of \p r_point is not 2 or 3, or if
+ * \p r_point contains NaNs.
+ */
+incremental_hypervolume::incremental_hypervolume(const vector_double &r_point) : m_ref(r_point)
+{
+    if (m_ref.size() != 2u && m_ref.size() != 3u) {
+        pagmo_throw(std::invalid_argument, "The incremental hypervolume supports only 2 or 3 dimensions, but a "
+                                           "reference point of dimension "
+                                               + std::to_string(m_ref.size()) + " was provided");
+    }
+    if (std::any_of(m_ref.begin(), m_ref.end(), [](double x) { return std::isnan(x); })) {
+        pagmo_throw(std::invalid_argument, "A NaN value was detected in the reference point of an incremental "
+                                           "hypervolume");
+    }
+}
+
+/// Constructor from points and reference point.
+/**
+ * Initialises the set with the points in \p points and the reference point \p r_point.
+ *
+ * @param points the initial set of points.
+ * @param r_point the reference point.
+ *
+ * @throws unspecified any exception thrown by the constructor from reference point or
+ * by incremental_hypervolume::insert().
+ */
+incremental_hypervolume::incremental_hypervolume(const std::vector<vector_double> &points,
+                                                 const vector_double &r_point)
+    : incremental_hypervolume(r_point)
+{
+    m_points.reserve(points.size());
+    m_contrib.reserve(points.size());
+    for (const auto &p : points) {
+        insert(p);
+    }
+}
+
+/// Copy constructor.
+/**
+ * @param other the source object.
+ *
+ * @throws unspecified any exception thrown by memory errors in standard containers.
+ */
+incremental_hypervolume::incremental_hypervolume(const incremental_hypervolume &other)
+    : incremental_hypervolume(other.m_points, other.m_ref)
+{
+}
+
+/// Move constructor.
+/**
+ * @param other the source object.
+ */
+incremental_hypervolume::incremental_hypervolume(incremental_hypervolume &&other) noexcept = default;
+
+/// Copy assignment operator.
+/**
+ * @param other the assignment argument.
+ *
+ * @return a reference to \p this.
+ *
+ * @throws unspecified any exception thrown by the copy constructor.
+ */
+incremental_hypervolume &incremental_hypervolume::operator=(const incremental_hypervolume &other)
+{
+    if (this != &other) {
+        *this = incremental_hypervolume(other);
+    }
+    return *this;
+}
+
+/// Move assignment operator.
+/**
+ * @param other the assignment argument.
+ *
+ * @return a reference to \p this.
+ */
+incremental_hypervolume &incremental_hypervolume::operator=(incremental_hypervolume &&other) noexcept = default;
+
+incremental_hypervolume::~incremental_hypervolume() = default;
+
+void incremental_hypervolume::check_point(const vector_double &p) const
+{
+    if (p.size() != m_ref.size()) {
+        pagmo_throw(std::invalid_argument, "Cannot insert a point of dimension " + std::to_string(p.size())
+                                               + " into an incremental hypervolume of dimension "
+                                               + std::to_string(m_ref.size()));
+    }
+    bool all_equal = true;
+    for (decltype(p.size()) i = 0; i < p.size(); ++i) {
+        if (std::isnan(p[i])) {
+            pagmo_throw(std::invalid_argument,
+                        "A NaN value was detected in a point inserted into an incremental hypervolume");
+        }
+        if (p[i] > m_ref[i]) {
+            pagmo_throw(std::invalid_argument, "A point inserted into an incremental hypervolume is outside the "
+                                               "bounds set by the reference point");
+        }
+        all_equal = all_equal && p[i] == m_ref[i];
+    }
+    if (all_equal) {
+        pagmo_throw(std::invalid_argument,
+                    "A point inserted into an incremental hypervolume is equal to the reference point");
+    }
+}
+
+void incremental_hypervolume::check_index(size_type idx) const
+{
+    if (idx >= m_points.size()) {
+        pagmo_throw(std::invalid_argument, "The index " + std::to_string(idx)
+                                               + " is out of bounds for an incremental hypervolume of size "
+                                               + std::to_string(m_points.size()));
+    }
+}
+
+/// Insert a point.
+/**
+ * The point is appended to the set, and its index will thus be equal to the size of
+ * the set before the insertion.
+ *
+ * @param p the point to be inserted.
+ *
+ * @throws std::invalid_argument if the dimension of \p p differs from the dimension of the reference point,
+ * if \p p contains NaNs, if \p p is not dominated by the reference point or if \p p is equal to the
+ * reference point.
+ * @throws unspecified any exception thrown by memory errors in standard containers.
+ */
+void incremental_hypervolume::insert(const vector_double &p)
+{
+    check_point(p);
+
+    m_points.push_back(p);
+    m_contrib.push_back(0.);
+
+    if (m_ref.size() == 2u) {
+        insert_2d(m_points.size() - 1u);
+    } else {
+        m_dirty = true;
+    }
+}
+
+/// Remove a point.
+/**
+ * The point at index \p idx is removed from the set. If \p idx is not the index of the last point,
+ * the last point is moved into position \p idx.
+ *
+ * @param idx the index of the point to be removed.
+ *
+ * @throws std::invalid_argument if \p idx is not less than the size of the set.
+ * @throws unspecified any exception thrown by memory errors in standard containers.
+ */
+void incremental_hypervolume::erase(size_type idx)
+{
+    check_index(idx);
+
+    const auto is_2d = m_ref.size() == 2u;
+    const key2d_t key(m_points[idx][0], m_points[idx][1]);
+
+    if (is_2d) {
+        m_all.erase(m_all_its[idx]);
+        m_order.erase(std::make_pair(m_contrib[idx], idx));
+    }
+
+    const auto last = m_points.size() - 1u;
+    if (idx != last) {
+        m_points[idx] = std::move(m_points[last]);
+        m_contrib[idx] = m_contrib[last];
+
+        if (is_2d) {
+            m_all_its[idx] = m_all_its[last];
+            m_all_its[idx]->second = idx;
+            m_order.erase(std::make_pair(m_contrib[last], last));
+            m_order.emplace(m_contrib[idx], idx);
+        }
+    }
+    m_points.pop_back();
+    m_contrib.pop_back();
+
+    if (is_2d) {
+        m_all_its.pop_back();
+        erase_2d(key);
+    } else {
+        m_dirty = true;
+    }
+}
+
+// Set the contribution of the point at index idx,
+// keeping m_order in sync.
+void incremental_hypervolume::set_contrib(size_type idx, double c)
+{
+    if (m_contrib[idx] != c) {
+        m_order.erase(std::make_pair(m_contrib[idx], idx));
+        m_contrib[idx] = c;
+        m_order.emplace(c, idx);
+    }
+}
+
+// Recompute the contributions of the points with coordinates k. If k is on the front, the contribution
+// is the part of the rectangle delimited by k and by its neighbours on the front which is not covered by
+// the points dominated by k, otherwise it is zero. Duplicate points do not contribute.
+void incremental_hypervolume::refresh_2d(const key2d_t &k)
+{
+    double c = 0.;
+
+    const auto it = m_front.find(k);
+    if (it != m_front.end()) {
+        const auto next = std::next(it);
+        const auto next_x = next == m_front.end() ? m_ref[0] : next->first;
+        const auto prev_y = it == m_front.begin() ? m_ref[1] : std::prev(it)->second;
+
+        // The points dominated by k (and not by its neighbours on the front) lie
+        // between k and its successor on the front in lexicographic order. Sum the
+        // area of the vertical slabs below the staircase they form.
+        const auto first = m_all.upper_bound(k);
+        const auto last = next == m_front.end() ? m_all.end() : m_all.lower_bound(*next);
+        auto x = k.first, h = prev_y - k.second;
+        for (auto a = first; a != last; ++a) {
+            if (a->first.second < k.second + h) {
+                c += (a->first.first - x) * h;
+                x = a->first.first;
+                h = a->first.second - k.second;
+            }
+        }
+        c += (next_x - x) * h;
+    }
+
+    const auto range = m_all.equal_range(k);
+    if (range.first != range.second && std::next(range.first) != range.second) {
+        c = 0.;
+    }
+    for (auto a = range.first; a != range.second; ++a) {
+        set_contrib(a->second, c);
+    }
+}
+
+void incremental_hypervolume::insert_2d(size_type idx)
+{
+    const key2d_t key(m_points[idx][0], m_points[idx][1]);
+
+    m_all_its.push_back(m_all.emplace(key, idx));
+    m_order.emplace(0., idx);
+
+    if (m_front.count(key)) {
+        // A duplicate of a point on the front: neither
+        // the front nor the hypervolume change.
+        refresh_2d(key);
+        return;
+    }
+
+    auto next = m_front.upper_bound(key);
+    if (next != m_front.begin() && std::prev(next)->second <= key.second) {
+        // The point is dominated. It may reduce the contribution
+        // of the front point preceding it.
+        refresh_2d(*std::prev(next));
+        return;
+    }
+
+    // Remove from the front the points dominated by the new point. They form
+    // a contiguous run following the new point.
+    std::vector<key2d_t> dominated;
+    while (next != m_front.end() && next->second >= key.second) {
+        dominated.push_back(*next);
+        next = m_front.erase(next);
+    }
+    for (const auto &k : dominated) {
+        refresh_2d(k);
+    }
+
+    const auto it = m_front.insert(next, key);
+    refresh_2d(key);
+    if (it != m_front.begin()) {
+        refresh_2d(*std::prev(it));
+    }
+    if (next != m_front.end()) {
+        refresh_2d(*next);
+    }
+}
+
+void incremental_hypervolume::erase_2d(const key2d_t &key)
+{
+    auto it = m_front.lower_bound(key);
+    if (it == m_front.end() || *it != key) {
+        // A dominated point was removed. The contribution of the
+        // front point preceding it may increase.
+        assert(it != m_front.begin());
+        refresh_2d(*std::prev(it));
+        return;
+    }
+
+    if (m_all.count(key)) {
+        // Other points with the same coordinates are still in the set.
+        refresh_2d(key);
+        return;
+    }
+
+    const bool has_prev = it != m_front.begin();
+    const auto prev = has_prev ? *std::prev(it) : key2d_t{};
+    it = m_front.erase(it);
+
+    // The points which were dominated only by the removed point lie between
+    // the removed point and its successor on the front in lexicographic order.
+    // Among them, the non-dominated ones enter the front.
+    const auto first = m_all.upper_bound(key);
+    const auto last = it == m_front.end() ? m_all.end() : m_all.lower_bound(*it);
+    std::vector<key2d_t> promoted;
+    auto bound = has_prev ? prev.second : std::numeric_limits<double>::infinity();
+    for (auto a = first; a != last; ++a) {
+        if (a->first.second < bound) {
+            promoted.push_back(a->first);
+            bound = a->first.second;
+        }
+    }
+
+    for (const auto &k : promoted) {
+        m_front.insert(it, k);
+    }
+    for (const auto &k : promoted) {
+        refresh_2d(k);
+    }
+    if (has_prev) {
+        refresh_2d(prev);
+    }
+    if (it != m_front.end()) {
+        refresh_2d(*it);
+    }
+}
+
+// Recompute the hypervolume and the contributions
+// in the 3-dimensional case, if needed.
+void incremental_hypervolume::update_3d() const
+{
+    assert(m_ref.size() == 3u);
+
+    if (!m_dirty) {
+        return;
+    }
+
+    const auto n = m_points.size();
+    std::fill(m_contrib.begin(), m_contrib.end(), 0.);
+
+    // Sort the indices of the points lexicographically.
+    std::vector<size_type> idxs(n);
+    std::iota(idxs.begin(), idxs.end(), size_type(0));
+    std::sort(idxs.begin(), idxs.end(), [this](size_type a, size_type b) { return m_points[a] < m_points[b]; });
+
+    // Determine the non-dominated points, skipping the duplicates. A point is weakly dominated iff a point
+    // preceding it in lexicographic order has second and third coordinates not greater than its own. This is
+    // checked with a staircase of the second and third coordinates of the non-dominated points found so far.
+    std::map<double, double> staircase;
+    std::vector<vector_double> front;
+    // The index of each front point (or n, if the point is duplicated).
+    std::vector<size_type> front_idx;
+    // The (distinct) dominated points.
+    std::vector<vector_double> dominated;
+    for (size_type i = 0; i < n;) {
+        const auto &p = m_points[idxs[i]];
+        auto j = i + 1u;
+        while (j < n && m_points[idxs[j]] == p) {
+            ++j;
+        }
+
+        auto st = staircase.upper_bound(p[1]);
+        if (st == staircase.begin() || std::prev(st)->second > p[2]) {
+            st = staircase.lower_bound(p[1]);
+            while (st != staircase.end() && st->second >= p[2]) {
+                st = staircase.erase(st);
+            }
+            staircase.emplace_hint(st, p[1], p[2]);
+
+            front.push_back(p);
+            front_idx.push_back(j - i == 1u ? idxs[i] : n);
+        } else {
+            dominated.push_back(p);
+        }
+
+        i = j;
+    }
+
+    if (front.empty()) {
+        m_hv3d = 0.;
+        m_dirty = false;
+        return;
+    }
+
+    vector_double c;
+    if (front.size() == 1u) {
+        m_hv3d = hv_algorithm::volume_between(front[0], m_ref);
+        c.push_back(m_hv3d);
+    } else {
+        // NOTE: the points are sorted by their first coordinate,
+        // while hv3d needs them sorted by the third: leave the sorting on.
+        auto front_copy(front);
+        m_hv3d = hv3d().compute(front_copy, m_ref);
+        // NOTE: HyCon3D assumes that the front points do not share
+        // any coordinate. Otherwise, fall back to hvwfg, like hv3d
+        // does for dominated points.
+        if (detail::ihv_has_ties(front)) {
+            c = hvwfg(2).contributions(front, m_ref);
+        } else {
+            c = hv3d().contributions(front, m_ref);
+        }
+    }
+    assert(c.size() == front.size());
+
+    // The contributions computed on the front alone are exact unless some dominated point
+    // is dominated by a single front point p: removing p would expose that point, and thus
+    // the contribution of p must be reduced accordingly. For the (usually few) front points
+    // affected, recompute the contribution as the volume dominated by p minus the volume
+    // of p's dominated region which is covered by the rest of the points.
+    std::vector<std::vector<vector_double>> owned(front.size());
+    for (const auto &q : dominated) {
+        auto n_dom = 0u;
+        decltype(front.size()) owner = 0;
+        for (decltype(front.size()) k = 0; k < front.size() && n_dom < 2u; ++k) {
+            if (front[k][0] <= q[0] && front[k][1] <= q[1] && front[k][2] <= q[2]) {
+                owner = k;
+                ++n_dom;
+            }
+        }
+        assert(n_dom > 0u);
+        if (n_dom == 1u) {
+            owned[owner].push_back(q);
+        }
+    }
+    for (decltype(front.size()) k = 0; k < front.size(); ++k) {
+        if (owned[k].empty() || front_idx[k] == n) {
+            continue;
+        }
+        const auto &p = front[k];
+        std::vector<vector_double> clipped(std::move(owned[k]));
+        for (decltype(front.size()) l = 0; l < front.size(); ++l) {
+            if (l != k) {
+                clipped.push_back({std::max(front[l][0], p[0]), std::max(front[l][1], p[1]),
+                                   std::max(front[l][2], p[2])});
+            }
+        }
+        c[k] = hv_algorithm::volume_between(p, m_ref) - hv3d().compute(clipped, m_ref);
+    }
+
+    for (decltype(c.size()) k = 0; k < c.size(); ++k) {
+        if (front_idx[k] != n) {
+            m_contrib[front_idx[k]] = c[k];
+        }
+    }
+
+    m_dirty = false;
+}
+
+/// Number of points.
+/**
+ * @return the number of points in the set.
+ */
+incremental_hypervolume::size_type incremental_hypervolume::size() const
+{
+    return m_points.size();
+}
+
+/// Get the points.
+/**
+ * @return a const reference to the points in the set.
+ */
+const std::vector<vector_double> &incremental_hypervolume::get_points() const
+{
+    return m_points;
+}
+
+/// Get the reference point.
+/**
+ * @return a const reference to the reference point.
+ */
+const vector_double &incremental_hypervolume::get_refpoint() const
+{
+    return m_ref;
+}
+
+/// Hypervolume of the set.
+/**
+ * In the 2-dimensional case, the hypervolume is computed in linear time from the front
+ * maintained by this object.
+ *
+ * @return the hypervolume of the set of points.
+ *
+ * @throws unspecified any exception thrown by memory errors in standard containers.
+ */
+double incremental_hypervolume::compute() const
+{
+    if (m_ref.size() == 3u) {
+        update_3d();
+        return m_hv3d;
+    }
+
+    double retval = 0.;
+    for (auto it = m_front.begin(); it != m_front.end(); ++it) {
+        const auto next_x = std::next(it) == m_front.end() ? m_ref[0] : std::next(it)->first;
+        retval += (next_x - it->first) * (m_ref[1] - it->second);
+    }
+    return retval;
+}
+
+/// Exclusive contribution of a point.
+/**
+ * @param idx the index of the point.
+ *
+ * @return the exclusive contribution to the hypervolume of the point at index \p idx.
+ *
+ * @throws std::invalid_argument if \p idx is not less than the size of the set.
+ * @throws unspecified any exception thrown by memory errors in standard containers.
+ */
+double incremental_hypervolume::exclusive(size_type idx) const
+{
+    check_index(idx);
+
+    if (m_ref.size() == 3u) {
+        update_3d();
+    }
+    return m_contrib[idx];
+}
+
+/// Exclusive contributions of all the points.
+/**
+ * @return the exclusive contributions to the hypervolume of all the points in the set.
+ *
+ * @throws unspecified any exception thrown by memory errors in standard containers.
+ */
+std::vector<double> incremental_hypervolume::contributions() const
+{
+    if (m_ref.size() == 3u) {
+        update_3d();
+    }
+    return m_contrib;
+}
+
+/// Index of the least contributor.
+/**
+ * If multiple points share the least contribution, the smallest index is returned.
+ *
+ * @return the index of the point with the smallest exclusive contribution.
+ *
+ * @throws std::invalid_argument if the set is empty.
+ * @throws unspecified any exception thrown by memory errors in standard containers.
+ */
+incremental_hypervolume::size_type incremental_hypervolume::least_contributor() const
+{
+    if (m_points.empty()) {
+        pagmo_throw(std::invalid_argument, "Cannot determine the least contributor of an empty incremental "
+                                           "hypervolume");
+    }
+
+    if (m_ref.size() == 3u) {
+        update_3d();
+        return static_cast<size_type>(std::min_element(m_contrib.begin(), m_contrib.end()) - m_contrib.begin());
+    }
+    return m_order.begin()->second;
+}
+
+/// Index of the greatest contributor.
+/**
+ * If multiple points share the greatest contribution, the smallest index is returned.
+ *
+ * @return the index of the point with the greatest exclusive contribution.
+ *
+ * @throws std::invalid_argument if the set is empty.
+ * @throws unspecified any exception thrown by memory errors in standard containers.
+ */
+incremental_hypervolume::size_type incremental_hypervolume::greatest_contributor() const
+{
+    if (m_points.empty()) {
+        pagmo_throw(std::invalid_argument, "Cannot determine the greatest contributor of an empty incremental "
+                                           "hypervolume");
+    }
+
+    if (m_ref.size() == 3u) {
+        update_3d();
+        return static_cast<size_type>(std::max_element(m_contrib.begin(), m_contrib.end()) - m_contrib.begin());
+    }
+    return m_order.lower_bound(std::make_pair(m_order.rbegin()->first, size_type(0)))->second;
+}
+
+} // namespace pagmo
@@ -256,6 +256,139 @@ fnds_return_type fast_non_dominated_sorting(const std::vector<vector_double> &po
                            std::move(non_dom_rank));
 }
 
+namespace detail
+{
+
+namespace
+{
+
+// Population size from which fast_non_dominated_fronts() switches
+// from the classic fast non dominated sorting algorithm to ENS-BS.
+// NOTE: below this threshold we keep on using the classic algorithm,
+// so that the order of the individuals within the fronts (which may influence
+// the tie-breaking in the algorithms) is unchanged for small populations.
+constexpr pop_size_t fndf_ens_threshold = 1000u;
+
+// Efficient non-dominated sort with binary search (ENS-BS).
+// See: Zhang, Xingyi, et al. "An efficient approach to nondominated sorting for evolutionary multiobjective
+// optimization." IEEE Transactions on Evolutionary Computation 19.2 (2015): 201-213.
+fndf_return_type ens_bs_sorting(const std::vector<vector_double> &points)
+{
+    const auto N = points.size();
+    const auto M = points[0].size();
+
+    // Sort the points lexicographically. A point can then be dominated only by points
+    // preceding it in the sorted order.
+    // NOTE: the comparison functions are the same used in pareto_dominance(), which
+    // guarantees the consistency of the lexicographic order with Pareto dominance also
+    // in presence of NaNs.
+    std::vector<pop_size_t> sorted(N);
+    std::iota(sorted.begin(), sorted.end(), pop_size_t(0u));
+    std::sort(sorted.begin(), sorted.end(), [&points](pop_size_t idx1, pop_size_t idx2) {
+        const auto &p1 = points[idx1];
+        const auto &p2 = points[idx2];
+        const auto mm = std::mismatch(p1.begin(), p1.end(), p2.begin(), equal_to_f<double>);
+        return mm.first != p1.end() && less_than_f(*mm.first, *mm.second);
+    });
+
+    // Check if the point at index idx is dominated by some point in front.
+    auto dominated_by = [&points, M](const std::vector<pop_size_t> &front, pop_size_t idx) {
+        if (M == 2u) {
+            // NOTE: in the bi-objective case, the points of a front sorted lexicographically have
+            // non-increasing second objective. The last point of the front has thus the smallest
+            // second objective and the largest first objective: if any point of the front dominates
+            // the point at index idx, then the last point does.
+            return pareto_dominance(points[front.back()], points[idx]);
+        }
+        // NOTE: check the most recently added points first, as they are the most likely
+        // to dominate the current point.
+        return std::any_of(front.rbegin(), front.rend(),
+                           [&points, idx](pop_size_t other) { return pareto_dominance(points[other], points[idx]); });
+    };
+
+    std::vector<std::vector<pop_size_t>> non_dom_fronts;
+    std::vector<pop_size_t> non_dom_rank(N);
+    for (auto idx : sorted) {
+        // Binary search for the first front not containing
+        // points dominating the current point.
+        decltype(non_dom_fronts.size()) lo = 0, hi = non_dom_fronts.size();
+        while (lo < hi) {
+            const auto mid = lo + (hi - lo) / 2u;
+            if (dominated_by(non_dom_fronts[mid], idx)) {
+                lo = mid + 1u;
+            } else {
+                hi = mid;
+            }
+        }
+        if (lo == non_dom_fronts.size()) {
+            non_dom_fronts.emplace_back();
+        }
+        non_dom_fronts[lo].push_back(idx);
+        non_dom_rank[idx] = static_cast<pop_size_t>(lo);
+    }
+
+    // Return the fronts with the indices in ascending order.
+    for (auto &front : non_dom_fronts) {
+        std::sort(front.begin(), front.end());
+    }
+
+    return fndf_return_type(std::move(non_dom_fronts), std::move(non_dom_rank));
+}
+
+} // namespace
+
+} // namespace detail
+
+/// Fast non dominated fronts
+/**
+ * \verbatim embed:rst:leading-asterisk
+ * .. versionadded:: 2.20
+ * \endverbatim
+ *
+ * This function computes the non dominated fronts and the non domination ranks of the input points, with the
+ * same meaning as the first and last elements of the tuple returned by pagmo::fast_non_dominated_sorting().
+ * Contrary to pagmo::fast_non_dominated_sorting(), the domination lists and counts are not computed, which
+ * allows to avoid the \f$ O(N^2)\f$ memory footprint and, for large \f$N\f$, to switch to the efficient
+ * non-dominated sort with binary search (ENS-BS). The complexity of ENS-BS is \f$ O(MN\log N)\f$ in the best case,
+ * \f$ O(N\log N)\f$ for two objectives, and \f$ O(MN^2)\f$ in the worst case.
+ *
+ * For small \f$N\f$, the classic algorithm is used, and the returned fronts are identical to those returned by
+ * pagmo::fast_non_dominated_sorting(). For large \f$N\f$, the indices within each front are sorted in ascending
+ * order.
+ *
+ * See: Zhang, Xingyi, et al. "An efficient approach to nondominated sorting for evolutionary multiobjective
+ * optimization." IEEE Transactions on Evolutionary Computation 19.2 (2015): 201-213.
+ *
+ * @param points An std::vector containing the objectives of different individuals. Example
+ * {{1,2,3},{-2,3,7},{-1,-2,-3},{0,0,0}}
+ *
+ * @return an std::pair containing:
+ *  - the non dominated fronts, an <tt>std::vector<std::vector<pop_size_t>></tt>
+ * containing the non dominated fronts. Example {{1,2},{3},{0}}
+ *  - the non domination rank, an <tt>std::vector<pop_size_t></tt> containing the index of the non
+ * dominated front to which the individual at position \f$i\f$ belongs. Example {2,0,0,1}
+ *
+ * @throws std::invalid_argument If the size of \p points is not at least 2, or if the
+ * points do not all have the same dimension.
+ */
+fndf_return_type fast_non_dominated_fronts(const std::vector<vector_double> &points)
+{
+    const auto N = points.size();
+    if (N < 2u) {
+        pagmo_throw(std::invalid_argument, "At least two points are needed for fast_non_dominated_fronts: "
+                                               + std::to_string(N) + " detected.");
+    }
+    if (N < detail::fndf_ens_threshold) {
+        auto fnds = fast_non_dominated_sorting(points);
+        return fndf_return_type(std::move(std::get<0>(fnds)), std::move(std::get<3>(fnds)));
+    }
+    const auto M = points[0].size();
+    if (!std::all_of(points.begin(), points.end(), [M](const vector_double &item) { return item.size() == M; })) {
+        pagmo_throw(std::invalid_argument, "Input contains vector of objectives with heterogeneous dimensionalities");
+    }
+    return detail::ens_bs_sorting(points);
+}
+
 /// Crowding distance
 /**
  * An implementation of the crowding distance. Complexity is \f$ O(MNlog(N))\f$ where \f$M\f$ is the number of
@@ -339,7 +472,7 @@ vector_double crowding_distance(const std::vector<vector_double> &non_dom_front)
  *
  * @returns an <tt>std::vector</tt> containing the indexes of the best N objective vectors. Example {2,1}
  *
- * @throws unspecified all exceptions thrown by pagmo::fast_non_dominated_sorting and pagmo::crowding_distance
+ * @throws unspecified all exceptions thrown by pagmo::fast_non_dominated_fronts and pagmo::crowding_distance
  */
 std::vector<pop_size_t> select_best_N_mo(const std::vector<vector_double> &input_f, pop_size_t N)
 {
@@ -359,10 +492,10 @@ std::vector<pop_size_t> select_best_N_mo(const std::vector<vector_double> &input
     }
     std::vector<pop_size_t> retval;
     std::vector<pop_size_t>::size_type front_id(0u);
-    // Run fast-non-dominated sorting
-    auto tuple = fast_non_dominated_sorting(input_f);
+    // Compute the non dominated fronts
+    auto tuple = fast_non_dominated_fronts(input_f);
     // Insert all non dominated fronts if not more than N
-    for (const auto &front : std::get<0>(tuple)) {
+    for (const auto &front : tuple.first) {
         if (retval.size() + front.size() <= N) {
             for (auto i : front) {
                 retval.push_back(i);
@@ -375,7 +508,7 @@ std::vector<pop_size_t> select_best_N_mo(const std::vector<vector_double> &input
             break;
         }
     }
-    auto front = std::get<0>(tuple)[front_id];
+    auto front = tuple.first[front_id];
     std::vector<vector_double> non_dom_fits(front.size());
     // Run crowding distance for the front
     for (decltype(front.size()) i = 0u; i < front.size(); ++i) {
@@ -420,7 +553,7 @@ std::vector<pop_size_t> select_best_N_mo(const std::vector<vector_double> &input
  *
  * @returns an <tt>std::vector</tt> containing the indexes of the sorted objectives vectors. Example {1,2,0}
  *
- * @throws unspecified all exceptions thrown by pagmo::fast_non_dominated_sorting and pagmo::crowding_distance
+ * @throws unspecified all exceptions thrown by pagmo::fast_non_dominated_fronts and pagmo::crowding_distance
  */
 std::vector<pop_size_t> sort_population_mo(const std::vector<vector_double> &input_f)
 {
@@ -435,10 +568,10 @@ std::vector<pop_size_t> sort_population_mo(const std::vector<vector_double> &inp
     // Create the indexes 0....N-1
     std::vector<pop_size_t> retval(input_f.size());
     std::iota(retval.begin(), retval.end(), pop_size_t(0u));
-    // Run fast-non-dominated sorting and compute the crowding distance for all input objectives vectors
-    auto tuple = fast_non_dominated_sorting(input_f);
+    // Compute the non dominated fronts and the crowding distance for all input objectives vectors
+    auto tuple = fast_non_dominated_fronts(input_f);
     vector_double crowding(input_f.size());
-    for (const auto &front : std::get<0>(tuple)) {
+    for (const auto &front : tuple.first) {
         if (front.size() == 1u) {
             crowding[front[0]] = 0u; // corner case of a non dominated front containing one individual. Crowding
                                      // distance is not defined nor it will be used
@@ -455,10 +588,10 @@ std::vector<pop_size_t> sort_population_mo(const std::vector<vector_double> &inp
     }
     // Sort the indexes
     std::sort(retval.begin(), retval.end(), [&tuple, &crowding](pop_size_t idx1, pop_size_t idx2) {
-        if (std::get<3>(tuple)[idx1] == std::get<3>(tuple)[idx2]) {        // same non domination rank
+        if (tuple.second[idx1] == tuple.second[idx2]) {                    // same non domination rank
             return detail::greater_than_f(crowding[idx1], crowding[idx2]); // crowding distance decides
         } else {                                                           // different non domination ranks
-            return std::get<3>(tuple)[idx1] < std::get<3>(tuple)[idx2];    // non domination rank decides
+            return tuple.second[idx1] < tuple.second[idx2];                // non domination rank decides
         };
     });
     return retval;
@@ -525,7 +658,7 @@ vector_double nadir(const std::vector<vector_double> &points)
     // Sanity checks
     auto M = points[0].size();
     // We extract all objective vectors belonging to the first non dominated front (the Pareto front)
-    auto pareto_idx = std::get<0>(fast_non_dominated_sorting(points))[0];
+    auto pareto_idx = fast_non_dominated_fronts(points).first[0];
     std::vector<vector_double> nd_points;
     for (auto idx : pareto_idx) {
         nd_points.push_back(points[idx]);
@@ -34,7 +34,9 @@ see https://www.gnu.org/licenses/. */
 #include <iostream>
 #include <stdexcept>
 #include <string>
+#include <vector>
 
+#include <pagmo/batch_evaluators/default_bfe.hpp>
 #include <pagmo/problem.hpp>
 #include <pagmo/problems/ackley.hpp>
 #include <pagmo/s11n.hpp>
@@ -64,6 +66,23 @@ BOOST_AUTO_TEST_CASE(ackley_test)
     BOOST_CHECK((x_best == vector_double{0., 0., 0.}));
 }
 
+BOOST_AUTO_TEST_CASE(ackley_batch_fitness_test)
+{
+    // Alternate x3 and the global minimum.
+    ackley ack3{3u};
+    vector_double xs;
+    for (auto i = 0; i < 500; ++i) {
+        xs.insert(xs.end(), {-23.45, 12.34, 111.12, 0., 0., 0.});
+    }
+    const auto fs = ack3.batch_fitness(xs);
+    BOOST_CHECK(fs.size() == 1000u);
+    for (decltype(fs.size()) i = 0u; i < fs.size(); i += 2u) {
+        BOOST_CHECK_CLOSE(fs[i], 21.941495638130885, 1e-13);
+        BOOST_CHECK_SMALL(fs[i + 1u], 1e-13);
+    }
+    BOOST_CHECK(default_bfe{}(problem{ack3}, xs) == fs);
+}
+
 BOOST_AUTO_TEST_CASE(ackley_serialization_test)
 {
     problem p{ackley{4u}};
@@ -39,12 +39,18 @@ see https://www.gnu.org/licenses/. */
 #include <algorithm>
 #include <atomic>
 #include <cstddef>
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
 #include <initializer_list>
 #include <iostream>
 #include <iterator>
+#include <random>
 #include <sstream>
 #include <stdexcept>
 #include <string>
+#include <system_error>
+#include <thread>
 #include <tuple>
 #include <type_traits>
 #include <utility>
@@ -59,6 +65,7 @@ see https://www.gnu.org/licenses/. */
 #include <pagmo/archipelago.hpp>
 #include <pagmo/batch_evaluators/thread_bfe.hpp>
 #include <pagmo/bfe.hpp>
+#include <pagmo/detail/migration_db.hpp>
 #include <pagmo/island.hpp>
 #include <pagmo/islands/thread_island.hpp>
 #include <pagmo/population.hpp>
@@ -70,14 +77,36 @@ see https://www.gnu.org/licenses/. */
 #include <pagmo/rng.hpp>
 #include <pagmo/s11n.hpp>
 #include <pagmo/s_policies/select_best.hpp>
+#include <pagmo/threading.hpp>
 #include <pagmo/topologies/fully_connected.hpp>
 #include <pagmo/topologies/ring.hpp>
 #include <pagmo/topologies/unconnected.hpp>
 #include <pagmo/topology.hpp>
 #include <pagmo/types.hpp>
 
+#include "conc_prob.hpp"
+
 using namespace pagmo;
 
+// A unique file path in the temporary directory,
+// the file is removed (if it exists) on destruction.
+struct tmp_file {
+    explicit tmp_file(const std::string &name)
+        : path((std::filesystem::temp_directory_path()
+                / (name + "_" + std::to_string(std::random_device{}()) + ".bin"))
+                   .string())
+    {
+    }
+    tmp_file(const tmp_file &) = delete;
+    tmp_file &operator=(const tmp_file &) = delete;
+    ~tmp_file()
+    {
+        std::error_code ec;
+        std::filesystem::remove(path, ec);
+    }
+    const std::string path;
+};
+
 BOOST_AUTO_TEST_CASE(archipelago_construction)
 {
     // Make the test deterministic.
@@ -643,6 +672,7 @@ BOOST_AUTO_TEST_CASE(archipelago_stream)
     BOOST_CHECK(boost::contains(oss.str(), "Topology:"));
     BOOST_CHECK(boost::contains(oss.str(), "Migration type:"));
     BOOST_CHECK(boost::contains(oss.str(), "Migrant handling policy:"));
+    BOOST_CHECK(boost::contains(oss.str(), "Migration log mode: unbounded"));
 }
 
 BOOST_AUTO_TEST_CASE(archipelago_serialization)
@@ -775,8 +805,40 @@ BOOST_AUTO_TEST_CASE(archipelago_status)
     BOOST_CHECK(a.status() == evolve_status::idle);
 }
 
+BOOST_AUTO_TEST_CASE(archipelago_islands_status)
+{
+    archipelago a;
+    BOOST_CHECK(a.get_islands_status().empty());
+    BOOST_CHECK(a.status() == evolve_status::idle);
+
+    // A few idle with errors, one busy.
+    a = archipelago{5, de{}, population{rosenbrock{}, 3}};
+    a.evolve();
+    a.wait();
+    flag.store(true);
+    a.push_back(de{}, population{prob_01{}, 25});
+    a.push_back(de{}, population{rosenbrock{}, 25});
+    flag.store(false);
+    a[5].evolve();
+    auto st = a.get_islands_status();
+    BOOST_CHECK_EQUAL(st.size(), 7u);
+    for (auto i = 0u; i < 5u; ++i) {
+        BOOST_CHECK(st[i] == evolve_status::idle_error);
+    }
+    BOOST_CHECK(st[5] == evolve_status::busy);
+    BOOST_CHECK(st[6] == evolve_status::idle);
+    BOOST_CHECK(a.status() == evolve_status::busy_error);
+    flag.store(true);
+    BOOST_CHECK_THROW(a.wait_check(), std::invalid_argument);
+    st = a.get_islands_status();
+    BOOST_CHECK((std::all_of(st.begin(), st.end(), [](evolve_status s) { return s == evolve_status::idle; })));
+    BOOST_CHECK(a.status() == evolve_status::idle);
+}
+
 struct pthrower_00 {
-    static int counter;
+    // NOTE: atomic, as the islands of an archipelago
+    // may be constructed in parallel.
+    static std::atomic<int> counter;
     vector_double fitness(const vector_double &) const
     {
         if (counter >= 50) {
@@ -791,7 +853,7 @@ struct pthrower_00 {
     }
 };
 
-int pthrower_00::counter = 0;
+std::atomic<int> pthrower_00::counter(0);
 
 // Small test about proper cleanup when throwing from the ctor.
 BOOST_AUTO_TEST_CASE(archipelago_throw_on_ctor)
@@ -953,3 +1015,472 @@ BOOST_AUTO_TEST_CASE(archipelago_set_migrants_db)
     a.evolve(4);
     BOOST_CHECK_NO_THROW(a.wait_check());
 }
+
+BOOST_AUTO_TEST_CASE(archipelago_migrants_db_resize)
+{
+    archipelago a{ring{}, 3u, de{}, rosenbrock{}, 10u};
+    BOOST_CHECK(a.get_migrants_db().size() == 3u);
+
+    // Grow the db beyond the number of islands.
+    archipelago::migrants_db_t new_db(5u);
+    std::get<0>(new_db[3]).push_back(42);
+    std::get<1>(new_db[3]).push_back(vector_double(2u));
+    std::get<2>(new_db[3]).push_back(vector_double(1u));
+    a.set_migrants_db(new_db);
+    BOOST_CHECK(a.get_migrants_db() == new_db);
+
+    // Shrink it.
+    a.set_migrants_db(archipelago::migrants_db_t(2u));
+    BOOST_CHECK(a.get_migrants_db().size() == 2u);
+
+    // Adding islands grows the db with empty entries,
+    // the entry previously set at index 3 must not reappear.
+    a.push_back(de{}, rosenbrock{}, 10u);
+    a.push_back(de{}, rosenbrock{}, 10u);
+    const auto db = a.get_migrants_db();
+    BOOST_CHECK(db.size() == 4u);
+    for (const auto &ig : db) {
+        BOOST_CHECK(std::get<0>(ig).empty());
+    }
+
+    // Copy and move preserve the db.
+    a.set_migrants_db(new_db);
+    auto a2(a);
+    BOOST_CHECK(a2.get_migrants_db() == new_db);
+    auto a3(std::move(a2));
+    BOOST_CHECK(a3.get_migrants_db() == new_db);
+}
+
+// Check the consistency of the island populations while migration
+// happens, both when the populations are modified in place and when
+// they are being read concurrently.
+BOOST_AUTO_TEST_CASE(archipelago_migration_consistency)
+{
+    for (auto mt : {migration_type::p2p, migration_type::broadcast}) {
+        archipelago a{ring{}, 5u, de{10}, rosenbrock{10}, 20u};
+        a.set_migration_type(mt);
+
+        a.evolve(20);
+        // Read the populations while the islands are evolving.
+        while (a.status() == evolve_status::busy) {
+            for (const auto &isl : a) {
+                const auto pop = isl.get_population();
+                BOOST_CHECK(pop.size() == 20u);
+                BOOST_CHECK(pop.get_ID().size() == 20u);
+                BOOST_CHECK(pop.get_f().size() == 20u);
+            }
+        }
+        a.wait_check();
+
+        for (const auto &isl : a) {
+            const auto pop = isl.get_population();
+            BOOST_CHECK(pop.size() == 20u);
+            for (population::size_type i = 0; i < pop.size(); ++i) {
+                BOOST_CHECK(pop.get_f()[i] == pop.get_problem().fitness(pop.get_x()[i]));
+            }
+        }
+
+        // Migrants must have made it into the islands.
+        BOOST_CHECK(!a.get_migration_log().empty());
+        for (const auto &entry : a.get_migration_log()) {
+            BOOST_CHECK(std::get<2>(entry).size() == 10u);
+            BOOST_CHECK(std::get<3>(entry) == rosenbrock{10}.fitness(std::get<2>(entry)));
+        }
+    }
+}
+
+BOOST_AUTO_TEST_CASE(archipelago_migration_log_modes)
+{
+    archipelago a{ring{}, 5u, de{10}, rosenbrock{10}, 20u};
+    BOOST_CHECK(a.get_migration_log_mode() == migration_log_mode::unbounded);
+    BOOST_CHECK(a.get_migration_log_capacity() == 0u);
+    BOOST_CHECK(boost::lexical_cast<std::string>(migration_log_mode::unbounded) == "unbounded");
+    BOOST_CHECK(boost::lexical_cast<std::string>(migration_log_mode::bounded) == "bounded");
+    BOOST_CHECK(boost::lexical_cast<std::string>(migration_log_mode::off) == "off");
+    BOOST_CHECK(boost::lexical_cast<std::string>(migration_log_mode::stream) == "stream");
+
+    a.evolve(10);
+    a.wait_check();
+    const auto full_log = a.get_migration_log();
+    BOOST_CHECK(full_log.size() > 5u);
+
+    // Bounded mode: the most recent entries are preserved.
+    BOOST_CHECK_THROW(a.set_migration_log_bounded(0), std::invalid_argument);
+    a.set_migration_log_bounded(5);
+    BOOST_CHECK(a.get_migration_log_mode() == migration_log_mode::bounded);
+    BOOST_CHECK(a.get_migration_log_capacity() == 5u);
+    BOOST_CHECK(a.get_migration_log() == archipelago::migration_log_t(full_log.end() - 5, full_log.end()));
+    a.evolve(10);
+    a.wait_check();
+    auto log = a.get_migration_log();
+    BOOST_CHECK(log.size() == 5u);
+    BOOST_CHECK(std::get<0>(log[0]) >= std::get<0>(full_log.back()));
+
+    // Copy, move and serialization.
+    auto a2(a);
+    BOOST_CHECK(a2.get_migration_log_mode() == migration_log_mode::bounded);
+    BOOST_CHECK(a2.get_migration_log() == log);
+    auto a3(std::move(a2));
+    BOOST_CHECK(a3.get_migration_log_capacity() == 5u);
+    BOOST_CHECK(a3.get_migration_log() == log);
+    std::stringstream ss;
+    {
+        boost::archive::binary_oarchive oarchive(ss);
+        oarchive << a3;
+    }
+    a3 = archipelago{};
+    {
+        boost::archive::binary_iarchive iarchive(ss);
+        iarchive >> a3;
+    }
+    BOOST_CHECK(a3.get_migration_log() == log);
+
+    // Back to unbounded.
+    a.set_migration_log_unbounded();
+    BOOST_CHECK(a.get_migration_log_mode() == migration_log_mode::unbounded);
+    BOOST_CHECK(a.get_migration_log() == log);
+    a.evolve(10);
+    a.wait_check();
+    BOOST_CHECK(a.get_migration_log().size() > 5u);
+
+    // Off.
+    a.set_migration_log_off();
+    BOOST_CHECK(a.get_migration_log_mode() == migration_log_mode::off);
+    BOOST_CHECK(a.get_migration_log().empty());
+    a.evolve(10);
+    a.wait_check();
+    BOOST_CHECK(a.get_migration_log().empty());
+
+    // Stream to a callback.
+    BOOST_CHECK_THROW(a.set_migration_log_sink({}), std::invalid_argument);
+    std::atomic<std::size_t> counter(0);
+    a.set_migration_log_sink([&counter](const archipelago::migration_log_t &mlog) { counter += mlog.size(); });
+    BOOST_CHECK(a.get_migration_log_mode() == migration_log_mode::stream);
+    a.evolve(10);
+    a.wait_check();
+    BOOST_CHECK(counter.load() > 0u);
+    BOOST_CHECK(a.get_migration_log().empty());
+
+    // Moved-from archipelagos are left with an empty
+    // log in the default mode, without the sink.
+    {
+        archipelago a2(a), a3;
+        a3 = std::move(a2);
+        BOOST_CHECK(a3.get_migration_log_mode() == migration_log_mode::stream);
+        BOOST_CHECK(a2.get_migration_log_mode() == migration_log_mode::unbounded);
+        auto a4(std::move(a3));
+        BOOST_CHECK(a4.get_migration_log_mode() == migration_log_mode::stream);
+        BOOST_CHECK(a3.get_migration_log_mode() == migration_log_mode::unbounded);
+        BOOST_CHECK(a3.get_migration_log().empty());
+    }
+
+    // Errors in the sink are propagated.
+    a.set_migration_log_sink([](const archipelago::migration_log_t &) { throw std::runtime_error("sink error"); });
+    a.evolve(10);
+    BOOST_CHECK_THROW(a.wait_check(), std::runtime_error);
+
+    // Stream to a file, and compare with the unbounded log.
+    const tmp_file tf("archipelago_migration_log_modes");
+    const auto &filename = tf.path;
+    archipelago::migration_log_t stream_log;
+    a.set_migration_log_sink([&stream_log, fsink = archipelago::migration_log_file_sink(filename)](
+                                 const archipelago::migration_log_t &mlog) {
+        fsink(mlog);
+        // NOTE: the file sink is thread-safe, our vector
+        // is not. Use a single island below.
+        stream_log.insert(stream_log.end(), mlog.begin(), mlog.end());
+    });
+    a[0].evolve(10);
+    a.wait_check();
+    BOOST_CHECK(!stream_log.empty());
+    BOOST_CHECK(archipelago::read_migration_log_file(filename) == stream_log);
+    std::remove(filename.c_str());
+
+    BOOST_CHECK_THROW(archipelago::read_migration_log_file(filename), std::runtime_error);
+    BOOST_CHECK_THROW(archipelago::migration_log_file_sink("/nonexistent/dir/file.bin"), std::runtime_error);
+}
+
+// Concurrent batches wrapping around the capacity of a ring log
+// must never replace a newer entry with an older one.
+BOOST_AUTO_TEST_CASE(archipelago_ring_log_wrap)
+{
+    detail::ring_log<int> rl(5);
+    std::vector<std::thread> threads;
+    for (int t = 0; t < 4; ++t) {
+        threads.emplace_back([&rl, t]() {
+            for (int i = 0; i < 1000; ++i) {
+                rl.append(std::vector<int>{t, t, t});
+            }
+        });
+    }
+    for (auto &t : threads) {
+        t.join();
+    }
+    // All the batches are done: the most recent entries
+    // must fill the whole log.
+    BOOST_CHECK(rl.get_all().size() == 5u);
+
+    rl.clear();
+    BOOST_CHECK(rl.get_all().empty());
+    rl.append({1, 2, 3, 4, 5, 6, 7});
+    BOOST_CHECK((rl.get_all() == std::vector<int>{3, 4, 5, 6, 7}));
+}
+
+BOOST_AUTO_TEST_CASE(archipelago_parallel_ctors)
+{
+    using size_type = archipelago::size_type;
+
+    // The seeded constructors must produce the same populations
+    // as a sequential construction.
+    {
+        archipelago a{50u, de{}, rosenbrock{10}, 20u, 42u};
+        archipelago b;
+        std::mt19937 eng(42u);
+        std::uniform_int_distribution<unsigned> udist;
+        for (size_type i = 0; i < 50u; ++i) {
+            b.push_back(de{}, rosenbrock{10}, 20u, udist(eng));
+        }
+        BOOST_CHECK(a.size() == 50u);
+        for (size_type i = 0; i < 50u; ++i) {
+            BOOST_CHECK(a[i].get_population().get_seed() == b[i].get_population().get_seed());
+            BOOST_CHECK(a[i].get_population().get_x() == b[i].get_population().get_x());
+            BOOST_CHECK(a[i].get_population().get_f() == b[i].get_population().get_f());
+        }
+    }
+    {
+        archipelago a{ring{}, 50u, de{}, rosenbrock{10}, thread_bfe{}, 20u, fair_replace{}, select_best{}, 43u};
+        archipelago b;
+        std::mt19937 eng(43u);
+        std::uniform_int_distribution<unsigned> udist;
+        for (size_type i = 0; i < 50u; ++i) {
+            b.push_back(de{}, rosenbrock{10}, thread_bfe{}, 20u, fair_replace{}, select_best{}, udist(eng));
+        }
+        BOOST_CHECK(a.get_topology().is<ring>());
+        for (size_type i = 0; i < 50u; ++i) {
+            BOOST_CHECK(a[i].get_population().get_seed() == b[i].get_population().get_seed());
+            BOOST_CHECK(a[i].get_population().get_x() == b[i].get_population().get_x());
+        }
+    }
+
+    // Without a seed, the populations must receive the seeds from the
+    // global random device in the same order as a sequential construction.
+    {
+        // NOTE: construct the algorithm beforehand, as the
+        // default constructor of de draws a seed as well.
+        const de algo{};
+        random_device::set_seed(123u);
+        archipelago a{50u, algo, rosenbrock{10}, 20u};
+        random_device::set_seed(123u);
+        archipelago b;
+        for (size_type i = 0; i < 50u; ++i) {
+            b.push_back(algo, rosenbrock{10}, 20u);
+        }
+        for (size_type i = 0; i < 50u; ++i) {
+            BOOST_CHECK(a[i].get_population().get_seed() == b[i].get_population().get_seed());
+            BOOST_CHECK(a[i].get_population().get_x() == b[i].get_population().get_x());
+        }
+    }
+
+    // Problems without thread safety guarantees must be evaluated sequentially.
+    conc_prob cp;
+    cp.ts = thread_safety::none;
+    conc_prob::max_active.store(0);
+    archipelago a{20u, thread_island{}, de{}, cp, 50u, 44u};
+    BOOST_CHECK(a.size() == 20u);
+    BOOST_CHECK(conc_prob::max_active.load() == 1);
+    for (size_type i = 0; i < 20u; ++i) {
+        BOOST_CHECK(a[i].get_population().size() == 50u);
+        BOOST_CHECK(a[i].get_population().get_problem().get_fevals() == 50u);
+    }
+
+    // Same with a bfe which does not provide the constant thread safety guarantee.
+    cp.ts = thread_safety::basic;
+    conc_prob::max_active.store(0);
+    archipelago a2{20u, de{}, cp, bfe{seq_bfe{}}, 50u, 45u};
+    BOOST_CHECK(a2.size() == 20u);
+    BOOST_CHECK(conc_prob::max_active.load() == 1);
+}
+
+BOOST_AUTO_TEST_CASE(archipelago_checkpoint)
+{
+    const tmp_file tf("archipelago_checkpoint");
+    const auto &filename = tf.path;
+
+    archipelago a{ring{}, 6, de{}, population{rosenbrock{}, 25}};
+    a.evolve(10);
+    a.wait_check();
+    a.set_migration_type(migration_type::broadcast);
+    a.set_migrant_handling(migrant_handling::evict);
+
+    auto check_equal = [](const archipelago &a1, const archipelago &a2) {
+        BOOST_CHECK_EQUAL(boost::lexical_cast<std::string>(a1), boost::lexical_cast<std::string>(a2));
+        BOOST_CHECK(a1.get_migration_type() == a2.get_migration_type());
+        BOOST_CHECK(a1.get_migrant_handling() == a2.get_migrant_handling());
+        BOOST_CHECK(a1.get_migrants_db() == a2.get_migrants_db());
+        BOOST_CHECK(a1.get_migration_log() == a2.get_migration_log());
+        BOOST_CHECK(a2.get_topology().is<ring>());
+        BOOST_CHECK(a1.get_topology().get_connections(0) == a2.get_topology().get_connections(0));
+        BOOST_REQUIRE(a1.size() == a2.size());
+        for (archipelago::size_type i = 0; i < a1.size(); ++i) {
+            const auto p1 = a1[i].get_population(), p2 = a2[i].get_population();
+            BOOST_CHECK(p1.get_ID() == p2.get_ID());
+            BOOST_CHECK(p1.get_x() == p2.get_x());
+            BOOST_CHECK(p1.get_f() == p2.get_f());
+            BOOST_CHECK(p1.champion_x() == p2.champion_x());
+            BOOST_CHECK(p1.get_seed() == p2.get_seed());
+            BOOST_CHECK(p1.get_problem().get_fevals() == p2.get_problem().get_fevals());
+            BOOST_CHECK(a2[i].get_algorithm().is<de>());
+            BOOST_CHECK(a2[i].get_r_policy().is<fair_replace>());
+            BOOST_CHECK(a2[i].get_s_policy().is<select_best>());
+            BOOST_CHECK(a2[i].is<thread_island>());
+        }
+    };
+
+    // Round trip.
+    BOOST_CHECK(a.save_checkpoint(filename) == 6u);
+    archipelago b;
+    b.load_checkpoint(filename);
+    check_equal(a, b);
+
+    // Nothing changed, nothing is written.
+    BOOST_CHECK(a.save_checkpoint(filename) == 0u);
+
+    // Only the changed islands are written.
+    a[1].set_population(population{rosenbrock{}, 10});
+    a[4].set_algorithm(algorithm{de{20}});
+    BOOST_CHECK(a.save_checkpoint(filename) == 2u);
+    archipelago c;
+    c.load_checkpoint(filename);
+    check_equal(a, c);
+    BOOST_CHECK(c[4].get_algorithm().extract<de>()->get_seed() == a[4].get_algorithm().extract<de>()->get_seed());
+
+    // Evolution and new islands.
+    a.evolve();
+    a.wait_check();
+    a.push_back(de{}, rosenbrock{}, 5u);
+    BOOST_CHECK(a.save_checkpoint(filename) == 7u);
+    c.load_checkpoint(filename);
+    check_equal(a, c);
+
+    // The file was changed behind b's back: the checkpoint
+    // is rewritten from scratch. Then c picks up
+    // b's checkpoint incrementally.
+    BOOST_CHECK(b.save_checkpoint(filename) == 6u);
+    c.load_checkpoint(filename);
+    check_equal(b, c);
+    c[0].set_population(population{rosenbrock{}, 3});
+    BOOST_CHECK(c.save_checkpoint(filename) == 1u);
+    b.load_checkpoint(filename);
+    check_equal(b, c);
+
+    // Copies do not inherit the incremental state.
+    auto d(c);
+    BOOST_CHECK(d.save_checkpoint(filename) == 6u);
+    BOOST_CHECK(d.save_checkpoint(filename) == 0u);
+
+    // The data superseded by incremental checkpoints
+    // eventually triggers a rewrite from scratch.
+    std::vector<archipelago::size_type> n_written;
+    for (int i = 0; i < 10; ++i) {
+        d[0].set_population(population{rosenbrock{}, 25});
+        n_written.push_back(d.save_checkpoint(filename));
+    }
+    BOOST_CHECK(std::count(n_written.begin(), n_written.end(), 6u) > 0);
+    BOOST_CHECK(std::count(n_written.begin(), n_written.end(), 1u) > 0);
+    c.load_checkpoint(filename);
+    check_equal(c, d);
+
+    // Checkpoints while evolving.
+    d.evolve(20);
+    d.save_checkpoint(filename);
+    d.wait_check();
+    c.load_checkpoint(filename);
+    BOOST_CHECK(c.size() == 6u);
+
+    // Interrupted incremental checkpoints.
+    {
+        auto read_file = [&filename]() {
+            std::ifstream ifs(filename, std::ios::binary);
+            return std::string(std::istreambuf_iterator<char>(ifs), std::istreambuf_iterator<char>());
+        };
+        auto write_file = [&filename](const std::string &str) {
+            std::ofstream ofs(filename, std::ios::binary | std::ios::trunc);
+            ofs.write(str.data(), static_cast<std::streamsize>(str.size()));
+        };
+
+        archipelago e{ring{}, 4, de{}, population{rosenbrock{}, 20}};
+        BOOST_CHECK(e.save_checkpoint(filename) == 4u);
+        const auto e_copy(e);
+        const auto first = read_file();
+        e[2].set_population(population{rosenbrock{}, 30});
+        BOOST_CHECK(e.save_checkpoint(filename) == 1u);
+        const auto second = read_file();
+        BOOST_REQUIRE(second.size() > first.size());
+
+        // The process died halfway through the append: the file contains the
+        // first checkpoint (whose header was not updated yet) followed by
+        // part of the second one.
+        write_file(first + second.substr(first.size(), (second.size() - first.size()) / 2u));
+        archipelago f;
+        f.load_checkpoint(filename);
+        check_equal(e_copy, f);
+        // The next checkpoint is written from scratch.
+        BOOST_CHECK(f.save_checkpoint(filename) == 4u);
+        f.load_checkpoint(filename);
+        check_equal(e_copy, f);
+
+        // The trailer of the second checkpoint reached the disk,
+        // but the data preceding it did not.
+        auto tmp(second);
+        std::fill(tmp.begin() + static_cast<std::string::difference_type>(first.size()), tmp.end() - 24, '\0');
+        write_file(tmp);
+        f.load_checkpoint(filename);
+        check_equal(e_copy, f);
+
+        // The complete file loads the second checkpoint.
+        write_file(second);
+        f.load_checkpoint(filename);
+        check_equal(e, f);
+    }
+
+    // Error handling.
+    {
+        std::ofstream ofs(filename, std::ios::binary | std::ios::trunc);
+        ofs << "hello world";
+    }
+    BOOST_CHECK_EXCEPTION(c.load_checkpoint(filename), std::runtime_error, [](const std::runtime_error &e) {
+        return boost::contains(e.what(), "is not a valid archipelago checkpoint file");
+    });
+    BOOST_CHECK(c.size() == 6u);
+    a.save_checkpoint(filename);
+    std::string contents;
+    {
+        std::ifstream ifs(filename, std::ios::binary);
+        contents.assign(std::istreambuf_iterator<char>(ifs), std::istreambuf_iterator<char>());
+    }
+    {
+        // Unsupported format version.
+        auto tmp(contents);
+        tmp[32] = 42;
+        std::ofstream ofs(filename, std::ios::binary | std::ios::trunc);
+        ofs.write(tmp.data(), static_cast<std::streamsize>(tmp.size()));
+    }
+    BOOST_CHECK_EXCEPTION(c.load_checkpoint(filename), std::runtime_error, [](const std::runtime_error &e) {
+        return boost::contains(e.what(), "was written with version 42 of the checkpoint format");
+    });
+    {
+        std::ofstream ofs(filename, std::ios::binary | std::ios::trunc);
+        ofs.write(contents.data(), static_cast<std::streamsize>(contents.size() - 100u));
+    }
+    BOOST_CHECK_EXCEPTION(c.load_checkpoint(filename), std::runtime_error, [](const std::runtime_error &e) {
+        return boost::contains(e.what(), "is truncated or corrupted");
+    });
+    // The truncated file is rewritten from scratch.
+    BOOST_CHECK(a.save_checkpoint(filename) == 7u);
+    c.load_checkpoint(filename);
+    check_equal(a, c);
+    std::remove(filename.c_str());
+
+    BOOST_CHECK_THROW(c.load_checkpoint(filename), std::runtime_error);
+    BOOST_CHECK_THROW(a.save_checkpoint("/nonexistent/dir/file.bin"), std::runtime_error);
+}
@@ -0,0 +1,160 @@
+/* Copyright 2017-2021 PaGMO development team
+
+This file is part of the PaGMO library.
+
+The PaGMO library is free software; you can redistribute it and/or modify
+it under the terms of either:
+
+  * the GNU Lesser General Public License as published by the Free
+    Software Foundation; either version 3 of the License, or (at your
+    option) any later version.
+
+or
+
+  * the GNU General Public License as published by the Free Software
+    Foundation; either version 3 of the License, or (at your option) any
+    later version.
+
+or both in parallel, as here.
+
+The PaGMO library is distributed in the hope that it will be useful, but
+WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+for more details.
+
+You should have received copies of the GNU General Public License and the
+GNU Lesser General Public License along with the PaGMO library.  If not,
+see https://www.gnu.org/licenses/. */
+
+#define BOOST_TEST_MODULE async_evaluator_test
+#define BOOST_TEST_DYN_LINK
+#include <boost/test/unit_test.hpp>
+
+#include <algorithm>
+#include <chrono>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include <boost/algorithm/string/predicate.hpp>
+
+#include <pagmo/async_evaluator.hpp>
+#include <pagmo/problem.hpp>
+#include <pagmo/problems/inventory.hpp>
+#include <pagmo/problems/rosenbrock.hpp>
+#include <pagmo/threading.hpp>
+#include <pagmo/types.hpp>
+
+using namespace pagmo;
+
+// A problem whose evaluation time depends on the decision vector,
+// and which throws for negative decision vectors.
+struct slow_prob {
+    vector_double fitness(const vector_double &dv) const
+    {
+        if (dv[0] < 0) {
+            throw std::runtime_error("negative dv");
+        }
+        std::this_thread::sleep_for(std::chrono::milliseconds(static_cast<int>(dv[0])));
+        return {2 * dv[0]};
+    }
+    std::pair<vector_double, vector_double> get_bounds() const
+    {
+        return {{-1.}, {100.}};
+    }
+    thread_safety get_thread_safety() const
+    {
+        return thread_safety::basic;
+    }
+};
+
+// A problem not providing any thread safety.
+struct unsafe_prob {
+    vector_double fitness(const vector_double &) const
+    {
+        return {1.};
+    }
+    std::pair<vector_double, vector_double> get_bounds() const
+    {
+        return {{0.}, {1.}};
+    }
+    thread_safety get_thread_safety() const
+    {
+        return thread_safety::none;
+    }
+    std::string get_name() const
+    {
+        return "unsafe_prob";
+    }
+};
+
+BOOST_AUTO_TEST_CASE(async_evaluator_basic_test)
+{
+    BOOST_CHECK_EXCEPTION(async_evaluator(problem{unsafe_prob{}}), std::invalid_argument,
+                          [](const std::invalid_argument &ia) {
+                              return boost::contains(ia.what(), "Cannot use an async_evaluator on the problem "
+                                                                "'unsafe_prob', which does not provide the required "
+                                                                "level of thread safety");
+                          });
+
+    // Constant and basic thread safety.
+    for (auto p : {problem{rosenbrock{3}}, problem{inventory{3}}}) {
+        for (auto n_workers : {0u, 1u, 3u}) {
+            const auto fevals0 = p.get_fevals();
+            async_evaluator ev(p, n_workers);
+            BOOST_CHECK(ev.get_n_workers() > 0u);
+            if (n_workers != 0u) {
+                BOOST_CHECK_EQUAL(ev.get_n_workers(), n_workers);
+            }
+            BOOST_CHECK_EQUAL(ev.get_n_pending(), 0u);
+            BOOST_CHECK_THROW(ev.retrieve(), std::invalid_argument);
+            BOOST_CHECK_THROW(ev.submit({1., 2.}), std::invalid_argument);
+
+            std::vector<vector_double> dvs;
+            for (auto i = 0; i < 100; ++i) {
+                dvs.push_back({i / 100., i / 200., i / 300.});
+                BOOST_CHECK_EQUAL(ev.submit(dvs.back()), static_cast<unsigned long long>(i));
+            }
+            std::vector<bool> seen(100u);
+            for (auto i = 0; i < 100; ++i) {
+                BOOST_CHECK(ev.get_n_pending() > 0u);
+                auto [ticket, dv, fv] = ev.retrieve();
+                BOOST_CHECK(!seen[ticket]);
+                seen[ticket] = true;
+                BOOST_CHECK(dv == dvs[ticket]);
+                BOOST_CHECK(fv == p.fitness(dv));
+            }
+            BOOST_CHECK(std::all_of(seen.begin(), seen.end(), [](bool b) { return b; }));
+            BOOST_CHECK_EQUAL(ev.get_n_pending(), 0u);
+            BOOST_CHECK_EQUAL(ev.get_problem().get_fevals(), fevals0 + 100u);
+        }
+    }
+}
+
+BOOST_AUTO_TEST_CASE(async_evaluator_slow_test)
+{
+    async_evaluator ev(problem{slow_prob{}}, 4);
+
+    // Results are received in order of completion.
+    ev.submit({50.});
+    ev.submit({0.});
+    auto res = ev.retrieve();
+    BOOST_CHECK_EQUAL(std::get<0>(res), 1u);
+    BOOST_CHECK(std::get<2>(res) == vector_double{0.});
+    res = ev.retrieve();
+    BOOST_CHECK_EQUAL(std::get<0>(res), 0u);
+    BOOST_CHECK(std::get<2>(res) == vector_double{100.});
+
+    // Exceptions are transported to the retrieving thread.
+    ev.submit({-1.});
+    BOOST_CHECK_EXCEPTION(ev.retrieve(), std::runtime_error,
+                          [](const std::runtime_error &re) { return boost::contains(re.what(), "negative dv"); });
+    BOOST_CHECK_EQUAL(ev.get_n_pending(), 0u);
+
+    // Destruction with pending evaluations.
+    for (auto i = 0; i < 20; ++i) {
+        ev.submit({10.});
+    }
+}
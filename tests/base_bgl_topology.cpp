@@ -31,6 +31,7 @@ see https://www.gnu.org/licenses/. */
 #include <boost/test/unit_test.hpp>
 
 #include <atomic>
+#include <cstddef>
 #include <initializer_list>
 #include <limits>
 #include <sstream>
@@ -38,12 +39,14 @@ see https://www.gnu.org/licenses/. */
 #include <string>
 #include <thread>
 #include <utility>
+#include <vector>
 
 #include <boost/algorithm/string/predicate.hpp>
 #include <boost/graph/adjacency_list.hpp>
 
 #include <pagmo/s11n.hpp>
 #include <pagmo/topologies/base_bgl_topology.hpp>
+#include <pagmo/types.hpp>
 
 using namespace pagmo;
 
@@ -347,3 +350,60 @@ BOOST_AUTO_TEST_CASE(to_bgl_test)
     a_vertices = boost::adjacent_vertices(boost::vertex(2, b), b);
     BOOST_CHECK(a_vertices.first == a_vertices.second);
 }
+
+// Check that the connections are kept up to date
+// after every modification of the graph.
+BOOST_AUTO_TEST_CASE(connections_snapshot_test)
+{
+    using conn_t = std::pair<std::vector<std::size_t>, vector_double>;
+
+    bbt t0;
+    t0.add_vertex();
+    t0.add_vertex();
+    t0.add_vertex();
+    BOOST_CHECK(t0.get_connections(0) == conn_t{});
+    BOOST_CHECK_THROW(t0.get_connections(3), std::invalid_argument);
+
+    t0.add_edge(1, 0, .5);
+    t0.add_edge(2, 0, .25);
+    BOOST_CHECK((t0.get_connections(0) == conn_t{{1, 2}, {.5, .25}}));
+    BOOST_CHECK(t0.get_connections(1) == conn_t{});
+
+    t0.set_weight(2, 0, .75);
+    BOOST_CHECK((t0.get_connections(0) == conn_t{{1, 2}, {.5, .75}}));
+
+    t0.remove_edge(1, 0);
+    BOOST_CHECK((t0.get_connections(0) == conn_t{{2}, {.75}}));
+
+    t0.set_all_weights(.125);
+    BOOST_CHECK((t0.get_connections(0) == conn_t{{2}, {.125}}));
+
+    t0.add_vertex();
+    t0.add_edge(3, 0);
+    BOOST_CHECK((t0.get_connections(0) == conn_t{{2, 3}, {.125, 1.}}));
+    BOOST_CHECK(t0.get_connections(3) == conn_t{});
+
+    // Copy, move and assignment.
+    auto t1(t0);
+    BOOST_CHECK((t1.get_connections(0) == conn_t{{2, 3}, {.125, 1.}}));
+    auto t2(std::move(t1));
+    BOOST_CHECK((t2.get_connections(0) == conn_t{{2, 3}, {.125, 1.}}));
+    t2 = bbt{};
+    BOOST_CHECK_THROW(t2.get_connections(0), std::invalid_argument);
+    t2 = t0;
+    BOOST_CHECK((t2.get_connections(0) == conn_t{{2, 3}, {.125, 1.}}));
+
+    // Serialization.
+    std::stringstream ss;
+    {
+        boost::archive::binary_oarchive oarchive(ss);
+        oarchive << t0;
+    }
+    bbt t3;
+    BOOST_CHECK_THROW(t3.get_connections(0), std::invalid_argument);
+    {
+        boost::archive::binary_iarchive iarchive(ss);
+        iarchive >> t3;
+    }
+    BOOST_CHECK((t3.get_connections(0) == conn_t{{2, 3}, {.125, 1.}}));
+}
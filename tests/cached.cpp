@@ -0,0 +1,401 @@
+/* Copyright 2017-2021 PaGMO development team
+
+This file is part of the PaGMO library.
+
+The PaGMO library is free software; you can redistribute it and/or modify
+it under the terms of either:
+
+  * the GNU Lesser General Public License as published by the Free
+    Software Foundation; either version 3 of the License, or (at your
+    option) any later version.
+
+or
+
+  * the GNU General Public License as published by the Free Software
+    Foundation; either version 3 of the License, or (at your option) any
+    later version.
+
+or both in parallel, as here.
+
+The PaGMO library is distributed in the hope that it will be useful, but
+WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+for more details.
+
+You should have received copies of the GNU General Public License and the
+GNU Lesser General Public License along with the PaGMO library.  If not,
+see https://www.gnu.org/licenses/. */
+
+#define BOOST_TEST_MODULE cached_test
+#define BOOST_TEST_DYN_LINK
+#include <boost/test/unit_test.hpp>
+
+#include <atomic>
+#include <limits>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include <boost/lexical_cast.hpp>
+
+#include <pagmo/batch_evaluators/thread_bfe.hpp>
+#include <pagmo/exceptions.hpp>
+#include <pagmo/problem.hpp>
+#include <pagmo/problems/cached.hpp>
+#include <pagmo/problems/hock_schittkowski_71.hpp>
+#include <pagmo/problems/inventory.hpp>
+#include <pagmo/problems/null_problem.hpp>
+#include <pagmo/problems/rosenbrock.hpp>
+#include <pagmo/s11n.hpp>
+#include <pagmo/threading.hpp>
+#include <pagmo/types.hpp>
+
+using namespace pagmo;
+
+// A problem counting how many times its fitness
+// has been invoked, in single and batch mode.
+struct counting_prob {
+    vector_double fitness(const vector_double &x) const
+    {
+        ++m_n_fitness;
+        return {x[0] + x[1]};
+    }
+    vector_double batch_fitness(const vector_double &xs) const
+    {
+        ++m_n_batch;
+        vector_double retval;
+        for (decltype(xs.size()) i = 0; i < xs.size(); i += 2u) {
+            retval.push_back(xs[i] + xs[i + 1u]);
+        }
+        return retval;
+    }
+    std::pair<vector_double, vector_double> get_bounds() const
+    {
+        return {{0., 0.}, {1., 1.}};
+    }
+    thread_safety get_thread_safety() const
+    {
+        return thread_safety::constant;
+    }
+    static std::atomic<unsigned> m_n_fitness;
+    static std::atomic<unsigned> m_n_batch;
+};
+
+std::atomic<unsigned> counting_prob::m_n_fitness(0);
+std::atomic<unsigned> counting_prob::m_n_batch(0);
+
+BOOST_AUTO_TEST_CASE(cached_construction_test)
+{
+    problem p0{cached{}};
+    problem p1{cached{null_problem{}}};
+    BOOST_CHECK_EQUAL(boost::lexical_cast<std::string>(p0), boost::lexical_cast<std::string>(p1));
+
+    cached c{rosenbrock{5u}, 123u};
+    BOOST_CHECK_EQUAL(c.get_capacity(), 123u);
+    BOOST_CHECK_EQUAL(c.get_cache_size(), 0u);
+    BOOST_CHECK_EQUAL(c.get_hits(), 0u);
+    BOOST_CHECK_EQUAL(c.get_misses(), 0u);
+    BOOST_CHECK(c.get_inner_problem().is<rosenbrock>());
+    BOOST_CHECK(c.get_name() == "Multidimensional Rosenbrock Function [cached]");
+    BOOST_CHECK(c.get_extra_info().find("Cache capacity: 123") != std::string::npos);
+
+    // Construction from problem.
+    cached c2{problem{rosenbrock{5u}}};
+    BOOST_CHECK(c2.get_inner_problem().is<rosenbrock>());
+
+    BOOST_CHECK_THROW((cached{rosenbrock{}, 0u}), std::invalid_argument);
+}
+
+BOOST_AUTO_TEST_CASE(cached_fitness_test)
+{
+    counting_prob::m_n_fitness = 0;
+    problem p{cached{counting_prob{}}};
+    auto c = p.extract<cached>();
+
+    BOOST_CHECK(p.fitness({.1, .2}) == vector_double{.1 + .2});
+    BOOST_CHECK(p.fitness({.1, .2}) == vector_double{.1 + .2});
+    BOOST_CHECK(p.fitness({.3, .2}) == vector_double{.3 + .2});
+    BOOST_CHECK(p.fitness({.1, .2}) == vector_double{.1 + .2});
+    BOOST_CHECK_EQUAL(counting_prob::m_n_fitness.load(), 2u);
+    BOOST_CHECK_EQUAL(c->get_hits(), 2u);
+    BOOST_CHECK_EQUAL(c->get_misses(), 2u);
+    BOOST_CHECK_EQUAL(c->get_cache_size(), 2u);
+    // The outer problem counts all evaluations, the inner one only the misses.
+    BOOST_CHECK_EQUAL(p.get_fevals(), 4u);
+    // NOTE: use the const overload of get_inner_problem(),
+    // which does not detach the cache.
+    BOOST_CHECK_EQUAL(std::as_const(*c).get_inner_problem().get_fevals(), 2u);
+
+    // NaNs are treated as equal to each other.
+    const auto nan = std::numeric_limits<double>::quiet_NaN();
+    c->fitness({nan, .2});
+    c->fitness({nan, .2});
+    BOOST_CHECK_EQUAL(counting_prob::m_n_fitness.load(), 3u);
+
+    c->clear_cache();
+    BOOST_CHECK_EQUAL(c->get_cache_size(), 0u);
+    BOOST_CHECK_EQUAL(c->get_hits(), 0u);
+    BOOST_CHECK_EQUAL(c->get_misses(), 0u);
+    p.fitness({.1, .2});
+    BOOST_CHECK_EQUAL(counting_prob::m_n_fitness.load(), 4u);
+}
+
+BOOST_AUTO_TEST_CASE(cached_lru_test)
+{
+    counting_prob::m_n_fitness = 0;
+    // Capacity 1: a single shard holding a single entry.
+    cached c{counting_prob{}, 1u};
+    c.fitness({.1, .1});
+    c.fitness({.2, .2});
+    BOOST_CHECK_EQUAL(c.get_cache_size(), 1u);
+    c.fitness({.2, .2});
+    BOOST_CHECK_EQUAL(c.get_hits(), 1u);
+    c.fitness({.1, .1});
+    BOOST_CHECK_EQUAL(c.get_misses(), 3u);
+
+    // Larger capacity: the size of the cache never exceeds it.
+    cached c2{counting_prob{}, 37u};
+    for (auto i = 0; i < 1000; ++i) {
+        c2.fitness({i / 1000., .5});
+        BOOST_CHECK(c2.get_cache_size() <= 37u);
+    }
+    BOOST_CHECK(c2.get_cache_size() > 0u);
+}
+
+BOOST_AUTO_TEST_CASE(cached_batch_fitness_test)
+{
+    counting_prob::m_n_fitness = 0;
+    counting_prob::m_n_batch = 0;
+    problem p{cached{counting_prob{}}};
+    BOOST_CHECK(p.has_batch_fitness());
+    auto c = p.extract<cached>();
+
+    c->fitness({.1, .2});
+    auto fvs = p.batch_fitness({.1, .2, .3, .4, .5, .6});
+    BOOST_CHECK((fvs == vector_double{.1 + .2, .3 + .4, .5 + .6}));
+    BOOST_CHECK_EQUAL(counting_prob::m_n_batch.load(), 1u);
+    BOOST_CHECK_EQUAL(c->get_hits(), 1u);
+    BOOST_CHECK_EQUAL(c->get_misses(), 3u);
+    BOOST_CHECK_EQUAL(std::as_const(*c).get_inner_problem().get_fevals(), 3u);
+
+    // Everything in the cache now: no call to the inner batch fitness.
+    fvs = p.batch_fitness({.5, .6, .1, .2, .3, .4});
+    BOOST_CHECK((fvs == vector_double{.5 + .6, .1 + .2, .3 + .4}));
+    BOOST_CHECK_EQUAL(counting_prob::m_n_batch.load(), 1u);
+    BOOST_CHECK_EQUAL(c->get_hits(), 4u);
+    BOOST_CHECK_EQUAL(c->get_misses(), 3u);
+
+    // No batch fitness in the inner problem.
+    problem p2{cached{hock_schittkowski_71{}}};
+    BOOST_CHECK(!p2.has_batch_fitness());
+    BOOST_CHECK_THROW(p2.batch_fitness({3., 3., 3., 3.}), not_implemented_error);
+}
+
+BOOST_AUTO_TEST_CASE(cached_forwarding_test)
+{
+    hock_schittkowski_71 hs;
+    problem p0{hs};
+    problem p1{cached{hs}};
+    BOOST_CHECK(p0.get_bounds() == p1.get_bounds());
+    BOOST_CHECK_EQUAL(p0.get_nobj(), p1.get_nobj());
+    BOOST_CHECK_EQUAL(p0.get_nec(), p1.get_nec());
+    BOOST_CHECK_EQUAL(p0.get_nic(), p1.get_nic());
+    BOOST_CHECK_EQUAL(p0.get_nix(), p1.get_nix());
+    BOOST_CHECK(p1.has_gradient());
+    BOOST_CHECK_EQUAL(p0.has_gradient_sparsity(), p1.has_gradient_sparsity());
+    BOOST_CHECK(p1.has_hessians());
+    BOOST_CHECK_EQUAL(p0.has_hessians_sparsity(), p1.has_hessians_sparsity());
+    const vector_double x{1., 2., 3., 4.};
+    BOOST_CHECK(p0.fitness(x) == p1.fitness(x));
+    BOOST_CHECK(p0.gradient(x) == p1.gradient(x));
+    BOOST_CHECK(p0.gradient_sparsity() == p1.gradient_sparsity());
+    BOOST_CHECK(p0.hessians(x) == p1.hessians(x));
+    BOOST_CHECK(p0.hessians_sparsity() == p1.hessians_sparsity());
+}
+
+BOOST_AUTO_TEST_CASE(cached_stochastic_test)
+{
+    problem p{cached{inventory{}}};
+    BOOST_CHECK(p.is_stochastic());
+    auto c = p.extract<cached>();
+    const vector_double x(4u, 1.);
+    const auto f0 = p.fitness(x);
+    BOOST_CHECK(p.fitness(x) == f0);
+    BOOST_CHECK_EQUAL(c->get_cache_size(), 1u);
+    // Changing the seed clears the cache.
+    p.set_seed(42u);
+    BOOST_CHECK_EQUAL(c->get_cache_size(), 0u);
+    BOOST_CHECK((p.fitness(x) == problem{inventory{4u, 10u, 42u}}.fitness(x)));
+}
+
+BOOST_AUTO_TEST_CASE(cached_copy_move_test)
+{
+    cached c{counting_prob{}, 10u};
+    for (auto i = 0; i < 20; ++i) {
+        c.fitness({i / 20., .1});
+    }
+    const auto size = c.get_cache_size();
+
+    auto c2(c);
+    BOOST_CHECK_EQUAL(c2.get_cache_size(), size);
+    BOOST_CHECK_EQUAL(c2.get_hits(), c.get_hits());
+    BOOST_CHECK_EQUAL(c2.get_misses(), c.get_misses());
+    // The copy shares the cache with the original.
+    const auto hits = c.get_hits();
+    c2.fitness({19 / 20., .1});
+    BOOST_CHECK_EQUAL(c.get_hits(), hits + 1u);
+    const auto n_fitness = counting_prob::m_n_fitness.load();
+    c2.fitness({.5, .5});
+    c.fitness({.5, .5});
+    BOOST_CHECK_EQUAL(counting_prob::m_n_fitness.load(), n_fitness + 1u);
+    BOOST_CHECK_EQUAL(c2.get_misses(), c.get_misses());
+
+    // Non-const access to the inner problem detaches the copy.
+    c2.get_inner_problem();
+    BOOST_CHECK_EQUAL(c2.get_cache_size(), 0u);
+    BOOST_CHECK_EQUAL(c2.get_hits(), 0u);
+    BOOST_CHECK_EQUAL(c.get_cache_size(), size);
+    c2.fitness({19 / 20., .1});
+    BOOST_CHECK_EQUAL(c.get_hits(), hits + 2u);
+    BOOST_CHECK_EQUAL(c2.get_misses(), 1u);
+    BOOST_CHECK_EQUAL(c2.get_cache_size(), 1u);
+
+    cached c3;
+    c3 = c2;
+    BOOST_CHECK_EQUAL(c3.get_cache_size(), 1u);
+    BOOST_CHECK_EQUAL(c3.get_capacity(), 10u);
+
+    auto c4(std::move(c3));
+    BOOST_CHECK_EQUAL(c4.get_cache_size(), 1u);
+    c3 = std::move(c4);
+    BOOST_CHECK_EQUAL(c3.get_cache_size(), 1u);
+    BOOST_CHECK_EQUAL(c3.get_capacity(), 10u);
+}
+
+BOOST_AUTO_TEST_CASE(cached_thread_safety_test)
+{
+    BOOST_CHECK(problem{cached{rosenbrock{}}}.get_thread_safety() == thread_safety::constant);
+    BOOST_CHECK(problem{cached{hock_schittkowski_71{}}}.get_thread_safety() == thread_safety::basic);
+
+    // Concurrent evaluations.
+    counting_prob::m_n_fitness = 0;
+    cached c{counting_prob{}, 64u};
+    std::vector<std::thread> threads;
+    for (auto t = 0; t < 4; ++t) {
+        threads.emplace_back([&c]() {
+            for (auto i = 0; i < 1000; ++i) {
+                const vector_double x{(i % 100) / 100., .5};
+                BOOST_CHECK(c.fitness(x) == vector_double{x[0] + x[1]});
+            }
+        });
+    }
+    for (auto &th : threads) {
+        th.join();
+    }
+    BOOST_CHECK_EQUAL(c.get_hits() + c.get_misses(), 4000u);
+    BOOST_CHECK(c.get_cache_size() <= 64u);
+
+    // Use with thread_bfe.
+    problem p{cached{rosenbrock{2u}}};
+    vector_double dvs(200u);
+    for (auto i = 0u; i < 200u; ++i) {
+        dvs[i] = (i % 20u) / 10.;
+    }
+    const auto fvs = thread_bfe{}(p, dvs);
+    for (auto i = 0u; i < 100u; ++i) {
+        BOOST_CHECK(fvs[i] == rosenbrock{2u}.fitness({dvs[2u * i], dvs[2u * i + 1u]})[0]);
+    }
+    // thread_bfe evaluates a copy of p, which shares the cache with p.
+    // There are only 10 distinct decision vectors in dvs.
+    BOOST_CHECK_EQUAL(p.extract<cached>()->get_cache_size(), 10u);
+    BOOST_CHECK_EQUAL(p.extract<cached>()->get_hits() + p.extract<cached>()->get_misses(), 100u);
+    BOOST_CHECK(thread_bfe{}(p, dvs) == fvs);
+    BOOST_CHECK_EQUAL(p.extract<cached>()->get_misses(), 10u);
+}
+
+BOOST_AUTO_TEST_CASE(cached_serialization_test)
+{
+    problem p{cached{hock_schittkowski_71{}, 42u}};
+    std::stringstream ss;
+    auto before = boost::lexical_cast<std::string>(p);
+    {
+        boost::archive::binary_oarchive oarchive(ss);
+        oarchive << p;
+    }
+    p = problem{};
+    {
+        boost::archive::binary_iarchive iarchive(ss);
+        iarchive >> p;
+    }
+    auto after = boost::lexical_cast<std::string>(p);
+    BOOST_CHECK_EQUAL(before, after);
+    BOOST_CHECK(p.is<cached>());
+    BOOST_CHECK_EQUAL(p.extract<cached>()->get_capacity(), 42u);
+
+    // The content of the cache is not serialised.
+    p.fitness({1., 2., 3., 4.});
+    BOOST_CHECK_EQUAL(p.extract<cached>()->get_cache_size(), 1u);
+    std::stringstream ss2;
+    {
+        boost::archive::binary_oarchive oarchive(ss2);
+        oarchive << p;
+    }
+    p = problem{};
+    {
+        boost::archive::binary_iarchive iarchive(ss2);
+        iarchive >> p;
+    }
+    BOOST_CHECK_EQUAL(p.extract<cached>()->get_cache_size(), 0u);
+    BOOST_CHECK_EQUAL(p.extract<cached>()->get_hits(), 0u);
+}
+
+// A problem providing fitness_into(), counting
+// how many times it has been invoked.
+struct fi_prob {
+    vector_double fitness(const vector_double &) const
+    {
+        return {0.};
+    }
+    void fitness_into(const double *dv, double *fv) const
+    {
+        ++m_n_fitness_into;
+        fv[0] = dv[0] + dv[1];
+    }
+    std::pair<vector_double, vector_double> get_bounds() const
+    {
+        return {{0., 0.}, {1., 1.}};
+    }
+    static std::atomic<unsigned> m_n_fitness_into;
+};
+
+std::atomic<unsigned> fi_prob::m_n_fitness_into(0);
+
+BOOST_AUTO_TEST_CASE(cached_fitness_into_test)
+{
+    problem p0{cached{fi_prob{}}};
+    BOOST_CHECK(p0.has_fitness_into());
+    const vector_double x{.25, .5};
+    double f = 0;
+    p0.fitness_into(x.data(), &f);
+    BOOST_CHECK_EQUAL(f, .75);
+    BOOST_CHECK_EQUAL(fi_prob::m_n_fitness_into.load(), 1u);
+    // The cached value is shared with fitness().
+    BOOST_CHECK(p0.fitness(x) == vector_double{.75});
+    f = 0;
+    p0.fitness_into(x.data(), &f);
+    BOOST_CHECK_EQUAL(f, .75);
+    BOOST_CHECK_EQUAL(fi_prob::m_n_fitness_into.load(), 1u);
+    BOOST_CHECK_EQUAL(p0.extract<cached>()->get_hits(), 2u);
+    BOOST_CHECK_EQUAL(p0.extract<cached>()->get_misses(), 1u);
+
+    // Fall back to fitness() if the inner problem does not provide fitness_into().
+    problem p1{cached{hock_schittkowski_71{}}};
+    BOOST_CHECK(!p1.has_fitness_into());
+    const vector_double y{1., 2., 3., 4.};
+    vector_double fv(p1.get_nf());
+    p1.fitness_into(y.data(), fv.data());
+    BOOST_CHECK(fv == hock_schittkowski_71{}.fitness(y));
+}
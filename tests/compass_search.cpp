@@ -104,6 +104,20 @@ BOOST_AUTO_TEST_CASE(compass_search_evolve_test)
     BOOST_CHECK(compass_search{0u}.evolve(pop).get_x()[0] == pop.get_x()[0]);
 }
 
+BOOST_AUTO_TEST_CASE(compass_search_incremental_fitness_test)
+{
+    // The trial points are evaluated incrementally, but the fitness
+    // stored in the population is computed from scratch.
+    problem prob{rosenbrock{10u}};
+    population pop{prob, 5u, 23u};
+    const auto f0 = pop.champion_f();
+    pop = compass_search{10000u, 0.5, 1e-5, 0.5}.evolve(pop);
+    BOOST_CHECK(pop.champion_f()[0] < f0[0]);
+    for (decltype(pop.size()) i = 0; i < pop.size(); ++i) {
+        BOOST_CHECK(pop.get_f()[i] == prob.fitness(pop.get_x()[i]));
+    }
+}
+
 BOOST_AUTO_TEST_CASE(compass_search_setters_getters_test)
 {
     compass_search user_algo{10000u, 0.5, 0.1, 0.5};
@@ -0,0 +1,82 @@
+/* Copyright 2017-2021 PaGMO development team
+
+This file is part of the PaGMO library.
+
+The PaGMO library is free software; you can redistribute it and/or modify
+it under the terms of either:
+
+  * the GNU Lesser General Public License as published by the Free
+    Software Foundation; either version 3 of the License, or (at your
+    option) any later version.
+
+or
+
+  * the GNU General Public License as published by the Free Software
+    Foundation; either version 3 of the License, or (at your option) any
+    later version.
+
+or both in parallel, as here.
+
+The PaGMO library is distributed in the hope that it will be useful, but
+WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+for more details.
+
+You should have received copies of the GNU General Public License and the
+GNU Lesser General Public License along with the PaGMO library.  If not,
+see https://www.gnu.org/licenses/. */
+
+
+#ifndef PAGMO_TESTS_CONC_PROB_HPP
+#define PAGMO_TESTS_CONC_PROB_HPP
+
+#include <atomic>
+#include <numeric>
+#include <utility>
+
+#include <pagmo/problem.hpp>
+#include <pagmo/threading.hpp>
+#include <pagmo/types.hpp>
+
+// A problem which records the maximum number
+// of concurrent fitness evaluations. The fitness
+// is the sum of the components of the decision vector.
+struct conc_prob {
+    pagmo::vector_double fitness(const pagmo::vector_double &x) const
+    {
+        const auto cur = ++n_active;
+        auto old = max_active.load();
+        while (cur > old && !max_active.compare_exchange_weak(old, cur)) {
+        }
+        --n_active;
+        return {std::accumulate(x.begin(), x.end(), 0.)};
+    }
+    std::pair<pagmo::vector_double, pagmo::vector_double> get_bounds() const
+    {
+        return {pagmo::vector_double(dim, 0.), pagmo::vector_double(dim, 1.)};
+    }
+    pagmo::thread_safety get_thread_safety() const
+    {
+        return ts;
+    }
+    pagmo::vector_double::size_type dim = 1;
+    pagmo::thread_safety ts = pagmo::thread_safety::basic;
+    static inline std::atomic<int> n_active{0};
+    static inline std::atomic<int> max_active{0};
+};
+
+// A sequential UDBFE.
+struct seq_bfe {
+    pagmo::vector_double operator()(const pagmo::problem &p, const pagmo::vector_double &dvs) const
+    {
+        const auto nx = p.get_nx();
+        pagmo::vector_double retval;
+        for (decltype(dvs.size()) i = 0; i < dvs.size(); i += nx) {
+            const auto f = p.fitness(pagmo::vector_double(dvs.begin() + i, dvs.begin() + i + nx));
+            retval.insert(retval.end(), f.begin(), f.end());
+        }
+        return retval;
+    }
+};
+
+#endif
@@ -38,6 +38,7 @@ see https://www.gnu.org/licenses/. */
 
 #include <pagmo/algorithm.hpp>
 #include <pagmo/algorithms/de.hpp>
+#include <pagmo/bfe.hpp>
 #include <pagmo/io.hpp>
 #include <pagmo/population.hpp>
 #include <pagmo/problems/hock_schittkowski_71.hpp>
@@ -174,3 +175,40 @@ BOOST_AUTO_TEST_CASE(de_serialization_test)
         BOOST_CHECK_CLOSE(std::get<4>(before_log[i]), std::get<4>(after_log[i]), 1e-8);
     }
 }
+
+BOOST_AUTO_TEST_CASE(de_bfe_test)
+{
+    // The trial vectors depend only on the previous generation,
+    // thus the batch evaluation must not alter the evolution.
+    for (unsigned variant = 1u; variant <= 10u; ++variant) {
+        population pop{rosenbrock{10u}, 20u, 23u};
+        de uda{100u, 0.8, 0.9, variant, 0., 0., 23u};
+        uda.set_bfe(bfe{}); // This will use the default bfe.
+        pop = uda.evolve(pop);
+
+        population pop_2{rosenbrock{10u}, 20u, 23u};
+        de uda_2{100u, 0.8, 0.9, variant, 0., 0., 23u};
+        pop_2 = uda_2.evolve(pop_2);
+
+        BOOST_CHECK(pop.get_x() == pop_2.get_x());
+        BOOST_CHECK(pop.get_f() == pop_2.get_f());
+        BOOST_CHECK_EQUAL(pop.get_problem().get_fevals(), 20u + 100u * 20u);
+        BOOST_CHECK_EQUAL(pop.get_problem().get_fevals(), pop_2.get_problem().get_fevals());
+    }
+
+    // Check the bfe survives serialization.
+    algorithm algo{de{100u, 0.8, 0.9, 2u, 0., 0., 23u}};
+    algo.extract<de>()->set_bfe(bfe{});
+    std::stringstream ss;
+    {
+        boost::archive::binary_oarchive oarchive(ss);
+        oarchive << algo;
+    }
+    algorithm algo_2{};
+    {
+        boost::archive::binary_iarchive iarchive(ss);
+        iarchive >> algo_2;
+    }
+    population pop{rosenbrock{10u}, 20u, 23u};
+    BOOST_CHECK(algo.evolve(pop).get_f() == algo_2.evolve(pop).get_f());
+}
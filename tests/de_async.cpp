@@ -0,0 +1,192 @@
+/* Copyright 2017-2021 PaGMO development team
+
+This file is part of the PaGMO library.
+
+The PaGMO library is free software; you can redistribute it and/or modify
+it under the terms of either:
+
+  * the GNU Lesser General Public License as published by the Free
+    Software Foundation; either version 3 of the License, or (at your
+    option) any later version.
+
+or
+
+  * the GNU General Public License as published by the Free Software
+    Foundation; either version 3 of the License, or (at your option) any
+    later version.
+
+or both in parallel, as here.
+
+The PaGMO library is distributed in the hope that it will be useful, but
+WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+for more details.
+
+You should have received copies of the GNU General Public License and the
+GNU Lesser General Public License along with the PaGMO library.  If not,
+see https://www.gnu.org/licenses/. */
+
+#define BOOST_TEST_MODULE de_async_test
+#define BOOST_TEST_DYN_LINK
+#include <boost/test/unit_test.hpp>
+
+#include <iostream>
+#include <string>
+#include <utility>
+
+#include <boost/lexical_cast.hpp>
+
+#include <pagmo/algorithm.hpp>
+#include <pagmo/algorithms/de_async.hpp>
+#include <pagmo/io.hpp>
+#include <pagmo/population.hpp>
+#include <pagmo/problem.hpp>
+#include <pagmo/problems/hock_schittkowski_71.hpp>
+#include <pagmo/problems/inventory.hpp>
+#include <pagmo/problems/rosenbrock.hpp>
+#include <pagmo/problems/zdt.hpp>
+#include <pagmo/s11n.hpp>
+#include <pagmo/threading.hpp>
+#include <pagmo/types.hpp>
+
+using namespace pagmo;
+
+BOOST_AUTO_TEST_CASE(de_async_construction)
+{
+    de_async user_algo{1234u, 0.7, 0.5, 2u, 1e-6, 1e-6, 2u, 23u};
+    BOOST_CHECK(user_algo.get_verbosity() == 0u);
+    BOOST_CHECK(user_algo.get_seed() == 23u);
+    BOOST_CHECK(user_algo.get_gen() == 1234u);
+    BOOST_CHECK(user_algo.get_n_workers() == 2u);
+    BOOST_CHECK((user_algo.get_log() == de_async::log_type{}));
+
+    BOOST_CHECK_THROW((de_async{1234u, 0.7, 0.5, 0u}), std::invalid_argument);
+    BOOST_CHECK_THROW((de_async{1234u, 0.7, 0.5, 11u}), std::invalid_argument);
+    BOOST_CHECK_THROW((de_async{1234u, 1.2, 0.5, 2u}), std::invalid_argument);
+    BOOST_CHECK_THROW((de_async{1234u, -0.7, 0.5, 2u}), std::invalid_argument);
+    BOOST_CHECK_THROW((de_async{1234u, 0.7, 1.5, 2u}), std::invalid_argument);
+    BOOST_CHECK_THROW((de_async{1234u, 0.7, -0.5, 2u}), std::invalid_argument);
+}
+
+// A problem not providing any thread safety.
+struct unsafe_prob {
+    vector_double fitness(const vector_double &dv) const
+    {
+        return {dv[0]};
+    }
+    std::pair<vector_double, vector_double> get_bounds() const
+    {
+        return {{0.}, {1.}};
+    }
+    thread_safety get_thread_safety() const
+    {
+        return thread_safety::none;
+    }
+};
+
+BOOST_AUTO_TEST_CASE(de_async_evolve_test)
+{
+    // With a single worker the evolution is deterministic
+    // if the seed is controlled, for all variants.
+    for (unsigned i = 1u; i <= 10u; ++i) {
+        population pop1{rosenbrock{10u}, 20u, 23u};
+        population pop2{rosenbrock{10u}, 20u, 23u};
+
+        de_async user_algo1{50u, 0.7, 0.5, i, 0., 0., 1u, 23u};
+        user_algo1.set_verbosity(10u);
+        pop1 = user_algo1.evolve(pop1);
+        BOOST_CHECK(user_algo1.get_log().size() > 0u);
+        BOOST_CHECK_EQUAL(pop1.get_problem().get_fevals(), 20u + 50u * 20u);
+
+        de_async user_algo2{50u, 0.7, 0.5, i, 0., 0., 1u, 23u};
+        user_algo2.set_verbosity(10u);
+        pop2 = user_algo2.evolve(pop2);
+        BOOST_CHECK(user_algo1.get_log() == user_algo2.get_log());
+        BOOST_CHECK(pop1.get_f() == pop2.get_f());
+    }
+
+    // With multiple workers the outcome is not deterministic, but
+    // the champion can only improve.
+    {
+        population pop{rosenbrock{10u}, 20u, 23u};
+        const auto f0 = pop.champion_f()[0];
+        de_async user_algo{100u, 0.7, 0.5, 2u, 0., 0., 4u, 23u};
+        pop = user_algo.evolve(pop);
+        BOOST_CHECK(pop.champion_f()[0] < f0);
+        BOOST_CHECK_EQUAL(pop.get_problem().get_fevals(), 20u + 100u * 20u);
+        for (decltype(pop.size()) i = 0; i < pop.size(); ++i) {
+            BOOST_CHECK(pop.get_f()[i] == pop.get_problem().fitness(pop.get_x()[i]));
+        }
+    }
+    // Check the exit conditions.
+    {
+        de_async user_algo{1000000u, 0.7, 0.5, 2u, 1e-3, 1e-50, 2u, 23u};
+        user_algo.set_verbosity(1u);
+        population pop{rosenbrock{2u}, 20u, 23u};
+        pop = user_algo.evolve(pop);
+        BOOST_CHECK(user_algo.get_log().size() < 5000u);
+    }
+    {
+        de_async user_algo{1000000u, 0.7, 0.5, 2u, 1e-50, 1e-3, 2u, 23u};
+        user_algo.set_verbosity(1u);
+        population pop{rosenbrock{2u}, 20u, 23u};
+        pop = user_algo.evolve(pop);
+        BOOST_CHECK(user_algo.get_log().size() < 5000u);
+    }
+
+    // We then check that the evolve throws if called on unsuitable problems
+    BOOST_CHECK_THROW(de_async{10u}.evolve(population{problem{rosenbrock{}}, 4u}), std::invalid_argument);
+    BOOST_CHECK_THROW(de_async{10u}.evolve(population{problem{zdt{}}, 15u}), std::invalid_argument);
+    BOOST_CHECK_THROW(de_async{10u}.evolve(population{problem{hock_schittkowski_71{}}, 15u}),
+                      std::invalid_argument);
+    BOOST_CHECK_THROW(de_async{10u}.evolve(population{problem{inventory{}}, 15u}), std::invalid_argument);
+    BOOST_CHECK_THROW(de_async{10u}.evolve(population{problem{unsafe_prob{}}, 15u}), std::invalid_argument);
+    // And a clean exit for 0 generations
+    population pop{rosenbrock{25u}, 10u};
+    BOOST_CHECK(de_async{0u}.evolve(pop).get_x()[0] == pop.get_x()[0]);
+}
+
+BOOST_AUTO_TEST_CASE(de_async_setters_getters_test)
+{
+    de_async user_algo{10u, 0.7, 0.5, 2u, 1e-6, 1e-6, 0u, 23u};
+    user_algo.set_verbosity(23u);
+    BOOST_CHECK(user_algo.get_verbosity() == 23u);
+    user_algo.set_seed(24u);
+    BOOST_CHECK(user_algo.get_seed() == 24u);
+    BOOST_CHECK(user_algo.get_name().find("Differential") != std::string::npos);
+    BOOST_CHECK(user_algo.get_extra_info().find("Workers: auto") != std::string::npos);
+    BOOST_CHECK((de_async{10u, 0.7, 0.5, 2u, 1e-6, 1e-6, 3u}.get_extra_info().find("Workers: 3")
+                 != std::string::npos));
+    BOOST_CHECK_NO_THROW(user_algo.get_log());
+}
+
+BOOST_AUTO_TEST_CASE(de_async_serialization_test)
+{
+    // Make one evolution
+    problem prob{rosenbrock{2u}};
+    population pop{prob, 15u, 23u};
+    algorithm algo{de_async{100u, 0.8, 0.9, 2u, 1e-6, 1e-6, 1u, 23u}};
+    algo.set_verbosity(1u);
+    pop = algo.evolve(pop);
+
+    // Store the string representation of p.
+    std::stringstream ss;
+    auto before_text = boost::lexical_cast<std::string>(algo);
+    auto before_log = algo.extract<de_async>()->get_log();
+    // Now serialize, deserialize and compare the result.
+    {
+        boost::archive::binary_oarchive oarchive(ss);
+        oarchive << algo;
+    }
+    // Change the content of p before deserializing.
+    algo = algorithm{};
+    {
+        boost::archive::binary_iarchive iarchive(ss);
+        iarchive >> algo;
+    }
+    auto after_text = boost::lexical_cast<std::string>(algo);
+    auto after_log = algo.extract<de_async>()->get_log();
+    BOOST_CHECK_EQUAL(before_text, after_text);
+    BOOST_CHECK(before_log == after_log);
+    BOOST_CHECK(before_log.size() > 0u);
+}
@@ -311,4 +311,48 @@ BOOST_AUTO_TEST_CASE(decompose_thread_safety_test)
     decompose t{p0, {0.5, 0.5}, {2., 2.}};
     BOOST_CHECK(t.get_thread_safety() == thread_safety::basic);
     BOOST_CHECK((decompose{ts2{}, {0.5, 0.5}, {2., 2.}}.get_thread_safety() == thread_safety::none));
-}
\ No newline at end of file
+}
+
+// A bi-objective UDP providing fitness_into(), whose
+// output differs from the output of fitness().
+struct mo_fi {
+    vector_double fitness(const vector_double &) const
+    {
+        return {0., 0.};
+    }
+    void fitness_into(const double *dv, double *fv) const
+    {
+        fv[0] = dv[0];
+        fv[1] = 1. - dv[0];
+    }
+    vector_double::size_type get_nobj() const
+    {
+        return 2u;
+    }
+    std::pair<vector_double, vector_double> get_bounds() const
+    {
+        return {{0.}, {1.}};
+    }
+};
+
+BOOST_AUTO_TEST_CASE(decompose_fitness_into_test)
+{
+    problem p0{decompose{mo_fi{}, {0.5, 0.5}, {0., 0.}, "weighted", true}};
+    BOOST_CHECK(p0.has_fitness_into());
+    const double x = 0.25;
+    double f = -1.;
+    p0.fitness_into(&x, &f);
+    BOOST_CHECK_EQUAL(f, 0.5);
+    // The ideal point is adapted as in fitness().
+    BOOST_CHECK((p0.extract<decompose>()->get_z() == vector_double{0., 0.}));
+    const double y = -0.5;
+    p0.fitness_into(&y, &f);
+    BOOST_CHECK((p0.extract<decompose>()->get_z() == vector_double{-0.5, 0.}));
+
+    // Fall back to fitness() if the inner problem does not provide fitness_into().
+    problem p1{decompose{zdt{1u, 2u}, {0.5, 0.5}, {0., 0.}}};
+    BOOST_CHECK(!p1.has_fitness_into());
+    const vector_double z{0.5, 0.5};
+    p1.fitness_into(z.data(), &f);
+    BOOST_CHECK(vector_double{f} == p1.fitness(z));
+}
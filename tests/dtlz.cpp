@@ -35,7 +35,9 @@ see https://www.gnu.org/licenses/. */
 #include <iostream>
 #include <stdexcept>
 #include <string>
+#include <vector>
 
+#include <pagmo/batch_evaluators/default_bfe.hpp>
 #include <pagmo/problem.hpp>
 #include <pagmo/problems/dtlz.hpp>
 #include <pagmo/types.hpp>
@@ -211,6 +213,32 @@ BOOST_AUTO_TEST_CASE(dtlz_p_distance_test)
     BOOST_CHECK_NO_THROW(udp.p_distance(population{udp, 20u, 32u}));
 }
 
+BOOST_AUTO_TEST_CASE(dtlz_batch_fitness_test)
+{
+    vector_double dv1{0.5, 0.5, 0.5, 0.5, 0.5};
+    vector_double dv2{0.1, 0.2, 0.3, 0.4, 0.5};
+    vector_double xs(dv1);
+    xs.insert(xs.end(), dv2.begin(), dv2.end());
+    // Each problem id selects its own objective function.
+    for (unsigned i = 1u; i <= 7u; ++i) {
+        dtlz udp{i, 5u, 3u};
+        auto fs = udp.fitness(dv1);
+        const auto f2 = udp.fitness(dv2);
+        fs.insert(fs.end(), f2.begin(), f2.end());
+        BOOST_CHECK(udp.batch_fitness(xs) == fs);
+        BOOST_CHECK(default_bfe{}(problem{udp}, xs) == fs);
+    }
+    // On the centre of the box, g is 0 and the DTLZ1 objectives halve the linear front.
+    dtlz udp{1u, 5u, 3u};
+    const auto fs = udp.batch_fitness(vector_double(5000u, 0.5));
+    BOOST_CHECK(fs.size() == 3000u);
+    for (decltype(fs.size()) i = 0u; i < fs.size(); i += 3u) {
+        BOOST_CHECK_CLOSE(fs[i], 0.125, 1e-12);
+        BOOST_CHECK_CLOSE(fs[i + 1u], 0.125, 1e-12);
+        BOOST_CHECK_CLOSE(fs[i + 2u], 0.25, 1e-12);
+    }
+}
+
 BOOST_AUTO_TEST_CASE(dtlz_serialization_test)
 {
     problem p{dtlz{4u, 4u}};
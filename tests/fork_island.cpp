@@ -33,6 +33,7 @@ see https://www.gnu.org/licenses/. */
 #include <chrono>
 #include <csignal>
 #include <exception>
+#include <sstream>
 #include <stdexcept>
 #include <thread>
 #include <utility>
@@ -45,12 +46,15 @@ see https://www.gnu.org/licenses/. */
 #include <pagmo/algorithm.hpp>
 #include <pagmo/algorithms/compass_search.hpp>
 #include <pagmo/algorithms/de.hpp>
+#include <pagmo/archipelago.hpp>
 #include <pagmo/island.hpp>
 #include <pagmo/islands/fork_island.hpp>
+#include <pagmo/islands/thread_island.hpp>
 #include <pagmo/population.hpp>
 #include <pagmo/problem.hpp>
 #include <pagmo/problems/rosenbrock.hpp>
 #include <pagmo/s11n.hpp>
+#include <pagmo/topologies/ring.hpp>
 #include <pagmo/types.hpp>
 
 using namespace pagmo;
@@ -235,3 +239,124 @@ BOOST_AUTO_TEST_CASE(fork_island_torture)
         BOOST_CHECK_NO_THROW(isl.wait_check());
     }
 }
+
+// Tests for the persistent mode.
+BOOST_AUTO_TEST_CASE(fork_island_persistent)
+{
+    {
+        fork_island fi_0, fi_1(true);
+        BOOST_CHECK(!fi_0.get_persistent());
+        BOOST_CHECK(fi_1.get_persistent());
+        fork_island fi_2(fi_1), fi_3(std::move(fi_1));
+        BOOST_CHECK(fi_2.get_persistent());
+        BOOST_CHECK(fi_3.get_persistent());
+        BOOST_CHECK(boost::contains(fi_0.get_extra_info(), "Persistent child process: no"));
+        BOOST_CHECK(boost::contains(fi_2.get_extra_info(), "Persistent child process: yes"));
+    }
+    {
+        // Multiple evolutions in the same child.
+        island fi_0(fork_island{true}, compass_search{100}, rosenbrock{}, 1, 0);
+        auto old_cf = fi_0.get_population().champion_f();
+        auto old_fevals = fi_0.get_population().get_problem().get_fevals();
+        for (auto i = 0; i < 5; ++i) {
+            fi_0.evolve();
+            fi_0.wait_check();
+            const auto new_cf = fi_0.get_population().champion_f();
+            const auto new_fevals = fi_0.get_population().get_problem().get_fevals();
+            BOOST_CHECK(new_cf[0] <= old_cf[0]);
+            BOOST_CHECK(new_fevals > old_fevals);
+            old_cf = new_cf;
+            old_fevals = new_fevals;
+        }
+        // The result must match a thread island.
+        island ti_0(thread_island{}, compass_search{100}, rosenbrock{}, 1, 0);
+        for (auto i = 0; i < 5; ++i) {
+            ti_0.evolve();
+        }
+        ti_0.wait_check();
+        BOOST_CHECK(ti_0.get_population().get_x() == fi_0.get_population().get_x());
+        BOOST_CHECK(ti_0.get_population().get_f() == fi_0.get_population().get_f());
+        BOOST_CHECK(ti_0.get_population().get_ID() == fi_0.get_population().get_ID());
+        BOOST_CHECK(ti_0.get_population().get_problem().get_fevals()
+                    == fi_0.get_population().get_problem().get_fevals());
+    }
+    {
+        // The state of the algorithm is preserved.
+        island fi_0(fork_island{true}, stateful_algo{}, rosenbrock{}, 1, 0);
+        for (auto i = 0; i < 3; ++i) {
+            fi_0.evolve();
+            fi_0.wait_check();
+        }
+        BOOST_CHECK(fi_0.get_algorithm().extract<stateful_algo>()->n_evolve == 3);
+        // Replace the algorithm and the population in the parent.
+        fi_0.set_algorithm(algorithm{stateful_algo{}});
+        fi_0.set_population(population{rosenbrock{3}, 4, 1});
+        fi_0.evolve();
+        fi_0.wait_check();
+        BOOST_CHECK(fi_0.get_algorithm().extract<stateful_algo>()->n_evolve == 1);
+        BOOST_CHECK(fi_0.get_population().get_problem().get_nx() == 3u);
+        BOOST_CHECK(fi_0.get_population().size() == 4u);
+        BOOST_CHECK(fi_0.get_population().get_x() == population(rosenbrock{3}, 4, 1).get_x());
+    }
+    {
+        // Persistent islands in an archipelago, with migration.
+        archipelago archi(ring{}, 5, fork_island{true}, compass_search{100}, rosenbrock{10}, 10, 0);
+        archi.evolve(3);
+        BOOST_CHECK_NO_THROW(archi.wait_check());
+        for (const auto &isl : archi) {
+            const auto &pop = isl.get_population();
+            for (decltype(pop.size()) i = 0; i < pop.size(); ++i) {
+                BOOST_CHECK(pop.get_f()[i] == pop.get_problem().fitness(pop.get_x()[i]));
+            }
+        }
+    }
+#if !defined(__APPLE__)
+    {
+        // Error transport, and recovery after the error.
+        island fi_0(fork_island{true}, de{1}, rosenbrock{}, 1);
+        fi_0.evolve();
+        BOOST_CHECK_EXCEPTION(fi_0.wait_check(), std::runtime_error, [](const std::runtime_error &re) {
+            return boost::contains(re.what(), "needs at least 5 individuals in the population");
+        });
+        fi_0.set_algorithm(algorithm{compass_search{100}});
+        fi_0.evolve();
+        BOOST_CHECK_NO_THROW(fi_0.wait_check());
+    }
+    {
+        // Kill the persistent child during evolution.
+        island fi_0(fork_island{true}, de{200}, godot1{20}, 20);
+        fi_0.evolve();
+        pid_t child_pid;
+        while (!(child_pid = fi_0.extract<fork_island>()->get_child_pid())) {
+        }
+        kill(child_pid, SIGTERM);
+        BOOST_CHECK_EXCEPTION(fi_0.wait_check(), std::runtime_error, [](const std::runtime_error &re) {
+            return boost::contains(re.what(), "terminated unexpectedly");
+        });
+        // A new child is created at the next evolution.
+        fi_0.set_algorithm(algorithm{compass_search{100}});
+        fi_0.set_population(population{rosenbrock{}, 1, 0});
+        fi_0.evolve();
+        BOOST_CHECK_NO_THROW(fi_0.wait_check());
+    }
+#endif
+}
+
+BOOST_AUTO_TEST_CASE(fork_island_s11n)
+{
+    island fi_0(fork_island{true}, compass_search{100}, rosenbrock{}, 1, 0);
+    fi_0.evolve();
+    fi_0.wait_check();
+    std::stringstream ss;
+    {
+        boost::archive::binary_oarchive oarchive(ss);
+        oarchive << fi_0;
+    }
+    island fi_1;
+    {
+        boost::archive::binary_iarchive iarchive(ss);
+        iarchive >> fi_1;
+    }
+    BOOST_CHECK(fi_1.extract<fork_island>() != nullptr);
+    BOOST_CHECK(fi_1.extract<fork_island>()->get_persistent());
+}
@@ -30,10 +30,14 @@ see https://www.gnu.org/licenses/. */
 #define BOOST_TEST_DYN_LINK
 #include <boost/test/unit_test.hpp>
 
+#include <cmath>
 #include <limits>
 #include <stdexcept>
 
+#include <pagmo/batch_evaluators/thread_bfe.hpp>
+#include <pagmo/bfe.hpp>
 #include <pagmo/io.hpp>
+#include <pagmo/problem.hpp>
 #include <pagmo/rng.hpp>
 #include <pagmo/types.hpp>
 #include <pagmo/utils/gradients_and_hessians.hpp>
@@ -150,4 +154,73 @@ BOOST_AUTO_TEST_CASE(estimate_gradient_test)
     for (unsigned i = 0u; i < res.size(); ++i) {
         BOOST_CHECK_CLOSE(gh[i], res[i], 1e-11);
     }
-}
\ No newline at end of file
+}
+// A problem with a tridiagonal Jacobian.
+struct tridiagonal_problem {
+    vector_double fitness(const vector_double &dv) const
+    {
+        vector_double retval(dv.size());
+        for (decltype(dv.size()) i = 0; i < dv.size(); ++i) {
+            retval[i] = dv[i] * dv[i] + (i > 0u ? std::sin(dv[i - 1u]) : 0.)
+                        + (i + 1u < dv.size() ? dv[i] * dv[i + 1u] : 0.);
+        }
+        return retval;
+    }
+    std::pair<vector_double, vector_double> get_bounds() const
+    {
+        return {vector_double(20, -1.), vector_double(20, 1.)};
+    }
+    vector_double::size_type get_nobj() const
+    {
+        return 20u;
+    }
+};
+
+BOOST_AUTO_TEST_CASE(estimate_batched_test)
+{
+    const vector_double x{0.1, 0.2, 0.3, 0.4};
+    for (const auto &b : {bfe{}, bfe{thread_bfe{}}}) {
+        // The batched versions must give the same results as the callable-based ones.
+        problem prob{dummy_problem{}};
+        auto f = [&prob](const vector_double &y) { return prob.fitness(y); };
+        BOOST_CHECK(estimate_sparsity(b, prob, x) == estimate_sparsity(f, x));
+        BOOST_CHECK(estimate_gradient(b, prob, x) == estimate_gradient(f, x));
+        BOOST_CHECK(estimate_gradient_h(b, prob, x) == estimate_gradient_h(f, x));
+
+        problem prob2{dummy_problem_easy_grad{}};
+        auto f2 = [&prob2](const vector_double &y) { return prob2.fitness(y); };
+        BOOST_CHECK(estimate_gradient(b, prob2, x, 1e-6) == estimate_gradient(f2, x, 1e-6));
+        BOOST_CHECK(estimate_gradient_h(b, prob2, x, 1e-3) == estimate_gradient_h(f2, x, 1e-3));
+
+        // The fitness evaluations are counted in the problem.
+        const auto fevals0 = prob2.get_fevals();
+        estimate_gradient(b, prob2, x);
+        BOOST_CHECK_EQUAL(prob2.get_fevals(), fevals0 + 8u);
+
+        // Error handling.
+        BOOST_CHECK_THROW(estimate_gradient(b, prob, {1., 2.}), std::invalid_argument);
+        BOOST_CHECK_THROW(estimate_gradient_h(b, prob, {1., 2.}), std::invalid_argument);
+        BOOST_CHECK_THROW(estimate_sparsity(b, prob, {1., 2.}), std::invalid_argument);
+        BOOST_CHECK_THROW(estimate_gradient(b, prob, x, sparsity_pattern{{3, 0}}), std::invalid_argument);
+        BOOST_CHECK_THROW(estimate_gradient(b, prob, x, sparsity_pattern{{0, 4}}), std::invalid_argument);
+        BOOST_CHECK(estimate_gradient(b, prob, x, sparsity_pattern{}).empty());
+    }
+
+    // Sparse gradient with column grouping.
+    problem tp{tridiagonal_problem{}};
+    vector_double xt(20);
+    for (auto i = 0u; i < 20u; ++i) {
+        xt[i] = (i + 1u) / 20.;
+    }
+    const auto sp = estimate_sparsity(bfe{}, tp, xt);
+    BOOST_CHECK_EQUAL(sp.size(), 58u);
+    const auto dense = estimate_gradient(bfe{}, tp, xt);
+    const auto fevals0 = tp.get_fevals();
+    const auto sparse = estimate_gradient(bfe{}, tp, xt, sp);
+    // A tridiagonal Jacobian requires three groups of columns.
+    BOOST_CHECK_EQUAL(tp.get_fevals(), fevals0 + 6u);
+    BOOST_CHECK_EQUAL(sparse.size(), sp.size());
+    for (decltype(sp.size()) k = 0; k < sp.size(); ++k) {
+        BOOST_CHECK_CLOSE(sparse[k], dense[sp[k].first * 20u + sp[k].second], 1e-10);
+    }
+}
@@ -34,7 +34,9 @@ see https://www.gnu.org/licenses/. */
 #include <iostream>
 #include <stdexcept>
 #include <string>
+#include <vector>
 
+#include <pagmo/batch_evaluators/default_bfe.hpp>
 #include <pagmo/problem.hpp>
 #include <pagmo/problems/griewank.hpp>
 #include <pagmo/types.hpp>
@@ -63,6 +65,24 @@ BOOST_AUTO_TEST_CASE(griewank_test)
     BOOST_CHECK((x_best == vector_double{0., 0., 0.}));
 }
 
+BOOST_AUTO_TEST_CASE(griewank_batch_fitness_test)
+{
+    // x3 followed by the global minimum, where the
+    // sum of squares and the product of cosines cancel out exactly.
+    griewank gri3{3u};
+    const auto fs = gri3.batch_fitness({-23.45, 12.34, 111.12, 0., 0., 0.});
+    BOOST_CHECK(fs.size() == 2u);
+    BOOST_CHECK_CLOSE(fs[0], 4.241511427781268, 1e-13);
+    BOOST_CHECK(fs[1] == 0.);
+    // The one-dimensional problem, over many copies of x1.
+    griewank gri1{1u};
+    const vector_double xs(1000u, 1.12);
+    for (auto f : gri1.batch_fitness(xs)) {
+        BOOST_CHECK_CLOSE(f, 0.5646311537232878, 1e-13);
+    }
+    BOOST_CHECK(default_bfe{}(problem{gri1}, xs) == gri1.batch_fitness(xs));
+}
+
 BOOST_AUTO_TEST_CASE(griewank_serialization_test)
 {
     problem p{griewank{4u}};
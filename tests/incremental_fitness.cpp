@@ -0,0 +1,123 @@
+/* Copyright 2017-2021 PaGMO development team
+
+This file is part of the PaGMO library.
+
+The PaGMO library is free software; you can redistribute it and/or modify
+it under the terms of either:
+
+  * the GNU Lesser General Public License as published by the Free
+    Software Foundation; either version 3 of the License, or (at your
+    option) any later version.
+
+or
+
+  * the GNU General Public License as published by the Free Software
+    Foundation; either version 3 of the License, or (at your option) any
+    later version.
+
+or both in parallel, as here.
+
+The PaGMO library is distributed in the hope that it will be useful, but
+WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+for more details.
+
+You should have received copies of the GNU General Public License and the
+GNU Lesser General Public License along with the PaGMO library.  If not,
+see https://www.gnu.org/licenses/. */
+
+#define BOOST_TEST_MODULE incremental_fitness_test
+#define BOOST_TEST_DYN_LINK
+#include <boost/test/unit_test.hpp>
+
+#include <boost/test/tools/floating_point_comparison.hpp>
+
+#include <initializer_list>
+#include <random>
+#include <vector>
+
+#include <pagmo/problem.hpp>
+#include <pagmo/problems/lennard_jones.hpp>
+#include <pagmo/problems/rastrigin.hpp>
+#include <pagmo/problems/rosenbrock.hpp>
+#include <pagmo/types.hpp>
+
+using namespace pagmo;
+
+// Run a chain of moves of one or more components on p, starting from x.
+// The new value of the j-th component is computed by gen(j). The fitness updated
+// incrementally at each move is checked against the fitness computed from scratch.
+template <typename Gen>
+void check_chain(const problem &p, vector_double x, const Gen &gen, double tol)
+{
+    BOOST_CHECK(p.has_incremental_fitness());
+    const auto nx = p.get_nx();
+    auto f = p.fitness(x);
+    for (auto i = 0u; i < 100u; ++i) {
+        auto x_new = x;
+        // NOTE: the indices passed to incremental_fitness() may
+        // be unsorted and contain duplicates.
+        std::vector<vector_double::size_type> idx{i % nx};
+        if (i % 3u == 0u) {
+            idx.push_back((i * 7u) % nx);
+            idx.push_back(nx - 1u);
+            idx.push_back(0u);
+        }
+        for (auto j : idx) {
+            x_new[j] = gen(j);
+        }
+        f = p.incremental_fitness(x_new, x, f, idx);
+        x = x_new;
+        BOOST_CHECK_CLOSE(f[0], p.fitness(x)[0], tol);
+    }
+}
+
+BOOST_AUTO_TEST_CASE(rosenbrock_chain_test)
+{
+    std::mt19937 eng(42u);
+    std::uniform_real_distribution<double> dist(-5., 10.);
+    auto gen = [&eng, &dist](vector_double::size_type) { return dist(eng); };
+    for (auto dim : {2u, 3u, 10u}) {
+        vector_double x(dim);
+        for (auto &c : x) {
+            c = dist(eng);
+        }
+        check_chain(problem{rosenbrock{dim}}, x, gen, 1e-6);
+    }
+}
+
+BOOST_AUTO_TEST_CASE(rastrigin_chain_test)
+{
+    std::mt19937 eng(42u);
+    std::uniform_real_distribution<double> dist(-5.12, 5.12);
+    auto gen = [&eng, &dist](vector_double::size_type) { return dist(eng); };
+    for (auto dim : {1u, 2u, 10u}) {
+        vector_double x(dim);
+        for (auto &c : x) {
+            c = dist(eng);
+        }
+        check_chain(problem{rastrigin{dim}}, x, gen, 1e-8);
+    }
+}
+
+BOOST_AUTO_TEST_CASE(lennard_jones_chain_test)
+{
+    std::mt19937 eng(42u);
+    std::uniform_real_distribution<double> dist(-.2, .2);
+    // NOTE: the atoms are kept close to the points of a grid, so that
+    // the pair potentials (and the rounding errors) stay small.
+    auto gen = [&eng, &dist](vector_double::size_type k) {
+        const auto atom = k == 0u ? 1u : (k < 3u ? 2u : k / 3u + 2u);
+        const auto coord = k == 0u ? 2u : (k < 3u ? k : k % 3u);
+        const vector_double::size_type g[] = {atom / 9u, (atom / 3u) % 3u, atom % 3u};
+        return 1.2 * static_cast<double>(g[coord]) + dist(eng);
+    };
+    for (auto atoms : {3u, 4u, 20u}) {
+        const problem p{lennard_jones{atoms}};
+        vector_double x(p.get_nx());
+        for (decltype(x.size()) k = 0; k < x.size(); ++k) {
+            x[k] = gen(k);
+        }
+        check_chain(p, x, gen, 1e-8);
+    }
+}
@@ -0,0 +1,251 @@
+/* Copyright 2017-2021 PaGMO development team
+
+This file is part of the PaGMO library.
+
+The PaGMO library is free software; you can redistribute it and/or modify
+it under the terms of either:
+
+  * the GNU Lesser General Public License as published by the Free
+    Software Foundation; either version 3 of the License, or (at your
+    option) any later version.
+
+or
+
+  * the GNU General Public License as published by the Free Software
+    Foundation; either version 3 of the License, or (at your option) any
+    later version.
+
+or both in parallel, as here.
+
+The PaGMO library is distributed in the hope that it will be useful, but
+WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+for more details.
+
+You should have received copies of the GNU General Public License and the
+GNU Lesser General Public License along with the PaGMO library.  If not,
+see https://www.gnu.org/licenses/. */
+
+#define BOOST_TEST_MODULE incremental_hypervolume_test
+#define BOOST_TEST_DYN_LINK
+#include <boost/test/unit_test.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <random>
+#include <sstream>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+#include <pagmo/s11n.hpp>
+#include <pagmo/types.hpp>
+#include <pagmo/utils/hv_algos/hv_hvwfg.hpp>
+#include <pagmo/utils/hypervolume.hpp>
+#include <pagmo/utils/incremental_hypervolume.hpp>
+
+using namespace pagmo;
+
+// Check the state of an incremental hypervolume against
+// a full recomputation.
+void check_against_full(const incremental_hypervolume &ihv)
+{
+    const auto &points = ihv.get_points();
+    const auto &ref = ihv.get_refpoint();
+    const auto c = ihv.contributions();
+    BOOST_CHECK_EQUAL(c.size(), points.size());
+
+    if (points.empty()) {
+        BOOST_CHECK_EQUAL(ihv.compute(), 0.);
+        return;
+    }
+
+    hypervolume hv(points);
+    // NOTE: use hvwfg, which handles dominated and duplicate points natively.
+    hvwfg algo;
+    const auto c_full = hv.contributions(ref, algo);
+    const auto tol = 1E-8 * (1. + hv.compute(ref));
+    BOOST_CHECK(std::abs(ihv.compute() - hv.compute(ref)) <= tol);
+    for (decltype(c.size()) i = 0; i < c.size(); ++i) {
+        BOOST_CHECK(std::abs(c[i] - c_full[i]) <= tol);
+        BOOST_CHECK_EQUAL(ihv.exclusive(i), c[i]);
+    }
+
+    const auto least = ihv.least_contributor();
+    const auto greatest = ihv.greatest_contributor();
+    BOOST_CHECK_EQUAL(c[least], *std::min_element(c.begin(), c.end()));
+    BOOST_CHECK_EQUAL(c[greatest], *std::max_element(c.begin(), c.end()));
+    using size_type = incremental_hypervolume::size_type;
+    BOOST_CHECK(least == static_cast<size_type>(std::min_element(c.begin(), c.end()) - c.begin()));
+    BOOST_CHECK(greatest == static_cast<size_type>(std::max_element(c.begin(), c.end()) - c.begin()));
+}
+
+// Random point on a coarse grid, so that duplicates
+// and ties in the coordinates are frequent.
+vector_double random_point(std::mt19937 &eng, unsigned dim, bool coarse)
+{
+    std::uniform_int_distribution<int> idist(0, 7);
+    std::uniform_real_distribution<double> rdist(0., 8.);
+    vector_double retval(dim);
+    for (auto &x : retval) {
+        x = coarse ? static_cast<double>(idist(eng)) : rdist(eng);
+    }
+    return retval;
+}
+
+BOOST_AUTO_TEST_CASE(incremental_hypervolume_construction_test)
+{
+    incremental_hypervolume ihv0;
+    BOOST_CHECK_EQUAL(ihv0.size(), 0u);
+    BOOST_CHECK((ihv0.get_refpoint() == vector_double{0., 0.}));
+    BOOST_CHECK_EQUAL(ihv0.compute(), 0.);
+    BOOST_CHECK(ihv0.contributions().empty());
+
+    incremental_hypervolume ihv1({{1., 2.}, {2., 1.}}, {3., 3.});
+    BOOST_CHECK_EQUAL(ihv1.size(), 2u);
+    BOOST_CHECK_EQUAL(ihv1.compute(), 3.);
+    BOOST_CHECK((ihv1.contributions() == std::vector<double>{1., 1.}));
+
+    incremental_hypervolume ihv2({{1., 1., 1.}}, {2., 2., 2.});
+    BOOST_CHECK_EQUAL(ihv2.compute(), 1.);
+    BOOST_CHECK_EQUAL(ihv2.exclusive(0), 1.);
+
+    const auto nan = std::numeric_limits<double>::quiet_NaN();
+    BOOST_CHECK_THROW(incremental_hypervolume{vector_double{1.}}, std::invalid_argument);
+    BOOST_CHECK_THROW((incremental_hypervolume{vector_double{1., 1., 1., 1.}}), std::invalid_argument);
+    BOOST_CHECK_THROW((incremental_hypervolume{vector_double{1., nan}}), std::invalid_argument);
+    BOOST_CHECK_THROW(ihv1.insert({1., 1., 1.}), std::invalid_argument);
+    BOOST_CHECK_THROW(ihv1.insert({1., nan}), std::invalid_argument);
+    BOOST_CHECK_THROW(ihv1.insert({1., 4.}), std::invalid_argument);
+    BOOST_CHECK_THROW(ihv1.insert({3., 3.}), std::invalid_argument);
+    BOOST_CHECK_THROW(ihv1.erase(2), std::invalid_argument);
+    BOOST_CHECK_THROW(ihv1.exclusive(2), std::invalid_argument);
+    BOOST_CHECK_THROW(ihv0.least_contributor(), std::invalid_argument);
+    BOOST_CHECK_THROW(ihv0.greatest_contributor(), std::invalid_argument);
+    BOOST_CHECK_EQUAL(ihv1.size(), 2u);
+}
+
+BOOST_AUTO_TEST_CASE(incremental_hypervolume_2d_test)
+{
+    incremental_hypervolume ihv({5., 5.});
+
+    // Points on the boundary, dominated points and duplicates.
+    ihv.insert({1., 3.});
+    ihv.insert({3., 1.});
+    check_against_full(ihv);
+    ihv.insert({2., 4.});
+    BOOST_CHECK_EQUAL(ihv.exclusive(2), 0.);
+    ihv.insert({1., 3.});
+    BOOST_CHECK_EQUAL(ihv.exclusive(0), 0.);
+    BOOST_CHECK_EQUAL(ihv.exclusive(3), 0.);
+    check_against_full(ihv);
+    ihv.insert({5., 0.});
+    check_against_full(ihv);
+    // Removing a duplicate restores the contribution of the other copy.
+    ihv.erase(0);
+    BOOST_CHECK_EQUAL(ihv.get_points().size(), 4u);
+    BOOST_CHECK((ihv.get_points()[0] == vector_double{5., 0.}));
+    check_against_full(ihv);
+    BOOST_CHECK(ihv.exclusive(3) > 0.);
+    // Removing a front point promotes the point it dominated.
+    ihv.erase(3);
+    check_against_full(ihv);
+    BOOST_CHECK(ihv.exclusive(2) > 0.);
+
+    std::mt19937 eng(42u);
+    for (auto coarse : {true, false}) {
+        ihv = incremental_hypervolume({8., 8.});
+        for (auto i = 0; i < 200; ++i) {
+            std::uniform_int_distribution<int> op(0, 2);
+            if (ihv.size() == 0u || op(eng) != 0) {
+                ihv.insert(random_point(eng, 2u, coarse));
+            } else {
+                std::uniform_int_distribution<incremental_hypervolume::size_type> idx(0, ihv.size() - 1u);
+                ihv.erase(idx(eng));
+            }
+            check_against_full(ihv);
+        }
+        // Remove the least contributors one at a time.
+        while (ihv.size() != 0u) {
+            ihv.erase(ihv.least_contributor());
+            check_against_full(ihv);
+        }
+    }
+}
+
+BOOST_AUTO_TEST_CASE(incremental_hypervolume_3d_test)
+{
+    incremental_hypervolume ihv({5., 5., 5.});
+    ihv.insert({1., 1., 1.});
+    ihv.insert({1., 1., 1.});
+    ihv.insert({2., 2., 2.});
+    ihv.insert({0., 4., 4.});
+    check_against_full(ihv);
+    BOOST_CHECK_EQUAL(ihv.exclusive(0), 0.);
+    BOOST_CHECK_EQUAL(ihv.exclusive(2), 0.);
+    ihv.erase(0);
+    check_against_full(ihv);
+
+    std::mt19937 eng(42u);
+    for (auto coarse : {true, false}) {
+        ihv = incremental_hypervolume({8., 8., 8.});
+        for (auto i = 0; i < 100; ++i) {
+            std::uniform_int_distribution<int> op(0, 2);
+            if (ihv.size() == 0u || op(eng) != 0) {
+                ihv.insert(random_point(eng, 3u, coarse));
+            } else {
+                std::uniform_int_distribution<incremental_hypervolume::size_type> idx(0, ihv.size() - 1u);
+                ihv.erase(idx(eng));
+            }
+            check_against_full(ihv);
+        }
+        while (ihv.size() != 0u) {
+            ihv.erase(ihv.least_contributor());
+            check_against_full(ihv);
+        }
+    }
+}
+
+BOOST_AUTO_TEST_CASE(incremental_hypervolume_copy_s11n_test)
+{
+    std::mt19937 eng(0u);
+    for (auto dim : {2u, 3u}) {
+        incremental_hypervolume ihv(vector_double(dim, 8.));
+        for (auto i = 0; i < 50; ++i) {
+            ihv.insert(random_point(eng, dim, true));
+        }
+
+        auto ihv2(ihv);
+        BOOST_CHECK(ihv2.get_points() == ihv.get_points());
+        BOOST_CHECK(ihv2.contributions() == ihv.contributions());
+        ihv2.erase(ihv2.least_contributor());
+        check_against_full(ihv2);
+        check_against_full(ihv);
+
+        incremental_hypervolume ihv3;
+        ihv3 = ihv;
+        BOOST_CHECK(ihv3.get_points() == ihv.get_points());
+        auto ihv4(std::move(ihv3));
+        ihv4.insert(vector_double(dim, 0.5));
+        check_against_full(ihv4);
+        ihv3 = std::move(ihv4);
+        BOOST_CHECK_EQUAL(ihv3.size(), 51u);
+        check_against_full(ihv3);
+
+        std::stringstream ss;
+        {
+            boost::archive::binary_oarchive oarchive(ss);
+            oarchive << ihv;
+        }
+        incremental_hypervolume ihv5;
+        {
+            boost::archive::binary_iarchive iarchive(ss);
+            iarchive >> ihv5;
+        }
+        BOOST_CHECK(ihv5.get_points() == ihv.get_points());
+        BOOST_CHECK(ihv5.get_refpoint() == ihv.get_refpoint());
+        BOOST_CHECK(ihv5.contributions() == ihv.contributions());
+        BOOST_CHECK_EQUAL(ihv5.compute(), ihv.compute());
+    }
+}
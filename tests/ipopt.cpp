@@ -96,6 +96,26 @@ BOOST_AUTO_TEST_CASE(ipopt_evolve_test_01)
     BOOST_CHECK(!algo.extract<ipopt>()->get_log().empty());
 }
 
+BOOST_AUTO_TEST_CASE(ipopt_reuse_test)
+{
+    ipopt ip;
+    BOOST_CHECK_EQUAL(ip.get_last_fitness_reuses(), 0u);
+    BOOST_CHECK_EQUAL(ip.get_last_gradient_reuses(), 0u);
+    population pop(hock_schittkowski_71{}, 1, 42u);
+    ip.evolve(pop);
+    BOOST_CHECK_EQUAL(Ipopt::Solve_Succeeded, ip.get_last_opt_result());
+    // In a constrained problem, the objective and the constraints
+    // (and their derivatives) are requested at the same points.
+    const auto f_reuses = ip.get_last_fitness_reuses();
+    const auto g_reuses = ip.get_last_gradient_reuses();
+    BOOST_CHECK(f_reuses > 0u);
+    BOOST_CHECK(g_reuses > 0u);
+    // The counters refer to the last optimisation only.
+    ip.evolve(pop);
+    BOOST_CHECK_EQUAL(ip.get_last_fitness_reuses(), f_reuses);
+    BOOST_CHECK_EQUAL(ip.get_last_gradient_reuses(), g_reuses);
+}
+
 // Empty pop.
 BOOST_AUTO_TEST_CASE(ipopt_evolve_test_02)
 {
@@ -307,6 +327,25 @@ BOOST_AUTO_TEST_CASE(ipopt_serialization)
             BOOST_CHECK(s_log == algo.extract<ipopt>()->get_log());
         }
     }
+    // The reuse counters are serialised.
+    {
+        ipopt ip;
+        auto pop = population(hock_schittkowski_71{}, 1);
+        ip.evolve(pop);
+        algorithm algo{ip};
+        std::stringstream ss;
+        {
+            boost::archive::binary_oarchive oarchive(ss);
+            oarchive << algo;
+        }
+        algo = algorithm{};
+        {
+            boost::archive::binary_iarchive iarchive(ss);
+            iarchive >> algo;
+        }
+        BOOST_CHECK_EQUAL(algo.extract<ipopt>()->get_last_fitness_reuses(), ip.get_last_fitness_reuses());
+        BOOST_CHECK_EQUAL(algo.extract<ipopt>()->get_last_gradient_reuses(), ip.get_last_gradient_reuses());
+    }
 }
 
 BOOST_AUTO_TEST_CASE(ipopt_options)
@@ -661,3 +661,106 @@ BOOST_AUTO_TEST_CASE(get_ptr)
     BOOST_CHECK(p0.get_ptr() == p0.extract<udi_01a>());
     BOOST_CHECK(static_cast<const island &>(p0).get_ptr() == static_cast<const island &>(p0).extract<udi_01a>());
 }
+
+BOOST_AUTO_TEST_CASE(island_pool_backend)
+{
+    BOOST_CHECK(get_island_backend() == island_backend::thread);
+    BOOST_CHECK(boost::lexical_cast<std::string>(island_backend::thread) == "thread");
+    BOOST_CHECK(boost::lexical_cast<std::string>(island_backend::pool) == "pool");
+
+    set_island_backend(island_backend::pool);
+    BOOST_CHECK(get_island_backend() == island_backend::pool);
+
+    // Many islands, several evolve() calls each. Check that
+    // the tasks of each island are all executed.
+    std::vector<island> isls;
+    for (auto i = 0; i < 100; ++i) {
+        isls.emplace_back(thread_island{}, stateful_algo{}, null_problem{}, 5);
+    }
+    for (auto &isl : isls) {
+        for (auto i = 0; i < 5; ++i) {
+            isl.evolve(2);
+        }
+    }
+    for (auto &isl : isls) {
+        isl.wait_check();
+        BOOST_CHECK(isl.status() == evolve_status::idle);
+        BOOST_CHECK(isl.get_algorithm().extract<stateful_algo>()->n_evolve == 10);
+    }
+
+    // Busy status.
+    flag.store(true);
+    island isl{de{}, population{prob_01{}, 25}};
+    flag.store(false);
+    isl.evolve();
+    BOOST_CHECK(isl.status() == evolve_status::busy);
+    flag.store(true);
+    isl.wait();
+    BOOST_CHECK(isl.status() == evolve_status::idle);
+
+    // Error handling.
+    isl = island{de{}, population{rosenbrock{}, 3}};
+    isl.evolve();
+    isl.evolve();
+    isl.wait();
+    BOOST_CHECK(isl.status() == evolve_status::idle_error);
+    BOOST_CHECK_THROW(isl.wait_check(), std::invalid_argument);
+    BOOST_CHECK(isl.status() == evolve_status::idle);
+
+    // Copy/move operations with a few tasks queued.
+    isl = island{de{}, population{rosenbrock{}, 25}};
+    for (auto i = 0; i < 10; ++i) {
+        isl.evolve(20);
+    }
+    auto isl2(isl);
+    auto isl3(std::move(isl));
+    isl2.evolve(5);
+    isl2.wait_check();
+    isl3.wait_check();
+
+    // Islands constructed before switching back keep
+    // on using the pool.
+    set_island_backend(island_backend::thread);
+    BOOST_CHECK(get_island_backend() == island_backend::thread);
+    isl2.evolve(5);
+    isl2.wait_check();
+}
+
+BOOST_AUTO_TEST_CASE(island_champion_getters)
+{
+    island isl{de{}, rosenbrock{}, 20u};
+    BOOST_CHECK(isl.get_champion_x() == isl.get_population().champion_x());
+    BOOST_CHECK(isl.get_champion_f() == isl.get_population().champion_f());
+
+    // The champion is updated at the end of the evolution.
+    const auto f0 = isl.get_champion_f();
+    isl.evolve(10);
+    isl.wait_check();
+    BOOST_CHECK(isl.get_champion_x() == isl.get_population().champion_x());
+    BOOST_CHECK(isl.get_champion_f() == isl.get_population().champion_f());
+    BOOST_CHECK(isl.get_champion_f()[0] <= f0[0]);
+
+    // And when the population is set.
+    population pop{rosenbrock{5}, 10u};
+    isl.set_population(pop);
+    BOOST_CHECK(isl.get_champion_x() == pop.champion_x());
+    BOOST_CHECK(isl.get_champion_f() == pop.champion_f());
+
+    // Same throwing semantics as the population getters.
+    isl = island{de{}, zdt{}, 20u};
+    BOOST_CHECK_THROW(isl.get_champion_x(), std::invalid_argument);
+    BOOST_CHECK_THROW(isl.get_champion_f(), std::invalid_argument);
+    isl = island{de{}, inventory{}, 20u};
+    BOOST_CHECK_THROW(isl.get_champion_x(), std::invalid_argument);
+    BOOST_CHECK_THROW(isl.get_champion_f(), std::invalid_argument);
+
+    // Polling while evolving.
+    flag.store(true);
+    isl = island{de{}, population{prob_01{}, 25}};
+    flag.store(false);
+    isl.evolve();
+    BOOST_CHECK(isl.get_champion_x().size() == 1u);
+    BOOST_CHECK(isl.get_champion_f().size() == 1u);
+    flag.store(true);
+    isl.wait();
+}
@@ -31,6 +31,8 @@ see https://www.gnu.org/licenses/. */
 #include <boost/test/unit_test.hpp>
 
 #include <boost/lexical_cast.hpp>
+#include <cmath>
+#include <initializer_list>
 #include <iostream>
 #include <limits>
 #include <stdexcept>
@@ -64,6 +66,16 @@ BOOST_AUTO_TEST_CASE(lennard_jones_test)
     BOOST_CHECK(lj.get_name().find("Jones") != std::string::npos);
 }
 
+BOOST_AUTO_TEST_CASE(lennard_jones_incremental_fitness_test)
+{
+    // Overlapping atoms: the fitness is computed from scratch.
+    lennard_jones lj{3u};
+    const vector_double x_old = {1.12, -0.33, 2.34}, x = {1.12, 0., 1.12};
+    BOOST_CHECK(lj.incremental_fitness(x, x_old, lj.fitness(x_old), {1, 2}) == lj.fitness(x));
+    BOOST_CHECK(!std::isfinite(lj.fitness(x)[0]));
+    BOOST_CHECK(lj.incremental_fitness(x_old, x, lj.fitness(x), {1, 2}) == lj.fitness(x_old));
+}
+
 BOOST_AUTO_TEST_CASE(lennard_jones_serialization_test)
 {
     problem p{lennard_jones{30u}};
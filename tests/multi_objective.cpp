@@ -30,6 +30,8 @@ see https://www.gnu.org/licenses/. */
 #define BOOST_TEST_DYN_LINK
 #include <boost/test/unit_test.hpp>
 
+#include <algorithm>
+#include <limits>
 #include <numeric>
 #include <random>
 #include <stdexcept>
@@ -144,6 +146,56 @@ BOOST_AUTO_TEST_CASE(fast_non_dominated_sorting_test)
     BOOST_CHECK_THROW(fast_non_dominated_sorting(example), std::invalid_argument);
 }
 
+BOOST_AUTO_TEST_CASE(fast_non_dominated_fronts_test)
+{
+    // Small inputs: same result as fast_non_dominated_sorting().
+    std::vector<vector_double> example = {{0, 7}, {1, 5}, {2, 3}, {4, 2}, {7, 1}, {10, 0}, {2, 6}, {4, 4}, {10, 2},
+                                          {6, 6}, {9, 15}};
+    auto fnds = fast_non_dominated_sorting(example);
+    auto fndf = fast_non_dominated_fronts(example);
+    BOOST_CHECK(fndf.first == std::get<0>(fnds));
+    BOOST_CHECK(fndf.second == std::get<3>(fnds));
+
+    // Large inputs: compare the ranks and the content of the fronts
+    // with fast_non_dominated_sorting().
+    std::mt19937 rng(42u);
+    std::uniform_int_distribution<int> small_int(0, 20);
+    std::uniform_real_distribution<double> real(0., 1.);
+    for (auto M : {1u, 2u, 3u, 5u}) {
+        for (auto discrete : {false, true}) {
+            std::vector<vector_double> points(1500u, vector_double(M));
+            for (auto &p : points) {
+                for (auto &v : p) {
+                    // NOTE: with small integers there will be
+                    // plenty of ties and duplicates.
+                    v = discrete ? small_int(rng) : real(rng);
+                }
+            }
+            // Add a few NaNs and duplicates.
+            points[10][0] = std::numeric_limits<double>::quiet_NaN();
+            points[20] = points[10];
+            points[30] = points[40];
+
+            fnds = fast_non_dominated_sorting(points);
+            fndf = fast_non_dominated_fronts(points);
+            BOOST_CHECK(fndf.second == std::get<3>(fnds));
+            BOOST_CHECK_EQUAL(fndf.first.size(), std::get<0>(fnds).size());
+            for (decltype(fndf.first.size()) i = 0; i < fndf.first.size(); ++i) {
+                auto front = std::get<0>(fnds)[i];
+                std::sort(front.begin(), front.end());
+                BOOST_CHECK(fndf.first[i] == front);
+            }
+        }
+    }
+
+    // Error handling.
+    BOOST_CHECK_THROW(fast_non_dominated_fronts({{1, 2}}), std::invalid_argument);
+    BOOST_CHECK_THROW(fast_non_dominated_fronts({}), std::invalid_argument);
+    std::vector<vector_double> bad(1500u, vector_double{1., 2.});
+    bad.back() = {1., 2., 3.};
+    BOOST_CHECK_THROW(fast_non_dominated_fronts(bad), std::invalid_argument);
+}
+
 BOOST_AUTO_TEST_CASE(crowding_distance_test)
 {
     std::vector<vector_double> example;
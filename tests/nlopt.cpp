@@ -269,6 +269,44 @@ BOOST_AUTO_TEST_CASE(nlopt_set_sc)
     a.set_maxtime(123);
 }
 
+BOOST_AUTO_TEST_CASE(nlopt_reuse)
+{
+    nlopt n{"slsqp"};
+    BOOST_CHECK_EQUAL(n.get_last_fitness_reuses(), 0u);
+    BOOST_CHECK_EQUAL(n.get_last_gradient_reuses(), 0u);
+    population pop{hs71{}, 1, 42u};
+    pop.get_problem().set_c_tol({1E-6, 1E-6});
+    n.evolve(pop);
+    BOOST_CHECK(n.get_last_opt_result() >= 0);
+    // NLopt invokes separately the objective function and the equality
+    // and inequality constraints (with their gradients) at the same points.
+    const auto f_reuses = n.get_last_fitness_reuses();
+    const auto g_reuses = n.get_last_gradient_reuses();
+    BOOST_CHECK(f_reuses > 0u);
+    BOOST_CHECK(g_reuses > 0u);
+    // The counters refer to the last optimisation only.
+    n.evolve(pop);
+    BOOST_CHECK_EQUAL(n.get_last_fitness_reuses(), f_reuses);
+    BOOST_CHECK_EQUAL(n.get_last_gradient_reuses(), g_reuses);
+    // Copy and serialisation.
+    auto n2(n);
+    BOOST_CHECK_EQUAL(n2.get_last_fitness_reuses(), f_reuses);
+    BOOST_CHECK_EQUAL(n2.get_last_gradient_reuses(), g_reuses);
+    algorithm algo{n};
+    std::stringstream ss;
+    {
+        boost::archive::binary_oarchive oarchive(ss);
+        oarchive << algo;
+    }
+    algo = algorithm{};
+    {
+        boost::archive::binary_iarchive iarchive(ss);
+        iarchive >> algo;
+    }
+    BOOST_CHECK_EQUAL(algo.extract<nlopt>()->get_last_fitness_reuses(), f_reuses);
+    BOOST_CHECK_EQUAL(algo.extract<nlopt>()->get_last_gradient_reuses(), g_reuses);
+}
+
 BOOST_AUTO_TEST_CASE(nlopt_serialization)
 {
     for (auto r : {"best", "worst", "random"}) {
@@ -30,6 +30,7 @@ see https://www.gnu.org/licenses/. */
 #define BOOST_TEST_DYN_LINK
 #include <boost/test/unit_test.hpp>
 
+#include <atomic>
 #include <cmath>
 #include <initializer_list>
 #include <iostream>
@@ -51,8 +52,11 @@ see https://www.gnu.org/licenses/. */
 #include <pagmo/problems/rosenbrock.hpp>
 #include <pagmo/problems/zdt.hpp>
 #include <pagmo/s11n.hpp>
+#include <pagmo/threading.hpp>
 #include <pagmo/types.hpp>
 
+#include "conc_prob.hpp"
+
 using namespace pagmo;
 
 static inline std::string pop_to_string(const population &pop)
@@ -462,3 +466,47 @@ BOOST_AUTO_TEST_CASE(population_nan_champion)
     pop0.push_back({std::numeric_limits<double>::quiet_NaN(), std::numeric_limits<double>::quiet_NaN()});
     BOOST_CHECK(!std::isnan(pop0.champion_f()[0]));
 }
+
+BOOST_AUTO_TEST_CASE(population_parallel_init_test)
+{
+    BOOST_CHECK(!get_population_parallel_init());
+
+    const population pop_seq{rosenbrock{10u}, 1000u, 42u};
+
+    set_population_parallel_init(true);
+    BOOST_CHECK(get_population_parallel_init());
+
+    // The parallel initialisation must produce
+    // the same population as the sequential one.
+    const population pop_par{rosenbrock{10u}, 1000u, 42u};
+    BOOST_CHECK(pop_par.size() == 1000u);
+    BOOST_CHECK(pop_par.get_problem().get_fevals() == 1000u);
+    BOOST_CHECK(pop_par.get_x() == pop_seq.get_x());
+    BOOST_CHECK(pop_par.get_f() == pop_seq.get_f());
+    BOOST_CHECK(pop_par.get_ID() == pop_seq.get_ID());
+    BOOST_CHECK(pop_par.champion_x() == pop_seq.champion_x());
+    BOOST_CHECK(pop_par.champion_f() == pop_seq.champion_f());
+
+    // Small and empty populations.
+    BOOST_CHECK(population(rosenbrock{10u}, 0u, 42u).size() == 0u);
+    BOOST_CHECK(population(rosenbrock{10u}, 1u, 42u).get_x()[0] == pop_seq.get_x()[0]);
+
+    // Problems without thread safety guarantees are evaluated sequentially.
+    conc_prob cp;
+    cp.dim = 2;
+    cp.ts = thread_safety::none;
+    conc_prob::max_active.store(0);
+    const population pop_none{cp, 1000u, 43u};
+    BOOST_CHECK(pop_none.size() == 1000u);
+    BOOST_CHECK(pop_none.get_problem().get_fevals() == 1000u);
+    BOOST_CHECK(conc_prob::max_active.load() == 1);
+
+    cp.ts = thread_safety::basic;
+    const population pop_basic{cp, 1000u, 43u};
+    BOOST_CHECK(pop_basic.get_problem().get_fevals() == 1000u);
+    BOOST_CHECK(pop_basic.get_x() == pop_none.get_x());
+    BOOST_CHECK(pop_basic.get_f() == pop_none.get_f());
+
+    set_population_parallel_init(false);
+    BOOST_CHECK(!get_population_parallel_init());
+}
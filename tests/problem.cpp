@@ -30,6 +30,7 @@ see https://www.gnu.org/licenses/. */
 #define BOOST_TEST_DYN_LINK
 #include <boost/test/unit_test.hpp>
 
+#include <algorithm>
 #include <initializer_list>
 #include <limits>
 #include <sstream>
@@ -1376,6 +1377,228 @@ struct bf_s11n {
 
 PAGMO_S11N_PROBLEM_EXPORT(bf_s11n)
 
+BOOST_AUTO_TEST_CASE(fitness_into)
+{
+    // A problem with no fitness_into().
+    problem p;
+    BOOST_CHECK(!has_fitness_into<null_problem>::value);
+    BOOST_CHECK(!p.has_fitness_into());
+    vector_double fv(1u, -1.);
+    const vector_double dv{.1};
+    p.fitness_into(dv.data(), fv.data());
+    BOOST_CHECK(fv == p.fitness(dv));
+    BOOST_CHECK_EQUAL(p.get_fevals(), 2u);
+
+    // A UDP which provides fitness_into().
+    struct fi0 {
+        vector_double fitness(const vector_double &) const
+        {
+            return {0};
+        }
+        void fitness_into(const double *dv, double *fv) const
+        {
+            fv[0] = dv[0] + 1.;
+        }
+        std::pair<vector_double, vector_double> get_bounds() const
+        {
+            return {{0}, {1}};
+        }
+    };
+    p = problem{fi0{}};
+    BOOST_CHECK(has_fitness_into<fi0>::value);
+    BOOST_CHECK(p.has_fitness_into());
+    const double x = 1.;
+    double y = 0.;
+    p.fitness_into(&x, &y);
+    BOOST_CHECK_EQUAL(y, 2.);
+    BOOST_CHECK_EQUAL(p.get_fevals(), 1u);
+
+    // Wrong signature.
+    struct fi1 {
+        vector_double fitness(const vector_double &) const
+        {
+            return {0};
+        }
+        void fitness_into(const double *, double *)
+        {
+        }
+        std::pair<vector_double, vector_double> get_bounds() const
+        {
+            return {{0}, {1}};
+        }
+    };
+    BOOST_CHECK(!has_fitness_into<fi1>::value);
+    BOOST_CHECK(!problem{fi1{}}.has_fitness_into());
+
+    // A UDP which does not provide fitness_into() and
+    // returns a fitness vector of the wrong size.
+    struct fi2 {
+        vector_double fitness(const vector_double &) const
+        {
+            return {0, 0};
+        }
+        std::pair<vector_double, vector_double> get_bounds() const
+        {
+            return {{0}, {1}};
+        }
+    };
+    p = problem{fi2{}};
+    BOOST_CHECK_THROW(p.fitness_into(&x, &y), std::invalid_argument);
+    BOOST_CHECK_EQUAL(p.get_fevals(), 0u);
+
+    // A UDP which provides fitness_into() and overrides
+    // its availability.
+    struct fi3 {
+        vector_double fitness(const vector_double &dv) const
+        {
+            return {dv[0] + 2.};
+        }
+        void fitness_into(const double *dv, double *fv) const
+        {
+            fv[0] = dv[0] + 1.;
+        }
+        bool has_fitness_into() const
+        {
+            return flag;
+        }
+        std::pair<vector_double, vector_double> get_bounds() const
+        {
+            return {{0}, {1}};
+        }
+        bool flag = false;
+    };
+    BOOST_CHECK(has_fitness_into<fi3>::value);
+    BOOST_CHECK(override_has_fitness_into<fi3>::value);
+    p = problem{fi3{}};
+    BOOST_CHECK(!p.has_fitness_into());
+    p.fitness_into(&x, &y);
+    BOOST_CHECK_EQUAL(y, 3.);
+    fi3 f3;
+    f3.flag = true;
+    p = problem{f3};
+    BOOST_CHECK(p.has_fitness_into());
+    p.fitness_into(&x, &y);
+    BOOST_CHECK_EQUAL(y, 2.);
+
+    // The override is ignored if fitness_into() is not provided.
+    struct fi4 {
+        vector_double fitness(const vector_double &) const
+        {
+            return {0};
+        }
+        bool has_fitness_into() const
+        {
+            return true;
+        }
+        std::pair<vector_double, vector_double> get_bounds() const
+        {
+            return {{0}, {1}};
+        }
+    };
+    BOOST_CHECK(!has_fitness_into<fi4>::value);
+    BOOST_CHECK(override_has_fitness_into<fi4>::value);
+    BOOST_CHECK(!problem{fi4{}}.has_fitness_into());
+}
+
+BOOST_AUTO_TEST_CASE(incremental_fitness)
+{
+    using idx_t = std::vector<vector_double::size_type>;
+
+    // A problem with no incremental_fitness(): fitness() is used.
+    problem p;
+    BOOST_CHECK(!has_incremental_fitness<null_problem>::value);
+    BOOST_CHECK(!p.has_incremental_fitness());
+    BOOST_CHECK(p.incremental_fitness({.1}, {.2}, {42.}, {0}) == p.fitness({.1}));
+    BOOST_CHECK_EQUAL(p.get_fevals(), 2u);
+    // The input arguments are checked also when falling back to fitness().
+    BOOST_CHECK_THROW(p.incremental_fitness({.1}, {.2, .3}, {42.}, {0}), std::invalid_argument);
+    BOOST_CHECK_THROW(p.incremental_fitness({.1}, {.2}, {42., 43.}, {0}), std::invalid_argument);
+    BOOST_CHECK_THROW(p.incremental_fitness({.1}, {.2}, {42.}, {1}), std::invalid_argument);
+    BOOST_CHECK_EQUAL(p.get_fevals(), 2u);
+
+    // A UDP which provides incremental_fitness().
+    struct if0 {
+        vector_double fitness(const vector_double &x) const
+        {
+            return {x[0] + x[1] + x[2]};
+        }
+        vector_double incremental_fitness(const vector_double &x, const vector_double &x_old,
+                                          const vector_double &f_old, const idx_t &idx) const
+        {
+            // The indices must be sorted and unique.
+            if (!std::is_sorted(idx.begin(), idx.end()) || std::adjacent_find(idx.begin(), idx.end()) != idx.end()) {
+                throw std::runtime_error("unsorted indices");
+            }
+            auto retval = f_old;
+            for (auto i : idx) {
+                retval[0] += x[i] - x_old[i];
+            }
+            return retval;
+        }
+        std::pair<vector_double, vector_double> get_bounds() const
+        {
+            return {{0, 0, 0}, {1, 1, 1}};
+        }
+    };
+    p = problem{if0{}};
+    BOOST_CHECK(has_incremental_fitness<if0>::value);
+    BOOST_CHECK(p.has_incremental_fitness());
+    BOOST_CHECK(p.incremental_fitness({1, 2, 3}, {1, 0, 3}, {4}, {1}) == vector_double{6});
+    BOOST_CHECK(p.incremental_fitness({1, 2, 5}, {1, 0, 3}, {4}, {2, 1, 2}) == vector_double{8});
+    BOOST_CHECK(p.incremental_fitness({1, 0, 3}, {1, 0, 3}, {4}, {}) == vector_double{4});
+    BOOST_CHECK_EQUAL(p.get_fevals(), 3u);
+
+    // Invalid inputs.
+    BOOST_CHECK_THROW(p.incremental_fitness({1, 2}, {1, 0, 3}, {4}, {1}), std::invalid_argument);
+    BOOST_CHECK_THROW(p.incremental_fitness({1, 2, 3}, {1, 0}, {4}, {1}), std::invalid_argument);
+    BOOST_CHECK_THROW(p.incremental_fitness({1, 2, 3}, {1, 0, 3}, {4, 5}, {1}), std::invalid_argument);
+    BOOST_CHECK_EXCEPTION(p.incremental_fitness({1, 2, 3}, {1, 0, 3}, {4}, {1, 3}), std::invalid_argument,
+                          [](const std::invalid_argument &ia) {
+                              return boost::contains(ia.what(), "An invalid index of 3 was passed to the incremental "
+                                                                "fitness of a problem");
+                          });
+    BOOST_CHECK_EQUAL(p.get_fevals(), 3u);
+
+    // Wrong signature.
+    struct if1 {
+        vector_double fitness(const vector_double &) const
+        {
+            return {0};
+        }
+        vector_double incremental_fitness(const vector_double &, const vector_double &, const vector_double &,
+                                          const idx_t &)
+        {
+            return {0};
+        }
+        std::pair<vector_double, vector_double> get_bounds() const
+        {
+            return {{0}, {1}};
+        }
+    };
+    BOOST_CHECK(!has_incremental_fitness<if1>::value);
+    BOOST_CHECK(!problem{if1{}}.has_incremental_fitness());
+
+    // A UDP returning a fitness vector of the wrong size.
+    struct if2 {
+        vector_double fitness(const vector_double &) const
+        {
+            return {0};
+        }
+        vector_double incremental_fitness(const vector_double &, const vector_double &, const vector_double &,
+                                          const idx_t &) const
+        {
+            return {0, 0};
+        }
+        std::pair<vector_double, vector_double> get_bounds() const
+        {
+            return {{0}, {1}};
+        }
+    };
+    p = problem{if2{}};
+    BOOST_CHECK_THROW(p.incremental_fitness({0}, {1}, {0}, {0}), std::invalid_argument);
+    BOOST_CHECK_EQUAL(p.get_fevals(), 0u);
+}
+
 BOOST_AUTO_TEST_CASE(batch_fitness)
 {
     // Test a problem with no batch fitness.
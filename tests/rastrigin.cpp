@@ -31,11 +31,14 @@ see https://www.gnu.org/licenses/. */
 #include <boost/test/unit_test.hpp>
 
 #include <boost/lexical_cast.hpp>
+#include <initializer_list>
 #include <iostream>
 #include <stdexcept>
 #include <string>
+#include <vector>
 
 #include <pagmo/detail/constants.hpp>
+#include <pagmo/batch_evaluators/default_bfe.hpp>
 #include <pagmo/problem.hpp>
 #include <pagmo/problems/rastrigin.hpp>
 #include <pagmo/types.hpp>
@@ -85,6 +88,24 @@ BOOST_AUTO_TEST_CASE(rastrigin_test)
     BOOST_CHECK((x_best == vector_double{0., 0., 0., 0., 0.}));
 }
 
+BOOST_AUTO_TEST_CASE(rastrigin_batch_fitness_test)
+{
+    // Each unit component contributes exactly 1 to the fitness,
+    // each zero component contributes nothing.
+    rastrigin ras1{1u};
+    vector_double xs(1000u, 0.);
+    for (decltype(xs.size()) i = 0u; i < xs.size(); i += 2u) {
+        xs[i] = 1.;
+    }
+    const auto fs = ras1.batch_fitness(xs);
+    for (decltype(fs.size()) i = 0u; i < fs.size(); ++i) {
+        BOOST_CHECK(fs[i] == (i % 2u ? 0. : 1.));
+    }
+    rastrigin ras5{5u};
+    BOOST_CHECK((ras5.batch_fitness({1., 1., 1., 1., 1., 0., 0., 0., 0., 0.}) == vector_double{5., 0.}));
+    BOOST_CHECK(default_bfe{}(problem{ras1}, xs) == fs);
+}
+
 BOOST_AUTO_TEST_CASE(rastrigin_serialization_test)
 {
     problem p{rastrigin{4u}};
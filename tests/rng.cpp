@@ -31,11 +31,16 @@ see https://www.gnu.org/licenses/. */
 #include <boost/test/unit_test.hpp>
 
 #include <algorithm>
+#include <cstdint>
 #include <iostream>
 #include <iterator>
+#include <random>
+#include <set>
+#include <sstream>
 #include <thread>
 #include <vector>
 
+#include <pagmo/config.hpp>
 #include <pagmo/rng.hpp>
 
 using namespace pagmo;
@@ -71,7 +76,7 @@ BOOST_AUTO_TEST_CASE(set_seed_and_next)
 }
 
 // This test just runs calls to random_device::next() in two separate threads. If this executable
-// is compiled with -fsanitize=thread in clang/gcc, it should check that the locking logic
+// is compiled with -fsanitize=thread in clang/gcc, it should check that the atomic logic
 // in random_device is correct.
 BOOST_AUTO_TEST_CASE(data_races_test)
 {
@@ -81,4 +86,121 @@ BOOST_AUTO_TEST_CASE(data_races_test)
     std::thread t2([&]() { std::generate_n(std::back_inserter(prs5), N, random_device::next); });
     t1.join();
     t2.join();
+    BOOST_CHECK(prs4.size() == N);
+    BOOST_CHECK(prs5.size() == N);
+}
+
+#if !defined(PAGMO_WITH_XOSHIRO)
+
+// Without xoshiro support, the global sequence is
+// the one of the Mersenne Twister, as in the previous versions.
+BOOST_AUTO_TEST_CASE(mt19937_sequence_test)
+{
+    random_device::set_seed(42u);
+    std::mt19937 e(42u);
+    for (auto i = 0; i < 1000; ++i) {
+        BOOST_CHECK_EQUAL(random_device::next(), static_cast<unsigned>(e()));
+    }
+}
+
+#endif
+
+// Concurrent draws must return the same values as sequential ones
+// (possibly in a different order), without repetitions.
+BOOST_AUTO_TEST_CASE(concurrent_next_test)
+{
+    const unsigned N = 10000u;
+
+    random_device::set_seed(42u);
+    std::vector<unsigned> seq;
+    std::generate_n(std::back_inserter(seq), 4u * N, random_device::next);
+
+    random_device::set_seed(42u);
+    std::vector<std::vector<unsigned>> par(4);
+    std::vector<std::thread> threads;
+    for (auto &v : par) {
+        threads.emplace_back([&v, N]() { std::generate_n(std::back_inserter(v), N, random_device::next); });
+    }
+    for (auto &t : threads) {
+        t.join();
+    }
+
+    std::vector<unsigned> all;
+    for (const auto &v : par) {
+        all.insert(all.end(), v.begin(), v.end());
+    }
+    std::sort(all.begin(), all.end());
+    std::sort(seq.begin(), seq.end());
+    BOOST_CHECK(all == seq);
+}
+
+BOOST_AUTO_TEST_CASE(xoshiro128ss_test)
+{
+    using detail::xoshiro128ss;
+
+    // Reference values.
+    xoshiro128ss r;
+    BOOST_CHECK(r == xoshiro128ss{xoshiro128ss::default_seed});
+    const std::vector<std::uint32_t> ref = {2001543371u, 606055477u, 3698082788u, 253627654u, 2385661540u};
+    for (const auto x : ref) {
+        BOOST_CHECK_EQUAL(r(), x);
+    }
+
+    // Seeding.
+    r.seed(42u);
+    xoshiro128ss r2(42u);
+    BOOST_CHECK(r == r2);
+    r();
+    BOOST_CHECK(r != r2);
+    r2.discard(1);
+    BOOST_CHECK(r == r2);
+    r.discard(1000);
+    for (auto i = 0; i < 1000; ++i) {
+        r2();
+    }
+    BOOST_CHECK(r == r2);
+    r.seed();
+    BOOST_CHECK(r == xoshiro128ss{});
+
+    // Usage with the standard distributions.
+    std::uniform_real_distribution<double> rdist(0., 1.);
+    for (auto i = 0; i < 1000; ++i) {
+        const auto x = rdist(r);
+        BOOST_CHECK(x >= 0. && x < 1.);
+    }
+
+    // Substreams.
+    r.seed(42u);
+    auto r3(r);
+    r3.jump();
+    BOOST_CHECK(r3 == r.substream(1));
+    BOOST_CHECK(r == r.substream(0));
+    const std::vector<std::uint32_t> ref_jump = {2449739786u, 2605826980u, 3103900246u};
+    for (const auto x : ref_jump) {
+        BOOST_CHECK_EQUAL(r3(), x);
+    }
+    // The substreams do not overlap with each
+    // other within a short number of steps.
+    std::set<std::uint32_t> vals;
+    for (auto i = 0u; i < 10u; ++i) {
+        auto s = r.substream(i);
+        for (auto j = 0; j < 100; ++j) {
+            vals.insert(s());
+        }
+    }
+    BOOST_CHECK(vals.size() > 990u);
+
+    // State access.
+    auto r4(r);
+    r4();
+    BOOST_CHECK(r4 != r);
+    r4.set_state(r.get_state());
+    BOOST_CHECK(r4 == r);
+
+    // Stream operators.
+    std::stringstream ss;
+    ss << r4;
+    xoshiro128ss r5;
+    ss >> r5;
+    BOOST_CHECK(r5 == r4);
 }
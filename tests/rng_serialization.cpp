@@ -30,11 +30,14 @@ see https://www.gnu.org/licenses/. */
 #define BOOST_TEST_DYN_LINK
 #include <boost/test/unit_test.hpp>
 
+#include <algorithm>
+#include <functional>
 #include <iterator>
 #include <random>
 #include <sstream>
 #include <vector>
 
+#include <pagmo/rng.hpp>
 #include <pagmo/s11n.hpp>
 
 static std::mt19937 rng;
@@ -78,3 +81,49 @@ BOOST_AUTO_TEST_CASE(rng_serialization_test)
         BOOST_CHECK(r_copy == r);
     }
 }
+
+BOOST_AUTO_TEST_CASE(xoshiro_serialization_test)
+{
+    using r_type = pagmo::detail::xoshiro128ss;
+    std::uniform_int_distribution<r_type::result_type> dist;
+    for (auto i = 0; i < ntrials; ++i) {
+        r_type r(dist(rng));
+        r.discard(static_cast<unsigned long long>(i));
+        std::vector<r_type::result_type> v1;
+        auto r_copy(r);
+        std::generate_n(std::back_inserter(v1), 100, std::ref(r_copy));
+
+        // Binary archive.
+        {
+            std::stringstream ss;
+            {
+                boost::archive::binary_oarchive oarchive(ss);
+                oarchive << r;
+            }
+            r_type r2;
+            {
+                boost::archive::binary_iarchive iarchive(ss);
+                iarchive >> r2;
+            }
+            BOOST_CHECK(r2 == r);
+            std::vector<r_type::result_type> v2;
+            std::generate_n(std::back_inserter(v2), 100, std::ref(r2));
+            BOOST_CHECK_EQUAL_COLLECTIONS(v1.begin(), v1.end(), v2.begin(), v2.end());
+        }
+
+        // Text archive.
+        {
+            std::stringstream ss;
+            {
+                boost::archive::text_oarchive oarchive(ss);
+                oarchive << r;
+            }
+            r_type r2;
+            {
+                boost::archive::text_iarchive iarchive(ss);
+                iarchive >> r2;
+            }
+            BOOST_CHECK(r2 == r);
+        }
+    }
+}
@@ -31,12 +31,15 @@ see https://www.gnu.org/licenses/. */
 #include <boost/test/unit_test.hpp>
 
 #include <cmath>
+#include <initializer_list>
 #include <iostream>
 #include <stdexcept>
 #include <string>
+#include <vector>
 
 #include <boost/lexical_cast.hpp>
 
+#include <pagmo/batch_evaluators/default_bfe.hpp>
 #include <pagmo/problem.hpp>
 #include <pagmo/problems/rosenbrock.hpp>
 #include <pagmo/s11n.hpp>
@@ -80,6 +83,27 @@ BOOST_AUTO_TEST_CASE(rosenbrock_test)
     BOOST_CHECK(problem{rosenbrock{}}.get_thread_safety() == thread_safety::constant);
 }
 
+BOOST_AUTO_TEST_CASE(rosenbrock_batch_fitness_test)
+{
+    // {1, 1}, {0, 0} and {-1, 1}: only the (x_i - 1)^2 terms survive.
+    rosenbrock ros2{2u};
+    vector_double xs;
+    for (auto i = 0; i < 300; ++i) {
+        xs.insert(xs.end(), {1., 1., 0., 0., -1., 1.});
+    }
+    const auto fs = ros2.batch_fitness(xs);
+    BOOST_CHECK(fs.size() == 900u);
+    for (decltype(fs.size()) i = 0u; i < fs.size(); i += 3u) {
+        BOOST_CHECK(fs[i] == 0.);
+        BOOST_CHECK(fs[i + 1u] == 1.);
+        BOOST_CHECK(fs[i + 2u] == 4.);
+    }
+    BOOST_CHECK(default_bfe{}(problem{ros2}, xs) == fs);
+    // The coupling between consecutive components stays within each decision vector.
+    rosenbrock ros5{5u};
+    BOOST_CHECK((ros5.batch_fitness({1., 1., 1., 1., 1., 0., 0., 0., 0., 0.}) == vector_double{0., 4.}));
+}
+
 BOOST_AUTO_TEST_CASE(rosenbrock_serialization_test)
 {
     problem p{rosenbrock{4u}};
@@ -37,6 +37,7 @@ see https://www.gnu.org/licenses/. */
 
 #include <pagmo/algorithm.hpp>
 #include <pagmo/algorithms/sade.hpp>
+#include <pagmo/bfe.hpp>
 #include <pagmo/io.hpp>
 #include <pagmo/population.hpp>
 #include <pagmo/problems/hock_schittkowski_71.hpp>
@@ -173,3 +174,37 @@ BOOST_AUTO_TEST_CASE(serialization_test)
         BOOST_CHECK_CLOSE(std::get<6>(before_log[i]), std::get<6>(after_log[i]), 1e-8);
     }
 }
+
+BOOST_AUTO_TEST_CASE(bfe_test)
+{
+    for (unsigned variant_adptv = 1u; variant_adptv <= 2u; ++variant_adptv) {
+        population pop{rosenbrock{10u}, 20u, 23u};
+        sade uda{100u, 2u, variant_adptv, 0., 0., false, 23u};
+        uda.set_bfe(bfe{}); // This will use the default bfe.
+        uda.set_verbosity(10u);
+        pop = uda.evolve(pop);
+        BOOST_CHECK_EQUAL(pop.get_problem().get_fevals(), 20u + 100u * 20u);
+        BOOST_CHECK(uda.get_log().size() > 0u);
+
+        // The batch evolution is deterministic.
+        population pop_2{rosenbrock{10u}, 20u, 23u};
+        sade uda_2{100u, 2u, variant_adptv, 0., 0., false, 23u};
+        uda_2.set_bfe(bfe{});
+        pop_2 = uda_2.evolve(pop_2);
+        BOOST_CHECK(pop.get_f() == pop_2.get_f());
+
+        // Check the bfe survives serialization.
+        algorithm algo{uda};
+        std::stringstream ss;
+        {
+            boost::archive::binary_oarchive oarchive(ss);
+            oarchive << algo;
+        }
+        algorithm algo_2{};
+        {
+            boost::archive::binary_iarchive iarchive(ss);
+            iarchive >> algo_2;
+        }
+        BOOST_CHECK(algo.evolve(pop).get_f() == algo_2.evolve(pop).get_f());
+    }
+}
@@ -34,7 +34,9 @@ see https://www.gnu.org/licenses/. */
 #include <iostream>
 #include <stdexcept>
 #include <string>
+#include <vector>
 
+#include <pagmo/batch_evaluators/default_bfe.hpp>
 #include <pagmo/problem.hpp>
 #include <pagmo/problems/schwefel.hpp>
 #include <pagmo/types.hpp>
@@ -63,6 +65,24 @@ BOOST_AUTO_TEST_CASE(schwefel_test)
     BOOST_CHECK((x_best == vector_double{420.9687, 420.9687, 420.9687}));
 }
 
+BOOST_AUTO_TEST_CASE(schwefel_batch_fitness_test)
+{
+    schwefel sch1{1u};
+    const vector_double xs(1000u, 1.12);
+    const auto fs = sch1.batch_fitness(xs);
+    BOOST_CHECK(fs.size() == 1000u);
+    for (auto f : fs) {
+        BOOST_CHECK_CLOSE(f, 418.0067810680098, 1e-13);
+    }
+    BOOST_CHECK(default_bfe{}(problem{sch1}, xs) == fs);
+    // At the origin only the constant term is left.
+    schwefel sch3{3u};
+    const auto fs3 = sch3.batch_fitness({0., 0., 0., 0., 0., 0.});
+    BOOST_CHECK(fs3.size() == 2u);
+    BOOST_CHECK_CLOSE(fs3[0], 3 * 418.9828872724338, 1e-13);
+    BOOST_CHECK(fs3[0] == fs3[1]);
+}
+
 BOOST_AUTO_TEST_CASE(schwefel_serialization_test)
 {
     problem p{schwefel{4u}};
@@ -0,0 +1,348 @@
+/* Copyright 2017-2021 PaGMO development team
+
+This file is part of the PaGMO library.
+
+The PaGMO library is free software; you can redistribute it and/or modify
+it under the terms of either:
+
+  * the GNU Lesser General Public License as published by the Free
+    Software Foundation; either version 3 of the License, or (at your
+    option) any later version.
+
+or
+
+  * the GNU General Public License as published by the Free Software
+    Foundation; either version 3 of the License, or (at your option) any
+    later version.
+
+or both in parallel, as here.
+
+The PaGMO library is distributed in the hope that it will be useful, but
+WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+for more details.
+
+You should have received copies of the GNU General Public License and the
+GNU Lesser General Public License along with the PaGMO library.  If not,
+see https://www.gnu.org/licenses/. */
+
+#define BOOST_TEST_MODULE sharded_test
+#define BOOST_TEST_DYN_LINK
+#include <boost/test/unit_test.hpp>
+
+#include <atomic>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include <boost/lexical_cast.hpp>
+
+#include <pagmo/batch_evaluators/thread_bfe.hpp>
+#include <pagmo/exceptions.hpp>
+#include <pagmo/problem.hpp>
+#include <pagmo/problems/hock_schittkowski_71.hpp>
+#include <pagmo/problems/inventory.hpp>
+#include <pagmo/problems/null_problem.hpp>
+#include <pagmo/problems/rosenbrock.hpp>
+#include <pagmo/problems/sharded.hpp>
+#include <pagmo/s11n.hpp>
+#include <pagmo/threading.hpp>
+#include <pagmo/types.hpp>
+
+using namespace pagmo;
+
+// A problem providing only basic thread safety, because
+// its fitness function uses a mutable scratch buffer. The number
+// of copies and the detection of concurrent use of the same
+// object are tracked via static counters.
+struct scratch_prob {
+    scratch_prob() = default;
+    scratch_prob(const scratch_prob &) : m_buffer(), m_busy(false)
+    {
+        ++m_n_copies;
+    }
+    scratch_prob(scratch_prob &&) = default;
+    vector_double fitness(const vector_double &x) const
+    {
+        if (m_busy.exchange(true)) {
+            ++m_n_races;
+        }
+        m_buffer.assign(x.begin(), x.end());
+        vector_double retval{m_buffer[0] + m_buffer[1]};
+        m_busy.store(false);
+        return retval;
+    }
+    std::pair<vector_double, vector_double> get_bounds() const
+    {
+        return {{0., 0.}, {1., 1.}};
+    }
+    thread_safety get_thread_safety() const
+    {
+        return thread_safety::basic;
+    }
+    mutable vector_double m_buffer;
+    mutable std::atomic<bool> m_busy{false};
+    static std::atomic<unsigned> m_n_copies;
+    static std::atomic<unsigned> m_n_races;
+};
+
+std::atomic<unsigned> scratch_prob::m_n_copies(0);
+std::atomic<unsigned> scratch_prob::m_n_races(0);
+
+// A problem without thread safety.
+struct unsafe_prob {
+    vector_double fitness(const vector_double &) const
+    {
+        return {0.};
+    }
+    std::pair<vector_double, vector_double> get_bounds() const
+    {
+        return {{0.}, {1.}};
+    }
+    thread_safety get_thread_safety() const
+    {
+        return thread_safety::none;
+    }
+};
+
+BOOST_AUTO_TEST_CASE(sharded_construction_test)
+{
+    problem p0{sharded{}};
+    problem p1{sharded{null_problem{}}};
+    BOOST_CHECK_EQUAL(boost::lexical_cast<std::string>(p0), boost::lexical_cast<std::string>(p1));
+
+    sharded s{rosenbrock{5u}};
+    BOOST_CHECK_EQUAL(s.get_n_clones(), 0u);
+    BOOST_CHECK(s.get_inner_problem().is<rosenbrock>());
+    BOOST_CHECK(s.get_name() == "Multidimensional Rosenbrock Function [sharded]");
+    BOOST_CHECK(s.get_extra_info().find("Number of clones: 0") != std::string::npos);
+
+    // Construction from problem.
+    sharded s2{problem{rosenbrock{5u}}};
+    BOOST_CHECK(s2.get_inner_problem().is<rosenbrock>());
+}
+
+BOOST_AUTO_TEST_CASE(sharded_forwarding_test)
+{
+    hock_schittkowski_71 hs;
+    problem p0{hs};
+    problem p1{sharded{hs}};
+    BOOST_CHECK(p0.get_bounds() == p1.get_bounds());
+    BOOST_CHECK_EQUAL(p0.get_nobj(), p1.get_nobj());
+    BOOST_CHECK_EQUAL(p0.get_nec(), p1.get_nec());
+    BOOST_CHECK_EQUAL(p0.get_nic(), p1.get_nic());
+    BOOST_CHECK_EQUAL(p0.get_nix(), p1.get_nix());
+    BOOST_CHECK(p1.has_gradient());
+    BOOST_CHECK_EQUAL(p0.has_gradient_sparsity(), p1.has_gradient_sparsity());
+    BOOST_CHECK(p1.has_hessians());
+    BOOST_CHECK_EQUAL(p0.has_hessians_sparsity(), p1.has_hessians_sparsity());
+    BOOST_CHECK(!p1.has_batch_fitness());
+    const vector_double x{1., 2., 3., 4.};
+    BOOST_CHECK(p0.fitness(x) == p1.fitness(x));
+    BOOST_CHECK(p0.gradient(x) == p1.gradient(x));
+    BOOST_CHECK(p0.gradient_sparsity() == p1.gradient_sparsity());
+    BOOST_CHECK(p0.hessians(x) == p1.hessians(x));
+    BOOST_CHECK(p0.hessians_sparsity() == p1.hessians_sparsity());
+    BOOST_CHECK_THROW(p1.batch_fitness(x), not_implemented_error);
+    // The calls above all happened in this thread.
+    BOOST_CHECK_EQUAL(p1.extract<sharded>()->get_n_clones(), 1u);
+}
+
+BOOST_AUTO_TEST_CASE(sharded_thread_safety_test)
+{
+    BOOST_CHECK(problem{sharded{hock_schittkowski_71{}}}.get_thread_safety() == thread_safety::constant);
+    BOOST_CHECK(problem{sharded{rosenbrock{}}}.get_thread_safety() == thread_safety::constant);
+    BOOST_CHECK(problem{sharded{scratch_prob{}}}.get_thread_safety() == thread_safety::constant);
+    BOOST_CHECK(problem{sharded{unsafe_prob{}}}.get_thread_safety() == thread_safety::none);
+}
+
+BOOST_AUTO_TEST_CASE(sharded_clones_test)
+{
+    sharded s{scratch_prob{}};
+    scratch_prob::m_n_copies = 0;
+
+    // The clones are created lazily, and returned to the pool after use.
+    BOOST_CHECK_EQUAL(s.get_n_clones(), 0u);
+    BOOST_CHECK(s.fitness({.1, .2}) == vector_double{.1 + .2});
+    BOOST_CHECK_EQUAL(s.get_n_clones(), 1u);
+    BOOST_CHECK(s.fitness({.3, .2}) == vector_double{.3 + .2});
+    BOOST_CHECK_EQUAL(s.get_n_clones(), 1u);
+    BOOST_CHECK_EQUAL(scratch_prob::m_n_copies.load(), 1u);
+
+    // The clones are not tied to threads: another
+    // thread reuses the idle clone.
+    std::thread th([&s]() { s.fitness({.1, .2}); });
+    th.join();
+    BOOST_CHECK_EQUAL(s.get_n_clones(), 1u);
+    BOOST_CHECK_EQUAL(scratch_prob::m_n_copies.load(), 1u);
+    BOOST_CHECK(s.get_extra_info().find("Number of clones: 1") != std::string::npos);
+
+    // Non-const access to the inner problem destroys the clones.
+    s.get_inner_problem();
+    BOOST_CHECK_EQUAL(s.get_n_clones(), 0u);
+    s.fitness({.1, .2});
+    BOOST_CHECK_EQUAL(s.get_n_clones(), 1u);
+}
+
+BOOST_AUTO_TEST_CASE(sharded_concurrent_test)
+{
+    scratch_prob::m_n_races = 0;
+    scratch_prob::m_n_copies = 0;
+
+    sharded s{scratch_prob{}};
+    std::vector<std::thread> threads;
+    for (auto t = 0; t < 4; ++t) {
+        threads.emplace_back([&s]() {
+            for (auto i = 0; i < 1000; ++i) {
+                const vector_double x{(i % 100) / 100., .5};
+                BOOST_CHECK(s.fitness(x) == vector_double{x[0] + x[1]});
+            }
+        });
+    }
+    for (auto &th : threads) {
+        th.join();
+    }
+    BOOST_CHECK_EQUAL(scratch_prob::m_n_races.load(), 0u);
+    // The pool can store more than 4 idle clones, thus all the
+    // clones created (plus the copy made upon construction) are kept.
+    BOOST_CHECK(s.get_n_clones() >= 1u);
+    BOOST_CHECK_EQUAL(scratch_prob::m_n_copies.load(), s.get_n_clones() + 1u);
+
+    // Use with thread_bfe: the problem is evaluated in parallel
+    // and the clones of the inner problem are reused across evaluations.
+    problem p{sharded{scratch_prob{}}};
+    scratch_prob::m_n_copies = 0;
+    vector_double dvs(2000u);
+    for (auto i = 0u; i < 2000u; ++i) {
+        dvs[i] = (i % 20u) / 20.;
+    }
+    const auto fvs = thread_bfe{}(p, dvs);
+    for (auto i = 0u; i < 1000u; ++i) {
+        BOOST_CHECK(fvs[i] == dvs[2u * i] + dvs[2u * i + 1u]);
+    }
+    BOOST_CHECK_EQUAL(scratch_prob::m_n_races.load(), 0u);
+    BOOST_CHECK(scratch_prob::m_n_copies.load() >= 2u);
+    BOOST_CHECK(scratch_prob::m_n_copies.load() < 1000u);
+}
+
+// A problem whose fitness function blocks until
+// m_n_threads threads are evaluating it at the same time.
+struct barrier_prob {
+    vector_double fitness(const vector_double &) const
+    {
+        ++m_n_waiting;
+        while (m_n_waiting.load() < m_n_threads) {
+            std::this_thread::yield();
+        }
+        return {0.};
+    }
+    std::pair<vector_double, vector_double> get_bounds() const
+    {
+        return {{0.}, {1.}};
+    }
+    thread_safety get_thread_safety() const
+    {
+        return thread_safety::basic;
+    }
+    static unsigned m_n_threads;
+    static std::atomic<unsigned> m_n_waiting;
+};
+
+unsigned barrier_prob::m_n_threads = 0;
+std::atomic<unsigned> barrier_prob::m_n_waiting(0);
+
+BOOST_AUTO_TEST_CASE(sharded_bounded_pool_test)
+{
+    // The maximum number of idle clones: hardware_concurrency(),
+    // rounded up to a multiple of the number of shards (16).
+    const auto hc = std::max(std::thread::hardware_concurrency(), 1u);
+    const auto max_idle = (hc + 15u) / 16u * 16u;
+
+    // Force twice as many clones to be checked out at the same time.
+    barrier_prob::m_n_threads = 2u * max_idle;
+    sharded s{barrier_prob{}};
+    std::vector<std::thread> threads;
+    for (auto t = 0u; t < barrier_prob::m_n_threads; ++t) {
+        threads.emplace_back([&s]() { s.fitness({.5}); });
+    }
+    for (auto &th : threads) {
+        th.join();
+    }
+    // The clones in excess have been destroyed upon return.
+    BOOST_CHECK_EQUAL(s.get_n_clones(), max_idle);
+}
+
+BOOST_AUTO_TEST_CASE(sharded_stochastic_test)
+{
+    problem p{sharded{inventory{}}};
+    BOOST_CHECK(p.is_stochastic());
+    auto s = p.extract<sharded>();
+    const vector_double x(4u, 1.);
+    const auto f0 = p.fitness(x);
+    BOOST_CHECK(p.fitness(x) == f0);
+    BOOST_CHECK_EQUAL(s->get_n_clones(), 1u);
+    // Changing the seed destroys the clones.
+    p.set_seed(42u);
+    BOOST_CHECK_EQUAL(s->get_n_clones(), 0u);
+    BOOST_CHECK((p.fitness(x) == problem{inventory{4u, 10u, 42u}}.fitness(x)));
+}
+
+BOOST_AUTO_TEST_CASE(sharded_copy_move_test)
+{
+    sharded s{rosenbrock{3u}};
+    s.fitness({1., 2., 3.});
+    BOOST_CHECK_EQUAL(s.get_n_clones(), 1u);
+
+    // The clones are not copied.
+    auto s2(s);
+    BOOST_CHECK_EQUAL(s2.get_n_clones(), 0u);
+    BOOST_CHECK(s2.fitness({1., 2., 3.}) == s.fitness({1., 2., 3.}));
+
+    sharded s3;
+    s3 = s2;
+    BOOST_CHECK_EQUAL(s3.get_n_clones(), 0u);
+    BOOST_CHECK(s3.get_inner_problem().is<rosenbrock>());
+
+    auto s4(std::move(s2));
+    BOOST_CHECK_EQUAL(s4.get_n_clones(), 1u);
+    s3 = std::move(s4);
+    BOOST_CHECK_EQUAL(s3.get_n_clones(), 1u);
+    BOOST_CHECK(s3.fitness({1., 2., 3.}) == s.fitness({1., 2., 3.}));
+}
+
+BOOST_AUTO_TEST_CASE(sharded_serialization_test)
+{
+    problem p{sharded{hock_schittkowski_71{}}};
+    std::stringstream ss;
+    auto before = boost::lexical_cast<std::string>(p);
+    {
+        boost::archive::binary_oarchive oarchive(ss);
+        oarchive << p;
+    }
+    p = problem{};
+    {
+        boost::archive::binary_iarchive iarchive(ss);
+        iarchive >> p;
+    }
+    auto after = boost::lexical_cast<std::string>(p);
+    BOOST_CHECK_EQUAL(before, after);
+    BOOST_CHECK(p.is<sharded>());
+    BOOST_CHECK(p.extract<sharded>()->get_inner_problem().is<hock_schittkowski_71>());
+
+    // The clones are not serialised.
+    p.fitness({1., 2., 3., 4.});
+    BOOST_CHECK_EQUAL(p.extract<sharded>()->get_n_clones(), 1u);
+    std::stringstream ss2;
+    {
+        boost::archive::binary_oarchive oarchive(ss2);
+        oarchive << p;
+    }
+    p = problem{};
+    {
+        boost::archive::binary_iarchive iarchive(ss2);
+        iarchive >> p;
+    }
+    BOOST_CHECK_EQUAL(p.extract<sharded>()->get_n_clones(), 0u);
+}
@@ -41,6 +41,7 @@ see https://www.gnu.org/licenses/. */
 #include <pagmo/population.hpp>
 #include <pagmo/problems/hock_schittkowski_71.hpp>
 #include <pagmo/problems/inventory.hpp>
+#include <pagmo/problems/lennard_jones.hpp>
 #include <pagmo/problems/rosenbrock.hpp>
 #include <pagmo/problems/zdt.hpp>
 #include <pagmo/rng.hpp>
@@ -95,6 +96,24 @@ BOOST_AUTO_TEST_CASE(simulated_annealing_evolve_test)
     BOOST_CHECK_THROW((simulated_annealing{}.evolve(population{rosenbrock{}})), std::invalid_argument);
 }
 
+BOOST_AUTO_TEST_CASE(simulated_annealing_incremental_fitness_test)
+{
+    // The moves are evaluated incrementally, but the fitness
+    // stored in the population is computed from scratch.
+    problem prob{lennard_jones{10u}};
+    population pop{prob, 5u, 23u};
+    const auto f0 = pop.champion_f();
+    const auto fevals0 = pop.get_problem().get_fevals();
+    pop = simulated_annealing{10., 1e-5, 10u, 10u, 10u, 1., 23u}.evolve(pop);
+    BOOST_CHECK(pop.champion_f()[0] <= f0[0]);
+    // n_T_adj * n_range_adj * bin_size * dim evaluations, plus
+    // the one needed to write the best point back into pop.
+    BOOST_CHECK_EQUAL(pop.get_problem().get_fevals() - fevals0, 10u * 10u * 10u * 24u + 1u);
+    for (decltype(pop.size()) i = 0; i < pop.size(); ++i) {
+        BOOST_CHECK(pop.get_f()[i] == prob.fitness(pop.get_x()[i]));
+    }
+}
+
 BOOST_AUTO_TEST_CASE(sea_setters_getters_test)
 {
     simulated_annealing user_algo{10., 1e-5, 100u, 10u, 10u, 1., 123u};
@@ -30,6 +30,7 @@ see https://www.gnu.org/licenses/. */
 #define BOOST_TEST_DYN_LINK
 #include <boost/test/unit_test.hpp>
 
+#include <atomic>
 #include <initializer_list>
 #include <random>
 #include <sstream>
@@ -122,6 +123,164 @@ BOOST_AUTO_TEST_CASE(basic_tests)
     });
 }
 
+// A problem providing fitness_into(), which records
+// the number of invocations of fitness().
+struct fi_prob {
+    vector_double fitness(const vector_double &dv) const
+    {
+        ++n_fitness;
+        return {dv[0] + dv[1], dv[0] * dv[1]};
+    }
+    void fitness_into(const double *dv, double *fv) const
+    {
+        fv[0] = dv[0] + dv[1];
+        fv[1] = dv[0] * dv[1];
+    }
+    std::pair<vector_double, vector_double> get_bounds() const
+    {
+        return {{0., 0.}, {1., 1.}};
+    }
+    vector_double::size_type get_nobj() const
+    {
+        return 2;
+    }
+    thread_safety get_thread_safety() const
+    {
+        return thread_safety::basic;
+    }
+    mutable std::atomic<unsigned> n_fitness{0};
+
+    fi_prob() = default;
+    fi_prob(const fi_prob &) {}
+};
+
+BOOST_AUTO_TEST_CASE(fitness_into_tests)
+{
+    bfe bfe0{thread_bfe{}};
+
+    problem p0{fi_prob{}};
+    BOOST_CHECK(p0.has_fitness_into());
+    vector_double dvs(10000u);
+    for (auto &x : dvs) {
+        x = uniform_real_from_range(0., 1., rng);
+    }
+    const auto fvs = bfe0(p0, dvs);
+    BOOST_CHECK_EQUAL(fvs.size(), 10000u);
+    BOOST_CHECK_EQUAL(p0.get_fevals(), 5000u);
+    // fitness() was never called.
+    BOOST_CHECK_EQUAL(p0.extract<fi_prob>()->n_fitness.load(), 0u);
+    for (decltype(dvs.size()) i = 0; i < dvs.size(); i += 2u) {
+        BOOST_CHECK(fvs[i] == dvs[i] + dvs[i + 1u]);
+        BOOST_CHECK(fvs[i + 1u] == dvs[i] * dvs[i + 1u]);
+    }
+}
+
+BOOST_AUTO_TEST_CASE(grain_size_tests)
+{
+    BOOST_CHECK_EQUAL(thread_bfe{}.get_grain_size(), 0u);
+    BOOST_CHECK_EQUAL(thread_bfe{7}.get_grain_size(), 7u);
+
+    bfe bfe0{thread_bfe{7}};
+    BOOST_CHECK(boost::contains(bfe0.get_extra_info(), "Grain size: 7"));
+
+    // Check the results do not depend on the grain size.
+    problem p0{rosenbrock{2}};
+    vector_double dvs(1002u);
+    for (auto &x : dvs) {
+        x = uniform_real_from_range(-1., 1., rng);
+    }
+    BOOST_CHECK(bfe0(p0, dvs) == bfe{thread_bfe{}}(p0, dvs));
+    BOOST_CHECK(bfe0(p0, dvs) == bfe{thread_bfe{1000}}(p0, dvs));
+
+    p0 = problem{inventory{4}};
+    dvs.resize(1000u);
+    BOOST_CHECK(bfe0(p0, dvs) == bfe{thread_bfe{}}(p0, dvs));
+    BOOST_CHECK(bfe0(p0, dvs) == bfe{thread_bfe{1000}}(p0, dvs));
+}
+
+// A problem providing the basic thread safety level,
+// which records the number of times it has been copied
+// and which alters its own state at each fitness evaluation.
+struct copy_counting_prob {
+    vector_double fitness(const vector_double &dv) const
+    {
+        return {dv[0] + m_offset + m_n_evals++};
+    }
+    std::pair<vector_double, vector_double> get_bounds() const
+    {
+        return {{0.}, {1.}};
+    }
+    thread_safety get_thread_safety() const
+    {
+        return thread_safety::basic;
+    }
+
+    copy_counting_prob() = default;
+    copy_counting_prob(const copy_counting_prob &other) : m_offset(other.m_offset), m_n_evals(other.m_n_evals)
+    {
+        ++n_copies;
+    }
+    copy_counting_prob(copy_counting_prob &&) = default;
+
+    double m_offset = 0;
+    mutable unsigned m_n_evals = 0;
+    static std::atomic<unsigned> n_copies;
+};
+
+std::atomic<unsigned> copy_counting_prob::n_copies{0};
+
+BOOST_AUTO_TEST_CASE(copy_pool_tests)
+{
+    // NOTE: use a serial bfe, so that all the evaluations
+    // happen in a single task.
+    bfe bfe0{thread_bfe{1000}};
+
+    problem p0{copy_counting_prob{}};
+    vector_double dvs(100u);
+    for (auto &x : dvs) {
+        x = uniform_real_from_range(0., 1., rng);
+    }
+
+    copy_counting_prob::n_copies.store(0);
+    auto fvs = bfe0(p0, dvs);
+    BOOST_CHECK_EQUAL(p0.get_fevals(), 100u);
+    BOOST_CHECK_EQUAL(copy_counting_prob::n_copies.load(), 1u);
+    for (decltype(dvs.size()) i = 0; i < dvs.size(); ++i) {
+        BOOST_CHECK(fvs[i] == dvs[i] + static_cast<double>(i));
+    }
+    // The state of the original problem is untouched.
+    BOOST_CHECK_EQUAL(p0.extract<copy_counting_prob>()->m_n_evals, 0u);
+
+    // Evaluating again the same problem must start from a fresh
+    // copy, so that the state altered in the previous call
+    // does not leak into this one.
+    BOOST_CHECK(bfe0(p0, dvs) == fvs);
+    BOOST_CHECK_EQUAL(p0.get_fevals(), 200u);
+    BOOST_CHECK_EQUAL(copy_counting_prob::n_copies.load(), 2u);
+
+    // Modifications of the problem are seen by the next call.
+    p0.extract<copy_counting_prob>()->m_offset = 1;
+    fvs = bfe0(p0, dvs);
+    for (decltype(dvs.size()) i = 0; i < dvs.size(); ++i) {
+        BOOST_CHECK(fvs[i] == dvs[i] + 1. + static_cast<double>(i));
+    }
+
+    // Check with a parallel bfe as well: the copies are
+    // reused among the tasks of the same call, so
+    // that there are at most as many copies as tasks.
+    dvs.resize(10000u);
+    for (auto &x : dvs) {
+        x = uniform_real_from_range(0., 1., rng);
+    }
+    copy_counting_prob::n_copies.store(0);
+    fvs = bfe{thread_bfe{100}}(p0, dvs);
+    BOOST_CHECK(copy_counting_prob::n_copies.load() >= 1u);
+    BOOST_CHECK(copy_counting_prob::n_copies.load() <= 100u);
+    for (decltype(dvs.size()) i = 0; i < dvs.size(); ++i) {
+        BOOST_CHECK(fvs[i] >= dvs[i] + 1.);
+    }
+}
+
 BOOST_AUTO_TEST_CASE(s11n)
 {
     bfe bfe0{thread_bfe{}};
@@ -144,4 +303,21 @@ BOOST_AUTO_TEST_CASE(s11n)
     auto after = boost::lexical_cast<std::string>(bfe0);
     BOOST_CHECK_EQUAL(before, after);
     BOOST_CHECK(bfe0.is<thread_bfe>());
+}
+
+BOOST_AUTO_TEST_CASE(s11n_grain_size)
+{
+    bfe bfe0{thread_bfe{42}};
+    std::stringstream ss;
+    {
+        boost::archive::binary_oarchive oarchive(ss);
+        oarchive << bfe0;
+    }
+    bfe0 = bfe{};
+    {
+        boost::archive::binary_iarchive iarchive(ss);
+        iarchive >> bfe0;
+    }
+    BOOST_CHECK(bfe0.is<thread_bfe>());
+    BOOST_CHECK_EQUAL(bfe0.extract<thread_bfe>()->get_grain_size(), 42u);
 }
\ No newline at end of file
@@ -256,3 +256,39 @@ BOOST_AUTO_TEST_CASE(translate_batch_fitness_test)
     BOOST_CHECK(!no_bfe.has_batch_fitness());
     BOOST_CHECK_THROW(no_bfe.batch_fitness({3., 3., 3., 3.}), not_implemented_error);
 }
+
+// A UDP providing fitness_into(), whose output
+// differs from the output of fitness().
+struct udp_with_fi {
+    vector_double fitness(const vector_double &) const
+    {
+        return {0};
+    }
+    void fitness_into(const double *dv, double *fv) const
+    {
+        fv[0] = dv[0] + 2. * dv[1];
+    }
+    std::pair<vector_double, vector_double> get_bounds() const
+    {
+        return {{0, 0}, {1, 1}};
+    }
+};
+
+BOOST_AUTO_TEST_CASE(translate_fitness_into_test)
+{
+    problem p0{translate{udp_with_fi{}, {1, 2}}};
+    BOOST_CHECK(p0.has_fitness_into());
+    const vector_double x{3., 5.};
+    double f = 0;
+    p0.fitness_into(x.data(), &f);
+    BOOST_CHECK_EQUAL(f, 2. + 2. * 3.);
+    BOOST_CHECK_EQUAL(p0.extract<translate>()->get_inner_problem().get_fevals(), 1u);
+
+    // Fall back to fitness() if the inner problem does not provide fitness_into().
+    problem p1{translate{hock_schittkowski_71{}, {0.1, -0.2, 0.3, 0.4}}};
+    BOOST_CHECK(!p1.has_fitness_into());
+    const vector_double y{1., 2., 3., 4.};
+    vector_double fv(p1.get_nf());
+    p1.fitness_into(y.data(), fv.data());
+    BOOST_CHECK(fv == p1.fitness(y));
+}
@@ -340,3 +340,44 @@ BOOST_AUTO_TEST_CASE(unconstrain_batch_test)
     BOOST_CHECK(ys.size() == t.get_nobj() * bs);
     BOOST_CHECK(bf0::s_counter == 2u);
 }
+
+// A constrained UDP providing fitness_into(), whose
+// output differs from the output of fitness().
+struct fi0 {
+    vector_double fitness(const vector_double &) const
+    {
+        return {0., 0.};
+    }
+    void fitness_into(const double *dv, double *fv) const
+    {
+        fv[0] = dv[0];
+        fv[1] = dv[0] - 0.5;
+    }
+    vector_double::size_type get_nic() const
+    {
+        return 1u;
+    }
+    std::pair<vector_double, vector_double> get_bounds() const
+    {
+        return {{0.}, {1.}};
+    }
+};
+
+BOOST_AUTO_TEST_CASE(unconstrain_fitness_into_test)
+{
+    problem p0{unconstrain{fi0{}, "weighted", {10.}}};
+    BOOST_CHECK(p0.has_fitness_into());
+    double x = 0.25, f = -1.;
+    p0.fitness_into(&x, &f);
+    BOOST_CHECK_EQUAL(f, 0.25);
+    x = 0.75;
+    p0.fitness_into(&x, &f);
+    BOOST_CHECK_EQUAL(f, 0.75 + 10. * 0.25);
+
+    // Fall back to fitness() if the inner problem does not provide fitness_into().
+    problem p1{unconstrain{cec2006{1u}, "death penalty"}};
+    BOOST_CHECK(!p1.has_fitness_into());
+    const vector_double y(13u, 0.5);
+    p1.fitness_into(y.data(), &f);
+    BOOST_CHECK(vector_double{f} == p1.fitness(y));
+}
@@ -34,10 +34,12 @@ see https://www.gnu.org/licenses/. */
 #include <iostream>
 #include <stdexcept>
 #include <string>
+#include <vector>
 
 #include <boost/lexical_cast.hpp>
 #include <boost/test/tools/floating_point_comparison.hpp>
 
+#include <pagmo/batch_evaluators/default_bfe.hpp>
 #include <pagmo/problem.hpp>
 #include <pagmo/problems/zdt.hpp>
 #include <pagmo/s11n.hpp>
@@ -219,6 +221,25 @@ BOOST_AUTO_TEST_CASE(zdt_get_bounds_test)
     BOOST_CHECK(zdt6.get_bounds() == bounds6);
 }
 
+BOOST_AUTO_TEST_CASE(zdt_batch_fitness_test)
+{
+    // With all the components set to 0.33, f1 is 0.33 and g is 1 + 9 * 0.33.
+    zdt zdt1{1, 13};
+    const auto fs = zdt1.batch_fitness(vector_double(13u * 1000u, 0.33));
+    BOOST_CHECK(fs.size() == 2000u);
+    for (decltype(fs.size()) i = 0u; i < fs.size(); i += 2u) {
+        BOOST_CHECK_CLOSE(fs[i], 0.33, 1e-13);
+        BOOST_CHECK_CLOSE(fs[i + 1u], 2.825404001404863, 1e-13);
+    }
+    // Each problem id selects its own objective function, checked on the upper bounds.
+    for (auto prob_id : {1u, 2u, 3u, 4u, 5u, 6u}) {
+        zdt udp{prob_id, 11u};
+        const auto x = udp.get_bounds().second;
+        BOOST_CHECK(udp.batch_fitness(x) == udp.fitness(x));
+        BOOST_CHECK(default_bfe{}(problem{udp}, x) == udp.fitness(x));
+    }
+}
+
 BOOST_AUTO_TEST_CASE(zdt_serialization_test)
 {
     problem p{zdt{4, 4}};